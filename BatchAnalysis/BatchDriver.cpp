@@ -0,0 +1,273 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file BatchDriver.cpp
+ */
+
+#include "BatchDriver.h"
+#include "../LargeBarrelAnalysis/WorkStealingPool.h"
+#include "StatisticsMerger.h"
+#include <algorithm>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <thread>
+
+extern char** environ;
+
+namespace fs = boost::filesystem;
+
+BatchDriver::BatchDriver(const BatchSettings& settings) : fSettings(settings) {}
+
+std::vector<std::string> BatchDriver::expandInputs(const std::vector<std::string>& paths, const std::string& extension)
+{
+  std::vector<std::string> inputs;
+  for (const auto& path : paths)
+  {
+    if (fs::is_directory(path))
+    {
+      std::vector<std::string> directoryInputs;
+      for (fs::directory_iterator entry(path); entry != fs::directory_iterator(); ++entry)
+      {
+        const std::string fileName = entry->path().filename().string();
+        if (fs::is_regular_file(entry->path()) && boost::algorithm::ends_with(fileName, "." + extension))
+        {
+          directoryInputs.push_back(entry->path().string());
+        }
+      }
+      std::sort(directoryInputs.begin(), directoryInputs.end());
+      inputs.insert(inputs.end(), directoryInputs.begin(), directoryInputs.end());
+    }
+    else if (boost::algorithm::ends_with(path, ".txt"))
+    {
+      std::ifstream list(path);
+      std::string line;
+      while (std::getline(list, line))
+      {
+        line.erase(std::find_if(line.rbegin(), line.rend(), [](char c) { return !std::isspace(c); }).base(), line.end());
+        if (!line.empty() && line[0] != '#')
+        {
+          inputs.push_back(line);
+        }
+      }
+    }
+    else
+    {
+      inputs.push_back(path);
+    }
+  }
+  return inputs;
+}
+
+/**
+ * Outputs are written to the directory given to the executable with -o/--outputPath,
+ * otherwise next to the input file
+ */
+std::string BatchDriver::getOutputDirectory(const std::string& input, const std::vector<std::string>& executableArguments)
+{
+  for (std::size_t i = 0; i + 1 < executableArguments.size(); i++)
+  {
+    if (executableArguments[i] == "-o" || executableArguments[i] == "--outputPath")
+    {
+      return executableArguments[i + 1];
+    }
+  }
+  const auto parent = fs::path(input).parent_path();
+  return parent.empty() ? "." : parent.string();
+}
+
+std::vector<std::string> BatchDriver::findOutputFiles(const std::string& input, const std::string& outputDirectory,
+                                                      const std::vector<std::string>& types, std::time_t since)
+{
+  std::vector<std::string> outputs;
+  const std::string inputName = fs::path(input).filename().string();
+  const std::string stem = inputName.substr(0, inputName.find('.'));
+  boost::system::error_code error;
+  for (fs::directory_iterator entry(outputDirectory, error); !error && entry != fs::directory_iterator(); ++entry)
+  {
+    const std::string fileName = entry->path().filename().string();
+    if (fileName == inputName || !boost::algorithm::starts_with(fileName, stem + ".") || !boost::algorithm::ends_with(fileName, ".root"))
+    {
+      continue;
+    }
+    const std::string type = fileName.substr(stem.size() + 1, fileName.size() - stem.size() - 1 - std::string(".root").size());
+    if (!types.empty() && std::find(types.begin(), types.end(), type) == types.end())
+    {
+      continue;
+    }
+    if (fs::last_write_time(entry->path(), error) >= since && !error)
+    {
+      outputs.push_back(entry->path().string());
+    }
+  }
+  std::sort(outputs.begin(), outputs.end());
+  return outputs;
+}
+
+int BatchDriver::runJob(const std::vector<std::string>& inputs, const std::string& logFile) const
+{
+  std::vector<std::string> arguments = {fSettings.executable};
+  arguments.insert(arguments.end(), fSettings.executableArguments.begin(), fSettings.executableArguments.end());
+  for (const auto& input : inputs)
+  {
+    arguments.push_back("-f");
+    arguments.push_back(input);
+  }
+  std::vector<char*> argv;
+  for (auto& argument : arguments)
+  {
+    argv.push_back(&argument[0]);
+  }
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+  pid_t pid = 0;
+  const int spawnError = posix_spawnp(&pid, fSettings.executable.c_str(), &actions, nullptr, argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  if (spawnError != 0)
+  {
+    return -1;
+  }
+  int status = 0;
+  if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status))
+  {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+/**
+ * Jobs are run by the pool on background threads, the main thread merges outputs
+ * of finished jobs, so reading ROOT files is never done concurrently
+ */
+int BatchDriver::run()
+{
+  const unsigned int filesPerJob = std::max(fSettings.filesPerJob, 1u);
+  std::vector<std::vector<std::string>> jobs;
+  std::vector<double> costs;
+  for (std::size_t i = 0; i < fSettings.inputs.size(); i += filesPerJob)
+  {
+    jobs.emplace_back(fSettings.inputs.begin() + i, fSettings.inputs.begin() + std::min(i + filesPerJob, fSettings.inputs.size()));
+    double cost = 0.0;
+    for (const auto& input : jobs.back())
+    {
+      boost::system::error_code error;
+      auto size = fs::file_size(input, error);
+      cost += error ? 0.0 : static_cast<double>(size);
+    }
+    costs.push_back(cost);
+  }
+  boost::system::error_code error;
+  fs::create_directories(fSettings.logDirectory, error);
+
+  struct FinishedJob
+  {
+    std::size_t job;
+    int exitCode;
+    std::time_t start;
+  };
+  std::mutex finishedMutex;
+  std::condition_variable finishedCondition;
+  std::deque<FinishedJob> finishedJobs;
+  bool poolFinished = false;
+
+  WorkStealingPool pool(fSettings.numberOfWorkers);
+  std::cout << "Running " << jobs.size() << " jobs with " << fSettings.inputs.size() << " input files on " << pool.getNumberOfWorkers()
+            << " workers" << std::endl;
+  std::thread poolThread([&]() {
+    pool.run(costs, [&](std::size_t job, unsigned int) {
+      const std::string inputName = fs::path(jobs[job].front()).filename().string();
+      const std::string logFile = fSettings.logDirectory + "/" + inputName.substr(0, inputName.find('.')) + ".batch.log";
+      const std::time_t start = std::time(nullptr);
+      const int exitCode = runJob(jobs[job], logFile);
+      std::lock_guard<std::mutex> lock(finishedMutex);
+      finishedJobs.push_back({job, exitCode, start});
+      finishedCondition.notify_one();
+    });
+    std::lock_guard<std::mutex> lock(finishedMutex);
+    poolFinished = true;
+    finishedCondition.notify_one();
+  });
+
+  StatisticsMerger merger;
+  std::vector<std::string> failedInputs;
+  std::size_t doneJobs = 0;
+  int failedJobs = 0;
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(finishedMutex);
+    finishedCondition.wait(lock, [&]() { return !finishedJobs.empty() || poolFinished; });
+    if (finishedJobs.empty())
+    {
+      break;
+    }
+    const FinishedJob finished = finishedJobs.front();
+    finishedJobs.pop_front();
+    lock.unlock();
+
+    doneJobs++;
+    const auto& inputs = jobs[finished.job];
+    if (finished.exitCode != 0)
+    {
+      std::cerr << "[" << doneJobs << "/" << jobs.size() << "] Failed with exit code " << finished.exitCode << ": " << inputs.front() << std::endl;
+      failedInputs.insert(failedInputs.end(), inputs.begin(), inputs.end());
+      failedJobs++;
+      continue;
+    }
+    int histograms = 0;
+    for (const auto& input : inputs)
+    {
+      // modification times have a resolution of seconds
+      for (const auto& output :
+           findOutputFiles(input, getOutputDirectory(input, fSettings.executableArguments), fSettings.mergedTypes, finished.start - 1))
+      {
+        const int fileHistograms = merger.addFile(output);
+        if (fileHistograms < 0)
+        {
+          std::cerr << "Could not open output file for merging: " << output << std::endl;
+        }
+        else
+        {
+          histograms += fileHistograms;
+        }
+      }
+    }
+    std::cout << "[" << doneJobs << "/" << jobs.size() << "] Done: " << inputs.front() << ", merged " << histograms << " histograms" << std::endl;
+  }
+  poolThread.join();
+
+  if (!merger.write(fSettings.mergedFile))
+  {
+    std::cerr << "Could not write merged statistics to the file: " << fSettings.mergedFile << std::endl;
+  }
+  else
+  {
+    std::cout << "Statistics of " << merger.getNumberOfFiles() << " output files (" << merger.getNumberOfHistograms()
+              << " histograms) merged into: " << fSettings.mergedFile << std::endl;
+  }
+  for (const auto& input : failedInputs)
+  {
+    std::cerr << "Failed input: " << input << std::endl;
+  }
+  return failedJobs;
+}
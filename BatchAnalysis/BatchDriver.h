@@ -0,0 +1,78 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file BatchDriver.h
+ */
+
+#ifndef BATCHDRIVER_H
+#define BATCHDRIVER_H
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Settings of a batch of analyses, see BatchDriver
+ */
+struct BatchSettings
+{
+  /// Analysis executable, e.g. ./LargeBarrelAnalysis.x
+  std::string executable;
+  /// Options passed to every run of the executable, without input files
+  std::vector<std::string> executableArguments;
+  std::vector<std::string> inputs;
+  /// Number of parallel runs, 0 means all available hardware threads
+  unsigned int numberOfWorkers = 0;
+  /// Input files given to one run of the executable, processed one after another
+  unsigned int filesPerJob = 1;
+  std::string mergedFile = "merged.root";
+  /// Types of outputs with merged statistics, e.g. "cat.evt", all outputs if empty
+  std::vector<std::string> mergedTypes;
+  std::string logDirectory = ".";
+};
+
+/**
+ * @brief Driver running an analysis executable over many input files and merging the statistics
+ *
+ * Inputs are grouped in jobs, every job is one run of the executable with the job input files
+ * and the common options. Jobs are scheduled over a pool of workers with work stealing,
+ * largest inputs first. Output of every run goes to its own log file. As soon as a job is
+ * finished, histograms from the statistics directories of its output files are added to
+ * the merged statistics, which are written to one file at the end.
+ *
+ * Every job is a separate process, since the manager of the framework is a singleton running
+ * one chain of tasks at a time. Giving more files per job lets the executable load the parameter
+ * bank and start up once for all of them.
+ */
+class BatchDriver
+{
+public:
+  explicit BatchDriver(const BatchSettings& settings);
+
+  /// Returns the number of failed jobs
+  int run();
+
+  /// Files given directly, files from list files (*.txt, one path per line) and files with the extension from directories
+  static std::vector<std::string> expandInputs(const std::vector<std::string>& paths, const std::string& extension);
+  /// Output files of the input, named <input name up to first dot>.<type>.root, modified not earlier than given time
+  static std::vector<std::string> findOutputFiles(const std::string& input, const std::string& outputDirectory,
+                                                  const std::vector<std::string>& types, std::time_t since);
+  static std::string getOutputDirectory(const std::string& input, const std::vector<std::string>& executableArguments);
+
+private:
+  /// Returns exit code of the executable, -1 if it could not be run or was killed
+  int runJob(const std::vector<std::string>& inputs, const std::string& logFile) const;
+
+  BatchSettings fSettings;
+};
+
+#endif /* !BATCHDRIVER_H */
@@ -0,0 +1,110 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file StatisticsMerger.cpp
+ */
+
+#include "StatisticsMerger.h"
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TKey.h>
+
+int StatisticsMerger::addFile(const std::string& fileName)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if (!file || file->IsZombie())
+  {
+    return -1;
+  }
+  int histograms = 0;
+  TIter next(file->GetListOfKeys());
+  while (auto key = static_cast<TKey*>(next()))
+  {
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if (keyClass && keyClass->InheritsFrom(TDirectory::Class()))
+    {
+      histograms += addDirectory(static_cast<TDirectory*>(key->ReadObj()), key->GetName());
+    }
+  }
+  fNumberOfFiles++;
+  return histograms;
+}
+
+int StatisticsMerger::addDirectory(TDirectory* directory, const std::string& path)
+{
+  int histograms = 0;
+  TIter next(directory->GetListOfKeys());
+  while (auto key = static_cast<TKey*>(next()))
+  {
+    auto keyClass = TClass::GetClass(key->GetClassName());
+    if (!keyClass)
+    {
+      continue;
+    }
+    const std::string keyPath = path + "/" + key->GetName();
+    if (keyClass->InheritsFrom(TDirectory::Class()))
+    {
+      histograms += addDirectory(static_cast<TDirectory*>(key->ReadObj()), keyPath);
+    }
+    else if (keyClass->InheritsFrom(TH1::Class()))
+    {
+      std::unique_ptr<TH1> histogram(static_cast<TH1*>(key->ReadObj()));
+      histogram->SetDirectory(nullptr);
+      auto merged = fHistograms.find(keyPath);
+      if (merged == fHistograms.end())
+      {
+        fHistograms.emplace(keyPath, std::move(histogram));
+      }
+      else
+      {
+        merged->second->Add(histogram.get());
+      }
+      histograms++;
+    }
+  }
+  return histograms;
+}
+
+bool StatisticsMerger::write(const std::string& fileName) const
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "RECREATE"));
+  if (!file || file->IsZombie())
+  {
+    return false;
+  }
+  for (const auto& histogram : fHistograms)
+  {
+    const auto& path = histogram.first;
+    const auto separator = path.find_last_of('/');
+    TDirectory* directory = file.get();
+    if (separator != std::string::npos)
+    {
+      const std::string directoryPath = path.substr(0, separator);
+      directory = file->GetDirectory(directoryPath.c_str());
+      if (!directory)
+      {
+        file->mkdir(directoryPath.c_str());
+        directory = file->GetDirectory(directoryPath.c_str());
+      }
+    }
+    directory->WriteObject(histogram.second.get(), path.substr(separator + 1).c_str());
+  }
+  file->Close();
+  return true;
+}
+
+const TH1* StatisticsMerger::getHistogram(const std::string& path) const
+{
+  auto histogram = fHistograms.find(path);
+  return histogram != fHistograms.end() ? histogram->second.get() : nullptr;
+}
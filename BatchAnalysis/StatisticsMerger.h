@@ -0,0 +1,54 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file StatisticsMerger.h
+ */
+
+#ifndef STATISTICSMERGER_H
+#define STATISTICSMERGER_H
+
+#include <TH1.h>
+#include <map>
+#include <memory>
+#include <string>
+
+class TDirectory;
+
+/**
+ * @brief Merging of the statistics histograms of many output files into one file
+ *
+ * Histograms written by the tasks from getStatistics() are kept in directories of
+ * the output files. Merger sums histograms with the same path in all added files,
+ * objects outside of directories (parameter bank, time windows tree) are not merged,
+ * so the result needs no purging. Files can be added as soon as they are written,
+ * only the sums are kept in memory.
+ */
+class StatisticsMerger
+{
+public:
+  /// Returns number of histograms read from the file, -1 if it cannot be opened
+  int addFile(const std::string& fileName);
+  bool write(const std::string& fileName) const;
+
+  std::size_t getNumberOfFiles() const { return fNumberOfFiles; }
+  std::size_t getNumberOfHistograms() const { return fHistograms.size(); }
+  /// Merged histogram with path "directory/name", nullptr if there is none
+  const TH1* getHistogram(const std::string& path) const;
+
+private:
+  int addDirectory(TDirectory* directory, const std::string& path);
+
+  std::map<std::string, std::unique_ptr<TH1>> fHistograms;
+  std::size_t fNumberOfFiles = 0;
+};
+
+#endif /* !STATISTICSMERGER_H */
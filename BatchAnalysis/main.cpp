@@ -0,0 +1,69 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file main.cpp
+ */
+
+#include "BatchDriver.h"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+namespace po = boost::program_options;
+
+int main(int argc, const char* argv[])
+{
+  BatchSettings settings;
+  std::vector<std::string> inputPaths;
+  std::string extension;
+
+  po::options_description description("Usage: BatchAnalysis.x -x <executable> -i <inputs> [options] -- <options of the executable>\nOptions");
+  description.add_options()("help,h", "produce help message")(
+      "executable,x", po::value<std::string>(&settings.executable)->required(), "analysis executable, e.g. ./LargeBarrelAnalysis.x")(
+      "input,i", po::value<std::vector<std::string>>(&inputPaths)->required()->multitoken(),
+      "input files, directories or lists of input files (*.txt, one path per line)")(
+      "extension,e", po::value<std::string>(&extension)->default_value("hld"), "extension of input files taken from directories")(
+      "workers,n", po::value<unsigned int>(&settings.numberOfWorkers)->default_value(0), "number of parallel jobs, 0 means all hardware threads")(
+      "files-per-job,k", po::value<unsigned int>(&settings.filesPerJob)->default_value(1), "number of input files given to one run of the executable")(
+      "merged,m", po::value<std::string>(&settings.mergedFile)->default_value("merged.root"), "file with merged statistics histograms")(
+      "merge-type,s", po::value<std::vector<std::string>>(&settings.mergedTypes)->multitoken(),
+      "types of output files to merge, e.g. cat.evt, all outputs by default")(
+      "log-dir,l", po::value<std::string>(&settings.logDirectory)->default_value("."), "directory of log files of the jobs")(
+      "executable-arguments", po::value<std::vector<std::string>>(&settings.executableArguments), "options of the executable");
+  po::positional_options_description positional;
+  positional.add("executable-arguments", -1);
+
+  try
+  {
+    po::variables_map variables;
+    po::store(po::command_line_parser(argc, argv).options(description).positional(positional).run(), variables);
+    if (variables.count("help"))
+    {
+      std::cout << description << std::endl;
+      return EXIT_SUCCESS;
+    }
+    po::notify(variables);
+  }
+  catch (const po::error& error)
+  {
+    std::cerr << error.what() << std::endl << description << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  settings.inputs = BatchDriver::expandInputs(inputPaths, extension);
+  if (settings.inputs.empty())
+  {
+    std::cerr << "No input files found" << std::endl;
+    return EXIT_FAILURE;
+  }
+  BatchDriver driver(settings);
+  return driver.run() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -38,7 +38,7 @@ bool EventCategorizerCosmic::init()
     WARNING(Form("No value of the %s parameter provided by the user. Using default value of %lf.", kMinCosmicTOTParamKey.c_str(), fMinCosmicTOT));
   }
   if (isOptionSet(fParams.getOptions(), kTOTCalculationType)) {
-    fTOTCalculationType = getOptionAsString(fParams.getOptions(), kTOTCalculationType);
+    fTOTCalculationType = HitFinderTools::getTOTCalculationType(getOptionAsString(fParams.getOptions(), kTOTCalculationType));
   } else {
     WARNING("No TOT calculation option given by the user. Using standard sum.");
   }
@@ -83,7 +83,7 @@ JPetEvent EventCategorizerCosmic::cosmicAnalysis(vector<JPetHit> hits)
 {
   JPetEvent cosmicEvent;
   for (unsigned i = 0; i < hits.size(); i++) {
-    double TOTofHit = HitFinderTools::calculateTOT(hits[i], HitFinderTools::getTOTCalculationType(fTOTCalculationType));
+    double TOTofHit = HitFinderTools::calculateTOT(hits[i], fTOTCalculationType);
     if (TOTofHit >= fMinCosmicTOT) {
       cosmicEvent.addHit(hits[i]);
       //Uncomment if kCosmic type will be avalible
@@ -16,6 +16,7 @@
 #ifndef EVENTCATEGORIZERCOSMIC_H
 #define EVENTCATEGORIZERCOSMIC_H
 
+#include "../LargeBarrelAnalysis/HitFinderTools.h"
 #include <JPetStatistics/JPetStatistics.h>
 #include <JPetEventType/JPetEventType.h>
 #include <JPetUserTask/JPetUserTask.h>
@@ -41,7 +42,7 @@ protected:
 	void saveEvents(const std::vector<JPetEvent>& event);
 	double fMinCosmicTOT = 55000.0;
 	bool fSaveControlHistos = true;
-    std::string fTOTCalculationType = "";
+    HitFinderTools::TOTCalculationType fTOTCalculationType = HitFinderTools::kSimplified;
     void initialiseHistograms();
 };
 
@@ -18,6 +18,7 @@
 #include "../LargeBarrelAnalysis/SignalFinder.h"
 #include "../LargeBarrelAnalysis/EventFinder.h"
 #include "../LargeBarrelAnalysis/HitFinder.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include <JPetManager/JPetManager.h>
 #include "EventCategorizerCosmic.h"
 using namespace std;
@@ -27,12 +28,12 @@ int main(int argc, const char* argv[])
   try {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<EventFinder>("EventFinder");
-    manager.registerTask<EventCategorizerCosmic>("EventCategorizerCosmic");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<EventFinder>>("EventFinder");
+    manager.registerTask<InstrumentedTask<EventCategorizerCosmic>>("EventCategorizerCosmic");
 
     manager.useTask("TimeWindowCreator", "hld", "tslot.calib");
     manager.useTask("SignalFinder", "tslot.calib", "raw.sig");
@@ -0,0 +1,154 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file JPetGojaFileReader.cpp
+ */
+
+#include "JPetGojaFileReader.h"
+#include "JPetLoggerInclude.h"
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+JPetGojaFileReader::JPetGojaFileReader(const std::string& path)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    ERROR("Could not open GOJA file: " + path);
+    return;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0)
+  {
+    ERROR("Could not read size of GOJA file: " + path);
+    close(fd);
+    return;
+  }
+  fSize = static_cast<std::size_t>(fileStat.st_size);
+  if (fSize == 0)
+  {
+    close(fd);
+    fOpened = true;
+    return;
+  }
+  void* mapped = mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    ERROR("Could not map GOJA file into memory: " + path);
+    fSize = 0;
+    return;
+  }
+  madvise(mapped, fSize, MADV_SEQUENTIAL);
+  fBegin = static_cast<const char*>(mapped);
+  fOpened = true;
+}
+
+JPetGojaFileReader::~JPetGojaFileReader()
+{
+  if (fBegin)
+  {
+    munmap(const_cast<char*>(fBegin), fSize);
+  }
+}
+
+std::vector<JPetGojaFileReader::Chunk> JPetGojaFileReader::split(unsigned int numberOfChunks) const
+{
+  std::vector<Chunk> chunks;
+  if (!fBegin || numberOfChunks == 0)
+  {
+    return chunks;
+  }
+  const char* end = fBegin + fSize;
+  const char* chunkBegin = fBegin;
+  const std::size_t chunkSize = fSize / numberOfChunks + 1;
+  while (chunkBegin < end)
+  {
+    const char* chunkEnd = chunkBegin + chunkSize < end ? chunkBegin + chunkSize : end;
+    if (chunkEnd < end)
+    {
+      const void* newLine = std::memchr(chunkEnd, '\n', end - chunkEnd);
+      chunkEnd = newLine ? static_cast<const char*>(newLine) + 1 : end;
+    }
+    chunks.push_back(Chunk(chunkBegin, chunkEnd));
+    chunkBegin = chunkEnd;
+  }
+  return chunks;
+}
+
+bool JPetGojaFileReader::next(const char*& current, const char* end, JPetGojaCoincidence& coincidence)
+{
+  while (current < end)
+  {
+    const void* newLine = std::memchr(current, '\n', end - current);
+    const char* lineEnd = newLine ? static_cast<const char*>(newLine) : end;
+    const char* position = current;
+    current = newLine ? lineEnd + 1 : end;
+
+    if (parseFloat(position, lineEnd, coincidence.firstX) && parseFloat(position, lineEnd, coincidence.firstY) &&
+        parseFloat(position, lineEnd, coincidence.firstZ) && parseDouble(position, lineEnd, coincidence.firstT) &&
+        parseFloat(position, lineEnd, coincidence.secondX) && parseFloat(position, lineEnd, coincidence.secondY) &&
+        parseFloat(position, lineEnd, coincidence.secondZ) && parseDouble(position, lineEnd, coincidence.secondT))
+    {
+      return true;
+    }
+    // empty or incomplete line, skip it
+  }
+  return false;
+}
+
+bool JPetGojaFileReader::nextToken(const char*& current, const char* lineEnd, char* buffer, std::size_t bufferSize)
+{
+  while (current < lineEnd && isSpace(*current))
+  {
+    current++;
+  }
+  std::size_t length = 0;
+  while (current < lineEnd && !isSpace(*current))
+  {
+    if (length + 1 >= bufferSize)
+    {
+      return false;
+    }
+    buffer[length++] = *current++;
+  }
+  buffer[length] = '\0';
+  return length > 0;
+}
+
+bool JPetGojaFileReader::parseFloat(const char*& current, const char* lineEnd, float& value)
+{
+  char buffer[64];
+  if (!nextToken(current, lineEnd, buffer, sizeof(buffer)))
+  {
+    return false;
+  }
+  char* parsedEnd = nullptr;
+  value = std::strtof(buffer, &parsedEnd);
+  return parsedEnd != buffer;
+}
+
+bool JPetGojaFileReader::parseDouble(const char*& current, const char* lineEnd, double& value)
+{
+  char buffer[64];
+  if (!nextToken(current, lineEnd, buffer, sizeof(buffer)))
+  {
+    return false;
+  }
+  char* parsedEnd = nullptr;
+  value = std::strtod(buffer, &parsedEnd);
+  return parsedEnd != buffer;
+}
@@ -0,0 +1,87 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file JPetGojaFileReader.h
+ */
+
+#ifndef JPETGOJAFILEREADER_H
+#define JPETGOJAFILEREADER_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Single coincidence read from GOJA ASCII file
+ *
+ * Only first 8 columns of GOJA line are used (positions in cm and times in ps of both hits),
+ * rest of the line is skipped.
+ */
+struct JPetGojaCoincidence
+{
+  float firstX = 0.f;
+  float firstY = 0.f;
+  float firstZ = 0.f;
+  double firstT = 0.;
+  float secondX = 0.f;
+  float secondY = 0.f;
+  float secondZ = 0.f;
+  double secondT = 0.;
+};
+
+/**
+ * @brief Memory mapped reader of GOJA ASCII coincidence files
+ *
+ * File is mapped into memory in read only mode and parsed line by line without iostreams.
+ * Numbers are converted with strtof/strtod, so the values are the same as the ones read by std::ifstream.
+ * Mapped buffer can be split into chunks starting at line boundaries, which allows
+ * parsing different parts of the file in separate threads.
+ */
+class JPetGojaFileReader
+{
+public:
+  using Chunk = std::pair<const char*, const char*>;
+
+  explicit JPetGojaFileReader(const std::string& path);
+  ~JPetGojaFileReader();
+
+  bool isOpen() const { return fOpened; }
+  std::size_t size() const { return fSize; }
+
+  /**
+   * @brief Split mapped file into at most numberOfChunks parts, each starting at the beginning of a line
+   */
+  std::vector<Chunk> split(unsigned int numberOfChunks) const;
+  Chunk whole() const { return Chunk(fBegin, fBegin + fSize); }
+
+  /**
+   * @brief Parse next coincidence from [current, end) and move current to the beginning of next line
+   * \return false when end of chunk is reached without finding complete coincidence
+   */
+  static bool next(const char*& current, const char* end, JPetGojaCoincidence& coincidence);
+
+private:
+  JPetGojaFileReader(const JPetGojaFileReader&) = delete;
+  JPetGojaFileReader& operator=(const JPetGojaFileReader&) = delete;
+
+  static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+  static bool parseFloat(const char*& current, const char* lineEnd, float& value);
+  static bool parseDouble(const char*& current, const char* lineEnd, double& value);
+  static bool nextToken(const char*& current, const char* lineEnd, char* buffer, std::size_t bufferSize);
+
+  const char* fBegin = nullptr;
+  std::size_t fSize = 0;
+  bool fOpened = false;
+};
+
+#endif /*  !JPETGOJAFILEREADER_H */
@@ -0,0 +1,139 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file JPetVolumeWriter.cpp
+ */
+
+#include "JPetVolumeWriter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+bool JPetVolumeWriter::isLittleEndian()
+{
+  const uint16_t test = 1;
+  uint8_t firstByte = 0;
+  std::memcpy(&firstByte, &test, 1);
+  return firstByte == 1;
+}
+
+bool JPetVolumeWriter::writeNRRD(const JPetVolume& volume, const std::string& outputFileName)
+{
+  if (volume.data.size() != static_cast<std::size_t>(volume.sizeX) * volume.sizeY * volume.sizeZ)
+    return false;
+  std::ofstream out(outputFileName, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+    return false;
+  out << "NRRD0004\n";
+  out << "type: float\n";
+  out << "dimension: 3\n";
+  out << "sizes: " << volume.sizeX << " " << volume.sizeY << " " << volume.sizeZ << "\n";
+  out << "spacings: " << volume.spacingX << " " << volume.spacingY << " " << volume.spacingZ << "\n";
+  out << "encoding: raw\n";
+  out << "endian: " << (isLittleEndian() ? "little" : "big") << "\n";
+  for (const auto& keyValue : volume.keyValues)
+  {
+    out << keyValue.first << ":=" << keyValue.second << "\n";
+  }
+  out << "\n";
+  out.write(reinterpret_cast<const char*>(volume.data.data()), volume.data.size() * sizeof(float));
+  return out.good();
+}
+
+bool JPetVolumeWriter::readNRRD(const std::string& inputFileName, JPetVolume& volume)
+{
+  std::ifstream in(inputFileName, std::ios::binary);
+  if (!in.is_open())
+    return false;
+  std::string line;
+  std::getline(in, line);
+  if (line.compare(0, 4, "NRRD") != 0)
+    return false;
+  bool swapBytes = false;
+  volume = JPetVolume();
+  while (std::getline(in, line) && !line.empty())
+  {
+    const auto keyValueSeparator = line.find(":=");
+    if (keyValueSeparator != std::string::npos)
+    {
+      volume.keyValues[line.substr(0, keyValueSeparator)] = line.substr(keyValueSeparator + 2);
+      continue;
+    }
+    const auto separator = line.find(": ");
+    if (separator == std::string::npos)
+      continue;
+    const std::string field = line.substr(0, separator);
+    std::istringstream value(line.substr(separator + 2));
+    if (field == "type" && value.str() != "float")
+      return false;
+    if (field == "encoding" && value.str() != "raw")
+      return false;
+    if (field == "dimension" && value.str() != "3")
+      return false;
+    if (field == "sizes")
+      value >> volume.sizeX >> volume.sizeY >> volume.sizeZ;
+    if (field == "spacings")
+      value >> volume.spacingX >> volume.spacingY >> volume.spacingZ;
+    if (field == "endian")
+      swapBytes = (value.str() == "little") != isLittleEndian();
+  }
+  volume.data.resize(static_cast<std::size_t>(volume.sizeX) * volume.sizeY * volume.sizeZ);
+  in.read(reinterpret_cast<char*>(volume.data.data()), volume.data.size() * sizeof(float));
+  if (static_cast<std::size_t>(in.gcount()) != volume.data.size() * sizeof(float))
+    return false;
+  if (swapBytes)
+  {
+    for (auto& value : volume.data)
+    {
+      char* bytes = reinterpret_cast<char*>(&value);
+      std::reverse(bytes, bytes + sizeof(float));
+    }
+  }
+  return true;
+}
+
+bool JPetVolumeWriter::writePPMSlice(const JPetVolume& volume, unsigned int z, const std::string& outputFileName)
+{
+  if (z >= volume.sizeZ)
+    return false;
+  int maxValue = 0;
+  for (unsigned int y = 0; y < volume.sizeY; y++)
+  {
+    for (unsigned int x = 0; x < volume.sizeX; x++)
+    {
+      maxValue = std::max(maxValue, static_cast<int>(volume(x, y, z)));
+    }
+  }
+  std::ofstream res(outputFileName);
+  if (!res.is_open())
+    return false;
+  res << "P2" << std::endl;
+  res << volume.sizeX << " " << volume.sizeY << std::endl;
+  res << maxValue << std::endl;
+  for (unsigned int y = 0; y < volume.sizeY; y++)
+  {
+    for (unsigned int x = 0; x < volume.sizeX; x++)
+    {
+      int resultInt = std::round(volume(x, y, z));
+      if (resultInt < 0)
+      {
+        resultInt = 0;
+      }
+      res << resultInt << " ";
+    }
+    res << std::endl;
+  }
+  return res.good();
+}
@@ -0,0 +1,63 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file JPetVolumeWriter.h
+ */
+
+#ifndef JPETVOLUMEWRITER_H
+#define JPETVOLUMEWRITER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reconstructed volume stored as contiguous float array, x is the fastest changing index
+ */
+struct JPetVolume
+{
+  unsigned int sizeX = 0;
+  unsigned int sizeY = 0;
+  unsigned int sizeZ = 0;
+  float spacingX = 1.f;
+  float spacingY = 1.f;
+  float spacingZ = 1.f;
+  std::map<std::string, std::string> keyValues; // extra description saved as NRRD key/value pairs
+  std::vector<float> data;
+
+  float& operator()(unsigned int x, unsigned int y, unsigned int z) { return data[(z * sizeY + y) * sizeX + x]; }
+  float operator()(unsigned int x, unsigned int y, unsigned int z) const { return data[(z * sizeY + y) * sizeX + x]; }
+};
+
+/**
+ * @brief Functions saving and reading volumes as single NRRD file (text header followed by raw little endian floats)
+ *
+ * Files can be opened in e.g. 3D Slicer, ImageJ or MRIcroGL, and read back in one read with readNRRD.
+ * PPM (P2) preview of single slice can be written from the volume with the same format as ReconstructionTask used before.
+ */
+class JPetVolumeWriter
+{
+public:
+  static bool writeNRRD(const JPetVolume& volume, const std::string& outputFileName);
+  static bool readNRRD(const std::string& inputFileName, JPetVolume& volume);
+  static bool writePPMSlice(const JPetVolume& volume, unsigned int z, const std::string& outputFileName);
+
+private:
+  JPetVolumeWriter() = delete;
+  ~JPetVolumeWriter() = delete;
+  JPetVolumeWriter(const JPetVolumeWriter&) = delete;
+  JPetVolumeWriter& operator=(const JPetVolumeWriter&) = delete;
+
+  static bool isLittleEndian();
+};
+
+#endif /*  !JPETVOLUMEWRITER_H */
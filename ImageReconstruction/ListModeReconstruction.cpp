@@ -0,0 +1,135 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ListModeReconstruction.cpp
+ */
+
+#include "ListModeReconstruction.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
+#include "JPetVolumeWriter.h"
+#include <algorithm>
+#include <cmath>
+using namespace jpet_options_tools;
+
+ListModeReconstruction::ListModeReconstruction(const char* name) : JPetUserTask(name) {}
+
+ListModeReconstruction::~ListModeReconstruction() {}
+
+bool ListModeReconstruction::init()
+{
+  setUpOptions();
+  fOutputEvents = new JPetTimeWindow("JPetEvent");
+  return true;
+}
+
+bool ListModeReconstruction::exec()
+{
+  if (const auto& timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent))
+  {
+    const unsigned int numberOfEventsInTimeWindow = timeWindow->getNumberOfEvents();
+    for (unsigned int i = 0; i < numberOfEventsInTimeWindow; i++)
+    {
+      const auto& event = dynamic_cast<const JPetEvent&>(timeWindow->operator[](static_cast<int>(i)));
+      const auto& hits = event.getHits();
+      fTotalAnalyzedEvents++;
+      if (hits.size() != 2)
+      {
+        continue;
+      }
+      addLOR(hits[0], hits[1]);
+    }
+  }
+  else
+  {
+    ERROR("Returned event is not TimeWindow");
+    return false;
+  }
+  return true;
+}
+
+void ListModeReconstruction::addLOR(const JPetHit& firstHit, const JPetHit& secondHit)
+{
+  ListModeLOR lor;
+  lor.firstX = firstHit.getPosX();
+  lor.firstY = firstHit.getPosY();
+  lor.firstZ = firstHit.getPosZ();
+  lor.firstTime = firstHit.getTime();
+  lor.secondX = secondHit.getPosX();
+  lor.secondY = secondHit.getPosY();
+  lor.secondZ = secondHit.getPosZ();
+  lor.secondTime = secondHit.getTime();
+  fLORs.push_back(lor);
+}
+
+bool ListModeReconstruction::terminate()
+{
+  JPetVolume volume;
+  volume.sizeX = std::max(1, static_cast<int>(std::ceil(2.f * fXYRange / fVoxelSize)));
+  volume.sizeY = volume.sizeX;
+  volume.sizeZ = std::max(1, static_cast<int>(std::ceil(2.f * fZRange / fSliceThickness)));
+  volume.spacingX = fVoxelSize;
+  volume.spacingY = fVoxelSize;
+  volume.spacingZ = fSliceThickness;
+  volume.keyValues["reconstruction"] = fTOFSigma > 0.f ? "ListModeTOFBackProjection" : "ListModeBackProjection";
+  volume.keyValues["tof sigma"] = std::to_string(fTOFSigma);
+  volume.keyValues["spacing units"] = "cm";
+
+  const unsigned long numberOfUsedLORs =
+      ListModeTools::backProject(fLORs, volume, ListModeTools::getTOFSigmaAlongLOR(fTOFSigma), fNumberOfThreads);
+  if (!JPetVolumeWriter::writeNRRD(volume, fOutFileName))
+  {
+    ERROR("Could not save reconstructed volume to file: " + fOutFileName);
+  }
+
+  INFO("List-mode back-projection: " + std::to_string(numberOfUsedLORs) + " LORs in volume, " + std::to_string(fLORs.size()) +
+       " LORs from " + std::to_string(fTotalAnalyzedEvents) + " events");
+  return true;
+}
+
+void ListModeReconstruction::setUpOptions()
+{
+  auto opts = getOptions();
+  if (isOptionSet(opts, kOutFileNameKey))
+  {
+    fOutFileName = getOptionAsString(opts, kOutFileNameKey);
+  }
+  if (isOptionSet(opts, kVoxelSizeKey))
+  {
+    fVoxelSize = getOptionAsFloat(opts, kVoxelSizeKey);
+  }
+  if (isOptionSet(opts, kSliceThicknessKey))
+  {
+    fSliceThickness = getOptionAsFloat(opts, kSliceThicknessKey);
+  }
+  if (isOptionSet(opts, kXYRangeKey))
+  {
+    fXYRange = getOptionAsFloat(opts, kXYRangeKey);
+  }
+  if (isOptionSet(opts, kZRangeKey))
+  {
+    fZRange = getOptionAsFloat(opts, kZRangeKey);
+  }
+  if (isOptionSet(opts, kTOFSigmaKey))
+  {
+    fTOFSigma = getOptionAsFloat(opts, kTOFSigmaKey);
+  }
+  if (isOptionSet(opts, kNumberOfThreadsKey))
+  {
+    fNumberOfThreads = std::max(getOptionAsInt(opts, kNumberOfThreadsKey), 0);
+  }
+  if (fVoxelSize <= 0.f || fSliceThickness <= 0.f)
+  {
+    WARNING("Voxel size and slice thickness have to be positive, using defaults: 0.5 cm and 1 cm");
+    fVoxelSize = 0.5f;
+    fSliceThickness = 1.f;
+  }
+}
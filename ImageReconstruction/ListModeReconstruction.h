@@ -0,0 +1,79 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ListModeReconstruction.h
+ */
+
+#ifndef LISTMODERECONSTRUCTION_H
+#define LISTMODERECONSTRUCTION_H
+
+#include "JPetHit/JPetHit.h"
+#include "JPetUserTask/JPetUserTask.h"
+#include "ListModeTools.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Module back-projecting events directly into image volume, without creating sinogram
+ *
+ * Input: *.reco.unk.evt (events with two hits, selected by FilterEvents)
+ * Output: *.nrrd volume with TOF back-projection of all LORs (float values)
+ *
+ * Every LOR is back-projected with gaussian kernel centred in the annihilation point calculated from TOF,
+ * so neither z nor TOF information is binned, see ListModeTools. For low statistics data it is faster
+ * than filling and filtering mostly empty sinogram. Volume is centred in (0, 0, 0).
+ *
+ * - "ListModeReconstruction_OutFileName_std::string": output volume file name
+ * - "ListModeReconstruction_VoxelSize_float": size of the voxel in x/y [cm]
+ * - "ListModeReconstruction_SliceThickness_float": size of the voxel in z [cm]
+ * - "ListModeReconstruction_XYRange_float": volume covers [-range, range] in x and y [cm]
+ * - "ListModeReconstruction_ZRange_float": volume covers [-range, range] in z [cm]
+ * - "ListModeReconstruction_TOFSigma_float": sigma of the time difference of hits [ps], 0 means back-projection without TOF
+ * - "ListModeReconstruction_NumberOfThreads_int": number of threads, 0 or not set means all available hardware threads
+ */
+class ListModeReconstruction : public JPetUserTask
+{
+public:
+  explicit ListModeReconstruction(const char* name);
+  virtual ~ListModeReconstruction();
+  virtual bool init() override;
+  virtual bool exec() override;
+  virtual bool terminate() override;
+
+private:
+  ListModeReconstruction(const ListModeReconstruction&) = delete;
+  ListModeReconstruction& operator=(const ListModeReconstruction&) = delete;
+
+  void setUpOptions();
+  void addLOR(const JPetHit& firstHit, const JPetHit& secondHit);
+
+  const std::string kOutFileNameKey = "ListModeReconstruction_OutFileName_std::string";
+  const std::string kVoxelSizeKey = "ListModeReconstruction_VoxelSize_float";
+  const std::string kSliceThicknessKey = "ListModeReconstruction_SliceThickness_float";
+  const std::string kXYRangeKey = "ListModeReconstruction_XYRange_float";
+  const std::string kZRangeKey = "ListModeReconstruction_ZRange_float";
+  const std::string kTOFSigmaKey = "ListModeReconstruction_TOFSigma_float";
+  const std::string kNumberOfThreadsKey = "ListModeReconstruction_NumberOfThreads_int";
+
+  std::string fOutFileName = "listmode_reconstruction.nrrd";
+  float fVoxelSize = 0.5f;     // in cm
+  float fSliceThickness = 1.f; // in cm
+  float fXYRange = 50.f;       // in cm
+  float fZRange = 25.f;        // in cm
+  float fTOFSigma = 150.f;     // in ps
+  unsigned int fNumberOfThreads = 0;
+
+  std::vector<ListModeLOR> fLORs;
+  unsigned long fTotalAnalyzedEvents = 0;
+};
+
+#endif /*  !LISTMODERECONSTRUCTION_H */
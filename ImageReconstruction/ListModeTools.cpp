@@ -0,0 +1,165 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ListModeTools.cpp
+ */
+
+#include "ListModeTools.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+namespace
+{
+/* Clips range [begin, end] of the line position + t * direction to the part with coordinate inside [low, high].
+ * Returns false if line does not cross that range at all.
+ */
+bool clipToRange(float position, float direction, float low, float high, float& begin, float& end)
+{
+  if (std::abs(direction) < 1e-6f)
+    return position >= low && position <= high;
+  float first = (low - position) / direction;
+  float second = (high - position) / direction;
+  if (first > second)
+    std::swap(first, second);
+  begin = std::max(begin, first);
+  end = std::min(end, second);
+  return begin <= end;
+}
+}
+
+float ListModeTools::getAnnihilationPointDistance(const ListModeLOR& lor)
+{
+  const float dx = lor.secondX - lor.firstX;
+  const float dy = lor.secondY - lor.firstY;
+  const float dz = lor.secondZ - lor.firstZ;
+  const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+  return length / 2.f - kSpeedOfLight * (lor.secondTime - lor.firstTime) / 2.f;
+}
+
+unsigned long ListModeTools::backProject(const std::vector<ListModeLOR>& lors, JPetVolume& volume, float tofSigma, unsigned int numberOfThreads)
+{
+  volume.data.assign(static_cast<std::size_t>(volume.sizeX) * volume.sizeY * volume.sizeZ, 0.f);
+  if (volume.data.empty() || lors.empty())
+    return 0;
+
+  if (numberOfThreads == 0)
+    numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  numberOfThreads = std::min(numberOfThreads, volume.sizeZ);
+  const unsigned int slicesPerTile = (volume.sizeZ + numberOfThreads - 1) / numberOfThreads;
+
+  const unsigned int numberOfTiles = (volume.sizeZ + slicesPerTile - 1) / slicesPerTile;
+  std::vector<std::vector<char>> deposited(numberOfTiles, std::vector<char>(lors.size(), 0));
+  if (numberOfTiles == 1)
+  {
+    backProjectTile(lors, volume, tofSigma, 0, volume.sizeZ, deposited[0]);
+  }
+  else
+  {
+    std::vector<std::thread> workers;
+    for (unsigned int tile = 0; tile < numberOfTiles; tile++)
+    {
+      const unsigned int firstSlice = tile * slicesPerTile;
+      const unsigned int lastSlice = std::min(firstSlice + slicesPerTile, volume.sizeZ);
+      workers.emplace_back(&ListModeTools::backProjectTile, std::cref(lors), std::ref(volume), tofSigma, firstSlice, lastSlice,
+                           std::ref(deposited[tile]));
+    }
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  unsigned long numberOfDepositedLORs = 0;
+  for (std::size_t i = 0; i < lors.size(); i++)
+  {
+    for (const auto& tileDeposited : deposited)
+    {
+      if (tileDeposited[i])
+      {
+        numberOfDepositedLORs++;
+        break;
+      }
+    }
+  }
+  return numberOfDepositedLORs;
+}
+
+void ListModeTools::backProjectTile(const std::vector<ListModeLOR>& lors, JPetVolume& volume, float tofSigma, unsigned int firstSlice,
+                                    unsigned int lastSlice, std::vector<char>& deposited)
+{
+  const float halfX = volume.sizeX * volume.spacingX / 2.f;
+  const float halfY = volume.sizeY * volume.spacingY / 2.f;
+  const float halfZ = volume.sizeZ * volume.spacingZ / 2.f;
+  const float tileBegin = firstSlice * volume.spacingZ - halfZ;
+  const float tileEnd = lastSlice * volume.spacingZ - halfZ;
+  const float step = std::min(volume.spacingX, std::min(volume.spacingY, volume.spacingZ)) / 2.f;
+  const bool useTOF = tofSigma > 0.f;
+  const float kernelNormalization = useTOF ? step / (tofSigma * std::sqrt(2.f * static_cast<float>(M_PI))) : 0.f;
+
+  for (std::size_t i = 0; i < lors.size(); i++)
+  {
+    const ListModeLOR& lor = lors[i];
+    const float dx = lor.secondX - lor.firstX;
+    const float dy = lor.secondY - lor.firstY;
+    const float dz = lor.secondZ - lor.firstZ;
+    const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (length < step)
+      continue;
+    const float ux = dx / length;
+    const float uy = dy / length;
+    const float uz = dz / length;
+
+    // samples are placed in the same positions along LOR for every tile, tile only limits which of them are used
+    float center = 0.f;
+    float samplesBegin = 0.f;
+    float samplesEnd = length;
+    if (useTOF)
+    {
+      center = getAnnihilationPointDistance(lor);
+      samplesBegin = std::max(samplesBegin, center - kKernelRange * tofSigma);
+      samplesEnd = std::min(samplesEnd, center + kKernelRange * tofSigma);
+    }
+    if (samplesEnd <= samplesBegin)
+      continue;
+    const int numberOfSamples = std::ceil((samplesEnd - samplesBegin) / step);
+
+    float begin = samplesBegin;
+    float end = samplesEnd;
+    if (!clipToRange(lor.firstX, ux, -halfX, halfX, begin, end) || !clipToRange(lor.firstY, uy, -halfY, halfY, begin, end) ||
+        !clipToRange(lor.firstZ, uz, tileBegin, tileEnd, begin, end))
+      continue;
+    const int firstSample = std::max(0, static_cast<int>(std::floor((begin - samplesBegin) / step - 0.5f)));
+    const int lastSample = std::min(numberOfSamples, static_cast<int>(std::ceil((end - samplesBegin) / step + 0.5f)));
+
+    const float uniformWeight = step / length;
+    for (int sample = firstSample; sample < lastSample; sample++)
+    {
+      const float s = samplesBegin + (sample + 0.5f) * step;
+      const int x = std::floor((lor.firstX + s * ux + halfX) / volume.spacingX);
+      const int y = std::floor((lor.firstY + s * uy + halfY) / volume.spacingY);
+      const int z = std::floor((lor.firstZ + s * uz + halfZ) / volume.spacingZ);
+      if (x < 0 || y < 0 || z < static_cast<int>(firstSlice) || x >= static_cast<int>(volume.sizeX) || y >= static_cast<int>(volume.sizeY) ||
+          z >= static_cast<int>(lastSlice))
+        continue;
+      float weight = uniformWeight;
+      if (useTOF)
+      {
+        const float distance = (s - center) / tofSigma;
+        weight = kernelNormalization * std::exp(-0.5f * distance * distance);
+      }
+      volume(x, y, z) += weight;
+      deposited[i] = 1;
+    }
+  }
+}
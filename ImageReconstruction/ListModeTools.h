@@ -0,0 +1,86 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ListModeTools.h
+ */
+
+#ifndef LISTMODETOOLS_H
+#define LISTMODETOOLS_H
+
+#include "JPetVolumeWriter.h"
+#include <vector>
+
+/**
+ * @brief Single LOR of list-mode data: positions of both hits [cm] and their times [ps]
+ */
+struct ListModeLOR
+{
+  float firstX = 0.f;
+  float firstY = 0.f;
+  float firstZ = 0.f;
+  float secondX = 0.f;
+  float secondY = 0.f;
+  float secondZ = 0.f;
+  double firstTime = 0.;
+  double secondTime = 0.;
+};
+
+/**
+ * @brief Helper functions for list-mode back-projection of LORs directly into image volume
+ *
+ * Every LOR is back-projected with gaussian TOF kernel centred in the annihilation point estimated from
+ * the time difference of the hits, without binning the events into sinogram first.
+ * Volume is centred in (0, 0, 0), its size and spacing are taken from the volume passed to backProject.
+ * LOR is sampled with step equal to half of the smallest voxel spacing and each sample is added to the voxel containing it.
+ *
+ * Work is split into tiles of consecutive z slices, one tile per thread. Every thread goes over all LORs
+ * and samples only the part of LOR crossing its tile, so no merging of partial images is needed,
+ * and the result does not depend on the number of threads.
+ */
+class ListModeTools
+{
+public:
+  /**
+   * @brief Distance [cm] of the annihilation point from the first hit along the LOR.
+   * Same convention as SinogramCreatorTools::calculateLORSlice: point is moved towards the hit registered earlier.
+   */
+  static float getAnnihilationPointDistance(const ListModeLOR& lor);
+
+  /**
+   * @brief Back-project LORs into volume, volume data is (re)allocated and zeroed
+   * \param tofSigma sigma of the TOF kernel along LOR [cm], 0 or less means no TOF: whole LOR inside the volume is back-projected
+   * \param numberOfThreads number of z tiles processed in parallel, 0 means all available hardware threads
+   * \return number of LORs that deposited anything in the volume
+   */
+  static unsigned long backProject(const std::vector<ListModeLOR>& lors, JPetVolume& volume, float tofSigma, unsigned int numberOfThreads);
+
+  /// sigma [cm] of the TOF kernel along LOR corresponding to the sigma of the time difference of hits [ps]
+  static float getTOFSigmaAlongLOR(float timeDifferenceSigma) { return kSpeedOfLight * timeDifferenceSigma / 2.f; }
+
+  static constexpr float kSpeedOfLight = 0.0299792458f; // [cm/ps]
+  static constexpr float kKernelRange = 3.f;            // TOF kernel is cut at this number of sigmas
+
+private:
+  ListModeTools() = delete;
+  ~ListModeTools() = delete;
+  ListModeTools(const ListModeTools&) = delete;
+  ListModeTools& operator=(const ListModeTools&) = delete;
+
+  /**
+   * @brief Back-project LORs into slices [firstSlice, lastSlice) of volume
+   * \param deposited for each LOR set to 1 if anything was added to the tile, separate for every tile
+   */
+  static void backProjectTile(const std::vector<ListModeLOR>& lors, JPetVolume& volume, float tofSigma, unsigned int firstSlice,
+                              unsigned int lastSlice, std::vector<char>& deposited);
+};
+
+#endif /*  !LISTMODETOOLS_H */
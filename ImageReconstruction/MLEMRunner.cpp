@@ -19,7 +19,9 @@
 #include "JPetGeomMapping/JPetGeomMapping.h"
 #include "JPetHit/JPetHit.h"
 #include "JPetParamBank/JPetParamBank.h"
+#include <algorithm>
 #include <iomanip> //std::setprecision
+#include <memory>
 
 using namespace jpet_options_tools;
 
@@ -110,7 +112,13 @@ bool MLEMRunner::parseEvent(const JPetEvent& event)
   }
   double dl = (t1 - t2) * kSpeedOfLightMetersPerPs;
 
-  fReconstructionStringStream << d1 << " " << d2 << " " << z1* kCentimetersToMeters << " " << z2* kCentimetersToMeters << " " << dl << "\n";
+  if (fNumberOfSubsets > 1 && fSubsetType == OSEMTools::kAngular) {
+    const unsigned int subset = OSEMTools::getAngularSubset(OSEMTools::getLORAngle(x1, y1, x2, y2), fNumberOfSubsets);
+    fSubsetStringStreams[subset] << d1 << " " << d2 << " " << z1* kCentimetersToMeters << " " << z2* kCentimetersToMeters << " " << dl << "\n";
+  } else {
+    // temporal subsets are blocks of all events, they are split in runOSEMReconstruction
+    fReconstructionStringStream << d1 << " " << d2 << " " << z1* kCentimetersToMeters << " " << z2* kCentimetersToMeters << " " << dl << "\n";
+  }
   fOutputStream << d1 << " " << d2 << " " << z1* kCentimetersToMeters << " " << z2* kCentimetersToMeters << " " << dl << "\n";
 
   return true;
@@ -202,6 +210,19 @@ void MLEMRunner::setUpOptions()
   if (isOptionSet(opts, kTOFSigmaAlongZAxisKey)) {
     fTOFSigmaAlongZAxis = getOptionAsFloat(opts, kTOFSigmaAlongZAxisKey);
   }
+
+  if (isOptionSet(opts, kNumberOfSubsetsKey)) {
+    fNumberOfSubsets = static_cast<unsigned int>(std::max(getOptionAsInt(opts, kNumberOfSubsetsKey), 1));
+  }
+  fSubsetStringStreams.resize(fNumberOfSubsets);
+
+  if (isOptionSet(opts, kSubsetTypeKey)) {
+    fSubsetType = OSEMTools::getSubsetType(getOptionAsString(opts, kSubsetTypeKey));
+    if (fSubsetType == OSEMTools::kSubsetTypeNotFound) {
+      ERROR("Could not find subset type: " + getOptionAsString(opts, kSubsetTypeKey) + ", using Angular.");
+      fSubsetType = OSEMTools::kAngular;
+    }
+  }
 }
 
 void MLEMRunner::setSystemMatrix()
@@ -351,6 +372,10 @@ MLEMRunner::SquareMatrix MLEMRunner::runGenerateSystemMatrix()
 
 void MLEMRunner::runReconstruction()
 {
+  if (fNumberOfSubsets > 1) {
+    runOSEMReconstruction();
+    return;
+  }
   (*fReconstruction) << fReconstructionStringStream;
   if (fVerbose) {
     Reconstruction::EventStatistics st;
@@ -394,11 +419,7 @@ void MLEMRunner::runReconstruction()
     const auto iteration = (block + 1) * n_iterations_in_block;
     if (iteration <= start_iteration)
       continue;
-    util::nrrd_writer nrrd(fReconstructionOutputPath + "_" + std::to_string(iteration) + ".nrrd",
-                           fReconstructionOutputPath + "_" + std::to_string(iteration), false);
-    nrrd << fReconstruction->rho;
-    util::obstream bin(fReconstructionOutputPath + "_" + std::to_string(iteration));
-    bin << fReconstruction->rho;
+    saveIteration(iteration);
   }
   // final reconstruction statistics
   const auto st = fReconstruction->statistics();
@@ -406,3 +427,61 @@ void MLEMRunner::runReconstruction()
   std::cerr << "  voxel count = " << st.used_voxels << "(" << (double)st.used_voxels / st.used_events << " / event)" << std::endl;
   std::cerr << "  pixel count = " << st.used_pixels << "(" << (double)st.used_pixels / st.used_events << " / event)" << std::endl;
 }
+
+/**
+ * Ordered subsets reconstruction. Every subset has its own copy of reconstruction (sharing scanner, grid and
+ * sensitivity) holding only events from that subset. Single MLEM iteration over subset events started from current image
+ * gives rho * backprojection_subset / sensitivity, rescaling it by number of subsets gives OSEM update
+ * with sensitivity divided between subsets.
+ */
+void MLEMRunner::runOSEMReconstruction()
+{
+  if (fSubsetType == OSEMTools::kTemporal) {
+    std::string event;
+    unsigned long eventNumber = 0;
+    while (std::getline(fReconstructionStringStream, event)) {
+      fSubsetStringStreams[OSEMTools::getTemporalSubset(eventNumber++, fReconstructedEvents, fNumberOfSubsets)] << event << "\n";
+    }
+    fReconstructionStringStream.str(std::string());
+  }
+
+  std::vector<std::unique_ptr<Reconstruction>> subsets;
+  for (unsigned int subset = 0; subset < fNumberOfSubsets; subset++) {
+    subsets.emplace_back(new Reconstruction(*fReconstruction));
+    (*subsets.back()) << fSubsetStringStreams[subset];
+    fSubsetStringStreams[subset].str(std::string());
+    if (fVerbose) {
+      std::cerr << "   subset " << subset << " events = " << subsets.back()->n_events() << std::endl;
+    }
+  }
+
+  util::progress progress(fVerbose, fReconstructionIterations, 1, 0);
+  for (int iteration = 0; iteration < fReconstructionIterations; iteration++) {
+    progress(iteration);
+    OSEMTools::runSubsetsPass(fReconstruction->rho, subsets);
+    progress(iteration, true);
+    saveIteration(iteration + 1);
+  }
+
+  unsigned long usedEvents = 0;
+  unsigned long usedVoxels = 0;
+  unsigned long usedPixels = 0;
+  for (const auto& subset : subsets) {
+    const auto st = subset->statistics();
+    usedEvents += st.used_events;
+    usedVoxels += st.used_voxels;
+    usedPixels += st.used_pixels;
+  }
+  std::cerr << "  event count = " << usedEvents << std::endl;
+  std::cerr << "  voxel count = " << usedVoxels << "(" << (double)usedVoxels / usedEvents << " / event)" << std::endl;
+  std::cerr << "  pixel count = " << usedPixels << "(" << (double)usedPixels / usedEvents << " / event)" << std::endl;
+}
+
+void MLEMRunner::saveIteration(int iteration)
+{
+  util::nrrd_writer nrrd(fReconstructionOutputPath + "_" + std::to_string(iteration) + ".nrrd",
+                         fReconstructionOutputPath + "_" + std::to_string(iteration), false);
+  nrrd << fReconstruction->rho;
+  util::obstream bin(fReconstructionOutputPath + "_" + std::to_string(iteration));
+  bin << fReconstruction->rho;
+}
@@ -19,7 +19,10 @@
 #include "JPetEvent/JPetEvent.h"
 #include "JPetLoggerInclude.h"
 #include "JPetUserTask/JPetUserTask.h"
+#include "OSEMTools.h"
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #include "util/png_writer.h"
 #include "util/progress.h"
@@ -63,6 +66,9 @@
  *  "MLEMRunner_ReconstuctionIterations_int" : number of iterations in reconstruction
  *  "MLEMRunner_TOFSigmaAlongZAxis_float" : error of measurement of Z position along scintillator in meters
  *  "MLEMRunner_TOFSigmaAxis_float" :  error of measurement TOF along LOR (or TOR in case of 3D) in meters
+ *  "MLEMRunner_NumberOfSubsets_int" : number of ordered subsets (OSEM), 1 means plain MLEM; with more subsets
+ *  each iteration is one pass over all subsets and image is updated after every subset
+ *  "MLEMRunner_SubsetType_std::string" : how events are partitioned into subsets: "Angular" (by LOR angle) or "Temporal" (contiguous blocks of events in order of arrival)
  */
 
 class MLEMRunner : public JPetUserTask
@@ -103,6 +109,8 @@ private:
   void setSystemMatrix();
   bool setUpRunReconstructionWithMatrix();
   void runReconstruction();
+  void runOSEMReconstruction();
+  void saveIteration(int iteration);
 
   const std::string kOutFileNameKey = "MLEMRunner_OutFileName_std::string";
   const std::string kNumberOfPixelsInOneDimensionKey = "MLEMRunner_NumberOfPixelsInOneDimension_int";
@@ -118,6 +126,8 @@ private:
 
   const std::string kReconstructionOutputPathKey = "MLEMRunner_ReconstructionOutputPath_std::string";
   const std::string kReconstructionIterationsKey = "MLEMRunner_ReconstuctionIterations_int";
+  const std::string kNumberOfSubsetsKey = "MLEMRunner_NumberOfSubsets_int";
+  const std::string kSubsetTypeKey = "MLEMRunner_SubsetType_std::string";
 
   const double kSpeedOfLightMetersPerPs = 299792458.0e-12;
   const double kCentimetersToMeters = 0.01;
@@ -133,6 +143,7 @@ private:
 
   std::ofstream fOutputStream;                   // outputs data in format accepted by 3d_hybrid_reconstruction
   std::stringstream fReconstructionStringStream; // connection between parsing events and reconstruction
+  std::vector<std::stringstream> fSubsetStringStreams; // events split into subsets, used instead of fReconstructionStringStream for OSEM
 
   int fNumberOfPixelsInOneDimension = 160;             // Dimension of 1 axis in 3d reconstructed image(n-pixels)
   double fPixelSize = 0.004;                           // Size of 1 pixel in m(s-pixel)
@@ -145,6 +156,8 @@ private:
   bool fVerbose = true;               // if true prints extra information about reconstruction to cerr
   bool fSystemMatrixSaveFull = true;  // if true generate and save full system matrix, if not only 1/8 of it and then converts to full
   int fReconstructionIterations = 10; // number of iterations in reconstruction
+  unsigned int fNumberOfSubsets = 1u; // number of OSEM subsets, 1 means MLEM
+  OSEMTools::SubsetType fSubsetType = OSEMTools::kAngular;
 
   std::string fSystemMatrixOutputPath = "system_matix.bin";
   std::string fReconstructionOutputPath = "reconstuction";
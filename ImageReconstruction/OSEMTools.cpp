@@ -0,0 +1,71 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file OSEMTools.cpp
+ */
+
+#include "OSEMTools.h"
+#include <cassert>
+#include <cmath>
+#include <map>
+
+OSEMTools::SubsetType OSEMTools::getSubsetType(const std::string& name)
+{
+  static std::map<std::string, SubsetType> nameToSubsetType{{"Angular", kAngular}, {"Temporal", kTemporal}};
+  const auto type = nameToSubsetType.find(name);
+  if (type == nameToSubsetType.end())
+    return kSubsetTypeNotFound;
+  return type->second;
+}
+
+float OSEMTools::getLORAngle(float firstX, float firstY, float secondX, float secondY)
+{
+  float angle = std::atan2(secondY - firstY, secondX - firstX);
+  if (angle < 0.f)
+    angle += M_PI;
+  if (angle >= M_PI)
+    angle -= M_PI;
+  return angle;
+}
+
+unsigned int OSEMTools::getAngularSubset(float lorAngle, unsigned int numberOfSubsets)
+{
+  if (numberOfSubsets <= 1)
+    return 0;
+  const unsigned int numberOfBins = kAngularBinsPerSubset * numberOfSubsets;
+  unsigned int bin = static_cast<unsigned int>(lorAngle / M_PI * numberOfBins);
+  if (bin >= numberOfBins)
+    bin = numberOfBins - 1;
+  return bin % numberOfSubsets;
+}
+
+unsigned int OSEMTools::getTemporalSubset(unsigned long eventNumber, unsigned long numberOfEvents, unsigned int numberOfSubsets)
+{
+  if (numberOfSubsets <= 1)
+    return 0;
+  if (eventNumber >= numberOfEvents)
+    return numberOfSubsets - 1;
+  return static_cast<unsigned int>(static_cast<unsigned long long>(eventNumber) * numberOfSubsets / numberOfEvents);
+}
+
+void OSEMTools::updateImage(std::vector<float>& rho, const std::vector<float>& correction, const std::vector<float>& sensitivity,
+                            unsigned int numberOfSubsets)
+{
+  assert(rho.size() == correction.size() && rho.size() == sensitivity.size());
+  for (unsigned int i = 0; i < rho.size(); i++)
+  {
+    if (sensitivity[i] > 0.f)
+      rho[i] *= numberOfSubsets * correction[i] / sensitivity[i];
+    else
+      rho[i] = 0.f;
+  }
+}
@@ -0,0 +1,108 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file OSEMTools.h
+ */
+
+#ifndef OSEMTOOLS_H
+#define OSEMTOOLS_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Helper functions for ordered-subsets (OSEM) list-mode reconstruction
+ *
+ * Events are partitioned into subsets, and the image is updated after each subset.
+ * The sensitivity used for a single subset update is the full sensitivity divided by the number of subsets,
+ * so one pass over all subsets costs about the same as one MLEM iteration.
+ */
+class OSEMTools
+{
+public:
+  enum SubsetType
+  {
+    kSubsetTypeNotFound,
+    kAngular,
+    kTemporal
+  };
+
+  static SubsetType getSubsetType(const std::string& name);
+
+  /**
+   * @brief Angle of LOR in x/y plane in range [0, pi)
+   */
+  static float getLORAngle(float firstX, float firstY, float secondX, float secondY);
+
+  /**
+   * @brief Angular subset of LOR, angle range [0, pi) is divided into kAngularBinsPerSubset * numberOfSubsets bins
+   * which are assigned to subsets in interleaved order, so every subset covers the whole angular range
+   */
+  static unsigned int getAngularSubset(float lorAngle, unsigned int numberOfSubsets);
+  /**
+   * @brief Temporal subset of event, events in order of arrival are divided into numberOfSubsets contiguous blocks
+   * of (almost) equal size, so every subset covers one period of the acquisition
+   */
+  static unsigned int getTemporalSubset(unsigned long eventNumber, unsigned long numberOfEvents, unsigned int numberOfSubsets);
+
+  /**
+   * @brief OSEM image update with single subset: rho *= numberOfSubsets * correction / sensitivity.
+   * Voxels with zero sensitivity are set to 0. With numberOfSubsets equal 1 it is plain MLEM update.
+   */
+  static void updateImage(std::vector<float>& rho, const std::vector<float>& correction, const std::vector<float>& sensitivity,
+                          unsigned int numberOfSubsets);
+
+  /**
+   * @brief Rescale image obtained by MLEM iteration over single subset events with full sensitivity
+   * to OSEM update: rho_osem = numberOfSubsets * rho_subset
+   */
+  template <class Iterator>
+  static void rescaleSubsetImage(Iterator begin, Iterator end, unsigned int numberOfSubsets)
+  {
+    for (Iterator voxel = begin; voxel != end; ++voxel)
+    {
+      *voxel *= numberOfSubsets;
+    }
+  }
+
+  /**
+   * @brief One OSEM pass over all subsets, as run by MLEMRunner. Each subset reconstruction holds only events of its subset
+   * and the full sensitivity, its single MLEM iteration started from current image is rescaled to OSEM update.
+   * Subsets without events are skipped. Reconstruction has to provide image rho, n_events() and operator() running one iteration.
+   */
+  template <class Image, class Reconstruction>
+  static void runSubsetsPass(Image& rho, std::vector<std::unique_ptr<Reconstruction>>& subsets)
+  {
+    for (auto& subset : subsets)
+    {
+      if (subset->n_events() == 0)
+      {
+        continue;
+      }
+      subset->rho = rho;
+      (*subset)();
+      rescaleSubsetImage(subset->rho.begin(), subset->rho.end(), subsets.size());
+      rho = subset->rho;
+    }
+  }
+
+  static constexpr unsigned int kAngularBinsPerSubset = 8;
+
+private:
+  OSEMTools() = delete;
+  ~OSEMTools() = delete;
+  OSEMTools(const OSEMTools&) = delete;
+  OSEMTools& operator=(const OSEMTools&) = delete;
+};
+
+#endif /*  !OSEMTOOLS_H */
@@ -16,6 +16,8 @@
 #ifndef _JPetFilterInterface_H_
 #define _JPetFilterInterface_H_
 
+#include <vector>
+
 /*! \brief Interface that all filters should implement.
 */
 class JPetFilterInterface
@@ -27,6 +29,32 @@ public:
       @par pos Position of variable rescaled to [0, 1] 
    */
   virtual double operator()(double pos) = 0;
+
+  /*! @brief Returns filter values at positions (i + 1) / fftLength for i in [0, responseLength)
+      Values are calculated once and reused as long as the lengths do not change,
+      so the same filter can be applied to many sinograms without calling operator() for every frequency.
+      Not thread-safe: the cache is modified without locking and the returned reference is invalidated
+      by a call with other lengths, so a filter object must not be shared between threads, use one per thread.
+      @par responseLength Number of frequency samples
+      @par fftLength Length of the transform the frequencies are scaled with
+   */
+  const std::vector<double>& getFrequencyResponse(int responseLength, int fftLength)
+  {
+    if (responseLength != fResponseLength || fftLength != fResponseFFTLength)
+    {
+      fResponse.resize(responseLength);
+      for (int i = 0; i < responseLength; i++)
+        fResponse[i] = (*this)((double)(i + 1) / fftLength);
+      fResponseLength = responseLength;
+      fResponseFFTLength = fftLength;
+    }
+    return fResponse;
+  }
+
+private:
+  std::vector<double> fResponse;
+  int fResponseLength = -1;
+  int fResponseFFTLength = -1;
 };
 
 #endif /*  !_JPetFilterInterface_H_ */
@@ -15,6 +15,7 @@
 
 #include "JPetRecoImageTools.h"
 #include "JPetLoggerInclude.h"
+#include <algorithm>
 
 JPetRecoImageTools::JPetRecoImageTools() {}
 
@@ -249,13 +250,30 @@ double JPetRecoImageTools::FBPWeight(double, double, double) { return 1.; }
 JPetSinogramType::SparseMatrix JPetRecoImageTools::backProjectWithKDE(const JPetSinogramType::SparseMatrix& sinogram, Matrix2DTOF& tof, int nAngles,
                                                                       RescaleFunc rescaleFunc, int rescaleMinCutoff, int rescaleFactor)
 {
+  const double kTOFToDistance = 0.299792458;
+  const double kKDESigma = 150.;
+  const double kKDEWeight = 1000.;
+  const int kKDEStepsPerSigma = 10;
+
   int imageSize = sinogram.size1();
   double center = (double)(imageSize - 1) / 2.0;
   double center2 = center * center;
   double angleStep = M_PI / (double)nAngles;
 
-  JPetSinogramType::SparseMatrix reconstructedProjection(imageSize, imageSize);
+  // profiles of all LORs are calculated once, indexed by angle * imageSize + n
+  const double profileStep = kKDESigma / kKDEStepsPerSigma;
+  const int profileSteps = std::ceil(imageSize * std::sqrt(2.) / profileStep) + 2;
+  std::vector<std::vector<double>> profiles(nAngles * imageSize);
+  for (const auto& lor : tof)
+  {
+    const int n = lor.first.first;
+    const int angle = lor.first.second;
+    if (n < 0 || n >= imageSize || angle < 0 || angle >= nAngles) { continue; }
+    assert(sinogram(n, angle) == lor.second.size());
+    profiles[angle * imageSize + n] = calculateKDEProfile(lor.second, kTOFToDistance, kKDESigma, profileStep, profileSteps);
+  }
 
+  std::vector<double> image(imageSize * imageSize, 0.);
   for (int angle = 0; angle < nAngles; angle++)
   {
     double cos = std::cos((double)angle * (double)angleStep);
@@ -275,39 +293,75 @@ JPetSinogramType::SparseMatrix JPetRecoImageTools::backProjectWithKDE(const JPet
         {
           double t = ttemp - yMinusCenter * sin;
           int n = std::floor(t + 0.5F);
-          auto tofInfo = tof.find(std::make_pair(n, angle));
-          std::vector<float> tofVector;
-          if (tofInfo != tof.end()) { tofVector = tofInfo->second; }
-          else
-          {
-            continue;
-          }
-          assert(sinogram(n, angle) == tofVector.size());
+          if (n < 0 || n >= imageSize) { continue; }
+          const auto& profile = profiles[angle * imageSize + n];
+          if (profile.empty()) { continue; }
           float lor_center_x = center + cos * (n - center);
           float lor_center_y = center + sin * (n - center);
           double diffBetweenLORCenterYandY = lor_center_y - y;
           double diffBetweenLORCenterXandX = lor_center_x - x;
           double distanceToCenterOfLOR =
               std::sqrt((diffBetweenLORCenterXandX * diffBetweenLORCenterXandX) + (diffBetweenLORCenterYandY * diffBetweenLORCenterYandY));
-          for (unsigned int i = 0; i < tofVector.size(); i++)
-          {
-            float delta = tofVector[i] * 0.299792458;
-            double distributionProbability = normalDistributionProbability(distanceToCenterOfLOR, delta, 150.);
-            reconstructedProjection(y, x) += distributionProbability * 1000;
-          }
+          image[y * imageSize + x] += sampleKDEProfile(profile, distanceToCenterOfLOR, profileStep) * kKDEWeight;
         }
       }
     }
   }
 
+  JPetSinogramType::SparseMatrix reconstructedProjection(imageSize, imageSize);
   for (int x = 0; x < imageSize; x++)
   {
-    for (int y = 0; y < imageSize; y++) { reconstructedProjection(y, x) *= angleStep; }
+    for (int y = 0; y < imageSize; y++)
+    {
+      if (image[y * imageSize + x] != 0.) { reconstructedProjection(y, x) = image[y * imageSize + x] * angleStep; }
+    }
   }
   rescaleFunc(reconstructedProjection, rescaleMinCutoff, rescaleFactor);
   return reconstructedProjection;
 }
 
+std::vector<double> JPetRecoImageTools::calculateKDEProfile(const std::vector<float>& tofVector, double tofToDistance, double sigma, double step,
+                                                            int numberOfSteps)
+{
+  const double kKernelRangeInSigmas = 5.;
+  std::vector<double> profile(std::max(numberOfSteps, 0), 0.);
+  if (profile.empty() || tofVector.empty()) { return profile; }
+
+  // histogram bin j is at distance (j - kernelHalfWidth) * step, so positions up to kernel range outside of profile are kept
+  const int kernelHalfWidth = std::ceil(kKernelRangeInSigmas * sigma / step);
+  std::vector<double> histogram(numberOfSteps + 2 * kernelHalfWidth, 0.);
+  for (auto tofValue : tofVector)
+  {
+    const double position = tofValue * tofToDistance / step + kernelHalfWidth;
+    if (position < 0. || position >= histogram.size() - 1) { continue; }
+    const int bin = std::floor(position);
+    const double fraction = position - bin;
+    histogram[bin] += 1. - fraction;
+    histogram[bin + 1] += fraction;
+  }
+
+  // linear histogramming and linear sampling of the profile widen the kernel by step^2 / 3 in variance,
+  // so the kernel is narrowed by the same amount
+  const double kernelSigma = std::sqrt(std::max(sigma * sigma - step * step / 3., step * step));
+  std::vector<double> kernel(2 * kernelHalfWidth + 1);
+  for (int i = 0; i < (int)kernel.size(); i++) { kernel[i] = normalDistributionProbability((i - kernelHalfWidth) * step, 0., kernelSigma); }
+
+  for (int k = 0; k < numberOfSteps; k++)
+  {
+    for (int i = 0; i < (int)kernel.size(); i++) { profile[k] += histogram[k + i] * kernel[i]; }
+  }
+  return profile;
+}
+
+double JPetRecoImageTools::sampleKDEProfile(const std::vector<double>& profile, double distance, double step)
+{
+  const double position = distance / step;
+  if (position < 0. || position >= (double)profile.size() - 1) { return 0.; }
+  const int k = std::floor(position);
+  const double fraction = position - k;
+  return (1. - fraction) * profile[k] + fraction * profile[k + 1];
+}
+
 double JPetRecoImageTools::normalDistributionProbability(float x, float mean, float stddev)
 {
   double diff = x - mean;
@@ -356,27 +410,39 @@ JPetSinogramType::SparseMatrix JPetRecoImageTools::doFFTW1D(const JPetSinogramTy
   }
 
   fftw_complex* outFilter = (fftw_complex*)fftw_malloc(M * sizeof(fftw_complex));
-  fftw_plan planFilter = fftw_plan_dft_r2c_1d(M, inFilter, outFilter, FFTW_MEASURE);
+  fftw_plan planFilter = fftw_plan_dft_r2c_1d(M, inFilter, outFilter, FFTW_ESTIMATE);
   fftw_execute(planFilter);
+
+  // ramp and filter do not depend on angle, combine them once into single weight per frequency
+  const std::vector<double>& response = filter.getFrequencyResponse(inFTLength, M);
+  std::vector<double> weights(inFTLength);
+  for (int y = 0; y < inFTLength; y++)
+  {
+    weights[y] = 2 * outFilter[y][0] * response[y];
+  }
+  weights[0] *= 2 * outFilter[0][0];
+
   for (int x = 0; x < nAngles; x++)
   {
     for (int y = 0; y < N; y++) { in[y] = sinogram(y ,x); }
     for (int y = N; y < M; y++) { in[y] = 0; }
     fftw_execute(plan);
+    double* spectrum = &out[0][0];
     for (int y = 0; y < inFTLength; y++)
     {
-      if(y == 0) {
-        out[y][0] *= 2 * outFilter[y][0];
-        out[y][1] *= 2 * outFilter[y][0];
-      }
-      out[y][0] *= 2 * outFilter[y][0] * filter((double)(y + 1) / M);
-      out[y][1] *= 2 * outFilter[y][0] * filter((double)(y + 1) / M);
+      spectrum[2 * y] *= weights[y];
+      spectrum[2 * y + 1] *= weights[y];
     }
     fftw_execute(invPlan);
     for (int y = 0; y < N ; y++) { result(y, x) = outDouble[y] / N; }
   }
 
+  free(in);
+  free(outDouble);
+  free(inFilter);
   fftw_free(out);
+  fftw_free(outFilter);
+  fftw_destroy_plan(planFilter);
   fftw_destroy_plan(plan);
   fftw_destroy_plan(invPlan);
   fftw_cleanup();
@@ -150,9 +150,37 @@ public:
    * default no rescaling)
    */
 
+  /*! \brief Back projection weighted with kernel density estimate of TOF positions along each LOR
+   *  \param sinogram matrix containing sinogram, sinogram(n, angle) is the number of TOF values of LOR
+   *  \param tof TOF values of each (n, angle) LOR
+   *  \param angles number of angles in sinogram
+   *  \param rescaleFunc function that rescales the final result
+   *  \param rescaleMinCutoff min value to set in rescale
+   *  \param rescaleFactor max value to set in rescale
+   *
+   *  Kernel density estimate of each LOR is calculated once with calculateKDEProfile,
+   *  image pixels sample the precalculated profile instead of summing gaussians of all TOF values.
+   */
   static JPetSinogramType::SparseMatrix backProjectWithKDE(const JPetSinogramType::SparseMatrix& sinogram, Matrix2DTOF& tof, int angles,
                                                            RescaleFunc rescaleFunc, int rescaleMinCutoff, int rescaleFactor);
 
+  /*! \brief Returns sum of normal distributions centered at TOF positions along LOR, sampled at distances k * step, k = 0..numberOfSteps-1
+   *  \param tofVector TOF values of LOR
+   *  \param tofToDistance factor converting TOF value to the distance from the LOR center
+   *  \param sigma standard deviation of normal distribution
+   *  \param step distance between samples, should be small compared to sigma
+   *  \param numberOfSteps number of samples
+   *
+   *  TOF positions are first histogrammed with the same step, then histogram is convolved once with gaussian kernel.
+   *  Positions further than 5 sigma from the sampled range are skipped.
+   */
+  static std::vector<double> calculateKDEProfile(const std::vector<float>& tofVector, double tofToDistance, double sigma, double step,
+                                                 int numberOfSteps);
+
+  /*! \brief Linear interpolation of profile returned by calculateKDEProfile, 0 outside of the profile
+   */
+  static double sampleKDEProfile(const std::vector<double>& profile, double distance, double step);
+
   static double normalDistributionProbability(float x, float mean, float stddev);
 
   /*! \brief Returns max value in given matrix
@@ -35,41 +35,22 @@ bool ReconstructionTask::init()
 
 bool ReconstructionTask::exec() { return true; }
 
-int ReconstructionTask::getMaxValue(const JPetSinogramType::SparseMatrix& result)
+void ReconstructionTask::addSliceToVolume(const JPetSinogramType::SparseMatrix& result, unsigned int z, JPetVolume& volume)
 {
-  int maxValue = 0;
-  for (unsigned int i = 0; i < result.size1(); i++)
+  if (volume.data.empty())
   {
-    for (unsigned int j = 0; j < result.size2(); j++)
-    {
-      if (static_cast<int>(result(i, j)) > maxValue)
-        maxValue = static_cast<int>(result(i, j));
-    }
+    volume.sizeX = result.size2();
+    volume.sizeY = result.size1();
+    volume.data.assign(static_cast<std::size_t>(volume.sizeX) * volume.sizeY * volume.sizeZ, 0.f);
   }
-  return maxValue;
-}
-
-void ReconstructionTask::saveResult(const JPetSinogramType::SparseMatrix& result, const std::string& outputFileName)
-{
-  int maxValue = getMaxValue(result);
-  std::ofstream res(outputFileName);
-  res << "P2" << std::endl;
-  res << result.size2() << " " << result.size1() << std::endl;
-  res << maxValue << std::endl;
-  for (unsigned int i = 0; i < result.size1(); i++)
+  for (auto row = result.begin1(); row != result.end1(); ++row)
   {
-    for (unsigned int j = 0; j < result.size2(); j++)
+    for (auto element = row.begin(); element != row.end(); ++element)
     {
-      int resultInt = std::round(result(i, j));
-      if (resultInt < 0)
-      {
-        resultInt = 0;
-      }
-      res << resultInt << " ";
+      if (element.index1() < volume.sizeY && element.index2() < volume.sizeX)
+        volume(element.index2(), element.index1(), z) = static_cast<float>(*element);
     }
-    res << std::endl;
   }
-  res.close();
 }
 
 bool ReconstructionTask::terminate()
@@ -95,63 +76,99 @@ bool ReconstructionTask::terminate()
     break;
   }
 
+  std::vector<int> sliceNumbers;
+  std::vector<unsigned int> sliceIndexes;
   for (unsigned int i = 0; i < zSplitNumber; i++)
   { // loop throught Z slices
     int sliceNumber = i - (zSplitNumber / 2);
     if (!fReconstructSliceNumbers.empty()) // if there we want to reconstruct only selected z slices, skip others
       if (std::find(fReconstructSliceNumbers.begin(), fReconstructSliceNumbers.end(), sliceNumber) == fReconstructSliceNumbers.end())
         continue;
-    for (float cutOffValue = fCutOffValueBegin; cutOffValue <= fCutOffValueEnd; cutOffValue += fCutOffValueStep)
+    sliceNumbers.push_back(sliceNumber);
+    sliceIndexes.push_back(i);
+  }
+  if (sliceIndexes.empty())
+    return true;
+
+  std::string sliceNumbersDescription;
+  for (auto sliceNumber : sliceNumbers)
+    sliceNumbersDescription += (sliceNumbersDescription.empty() ? "" : " ") + std::to_string(sliceNumber);
+
+  for (float cutOffValue = fCutOffValueBegin; cutOffValue <= fCutOffValueEnd; cutOffValue += fCutOffValueStep)
+  {
+    JPetFilterInterface* filter;
+    static std::map<std::string, int> filterNameToFilter{{"None", ReconstructionTask::kFilterType::kFilterNone},
+                                                         {"Cosine", ReconstructionTask::kFilterType::kFilterCosine},
+                                                         {"Hamming", ReconstructionTask::kFilterType::kFilterHamming},
+                                                         {"Hann", ReconstructionTask::kFilterType::kFilterHann},
+                                                         {"Ridgelet", ReconstructionTask::kFilterType::kFilterRidgelet},
+                                                         {"SheppLogan", ReconstructionTask::kFilterType::kFilterSheppLogan}};
+
+    switch (filterNameToFilter[fFilterName])
     {
-      JPetFilterInterface* filter;
-      static std::map<std::string, int> filterNameToFilter{{"None", ReconstructionTask::kFilterType::kFilterNone},
-                                                           {"Cosine", ReconstructionTask::kFilterType::kFilterCosine},
-                                                           {"Hamming", ReconstructionTask::kFilterType::kFilterHamming},
-                                                           {"Hann", ReconstructionTask::kFilterType::kFilterHann},
-                                                           {"Ridgelet", ReconstructionTask::kFilterType::kFilterRidgelet},
-                                                           {"SheppLogan", ReconstructionTask::kFilterType::kFilterSheppLogan}};
-
-      switch (filterNameToFilter[fFilterName])
-      {
-      case ReconstructionTask::kFilterType::kFilterNone:
-        filter = new JPetFilterNone(cutOffValue);
-        break;
-      case ReconstructionTask::kFilterType::kFilterCosine:
-        filter = new JPetFilterCosine(cutOffValue);
-        break;
-      case ReconstructionTask::kFilterType::kFilterHamming:
-        filter = new JPetFilterHamming(cutOffValue);
-        break;
-      case ReconstructionTask::kFilterType::kFilterHann:
-        filter = new JPetFilterHann(cutOffValue);
-        break;
-      case ReconstructionTask::kFilterType::kFilterRidgelet:
-        filter = new JPetFilterRidgelet(cutOffValue);
-        break;
-      case ReconstructionTask::kFilterType::kFilterSheppLogan:
-        filter = new JPetFilterSheppLogan(cutOffValue);
-        break;
-      default:
-        ERROR("Could not find filter: " + fFilterName + ", using JPetFilterNone.");
-        filter = new JPetFilterNone(cutOffValue);
-        break;
-      }
+    case ReconstructionTask::kFilterType::kFilterNone:
+      filter = new JPetFilterNone(cutOffValue);
+      break;
+    case ReconstructionTask::kFilterType::kFilterCosine:
+      filter = new JPetFilterCosine(cutOffValue);
+      break;
+    case ReconstructionTask::kFilterType::kFilterHamming:
+      filter = new JPetFilterHamming(cutOffValue);
+      break;
+    case ReconstructionTask::kFilterType::kFilterHann:
+      filter = new JPetFilterHann(cutOffValue);
+      break;
+    case ReconstructionTask::kFilterType::kFilterRidgelet:
+      filter = new JPetFilterRidgelet(cutOffValue);
+      break;
+    case ReconstructionTask::kFilterType::kFilterSheppLogan:
+      filter = new JPetFilterSheppLogan(cutOffValue);
+      break;
+    default:
+      ERROR("Could not find filter: " + fFilterName + ", using JPetFilterNone.");
+      filter = new JPetFilterNone(cutOffValue);
+      break;
+    }
+
+    const std::string outputName = fOutFileName + "reconstruction_with_" + fReconstructionName + "_" + fFilterName + "_CutOff_" + std::to_string(cutOffValue);
 
+    JPetVolume volume;
+    volume.sizeZ = sliceIndexes.size();
+    volume.spacingX = fSinogram->getReconstructionDistanceAccuracy();
+    volume.spacingY = fSinogram->getReconstructionDistanceAccuracy();
+    volume.spacingZ = fSinogram->getScintillatorLenght() / zSplitNumber;
+    volume.keyValues["reconstruction"] = fReconstructionName;
+    volume.keyValues["filter"] = fFilterName;
+    volume.keyValues["cutoff"] = std::to_string(cutOffValue);
+    volume.keyValues["slice numbers"] = sliceNumbersDescription;
+    volume.keyValues["spacing units"] = "cm";
+
+    for (unsigned int z = 0; z < sliceIndexes.size(); z++)
+    {
       JPetSinogramType::Matrix3D filtered;
-      int tofID = 0;
-      for (auto& tofWindow : sinogram[i]) // filter sinogram in each TOF-windows(for FBP in single timewindow)
+      for (auto& tofWindow : sinogram[sliceIndexes[z]]) // filter sinogram in each TOF-windows(for FBP in single timewindow)
       {
         filtered[tofWindow.first] = JPetRecoImageTools::FilterSinogram(f, *filter, tofWindow.second);
-        tofID++;
       }
 
       JPetSinogramType::SparseMatrix result =
           JPetRecoImageTools::backProjectMatlab(filtered, fSinogram->getReconstructionDistanceAccuracy(), fSinogram->getTOFWindowSize(), fLORTOFSigma,
-                                          weightFunction, JPetRecoImageTools::rescale, 0, 10000);
+                                                weightFunction, JPetRecoImageTools::rescale, 0, 10000);
 
-      saveResult(result, fOutFileName + "reconstruction_with_" + fReconstructionName + "_" + fFilterName + "_CutOff_" + std::to_string(cutOffValue) +
-                             "_slicenumber_" + std::to_string(sliceNumber) + ".ppm");
-      delete filter;
+      addSliceToVolume(result, z, volume);
+    }
+    delete filter;
+
+    if (!JPetVolumeWriter::writeNRRD(volume, outputName + ".nrrd"))
+    {
+      ERROR("Could not save reconstructed volume to file: " + outputName + ".nrrd");
+    }
+    if (fSavePPMPreview)
+    {
+      for (unsigned int z = 0; z < sliceIndexes.size(); z++)
+      {
+        JPetVolumeWriter::writePPMSlice(volume, z, outputName + "_slicenumber_" + std::to_string(sliceNumbers[z]) + ".ppm");
+      }
     }
   }
   return true;
@@ -196,4 +213,8 @@ void ReconstructionTask::setUpOptions()
   {
     fReconstructionName = getOptionAsString(opts, kReconstructionName);
   }
+  if (isOptionSet(opts, kSavePPMPreview))
+  {
+    fSavePPMPreview = getOptionAsBool(opts, kSavePPMPreview);
+  }
 }
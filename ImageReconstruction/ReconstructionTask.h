@@ -28,9 +28,19 @@
 #include "JPetFilterSheppLogan.h"
 #include "JPetRecoImageTools.h"
 #include "JPetUserTask/JPetUserTask.h"
+#include "JPetVolumeWriter.h"
 
 #include "JPetSinogramType.h"
 
+/**
+ * @brief Module reconstructing images from sinograms created by SinogramCreator with (TOF-)FBP
+ *
+ * Input: sinogram file saved by SinogramCreator
+ * Output: for every filter cutoff value one *.nrrd volume with all reconstructed slices (float values),
+ * optionally *.ppm previews of every slice
+ *
+ * - "ReconstructionTask_SavePPMPreview_bool": if true, every reconstructed slice is also saved as ppm (P2) file
+ */
 class ReconstructionTask : public JPetUserTask
 {
 public:
@@ -63,17 +73,12 @@ private:
   ReconstructionTask& operator=(const ReconstructionTask&) = delete;
 
   /**
-   * @brief Helper function used in saving result
-   * \param result matrix to find max value
-   * \return max value of matrix
+   * @brief Helper function copying reconstructed slice into output volume
+   * \param result reconstructed slice
+   * \param z index of slice in volume
+   * \param volume output volume, allocated on first call
    */
-  int getMaxValue(const JPetSinogramType::SparseMatrix& result);
-  /**
-   * @brief Helper function used to save results(sinograms and reconstructed images)
-   * \param result resulted matrix to save
-   * \param outputFileName name with path where to save result
-   */
-  void saveResult(const JPetSinogramType::SparseMatrix& result, const std::string& outputFileName);
+  void addSliceToVolume(const JPetSinogramType::SparseMatrix& result, unsigned int z, JPetVolume& volume);
 
   /**
    * @brief Function where all options from user params are readed and setted.
@@ -97,6 +102,7 @@ private:
   const std::string kLORTOFSigma = "ReconstructionTask_LORTOFSigma_float";
 
   const std::string kOutFileNameKey = "ReconstructionTask_OutFileName_std::string";
+  const std::string kSavePPMPreview = "ReconstructionTask_SavePPMPreview_bool";
 
   std::vector<int> fReconstructSliceNumbers; // reconstruct only slices that was given in userParams
 
@@ -108,6 +114,8 @@ private:
 
   float fLORTOFSigma = 150.f;
 
+  bool fSavePPMPreview = false; // if true, each slice of reconstructed volume is also saved as ppm
+
   std::string fFilterName = "RamLak";
   std::string fReconstructionName = "FBP";
   std::string fOutFileName = "sinogram.root";
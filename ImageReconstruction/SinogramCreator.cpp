@@ -18,6 +18,9 @@
 #include <TH2F.h>
 #include <TH2I.h>
 #include <TH3F.h>
+#include <algorithm>
+#include <functional>
+#include <thread>
 using namespace jpet_options_tools;
 
 SinogramCreator::SinogramCreator(const char* name) : JPetUserTask(name) {}
@@ -41,51 +44,106 @@ bool SinogramCreator::init()
 
 void SinogramCreator::readAndAnalyzeGojaFile()
 {
-  float firstX = 0.f;
-  float firstY = 0.f;
-  float secondX = 0.f;
-  float secondY = 0.f;
-  float firstZ = 0.f;
-  float secondZ = 0.f;
-  double firstT = 0.f;
-  double secondT = 0.f;
-
   float sourceX = 0.f;
   float sourceY = 0.f;
   float sourceZ = 0.f;
 
-  float skip = 0.f;
-  float skipInt = 0.f;
-  int coincidence = 0;
+  unsigned int numberOfThreads = fNumberOfThreads > 0 ? fNumberOfThreads : std::max(std::thread::hardware_concurrency(), 1u);
+  if (fEnableNEMAAttenuation)
+  {
+    numberOfThreads = 1;
+  }
 
   for (const auto& inputPath : fGojaInputFilePath)
   {
-    std::ifstream in(inputPath);
-    while (in.peek() != EOF)
+    JPetGojaFileReader reader(inputPath);
+    if (!reader.isOpen())
     {
-      in >> firstX >> firstY >> firstZ >> firstT >> secondX >> secondY >> secondZ >> secondT >> skipInt >> skipInt >> skip >> skip >> coincidence >> skip >>
-          skip >> skip;
-      //in >> firstX >> firstY >> firstZ >> firstT >> secondX >> secondY >> secondZ >> secondT;
-      //if (coincidence != 1) // 1 == true event
-      //  continue;
-
-      fTotalAnalyzedHits++;
+      continue;
+    }
 
-      if (fEnableNEMAAttenuation)
+    if (numberOfThreads == 1)
+    {
+      JPetGojaCoincidence lor;
+      JPetGojaFileReader::Chunk chunk = reader.whole();
+      while (JPetGojaFileReader::next(chunk.first, chunk.second, lor))
       {
-        if (firstZ - secondZ < 30. &&
-            atenuation(SinogramCreatorTools::getPolyFit(std::vector<double>{(std::sqrt(sourceX * sourceX + sourceY * sourceY), -std::abs(sourceZ))})))
+        fTotalAnalyzedHits++;
+
+        if (fEnableNEMAAttenuation)
+        {
+          if (lor.firstZ - lor.secondZ < 30. &&
+              atenuation(SinogramCreatorTools::getPolyFit(std::vector<double>{(std::sqrt(sourceX * sourceX + sourceY * sourceY), -std::abs(sourceZ))})))
+          {
+            fTotalAttenuatedHits++;
+            continue;
+          }
+        }
+
+        if (analyzeHits(lor.firstX, lor.firstY, lor.firstZ, lor.firstT, lor.secondX, lor.secondY, lor.secondZ, lor.secondT))
         {
-          fTotalAttenuatedHits++;
-          continue;
+          fNumberOfCorrectHits++;
         }
       }
+      continue;
+    }
+
+    const auto chunks = reader.split(numberOfThreads);
+    std::vector<JPetSinogramType::WholeSinogram> partialSinograms(chunks.size(), JPetSinogramType::WholeSinogram(fZSplitNumber));
+    std::vector<unsigned int> analyzedHits(chunks.size(), 0);
+    std::vector<unsigned int> correctHits(chunks.size(), 0);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < chunks.size(); i++)
+    {
+      workers.emplace_back(&SinogramCreator::readAndAnalyzeGojaChunk, this, chunks[i], std::ref(partialSinograms[i]), std::ref(analyzedHits[i]),
+                           std::ref(correctHits[i]));
+    }
+    for (unsigned int i = 0; i < workers.size(); i++)
+    {
+      workers[i].join();
+      mergeSinograms(fSinogramData, partialSinograms[i]);
+      fTotalAnalyzedHits += analyzedHits[i];
+      fNumberOfCorrectHits += correctHits[i];
+    }
+  }
+}
+
+void SinogramCreator::readAndAnalyzeGojaChunk(JPetGojaFileReader::Chunk chunk, JPetSinogramType::WholeSinogram& sinogram,
+                                              unsigned int& analyzedHits, unsigned int& correctHits) const
+{
+  JPetGojaCoincidence lor;
+  while (JPetGojaFileReader::next(chunk.first, chunk.second, lor))
+  {
+    analyzedHits++;
+    if (fillSinogram(sinogram, lor.firstX, lor.firstY, lor.firstZ, lor.firstT, lor.secondX, lor.secondY, lor.secondZ, lor.secondT))
+    {
+      correctHits++;
+    }
+  }
+}
 
-      if (analyzeHits(firstX, firstY, firstZ, firstT, secondX, secondY, secondZ, secondT))
+void SinogramCreator::mergeSinograms(JPetSinogramType::WholeSinogram& target, JPetSinogramType::WholeSinogram& source)
+{
+  for (unsigned int slice = 0; slice < source.size() && slice < target.size(); slice++)
+  {
+    for (auto& tofWindow : source[slice])
+    {
+      auto data = target[slice].find(tofWindow.first);
+      if (data == target[slice].end())
       {
-        fNumberOfCorrectHits++;
+        target[slice].insert(std::make_pair(tofWindow.first, std::move(tofWindow.second)));
+        continue;
+      }
+      const auto& partial = tofWindow.second;
+      for (auto row = partial.begin1(); row != partial.end1(); ++row)
+      {
+        for (auto element = row.begin(); element != row.end(); ++element)
+        {
+          data->second(element.index1(), element.index2()) += *element;
+        }
       }
     }
+    source[slice].clear();
   }
 }
 
@@ -129,6 +187,13 @@ bool SinogramCreator::analyzeHits(const JPetHit& firstHit, const JPetHit& second
 
 bool SinogramCreator::analyzeHits(const float firstX, const float firstY, const float firstZ, const double firstTOF, const float secondX,
                                   const float secondY, const float secondZ, const double secondTOF)
+{
+  return fillSinogram(fSinogramData, firstX, firstY, firstZ, firstTOF, secondX, secondY, secondZ, secondTOF);
+}
+
+bool SinogramCreator::fillSinogram(JPetSinogramType::WholeSinogram& sinogram, const float firstX, const float firstY, const float firstZ,
+                                   const double firstTOF, const float secondX, const float secondY, const float secondZ,
+                                   const double secondTOF) const
 {
   int i = -1;
   if (!fEnableObliqueLORRemapping)
@@ -148,18 +213,18 @@ bool SinogramCreator::analyzeHits(const float firstX, const float firstY, const
   const auto sinogramResult = SinogramCreatorTools::getSinogramRepresentation(
       firstX, firstY, secondX, secondY, fMaxReconstructionLayerRadius, fReconstructionDistanceAccuracy, fMaxDistanceNumber, kReconstructionMaxAngle);
   const auto TOFSlice = SinogramCreatorTools::getTOFSlice(firstTOF, secondTOF, fTOFBinSliceSize);
-  const auto data = fSinogramData[i].find(TOFSlice);
+  const auto data = sinogram[i].find(TOFSlice);
   if (sinogramResult.first >= fMaxDistanceNumber || sinogramResult.second >= kReconstructionMaxAngle)
     return false;
-  if (data != fSinogramData[i].end())
+  if (data != sinogram[i].end())
   {
     data->second(sinogramResult.first, sinogramResult.second) += 1.;
   }
   else
   {
-    fSinogramData[i].insert(std::make_pair(
+    sinogram[i].insert(std::make_pair(
         TOFSlice, JPetSinogramType::SparseMatrix(fMaxDistanceNumber, kReconstructionMaxAngle, fMaxDistanceNumber * kReconstructionMaxAngle)));
-    fSinogramData[i][TOFSlice](sinogramResult.first, sinogramResult.second) += 1.;
+    sinogram[i][TOFSlice](sinogramResult.first, sinogramResult.second) += 1.;
   }
 
   return true;
@@ -243,6 +308,10 @@ void SinogramCreator::setUpOptions()
   {
     fTOFBinSliceSize = getOptionAsFloat(opts, kTOFBinSliceSize);
   }
+  if (isOptionSet(opts, kNumberOfThreads))
+  {
+    fNumberOfThreads = std::max(getOptionAsInt(opts, kNumberOfThreads), 0);
+  }
 
   if (isOptionSet(opts, kMaxReconstructionLayerRadius))
   {
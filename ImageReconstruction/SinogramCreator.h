@@ -18,6 +18,7 @@
 
 #include "JPetGeomMapping/JPetGeomMapping.h"
 #include "JPetHit/JPetHit.h"
+#include "JPetGojaFileReader.h"
 #include "JPetUserTask/JPetUserTask.h"
 #include "SinogramCreatorTools.h"
 #include <random>
@@ -48,6 +49,9 @@
  * corresponds to 0.1 cm in reality
  * - "SinogramCreator_SinogramZSplitNumber_int": defines number of splits around "z" coordinate
  * - "SinogramCreator_ScintillatorLenght_float": defines scintillator lenght in "z" coordinate
+ * - "SinogramCreator_NumberOfThreads_int": defines number of threads used to fill sinogram from GOJA input files,
+ * by default all available hardware threads are used. With NEMA attenuation enabled GOJA files are always read in single thread,
+ * to keep the same sequence of random numbers.
  */
 class SinogramCreator : public JPetUserTask
 {
@@ -71,7 +75,20 @@ protected:
    */
   float getTOFRescaleFactor(const TVector3& posDiff) const;
 
+  /**
+   * @brief Function adding LOR to given sinogram, used by both sequential and multi-threaded filling
+   * \return true if LOR was added to sinogram
+   */
+  bool fillSinogram(JPetSinogramType::WholeSinogram& sinogram, const float firstX, const float firstY, const float firstZ, const double firstTOF,
+                    const float secondX, const float secondY, const float secondZ, const double secondTOF) const;
+  /**
+   * @brief Function adding all entries of source sinogram to target sinogram, source is left in unspecified state
+   */
+  static void mergeSinograms(JPetSinogramType::WholeSinogram& target, JPetSinogramType::WholeSinogram& source);
+
   void readAndAnalyzeGojaFile();
+  void readAndAnalyzeGojaChunk(JPetGojaFileReader::Chunk chunk, JPetSinogramType::WholeSinogram& sinogram, unsigned int& analyzedHits,
+                               unsigned int& correctHits) const;
   bool atenuation(const float value);
 
   const int kReconstructionMaxAngle = 180;
@@ -87,6 +104,14 @@ protected:
 
   const float kEPSILON = 0.0001f;
 
+  std::vector<std::string> fGojaInputFilePath;
+  JPetSinogramType::WholeSinogram fSinogramData;
+  float fTOFBinSliceSize = 100.f;
+  unsigned int fNumberOfThreads = 0; // 0 means all available hardware threads
+
+  unsigned int fTotalAnalyzedHits = 0;
+  unsigned int fNumberOfCorrectHits = 0;
+
 private:
   SinogramCreator(const SinogramCreator&) = delete;
   SinogramCreator& operator=(const SinogramCreator&) = delete;
@@ -103,19 +128,14 @@ private:
   const std::string kEnableTOFReconstrution = "SinogramCreator_EnableKDEReconstruction_bool";
   const std::string kEnableNEMAAttenuation = "SinogramCreator_EnableNEMAAttenuation_bool";
   const std::string kTOFBinSliceSize = "SinogramCreator_TOFBinSliceSize_float";
+  const std::string kNumberOfThreads = "SinogramCreator_NumberOfThreads_int";
 
   const std::string kGojaInputFilePath = "SinogramCreator_GojaInputFilesPaths_std::vector<std::string>";
 
   std::string fOutFileName = "sinogram.root";
-  std::vector<std::string> fGojaInputFilePath;
-
-  JPetSinogramType::WholeSinogram fSinogramData;
-  float fTOFBinSliceSize = 100.f;
 
   bool fEnableNEMAAttenuation = false;
 
-  unsigned int fTotalAnalyzedHits = 0;
-  unsigned int fNumberOfCorrectHits = 0;
   unsigned int fTotalAttenuatedHits = 0;
 
   std::default_random_engine generator;
@@ -15,6 +15,7 @@
 
 #include "SinogramCreatorTools.h"
 #include "JPetLoggerInclude.h"
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 
@@ -117,8 +118,32 @@ float SinogramCreatorTools::calculateLORSlice(float x1, float y1, float z1, doub
   return resultZ;
 }
 
+/* Z split ranges created by SinogramCreator are sorted and have equal width, so index of range containing `z`
+ * can be calculated directly. Neighbouring ranges are checked by the callers in ascending order, so
+ * values lying on the border of two ranges are assigned the same way as with linear search.
+ * When `z` is outside of all ranges kOutOfSplitRange is returned.
+ */
+int SinogramCreatorTools::guessSplitRangeNumber(float z, const std::vector<std::pair<float, float>>& zSplitRange)
+{
+  if (zSplitRange.empty() || z < zSplitRange.front().first || z > zSplitRange.back().second)
+    return kOutOfSplitRange;
+  const float width = zSplitRange.front().second - zSplitRange.front().first;
+  if (width <= 0.f)
+    return 0;
+  const int guess = static_cast<int>(std::floor((z - zSplitRange.front().first) / width));
+  return std::min(std::max(guess, 0), static_cast<int>(zSplitRange.size()) - 1);
+}
+
 int SinogramCreatorTools::getSplitRangeNumber(float firstZ, float secondZ, const std::vector<std::pair<float, float>>& zSplitRange)
 {
+  const int guess = guessSplitRangeNumber(firstZ, zSplitRange);
+  if (guess == kOutOfSplitRange)
+    return -1;
+  for (int i = std::max(guess - 1, 0); i <= std::min(guess + 1, static_cast<int>(zSplitRange.size()) - 1); i++)
+  {
+    if (firstZ >= zSplitRange[i].first && firstZ <= zSplitRange[i].second && secondZ >= zSplitRange[i].first && secondZ <= zSplitRange[i].second)
+      return i;
+  }
   for (unsigned int i = 0; i < zSplitRange.size(); i++)
   {
     if (firstZ >= zSplitRange[i].first && firstZ <= zSplitRange[i].second && secondZ >= zSplitRange[i].first && secondZ <= zSplitRange[i].second)
@@ -134,6 +159,13 @@ int SinogramCreatorTools::getSplitRangeNumber(float firstZ, float secondZ, const
 
 int SinogramCreatorTools::getSplitRangeNumber(float z, const std::vector<std::pair<float, float>>& zSplitRange)
 {
+  const int guess = guessSplitRangeNumber(z, zSplitRange);
+  if (guess == kOutOfSplitRange)
+    return -1;
+  for (int i = std::max(guess - 1, 0); i <= std::min(guess + 1, static_cast<int>(zSplitRange.size()) - 1); i++)
+  {
+    if (z >= zSplitRange[i].first && z <= zSplitRange[i].second) return i;
+  }
   for (unsigned int i = 0; i < zSplitRange.size(); i++)
   {
     if (z >= zSplitRange[i].first && z <= zSplitRange[i].second) return i;
@@ -51,6 +51,9 @@ private:
 
   static std::tuple<float, float, float> cart2sph(float x, float y, float z);
   static std::tuple<float, float, float> sph2cart(float theta, float phi, float r);
+  static int guessSplitRangeNumber(float z, const std::vector<std::pair<float, float>>& zSplitRange);
+
+  static constexpr int kOutOfSplitRange = -1;
 
   static constexpr float kEPSILON = 0.00001f;
 };
@@ -15,6 +15,8 @@
 
 #include "FilterEvents.h"
 #include "ImageReco.h"
+#include "ListModeReconstruction.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include "JPetManager/JPetManager.h"
 #include "MLEMRunner.h"
 #include "ReconstructionTask.h"
@@ -28,16 +30,18 @@ int main(int argc, const char* argv[])
   {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<FilterEvents>("FilterEvents");
-    manager.registerTask<ImageReco>("ImageReco");
-    manager.registerTask<MLEMRunner>("MLEMRunner");
-    manager.registerTask<SinogramCreator>("SinogramCreator");
-    manager.registerTask<ReconstructionTask>("ReconstructionTask");
-    manager.registerTask<JPetGojaParser>("JPetGojaParser");
+    manager.registerTask<InstrumentedTask<FilterEvents>>("FilterEvents");
+    manager.registerTask<InstrumentedTask<ImageReco>>("ImageReco");
+    manager.registerTask<InstrumentedTask<ListModeReconstruction>>("ListModeReconstruction");
+    manager.registerTask<InstrumentedTask<MLEMRunner>>("MLEMRunner");
+    manager.registerTask<InstrumentedTask<SinogramCreator>>("SinogramCreator");
+    manager.registerTask<InstrumentedTask<ReconstructionTask>>("ReconstructionTask");
+    manager.registerTask<InstrumentedTask<JPetGojaParser>>("JPetGojaParser");
 
     // manager.useTask("FilterEvents", "unk.evt", "reco.unk.evt");
     // manager.useTask("MLEMRunner", "reco.unk.evt", "");
     // manager.useTask("ImageReco", "reco.unk.evt", "reco");
+    // manager.useTask("ListModeReconstruction", "reco.unk.evt", "");
     // manager.useTask("SinogramCreator", "reco.unk.evt", "sino");
     // manager.useTask("ReconstructionTask", "sino.mc", "reco.mc");
     // manager.useTask("JPetGojaParser", "", "unk.evt");
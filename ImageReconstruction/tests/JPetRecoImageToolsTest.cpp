@@ -0,0 +1,225 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetRecoImageToolsTest
+#include <boost/test/unit_test.hpp>
+
+#include "JPetRecoImageTools/JPetFilterCosine.h"
+#include "JPetRecoImageTools/JPetFilterHamming.h"
+#include "JPetRecoImageTools/JPetFilterNone.h"
+#include "JPetRecoImageTools/JPetFilterSheppLogan.h"
+#include "JPetRecoImageTools/JPetRecoImageTools.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+// Filtering of sinogram as done by doFFTW1D before the filter response was cached:
+// ramp filter and filter function evaluated for every frequency and angle, transforms calculated directly.
+JPetSinogramType::SparseMatrix referenceFilter(const JPetSinogramType::SparseMatrix& sinogram, JPetFilterInterface& filter) {
+  const int N = sinogram.size1();
+  const int nAngles = sinogram.size2();
+  const int M = JPetRecoImageTools::nextPowerOf2(2 * N);
+  const int inFTLength = M / 2 + 1;
+
+  std::vector<double> rampKernel(M, 0.);
+  rampKernel[0] = 0.25;
+  for (int i = 1; i < inFTLength; i++) {
+    if (i % 2 == 0)
+      rampKernel[i] = rampKernel[M - i] = 0;
+    else
+      rampKernel[i] = rampKernel[M - i] = -1. / ((M_PI * i) * (M_PI * i));
+  }
+  std::vector<double> ramp(inFTLength, 0.);
+  for (int k = 0; k < inFTLength; k++)
+    for (int n = 0; n < M; n++)
+      ramp[k] += rampKernel[n] * std::cos(2. * M_PI * k * n / M);
+
+  JPetSinogramType::SparseMatrix result(N, nAngles);
+  for (int x = 0; x < nAngles; x++) {
+    std::vector<std::complex<double>> spectrum(inFTLength);
+    for (int k = 0; k < inFTLength; k++)
+      for (int n = 0; n < N; n++)
+        spectrum[k] += sinogram(n, x) * std::polar(1., -2. * M_PI * k * n / M);
+    for (int k = 0; k < inFTLength; k++) {
+      if (k == 0)
+        spectrum[k] *= 2 * ramp[k];
+      spectrum[k] *= 2 * ramp[k] * filter((double)(k + 1) / M);
+    }
+    // unnormalized complex to real transform, imaginary parts of the first and the last frequency are ignored
+    for (int n = 0; n < N; n++) {
+      double value = spectrum[0].real() + spectrum[M / 2].real() * (n % 2 == 0 ? 1. : -1.);
+      for (int k = 1; k < M / 2; k++)
+        value += 2. * (spectrum[k] * std::polar(1., 2. * M_PI * k * n / M)).real();
+      result(n, x) = value / N;
+    }
+  }
+  return result;
+}
+
+JPetSinogramType::SparseMatrix createSinogram(int N, int nAngles) {
+  JPetSinogramType::SparseMatrix sinogram(N, nAngles);
+  for (int x = 0; x < nAngles; x++)
+    for (int y = 0; y < N; y++) {
+      const double distance = (y - N / 2.) / N;
+      sinogram(y, x) = std::exp(-distance * distance * 20.) * (1. + 0.3 * std::cos(x * 0.7)) + (y == x % N ? 0.5 : 0.);
+    }
+  return sinogram;
+}
+
+// Back projection with kernel density estimate as done by backProjectWithKDE before the profiles of LORs were precalculated:
+// normal distributions of all TOF values of the LOR summed for every pixel and angle.
+JPetSinogramType::SparseMatrix referenceBackProjectWithKDE(const JPetSinogramType::SparseMatrix& sinogram, JPetRecoImageTools::Matrix2DTOF& tof,
+                                                           int nAngles) {
+  int imageSize = sinogram.size1();
+  double center = (double)(imageSize - 1) / 2.0;
+  double center2 = center * center;
+  double angleStep = M_PI / (double)nAngles;
+
+  JPetSinogramType::SparseMatrix reconstructedProjection(imageSize, imageSize);
+  for (int angle = 0; angle < nAngles; angle++) {
+    double cos = std::cos((double)angle * (double)angleStep);
+    double sin = std::sin((double)angle * (double)angleStep);
+    for (int x = 0; x < imageSize; x++) {
+      double xMinusCenter = (double)x - center;
+      double xMinusCenter2 = xMinusCenter * xMinusCenter;
+      double ttemp = xMinusCenter * cos + center;
+      for (int y = 0; y < imageSize; y++) {
+        double yMinusCenter = (double)y - center;
+        double yMinusCenter2 = yMinusCenter * yMinusCenter;
+        if (yMinusCenter2 + xMinusCenter2 < center2) {
+          double t = ttemp - yMinusCenter * sin;
+          int n = std::floor(t + 0.5F);
+          auto tofInfo = tof.find(std::make_pair(n, angle));
+          if (tofInfo == tof.end())
+            continue;
+          float lor_center_x = center + cos * (n - center);
+          float lor_center_y = center + sin * (n - center);
+          double diffBetweenLORCenterYandY = lor_center_y - y;
+          double diffBetweenLORCenterXandX = lor_center_x - x;
+          double distanceToCenterOfLOR =
+              std::sqrt((diffBetweenLORCenterXandX * diffBetweenLORCenterXandX) + (diffBetweenLORCenterYandY * diffBetweenLORCenterYandY));
+          for (auto tofValue : tofInfo->second) {
+            float delta = tofValue * 0.299792458;
+            reconstructedProjection(y, x) += JPetRecoImageTools::normalDistributionProbability(distanceToCenterOfLOR, delta, 150.) * 1000;
+          }
+        }
+      }
+    }
+  }
+  for (int x = 0; x < imageSize; x++)
+    for (int y = 0; y < imageSize; y++)
+      reconstructedProjection(y, x) *= angleStep;
+  return reconstructedProjection;
+}
+
+void requireEqual(const JPetSinogramType::SparseMatrix& result, const JPetSinogramType::SparseMatrix& expected) {
+  BOOST_REQUIRE_EQUAL(result.size1(), expected.size1());
+  BOOST_REQUIRE_EQUAL(result.size2(), expected.size2());
+  double scale = 0.;
+  for (unsigned int x = 0; x < expected.size2(); x++)
+    for (unsigned int y = 0; y < expected.size1(); y++)
+      scale = std::max(scale, std::abs(expected(y, x)));
+  for (unsigned int x = 0; x < expected.size2(); x++)
+    for (unsigned int y = 0; y < expected.size1(); y++)
+      BOOST_REQUIRE_SMALL(result(y, x) - expected(y, x), 1e-9 * scale + 1e-12);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(frequency_response_test) {
+  JPetFilterHamming filter(0.6);
+  const auto& response = filter.getFrequencyResponse(17, 32);
+  BOOST_REQUIRE_EQUAL(response.size(), 17u);
+  for (int i = 0; i < 17; i++)
+    BOOST_REQUIRE_EQUAL(response[i], filter((double)(i + 1) / 32));
+
+  // response is calculated again when lengths change
+  const auto& longerResponse = filter.getFrequencyResponse(33, 64);
+  BOOST_REQUIRE_EQUAL(longerResponse.size(), 33u);
+  for (int i = 0; i < 33; i++)
+    BOOST_REQUIRE_EQUAL(longerResponse[i], filter((double)(i + 1) / 64));
+}
+
+BOOST_AUTO_TEST_CASE(filter_sinogram_test) {
+  JPetFilterNone noneFilter(1.);
+  JPetFilterHamming hammingFilter(0.5);
+  JPetFilterCosine cosineFilter(0.8);
+  JPetFilterSheppLogan sheppLoganFilter(1.f);
+  std::vector<JPetFilterInterface*> filters{&noneFilter, &hammingFilter, &cosineFilter, &sheppLoganFilter};
+
+  JPetRecoImageTools::FourierTransformFunction f = JPetRecoImageTools::doFFTW1D;
+  const auto sinogram = createSinogram(10, 6);
+  for (auto filter : filters) {
+    const auto expected = referenceFilter(sinogram, *filter);
+    requireEqual(JPetRecoImageTools::FilterSinogram(f, *filter, sinogram), expected);
+    // second sinogram filtered with the cached response
+    requireEqual(JPetRecoImageTools::FilterSinogram(f, *filter, sinogram), expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(filter_sinograms_of_different_sizes_test) {
+  JPetFilterHamming filter(0.7);
+  JPetRecoImageTools::FourierTransformFunction f = JPetRecoImageTools::doFFTW1D;
+  const auto small = createSinogram(10, 4);
+  const auto large = createSinogram(40, 4);
+  const auto expectedSmall = referenceFilter(small, filter);
+  const auto expectedLarge = referenceFilter(large, filter);
+
+  requireEqual(JPetRecoImageTools::FilterSinogram(f, filter, small), expectedSmall);
+  requireEqual(JPetRecoImageTools::FilterSinogram(f, filter, large), expectedLarge);
+  requireEqual(JPetRecoImageTools::FilterSinogram(f, filter, small), expectedSmall);
+}
+
+BOOST_AUTO_TEST_CASE(test_kde_profile) {
+  const double tofToDistance = 0.299792458;
+  const double sigma = 150.;
+  const double step = sigma / 10.;
+  std::vector<float> tof = {-1200.f, -350.f, 0.f, 20.f, 480.f, 2500.f};
+  std::vector<double> profile = JPetRecoImageTools::calculateKDEProfile(tof, tofToDistance, sigma, step, 30);
+  BOOST_REQUIRE_EQUAL(profile.size(), 30u);
+
+  double maxValue = 0.;
+  for (double distance = 0.; distance < 400.; distance += 7.3) {
+    double direct = 0.;
+    for (auto tofValue : tof)
+      direct += JPetRecoImageTools::normalDistributionProbability(distance, tofValue * tofToDistance, sigma);
+    maxValue = std::max(maxValue, direct);
+    BOOST_REQUIRE_SMALL(JPetRecoImageTools::sampleKDEProfile(profile, distance, step) - direct, 1e-5);
+  }
+  BOOST_REQUIRE(maxValue > 1e-3);
+  BOOST_REQUIRE_EQUAL(JPetRecoImageTools::sampleKDEProfile(profile, -1., step), 0.);
+  BOOST_REQUIRE_EQUAL(JPetRecoImageTools::sampleKDEProfile(profile, 30 * step, step), 0.);
+  BOOST_REQUIRE(JPetRecoImageTools::calculateKDEProfile(std::vector<float>(), tofToDistance, sigma, step, 30) == std::vector<double>(30, 0.));
+}
+
+BOOST_AUTO_TEST_CASE(back_project_with_kde_test) {
+  const int imageSize = 21;
+  const int nAngles = 12;
+  JPetSinogramType::SparseMatrix sinogram(imageSize, nAngles);
+  JPetRecoImageTools::Matrix2DTOF tof;
+  for (int angle = 0; angle < nAngles; angle++)
+    for (int n = 2; n < imageSize - 2; n += 3) {
+      auto& tofVector = tof[std::make_pair(n, angle)];
+      for (int i = 0; i <= (n + angle) % 4; i++)
+        tofVector.push_back(-900.f + 170.f * ((n * 7 + angle * 3 + i * 5) % 11));
+      sinogram(n, angle) = tofVector.size();
+    }
+
+  const auto result = JPetRecoImageTools::backProjectWithKDE(sinogram, tof, nAngles, JPetRecoImageTools::nonRescale, 0, 255);
+  const auto expected = referenceBackProjectWithKDE(sinogram, tof, nAngles);
+  BOOST_REQUIRE_EQUAL(result.size1(), expected.size1());
+  BOOST_REQUIRE_EQUAL(result.size2(), expected.size2());
+  double scale = 0.;
+  for (int x = 0; x < imageSize; x++)
+    for (int y = 0; y < imageSize; y++)
+      scale = std::max(scale, std::abs(expected(y, x)));
+  BOOST_REQUIRE(scale > 0.);
+  // profiles match the direct sums of normal distributions to about 1e-5 of the sum for a single TOF value
+  for (int x = 0; x < imageSize; x++)
+    for (int y = 0; y < imageSize; y++)
+      BOOST_REQUIRE_SMALL(result(y, x) - expected(y, x), 1e-3 * scale);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
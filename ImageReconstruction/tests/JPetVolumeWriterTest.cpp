@@ -0,0 +1,73 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE JPetVolumeWriterTest
+#include <boost/test/unit_test.hpp>
+
+#include "../JPetVolumeWriter.h"
+#include <fstream>
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(nrrd_write_read_test) {
+  JPetVolume volume;
+  volume.sizeX = 5;
+  volume.sizeY = 4;
+  volume.sizeZ = 3;
+  volume.spacingX = 0.1f;
+  volume.spacingY = 0.1f;
+  volume.spacingZ = 2.5f;
+  volume.keyValues["filter"] = "Hamming";
+  volume.keyValues["slice numbers"] = "-1 0 1";
+  for (unsigned int i = 0; i < volume.sizeX * volume.sizeY * volume.sizeZ; i++)
+    volume.data.push_back(i * 0.3333f - 2.f);
+
+  BOOST_REQUIRE(JPetVolumeWriter::writeNRRD(volume, "volume_test.nrrd"));
+
+  JPetVolume read;
+  BOOST_REQUIRE(JPetVolumeWriter::readNRRD("volume_test.nrrd", read));
+  BOOST_REQUIRE_EQUAL(read.sizeX, volume.sizeX);
+  BOOST_REQUIRE_EQUAL(read.sizeY, volume.sizeY);
+  BOOST_REQUIRE_EQUAL(read.sizeZ, volume.sizeZ);
+  BOOST_REQUIRE_CLOSE(read.spacingZ, volume.spacingZ, 0.001f);
+  BOOST_REQUIRE_EQUAL(read.keyValues["filter"], "Hamming");
+  BOOST_REQUIRE_EQUAL(read.keyValues["slice numbers"], "-1 0 1");
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(read.data.begin(), read.data.end(), volume.data.begin(), volume.data.end());
+  BOOST_REQUIRE_EQUAL(read(4, 3, 2), volume.data.back());
+}
+
+BOOST_AUTO_TEST_CASE(nrrd_wrong_size_test) {
+  JPetVolume volume;
+  volume.sizeX = 2;
+  volume.sizeY = 2;
+  volume.sizeZ = 2;
+  volume.data.assign(7, 1.f);
+  BOOST_REQUIRE(!JPetVolumeWriter::writeNRRD(volume, "volume_wrong_size_test.nrrd"));
+  BOOST_REQUIRE(!JPetVolumeWriter::readNRRD("not_existing_volume.nrrd", volume));
+}
+
+BOOST_AUTO_TEST_CASE(ppm_preview_test) {
+  JPetVolume volume;
+  volume.sizeX = 3;
+  volume.sizeY = 2;
+  volume.sizeZ = 2;
+  volume.data = {0.f, 1.4f, 2.6f, -3.f, 4.f, 5.f, 9.f, 9.f, 9.f, 9.f, 9.f, 9.f};
+
+  BOOST_REQUIRE(JPetVolumeWriter::writePPMSlice(volume, 0, "volume_preview_test.ppm"));
+  BOOST_REQUIRE(!JPetVolumeWriter::writePPMSlice(volume, 2, "volume_preview_wrong_test.ppm"));
+
+  std::ifstream in("volume_preview_test.ppm");
+  std::string header;
+  int width = 0, height = 0, maxValue = 0;
+  in >> header >> width >> height >> maxValue;
+  BOOST_REQUIRE_EQUAL(header, "P2");
+  BOOST_REQUIRE_EQUAL(width, 3);
+  BOOST_REQUIRE_EQUAL(height, 2);
+  BOOST_REQUIRE_EQUAL(maxValue, 5);
+  std::vector<int> values;
+  int value = 0;
+  while (in >> value)
+    values.push_back(value);
+  std::vector<int> expected = {0, 1, 3, 0, 4, 5};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(values.begin(), values.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
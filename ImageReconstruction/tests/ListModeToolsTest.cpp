@@ -0,0 +1,106 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ListModeToolsTest
+#include <boost/test/unit_test.hpp>
+
+#include "../ListModeTools.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+JPetVolume createVolume() {
+  JPetVolume volume;
+  volume.sizeX = 40;
+  volume.sizeY = 40;
+  volume.sizeZ = 20;
+  volume.spacingX = 0.5f;
+  volume.spacingY = 0.5f;
+  volume.spacingZ = 1.f;
+  return volume;
+}
+
+// LORs through point (x, y, z) with hits on cylinder of given radius and times consistent with TOF
+std::vector<ListModeLOR> createLORs(float x, float y, float z, float radius, int numberOfLORs) {
+  std::vector<ListModeLOR> lors;
+  for (int i = 0; i < numberOfLORs; i++) {
+    const float phi = i * M_PI / numberOfLORs;
+    const float slope = 0.3f * std::sin(7.f * i);
+    const float ux = std::cos(phi), uy = std::sin(phi), uz = slope;
+    // distance to the cylinder in both directions
+    const float b = x * ux + y * uy;
+    const float c = x * x + y * y - radius * radius;
+    const float a = ux * ux + uy * uy;
+    const float forward = (-b + std::sqrt(b * b - a * c)) / a;
+    const float backward = (-b - std::sqrt(b * b - a * c)) / a;
+    const float norm = std::sqrt(a + uz * uz);
+    ListModeLOR lor;
+    lor.firstX = x + backward * ux;
+    lor.firstY = y + backward * uy;
+    lor.firstZ = z + backward * uz;
+    lor.secondX = x + forward * ux;
+    lor.secondY = y + forward * uy;
+    lor.secondZ = z + forward * uz;
+    lor.firstTime = 1000. + -backward * norm / ListModeTools::kSpeedOfLight;
+    lor.secondTime = 1000. + forward * norm / ListModeTools::kSpeedOfLight;
+    lors.push_back(lor);
+  }
+  return lors;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(annihilation_point_distance_test) {
+  ListModeLOR lor;
+  lor.firstX = -10.f;
+  lor.secondX = 10.f;
+  BOOST_REQUIRE_SMALL(ListModeTools::getAnnihilationPointDistance(lor) - 10.f, 0.0001f);
+  lor.secondTime = 100.;
+  BOOST_REQUIRE_CLOSE(ListModeTools::getAnnihilationPointDistance(lor), 10.f - 0.0299792458f * 50.f, 0.001f);
+  BOOST_REQUIRE_CLOSE(ListModeTools::getTOFSigmaAlongLOR(200.f), 0.0299792458f * 100.f, 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE(point_source_test) {
+  const auto lors = createLORs(3.2f, -2.2f, 1.5f, 40.f, 200);
+  auto volume = createVolume();
+  BOOST_REQUIRE_EQUAL(ListModeTools::backProject(lors, volume, ListModeTools::getTOFSigmaAlongLOR(50.f), 1), lors.size());
+
+  const auto maxVoxel = std::max_element(volume.data.begin(), volume.data.end()) - volume.data.begin();
+  BOOST_REQUIRE_EQUAL(maxVoxel % volume.sizeX, 26u);
+  BOOST_REQUIRE_EQUAL((maxVoxel / volume.sizeX) % volume.sizeY, 15u);
+  BOOST_REQUIRE_EQUAL(maxVoxel / (volume.sizeX * volume.sizeY), 11u);
+  // kernel is normalised, so every LOR contributes ~1 when the kernel is inside the volume
+  const float sum = std::accumulate(volume.data.begin(), volume.data.end(), 0.f);
+  BOOST_REQUIRE_CLOSE(sum, lors.size(), 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(threads_test) {
+  auto lors = createLORs(3.f, -2.f, 1.5f, 40.f, 100);
+  const auto otherLORs = createLORs(-6.f, 4.f, -7.f, 40.f, 100);
+  lors.insert(lors.end(), otherLORs.begin(), otherLORs.end());
+  for (float sigma : {0.f, 1.f}) {
+    auto single = createVolume();
+    auto parallel = createVolume();
+    const auto singleDeposited = ListModeTools::backProject(lors, single, sigma, 1);
+    const auto parallelDeposited = ListModeTools::backProject(lors, parallel, sigma, 7);
+    BOOST_REQUIRE_EQUAL(singleDeposited, parallelDeposited);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(single.data.begin(), single.data.end(), parallel.data.begin(), parallel.data.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(outside_volume_test) {
+  ListModeLOR lor;
+  lor.firstX = -40.f;
+  lor.firstY = 30.f;
+  lor.secondX = 40.f;
+  lor.secondY = 30.f;
+  auto volume = createVolume();
+  BOOST_REQUIRE_EQUAL(ListModeTools::backProject({lor}, volume, 0.f, 4), 0u);
+  BOOST_REQUIRE_EQUAL(volume.data.size(), 40u * 40u * 20u);
+  BOOST_REQUIRE_EQUAL(*std::max_element(volume.data.begin(), volume.data.end()), 0.f);
+  BOOST_REQUIRE_EQUAL(ListModeTools::backProject({}, volume, 0.f, 4), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
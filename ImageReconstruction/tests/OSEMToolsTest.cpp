@@ -0,0 +1,276 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE OSEMToolsTest
+#include <boost/test/unit_test.hpp>
+
+#include "../OSEMTools.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Small synthetic 2D phantom reconstructed from parallel projections,
+// each measured event is a (angle, bin) pair.
+const int kImageSize = 16;
+const int kNumberOfAngles = 32;
+const int kNumberOfBins = 24;
+
+struct Event {
+  int angle;
+  int bin;
+};
+
+int getBin(int x, int y, int angle) {
+  const float theta = angle * M_PI / kNumberOfAngles;
+  const float cx = x - kImageSize / 2.f + 0.5f;
+  const float cy = y - kImageSize / 2.f + 0.5f;
+  const int bin = static_cast<int>(std::floor(cx * std::cos(theta) + cy * std::sin(theta) + kNumberOfBins / 2.f));
+  return bin >= 0 && bin < kNumberOfBins ? bin : -1;
+}
+
+std::vector<float> createPhantom() {
+  std::vector<float> phantom(kImageSize * kImageSize, 0.f);
+  for (int y = 0; y < kImageSize; y++) {
+    for (int x = 0; x < kImageSize; x++) {
+      const float dx = x - 7.5f;
+      const float dy = y - 7.5f;
+      if (dx * dx + dy * dy < 36.f)
+        phantom[y * kImageSize + x] = 1.f;
+      if ((x - 5) * (x - 5) + (y - 9) * (y - 9) < 4)
+        phantom[y * kImageSize + x] = 4.f;
+    }
+  }
+  return phantom;
+}
+
+std::vector<Event> createEvents(const std::vector<float>& phantom) {
+  std::vector<float> projections(kNumberOfAngles * kNumberOfBins, 0.f);
+  for (int angle = 0; angle < kNumberOfAngles; angle++)
+    for (int y = 0; y < kImageSize; y++)
+      for (int x = 0; x < kImageSize; x++) {
+        const int bin = getBin(x, y, angle);
+        if (bin >= 0)
+          projections[angle * kNumberOfBins + bin] += phantom[y * kImageSize + x];
+      }
+  std::vector<Event> events;
+  for (int angle = 0; angle < kNumberOfAngles; angle++)
+    for (int bin = 0; bin < kNumberOfBins; bin++) {
+      const int counts = std::round(projections[angle * kNumberOfBins + bin] * 10.f);
+      for (int i = 0; i < counts; i++)
+        events.push_back(Event{angle, bin});
+    }
+  return events;
+}
+
+std::vector<float> getSensitivity() {
+  std::vector<float> sensitivity(kImageSize * kImageSize, 0.f);
+  for (int angle = 0; angle < kNumberOfAngles; angle++)
+    for (int y = 0; y < kImageSize; y++)
+      for (int x = 0; x < kImageSize; x++)
+        if (getBin(x, y, angle) >= 0)
+          sensitivity[y * kImageSize + x] += 1.f;
+  return sensitivity;
+}
+
+std::vector<std::vector<int>> getLORPixels() {
+  std::vector<std::vector<int>> lorPixels(kNumberOfAngles * kNumberOfBins);
+  for (int angle = 0; angle < kNumberOfAngles; angle++)
+    for (int y = 0; y < kImageSize; y++)
+      for (int x = 0; x < kImageSize; x++) {
+        const int bin = getBin(x, y, angle);
+        if (bin >= 0)
+          lorPixels[angle * kNumberOfBins + bin].push_back(y * kImageSize + x);
+      }
+  return lorPixels;
+}
+
+unsigned int getSubset(const Event& event, unsigned int numberOfSubsets) {
+  return OSEMTools::getAngularSubset(event.angle * M_PI / kNumberOfAngles, numberOfSubsets);
+}
+
+void addCorrection(std::vector<float>& correction, const std::vector<float>& rho, const Event& event,
+                   const std::vector<std::vector<int>>& lorPixels) {
+  const auto& pixels = lorPixels[event.angle * kNumberOfBins + event.bin];
+  float denominator = 0.f;
+  for (auto pixel : pixels)
+    denominator += rho[pixel];
+  if (denominator <= 0.f)
+    return;
+  for (auto pixel : pixels)
+    correction[pixel] += 1.f / denominator;
+}
+
+void runPass(std::vector<float>& rho, const std::vector<Event>& events, const std::vector<std::vector<int>>& lorPixels,
+             const std::vector<float>& sensitivity, unsigned int numberOfSubsets) {
+  for (unsigned int subset = 0; subset < numberOfSubsets; subset++) {
+    std::vector<float> correction(rho.size(), 0.f);
+    for (const auto& event : events) {
+      if (getSubset(event, numberOfSubsets) == subset)
+        addCorrection(correction, rho, event, lorPixels);
+    }
+    OSEMTools::updateImage(rho, correction, sensitivity, numberOfSubsets);
+  }
+}
+
+// Stands for the MLEM reconstruction of MLEMRunner holding events of one subset and the full sensitivity
+struct SubsetReconstruction {
+  std::vector<float> rho;
+  std::vector<Event> events;
+  const std::vector<std::vector<int>>& lorPixels;
+  const std::vector<float>& sensitivity;
+
+  unsigned long n_events() const { return events.size(); }
+  void operator()() {
+    std::vector<float> correction(rho.size(), 0.f);
+    for (const auto& event : events)
+      addCorrection(correction, rho, event, lorPixels);
+    OSEMTools::updateImage(rho, correction, sensitivity, 1);
+  }
+};
+
+std::vector<std::unique_ptr<SubsetReconstruction>> createSubsets(const std::vector<Event>& events, const std::vector<std::vector<int>>& lorPixels,
+                                                                 const std::vector<float>& sensitivity, unsigned int numberOfSubsets) {
+  std::vector<std::unique_ptr<SubsetReconstruction>> subsets;
+  for (unsigned int subset = 0; subset < numberOfSubsets; subset++)
+    subsets.emplace_back(new SubsetReconstruction{std::vector<float>(), std::vector<Event>(), lorPixels, sensitivity});
+  for (const auto& event : events)
+    subsets[getSubset(event, numberOfSubsets)]->events.push_back(event);
+  return subsets;
+}
+
+float getRelativeError(const std::vector<float>& rho, const std::vector<float>& phantom) {
+  float rhoSum = 0.f;
+  float phantomSum = 0.f;
+  for (unsigned int i = 0; i < rho.size(); i++) {
+    rhoSum += rho[i];
+    phantomSum += phantom[i];
+  }
+  float error = 0.f;
+  float norm = 0.f;
+  for (unsigned int i = 0; i < rho.size(); i++) {
+    const float diff = rho[i] / rhoSum - phantom[i] / phantomSum;
+    error += diff * diff;
+    norm += (phantom[i] / phantomSum) * (phantom[i] / phantomSum);
+  }
+  return std::sqrt(error / norm);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FirstSuite)
+
+BOOST_AUTO_TEST_CASE(subset_type_test) {
+  BOOST_REQUIRE_EQUAL(OSEMTools::getSubsetType("Angular"), OSEMTools::kAngular);
+  BOOST_REQUIRE_EQUAL(OSEMTools::getSubsetType("Temporal"), OSEMTools::kTemporal);
+  BOOST_REQUIRE_EQUAL(OSEMTools::getSubsetType("Random"), OSEMTools::kSubsetTypeNotFound);
+}
+
+BOOST_AUTO_TEST_CASE(lor_angle_test) {
+  const float EPSILON = 0.0001f;
+  BOOST_REQUIRE_SMALL(OSEMTools::getLORAngle(-1.f, 0.f, 1.f, 0.f), EPSILON);
+  BOOST_REQUIRE_SMALL(OSEMTools::getLORAngle(1.f, 0.f, -1.f, 0.f), EPSILON);
+  BOOST_REQUIRE_CLOSE(OSEMTools::getLORAngle(0.f, -1.f, 0.f, 1.f), M_PI / 2., EPSILON);
+  BOOST_REQUIRE_CLOSE(OSEMTools::getLORAngle(0.f, 1.f, 0.f, -1.f), M_PI / 2., EPSILON);
+  BOOST_REQUIRE_CLOSE(OSEMTools::getLORAngle(1.f, 1.f, -1.f, -1.f), M_PI / 4., EPSILON);
+}
+
+BOOST_AUTO_TEST_CASE(subset_assignment_test) {
+  const unsigned int numberOfSubsets = 4;
+  std::vector<unsigned int> subsetSizes(numberOfSubsets, 0);
+  for (int i = 0; i < 3600; i++) {
+    const unsigned int subset = OSEMTools::getAngularSubset((i + 0.5) * M_PI / 3600., numberOfSubsets);
+    BOOST_REQUIRE(subset < numberOfSubsets);
+    subsetSizes[subset]++;
+  }
+  for (auto size : subsetSizes)
+    BOOST_REQUIRE_EQUAL(size, 900u);
+  BOOST_REQUIRE_EQUAL(OSEMTools::getAngularSubset(M_PI / 2., 1), 0u);
+
+  // 10 events in order of arrival are split into blocks 0 0 0 1 1 2 2 2 3 3
+  const std::vector<unsigned int> expectedTemporalSubsets = {0, 0, 0, 1, 1, 2, 2, 2, 3, 3};
+  for (unsigned int event = 0; event < expectedTemporalSubsets.size(); event++)
+    BOOST_REQUIRE_EQUAL(OSEMTools::getTemporalSubset(event, expectedTemporalSubsets.size(), numberOfSubsets), expectedTemporalSubsets[event]);
+  BOOST_REQUIRE_EQUAL(OSEMTools::getTemporalSubset(5, 10, 1), 0u);
+  unsigned int previousSubset = 0;
+  std::vector<unsigned int> temporalSubsetSizes(numberOfSubsets, 0);
+  for (unsigned long event = 0; event < 3601; event++) {
+    const unsigned int subset = OSEMTools::getTemporalSubset(event, 3601, numberOfSubsets);
+    BOOST_REQUIRE(subset == previousSubset || subset == previousSubset + 1);
+    previousSubset = subset;
+    temporalSubsetSizes[subset]++;
+  }
+  for (auto size : temporalSubsetSizes)
+    BOOST_REQUIRE(size == 900u || size == 901u);
+}
+
+BOOST_AUTO_TEST_CASE(osem_convergence_test) {
+  const auto phantom = createPhantom();
+  const auto events = createEvents(phantom);
+  const auto sensitivity = getSensitivity();
+  const auto lorPixels = getLORPixels();
+  const unsigned int numberOfSubsets = 4;
+
+  std::vector<float> mlem(phantom.size(), 1.f);
+  std::vector<float> osem(phantom.size(), 1.f);
+  std::vector<float> mlemErrors;
+  for (unsigned int iteration = 0; iteration < 2 * numberOfSubsets; iteration++) {
+    runPass(mlem, events, lorPixels, sensitivity, 1);
+    mlemErrors.push_back(getRelativeError(mlem, phantom));
+  }
+  runPass(osem, events, lorPixels, sensitivity, numberOfSubsets);
+  runPass(osem, events, lorPixels, sensitivity, numberOfSubsets);
+  const float osemError = getRelativeError(osem, phantom);
+
+  // two OSEM passes are better than two MLEM iterations
+  BOOST_REQUIRE_LT(osemError, mlemErrors[1]);
+  // and comparable to MLEM with the same number of image updates
+  BOOST_REQUIRE_LT(osemError, 1.2f * mlemErrors.back());
+  // MLEM itself converges
+  BOOST_REQUIRE_LT(mlemErrors.back(), mlemErrors.front());
+}
+
+BOOST_AUTO_TEST_CASE(runner_subsets_pass_test) {
+  const auto phantom = createPhantom();
+  const auto events = createEvents(phantom);
+  const auto sensitivity = getSensitivity();
+  const auto lorPixels = getLORPixels();
+  const unsigned int numberOfSubsets = 4;
+
+  // pass run by MLEMRunner gives the same images as OSEM updates with divided sensitivity
+  auto subsets = createSubsets(events, lorPixels, sensitivity, numberOfSubsets);
+  std::vector<float> runnerImage(phantom.size(), 1.f);
+  std::vector<float> osemImage(phantom.size(), 1.f);
+  for (int pass = 0; pass < 2; pass++) {
+    OSEMTools::runSubsetsPass(runnerImage, subsets);
+    runPass(osemImage, events, lorPixels, sensitivity, numberOfSubsets);
+    for (unsigned int i = 0; i < runnerImage.size(); i++) {
+      if (osemImage[i] == 0.f)
+        BOOST_REQUIRE_EQUAL(runnerImage[i], 0.f);
+      else
+        BOOST_REQUIRE_CLOSE(runnerImage[i], osemImage[i], 0.01f);
+    }
+  }
+  BOOST_REQUIRE_LT(getRelativeError(runnerImage, phantom), getRelativeError(std::vector<float>(phantom.size(), 1.f), phantom));
+
+  // subsets without events do not change the image
+  std::vector<Event> firstSubsetEvents;
+  for (const auto& event : events)
+    if (getSubset(event, numberOfSubsets) == 0)
+      firstSubsetEvents.push_back(event);
+  auto sparseSubsets = createSubsets(firstSubsetEvents, lorPixels, sensitivity, numberOfSubsets);
+  BOOST_REQUIRE_EQUAL(sparseSubsets[1]->n_events(), 0u);
+  std::vector<float> sparseImage(phantom.size(), 1.f);
+  OSEMTools::runSubsetsPass(sparseImage, sparseSubsets);
+  std::vector<float> expectedImage(phantom.size(), 1.f);
+  std::vector<float> correction(phantom.size(), 0.f);
+  for (const auto& event : firstSubsetEvents)
+    addCorrection(correction, expectedImage, event, lorPixels);
+  OSEMTools::updateImage(expectedImage, correction, sensitivity, numberOfSubsets);
+  for (unsigned int i = 0; i < sparseImage.size(); i++) {
+    if (expectedImage[i] == 0.f)
+      BOOST_REQUIRE_EQUAL(sparseImage[i], 0.f);
+    else
+      BOOST_REQUIRE_CLOSE(sparseImage[i], expectedImage[i], 0.01f);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
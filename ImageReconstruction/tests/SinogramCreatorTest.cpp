@@ -0,0 +1,218 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE SinogramCreatorGojaTest
+#include <boost/test/unit_test.hpp>
+
+#include "../JPetGojaFileReader.h"
+#include "../SinogramCreator.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string kGojaFileWithNewLine = "sinogramCreatorTest.newline.goja";
+const std::string kGojaFileWithoutNewLine = "sinogramCreatorTest.nonewline.goja";
+const int kNumberOfLines = 3000;
+
+// Writes GOJA lines with 16 columns, positions on radius 42.5 cm, times in ps
+void writeGojaFile(const std::string& path, bool endWithNewLine) {
+  std::mt19937 engine(2021);
+  std::uniform_real_distribution<double> angle(0., 2. * M_PI);
+  std::uniform_real_distribution<double> spread(-0.3, 0.3);
+  std::uniform_real_distribution<double> z(-24., 24.);
+  std::uniform_real_distribution<double> time(0., 2.e6);
+  std::uniform_real_distribution<double> timeDifference(-2000., 2000.);
+  std::ofstream out(path);
+  for (int i = 0; i < kNumberOfLines; i++) {
+    const double firstAngle = angle(engine);
+    const double secondAngle = firstAngle + M_PI + spread(engine);
+    const double firstTime = time(engine);
+    out << std::setprecision(i % 3 == 0 ? 6 : 10);
+    out << 42.5 * std::cos(firstAngle) << " " << 42.5 * std::sin(firstAngle) << "\t" << z(engine) << " " << firstTime << " ";
+    out << 42.5 * std::cos(secondAngle) << " " << 42.5 * std::sin(secondAngle) << " " << z(engine) << "  "
+        << firstTime + timeDifference(engine);
+    out << " " << i % 7 << " " << i % 5 << " 0.511 0.34 " << (i % 4 == 0 ? 2 : 1) << " 0 0 0";
+    if (endWithNewLine || i + 1 < kNumberOfLines)
+      out << "\n";
+  }
+}
+
+// Loop used by SinogramCreator and JPetGojaParser before JPetGojaFileReader
+std::vector<JPetGojaCoincidence> readWithIfstream(const std::string& path) {
+  std::vector<JPetGojaCoincidence> coincidences;
+  std::ifstream in(path);
+  JPetGojaCoincidence lor;
+  float skip = 0.f;
+  float skipInt = 0.f;
+  int coincidence = 0;
+  while (in.peek() != EOF) {
+    in >> lor.firstX >> lor.firstY >> lor.firstZ >> lor.firstT >> lor.secondX >> lor.secondY >> lor.secondZ >> lor.secondT >> skipInt >>
+        skipInt >> skip >> skip >> coincidence >> skip >> skip >> skip;
+    coincidences.push_back(lor);
+  }
+  return coincidences;
+}
+
+std::vector<JPetGojaCoincidence> readWithFileReader(const std::string& path) {
+  std::vector<JPetGojaCoincidence> coincidences;
+  JPetGojaFileReader reader(path);
+  BOOST_REQUIRE(reader.isOpen());
+  JPetGojaCoincidence lor;
+  auto chunk = reader.whole();
+  while (JPetGojaFileReader::next(chunk.first, chunk.second, lor))
+    coincidences.push_back(lor);
+  return coincidences;
+}
+
+void checkCoincidencesEqual(const JPetGojaCoincidence& first, const JPetGojaCoincidence& second) {
+  BOOST_REQUIRE_EQUAL(first.firstX, second.firstX);
+  BOOST_REQUIRE_EQUAL(first.firstY, second.firstY);
+  BOOST_REQUIRE_EQUAL(first.firstZ, second.firstZ);
+  BOOST_REQUIRE_EQUAL(first.firstT, second.firstT);
+  BOOST_REQUIRE_EQUAL(first.secondX, second.secondX);
+  BOOST_REQUIRE_EQUAL(first.secondY, second.secondY);
+  BOOST_REQUIRE_EQUAL(first.secondZ, second.secondZ);
+  BOOST_REQUIRE_EQUAL(first.secondT, second.secondT);
+}
+
+// SinogramCreator with the ranges set up by setUpOptions for given geometry, without reading options and param bank
+class GojaSinogramCreator : public SinogramCreator {
+public:
+  GojaSinogramCreator(const std::string& gojaFile, unsigned int numberOfThreads) : SinogramCreator("GojaSinogramCreator") {
+    fZSplitNumber = 3;
+    fScintillatorLenght = 50.f;
+    fMaxReconstructionLayerRadius = 45.f;
+    fReconstructionDistanceAccuracy = 0.5f;
+    fEnableObliqueLORRemapping = true;
+    fGojaInputFilePath = {gojaFile};
+    fNumberOfThreads = numberOfThreads;
+    const float range = fScintillatorLenght / fZSplitNumber;
+    for (int i = 0; i < fZSplitNumber; i++)
+      fZSplitRange.push_back(std::make_pair(i * range - fScintillatorLenght / 2.f, (i + 1) * range - fScintillatorLenght / 2.f));
+    fMaxDistanceNumber = std::ceil(fMaxReconstructionLayerRadius * 2 * (1.f / fReconstructionDistanceAccuracy)) + 1;
+    fSinogramData = JPetSinogramType::WholeSinogram(fZSplitNumber, JPetSinogramType::Matrix3D());
+  }
+
+  using SinogramCreator::readAndAnalyzeGojaFile;
+
+  void analyzeCoincidence(const JPetGojaCoincidence& lor) {
+    fTotalAnalyzedHits++;
+    if (analyzeHits(lor.firstX, lor.firstY, lor.firstZ, lor.firstT, lor.secondX, lor.secondY, lor.secondZ, lor.secondT))
+      fNumberOfCorrectHits++;
+  }
+
+  const JPetSinogramType::WholeSinogram& getSinogram() const { return fSinogramData; }
+  unsigned int getNumberOfAnalyzedHits() const { return fTotalAnalyzedHits; }
+  unsigned int getNumberOfCorrectHits() const { return fNumberOfCorrectHits; }
+};
+
+double getNumberOfEntries(const JPetSinogramType::WholeSinogram& sinogram) {
+  double entries = 0.;
+  for (const auto& slice : sinogram)
+    for (const auto& tofWindow : slice)
+      for (auto row = tofWindow.second.begin1(); row != tofWindow.second.end1(); ++row)
+        for (auto element = row.begin(); element != row.end(); ++element)
+          entries += *element;
+  return entries;
+}
+
+void checkSinogramsEqual(const JPetSinogramType::WholeSinogram& expected, const JPetSinogramType::WholeSinogram& result) {
+  BOOST_REQUIRE_EQUAL(expected.size(), result.size());
+  for (unsigned int slice = 0; slice < expected.size(); slice++) {
+    BOOST_REQUIRE_EQUAL(expected[slice].size(), result[slice].size());
+    for (const auto& tofWindow : expected[slice]) {
+      const auto resultWindow = result[slice].find(tofWindow.first);
+      BOOST_REQUIRE(resultWindow != result[slice].end());
+      const auto& expectedMatrix = tofWindow.second;
+      const auto& resultMatrix = resultWindow->second;
+      BOOST_REQUIRE_EQUAL(expectedMatrix.size1(), resultMatrix.size1());
+      BOOST_REQUIRE_EQUAL(expectedMatrix.size2(), resultMatrix.size2());
+      BOOST_REQUIRE_EQUAL(expectedMatrix.nnz(), resultMatrix.nnz());
+      for (auto row = expectedMatrix.begin1(); row != expectedMatrix.end1(); ++row)
+        for (auto element = row.begin(); element != row.end(); ++element)
+          BOOST_REQUIRE_EQUAL(*element, resultMatrix(element.index1(), element.index2()));
+    }
+  }
+}
+
+struct GojaFiles {
+  GojaFiles() {
+    writeGojaFile(kGojaFileWithNewLine, true);
+    writeGojaFile(kGojaFileWithoutNewLine, false);
+  }
+  ~GojaFiles() {
+    std::remove(kGojaFileWithNewLine.c_str());
+    std::remove(kGojaFileWithoutNewLine.c_str());
+  }
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FirstSuite, GojaFiles)
+
+BOOST_AUTO_TEST_CASE(goja_file_reader_test) {
+  const auto withoutNewLine = readWithFileReader(kGojaFileWithoutNewLine);
+  const auto expectedWithoutNewLine = readWithIfstream(kGojaFileWithoutNewLine);
+  BOOST_REQUIRE_EQUAL(withoutNewLine.size(), kNumberOfLines);
+  BOOST_REQUIRE_EQUAL(expectedWithoutNewLine.size(), kNumberOfLines);
+  for (unsigned int i = 0; i < withoutNewLine.size(); i++)
+    checkCoincidencesEqual(expectedWithoutNewLine[i], withoutNewLine[i]);
+
+  // ifstream loop repeated the last line when the file ended with new line
+  const auto withNewLine = readWithFileReader(kGojaFileWithNewLine);
+  const auto expectedWithNewLine = readWithIfstream(kGojaFileWithNewLine);
+  BOOST_REQUIRE_EQUAL(withNewLine.size(), kNumberOfLines);
+  BOOST_REQUIRE_EQUAL(expectedWithNewLine.size(), kNumberOfLines + 1);
+  checkCoincidencesEqual(expectedWithNewLine[kNumberOfLines - 1], expectedWithNewLine[kNumberOfLines]);
+  for (unsigned int i = 0; i < withNewLine.size(); i++)
+    checkCoincidencesEqual(expectedWithNewLine[i], withNewLine[i]);
+}
+
+BOOST_AUTO_TEST_CASE(goja_file_split_test) {
+  JPetGojaFileReader reader(kGojaFileWithoutNewLine);
+  BOOST_REQUIRE(reader.isOpen());
+  const auto expected = readWithFileReader(kGojaFileWithoutNewLine);
+  for (unsigned int numberOfChunks : {1u, 2u, 7u, 64u}) {
+    const auto chunks = reader.split(numberOfChunks);
+    BOOST_REQUIRE(!chunks.empty());
+    BOOST_REQUIRE(chunks.size() <= numberOfChunks);
+    BOOST_REQUIRE(chunks.front().first == reader.whole().first);
+    BOOST_REQUIRE(chunks.back().second == reader.whole().second);
+    unsigned int index = 0;
+    for (auto chunk : chunks) {
+      JPetGojaCoincidence lor;
+      while (JPetGojaFileReader::next(chunk.first, chunk.second, lor)) {
+        BOOST_REQUIRE(index < expected.size());
+        checkCoincidencesEqual(expected[index++], lor);
+      }
+    }
+    BOOST_REQUIRE_EQUAL(index, expected.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(threaded_sinogram_test) {
+  for (const auto& gojaFile : {kGojaFileWithoutNewLine, kGojaFileWithNewLine}) {
+    // Sinogram filled sequentially from values read by ifstream loop, without the repeated last line
+    GojaSinogramCreator expected(gojaFile, 1);
+    auto coincidences = readWithIfstream(gojaFile);
+    coincidences.resize(kNumberOfLines);
+    for (const auto& lor : coincidences)
+      expected.analyzeCoincidence(lor);
+    BOOST_REQUIRE(expected.getNumberOfCorrectHits() > kNumberOfLines / 2);
+    BOOST_REQUIRE_EQUAL(getNumberOfEntries(expected.getSinogram()), expected.getNumberOfCorrectHits());
+
+    for (unsigned int numberOfThreads : {1u, 4u, 7u}) {
+      GojaSinogramCreator creator(gojaFile, numberOfThreads);
+      creator.readAndAnalyzeGojaFile();
+      BOOST_REQUIRE_EQUAL(creator.getNumberOfAnalyzedHits(), expected.getNumberOfAnalyzedHits());
+      BOOST_REQUIRE_EQUAL(creator.getNumberOfCorrectHits(), expected.getNumberOfCorrectHits());
+      checkSinogramsEqual(expected.getSinogram(), creator.getSinogram());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -211,5 +211,38 @@ BOOST_AUTO_TEST_CASE(polyfit_test) {
       7.430144030486940e-01, kEPSILON);
 }
 
+BOOST_AUTO_TEST_CASE(split_range_number_test) {
+  std::vector<std::pair<float, float>> zSplitRange;
+  const float maxZRange = 25.f;
+  const int zSplitNumber = 7;
+  const float range = (2.f * maxZRange) / zSplitNumber;
+  for (int i = 0; i < zSplitNumber; i++) {
+    zSplitRange.push_back(
+        std::make_pair((i * range) - maxZRange, ((i + 1) * range) - maxZRange));
+  }
+
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(-25.f, zSplitRange), 0);
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(25.f, zSplitRange), zSplitNumber - 1);
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(-25.1f, zSplitRange), -1);
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(25.1f, zSplitRange), -1);
+  // value on the border of two ranges belongs to the first one
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(zSplitRange[3].first, zSplitRange), 2);
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(zSplitRange[3].first, zSplitRange[3].first + 0.1f, zSplitRange), 3);
+  BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(0.f, 24.f, zSplitRange), -1);
+
+  // results have to be the same as with linear search over all ranges
+  for (float z = -26.f; z <= 26.f; z += 0.01f) {
+    int expected = -1;
+    for (unsigned int i = 0; i < zSplitRange.size(); i++) {
+      if (z >= zSplitRange[i].first && z <= zSplitRange[i].second) {
+        expected = i;
+        break;
+      }
+    }
+    BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(z, zSplitRange), expected);
+    BOOST_REQUIRE_EQUAL(SinogramCreatorTools::getSplitRangeNumber(z, z, zSplitRange), expected);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
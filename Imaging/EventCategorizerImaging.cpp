@@ -32,6 +32,9 @@ bool EventCategorizerImaging::init()
 
   fOutputEvents = new JPetTimeWindow("JPetEvent");
 
+  // Optional flat copy of the categorized events
+  fFlatEventWriter.openFromOptions(fParams.getOptions(), getName());
+
   if (isOptionSet(fParams.getOptions(), kMinAnnihilationParamKey)) {
     fMinAnnihilationTOT = getOptionAsFloat(fParams.getOptions(), kMinAnnihilationParamKey);
   } else {
@@ -68,10 +71,26 @@ bool EventCategorizerImaging::init()
     WARNING(Form("No value of the %s parameter provided by the user. Using default value of %lf.", kDecayInto3MinAngleParamKey.c_str(), fDecayInto3MinAngle));
   }
   if (isOptionSet(fParams.getOptions(), kTOTCalculationType)) {
-    fTOTCalculationType = getOptionAsString(fParams.getOptions(), kTOTCalculationType);
+    fTOTCalculationType = HitFinderTools::getTOTCalculationType(getOptionAsString(fParams.getOptions(), kTOTCalculationType));
   } else {
     WARNING("No TOT calculation option given by the user. Using standard sum.");
   }
+
+  // Optional scan of many sets of cuts, evaluated next to the nominal ones
+  CategorizerCutSet nominalCuts;
+  nominalCuts.minAnnihilationTOT = fMinAnnihilationTOT;
+  nominalCuts.maxAnnihilationTOT = fMaxAnnihilationTOT;
+  nominalCuts.maxZPos = fMaxZPos;
+  nominalCuts.backToBackAngleWindow = fBackToBackAngleWindow;
+  nominalCuts.maxTimeDiff = fMaxTimeDiff;
+  std::string cutScanError;
+  auto cutSets = CategorizerCutScan::readCutSets(fParams.getOptions(), nominalCuts, cutScanError);
+  if (!cutScanError.empty()) {
+    ERROR("Scan of cuts disabled: " + cutScanError);
+  } else if (!cutSets.empty()) {
+    INFO(Form("Scanning %d sets of cuts", (int) cutSets.size()));
+  }
+  fCutScan.init(cutSets, false, getStatistics());
   
   if(fSaveControlHistos) initialiseHistograms();
   return true;
@@ -101,6 +120,7 @@ bool EventCategorizerImaging::exec()
 bool EventCategorizerImaging::terminate()
 {
   INFO("Imaging streaming ended.");
+  fFlatEventWriter.close();
   return true;
 }
 
@@ -108,14 +128,20 @@ void EventCategorizerImaging::saveEvents(const vector<JPetEvent>& events)
 {
   for (const auto& event : events) {
     fOutputEvents->add<JPetEvent>(event);
+    if (fFlatEventWriter.isOpen()) {
+      fFlatEventWriter.fill(event, fTOTCalculationType);
+    }
   }
 }
 
 JPetEvent EventCategorizerImaging::imageReconstruction(vector<JPetHit> hits)
 {
   JPetEvent imagingEvent;
+  // TOTs are calculated once and shared with the scanned sets of cuts
+  fHitTOTs.clear();
   for (unsigned i = 0; i < hits.size(); i++) {
-    double TOTofHit = HitFinderTools::calculateTOT(hits[i], HitFinderTools::getTOTCalculationType(fTOTCalculationType));
+    double TOTofHit = HitFinderTools::calculateTOT(hits[i], fTOTCalculationType);
+    fHitTOTs.push_back(TOTofHit);
     if (TOTofHit >= fMinAnnihilationTOT && TOTofHit <= fMaxAnnihilationTOT && fabs(hits[i].getPosZ()) < fMaxZPos) {
       imagingEvent.addHit(hits[i]);
     }
@@ -126,6 +152,7 @@ JPetEvent EventCategorizerImaging::imageReconstruction(vector<JPetHit> hits)
   if (EventCategorizerTools::checkFor3Gamma(imagingEvent, getStatistics(), fSaveControlHistos)) {
     imagingEvent.addEventType(JPetEventType::k3Gamma);
   }
+  fCutScan.evaluate(hits, fHitTOTs, getStatistics());
   return imagingEvent;
 }
 
@@ -16,6 +16,9 @@
 #ifndef EVENTCATEGORIZERIMAGING_H
 #define EVENTCATEGORIZERIMAGING_H
 
+#include "../LargeBarrelAnalysis/CategorizerCutScan.h"
+#include "../LargeBarrelAnalysis/FlatEventTree.h"
+#include "../LargeBarrelAnalysis/HitFinderTools.h"
 #include <JPetStatistics/JPetStatistics.h>
 #include <JPetEventType/JPetEventType.h>
 #include <JPetUserTask/JPetUserTask.h>
@@ -54,8 +57,11 @@ protected:
 	double fMaxTimeDiff = 1000.;
 	double fMaxZPos = 23.;
 	bool fSaveControlHistos = true;
-    std::string fTOTCalculationType = "";
+    HitFinderTools::TOTCalculationType fTOTCalculationType = HitFinderTools::kSimplified;
 	void saveEvents(const std::vector<JPetEvent>& event);
+	FlatEventWriter fFlatEventWriter;
+	CategorizerCutScan fCutScan;
+	std::vector<double> fHitTOTs;
     void initialiseHistograms();
 };
 
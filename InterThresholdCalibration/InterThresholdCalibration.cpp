@@ -19,7 +19,8 @@
 #include <sstream>
 #include <cctype>
 #include "InterThresholdCalibration.h"
-#include <TF1.h>
+#include "../LargeBarrelAnalysis/RawSignalTimes.h"
+#include <TH1D.h>
 #include <TString.h>
 #include <TDirectory.h>
 #include <vector>
@@ -28,6 +29,8 @@
 #include <time.h>
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include <JPetTimer/JPetTimer.h>
+#include <algorithm>
+#include <thread>
 
 using namespace jpet_options_tools;
 using namespace std;
@@ -72,6 +75,12 @@ bool InterThresholdCalibration::init()
   if ( isOptionSet(fParams.getOptions(), fMin_evKey))
     fMin_ev = getOptionAsDouble(fParams.getOptions(), fMin_evKey);
 
+  if ( isOptionSet(fParams.getOptions(), fInspectedSlotsKey))
+    fInspectedSlots = InterThresholdCalibrationTools::parseInspectedSlots(getOptionAsString(fParams.getOptions(), fInspectedSlotsKey));
+
+  if ( isOptionSet(fParams.getOptions(), fNumberOfThreadsKey))
+    fNumberOfThreads = std::max(getOptionAsInt(fParams.getOptions(), fNumberOfThreadsKey), 0);
+
   std::ofstream output;
 
   output.open(fOutputFile, std::ios::app); //open the final output file in append mode
@@ -86,36 +95,8 @@ bool InterThresholdCalibration::init()
     output.close();
   }
 
-  //histograms
-
-  for (int lay = 1; lay <= kSl_max.size() + 1; lay++) { // loop over layers
-    for (int sl = 1; sl <= kSl_max[lay - 1]; sl++) { // loop over slots
-      for (int thre = 2; thre <= 4; thre++) { // loop over th diffr times
-	
-//leading
-//histos for side A
-        const char* histo_name_l_A = Form("timeDiffA_leading_layer_%d_slot_%d_thr_1%d", lay, sl, thre);
-        getStatistics().createHistogramWithAxes( new TH1D(histo_name_l_A, histo_name_l_A, 200, -2., 2.),
-                                                            "Time difference A Leading [ns]", "Counts");
-
-//histos for side B
-        const char* histo_name_l_B = Form("timeDiffB_leading_layer_%d_slot_%d_thr_1%d", lay, sl, thre);
-        getStatistics().createHistogramWithAxes( new TH1D(histo_name_l_B, histo_name_l_B, 300, -3., 3.),
-                                                            "Time difference B Leading reference detector [ns]", "Counts");
-
-//trailing
-//histos for side A
-        const char* histo_name_t_A = Form("timeDiffA_trailing_layer_%d_slot_%d_thr_1%d", lay, sl, thre);
-        getStatistics().createHistogramWithAxes( new TH1D(histo_name_t_A, histo_name_t_A, 200, -2., 2.),
-                                                            "Time difference A Trailing [ns]", "Counts");
-	
-//histos for side B
-        const char* histo_name_t_B = Form("timeDiffB_trailing_layer_%d_slot_%d_thr_1%d", lay, sl, thre);
-        getStatistics().createHistogramWithAxes( new TH1D(histo_name_t_B, histo_name_t_B, 300, -3., 3.),
-                                                            "Time difference B Trailing reference detector [ns]", "Counts");
-      }
-    }
-  }
+  //accumulators of time differences, one per layer, slot, threshold, side and edge
+  fAccumulators.reset(new InterThresholdAccumulators(kSl_max));
 
   INFO("#############");
   INFO("CALIB_INIT: INITIALIZATION DONE!");
@@ -126,25 +107,15 @@ bool InterThresholdCalibration::init()
 
 bool InterThresholdCalibration::exec()
 {
-  std::vector <JPetHit> fhitsCalib;
-
   //getting the data from event in propriate format
   if (auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent)) {
     uint n = timeWindow->getNumberOfEvents();
 
     for (uint i = 0; i < n; ++i) {
       const JPetHit& hit = dynamic_cast<const JPetHit&>(timeWindow->operator[](i));
-
-      fhitsCalib.push_back(hit);
-
-    }
-
-    for (auto i = fhitsCalib.begin(); i != fhitsCalib.end(); i++) {
-      fillHistosForHit(*i);
+      fillAccumulatorsForHit(hit);
     }
 
-    fhitsCalib.clear();
-
   } else {
     return false;
   }
@@ -154,129 +125,75 @@ bool InterThresholdCalibration::exec()
 
 bool InterThresholdCalibration::terminate()
 {
+  if (fHitsOutsideSetup > 0) {
+    WARNING("Number of hits with layer or slot outside of the setup, not used in the calibration: " + std::to_string(fHitsOutsideSetup));
+  }
+
+  //peaks of all distributions are estimated at once, in parallel
+  unsigned int numberOfThreads = fNumberOfThreads > 0 ? fNumberOfThreads : std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<InterThresholdPeak> peaks = InterThresholdCalibrationTools::estimatePeaks(*fAccumulators, kPeakWindow, numberOfThreads);
+
   // create output txt file with calibration parameters
   std::ofstream results_fit;
   results_fit.open(fOutputFile, std::ios::app);
 
-  for (int lay = 1; lay <= kSl_max.size() + 1; lay++) { // loop over layers
-    for (int sl = 1; sl <= kSl_max[lay - 1]; sl++) { // loop over slots
+  unsigned long min_ev = std::max(fMin_ev, 0);
+
+  for (int lay = 1; lay <= fAccumulators->getNumberOfLayers(); lay++) { // loop over layers
+    for (int sl = 1; sl <= fAccumulators->getNumberOfSlots(lay); sl++) { // loop over slots
+      if (fInspectedSlots.count(std::make_pair(lay, sl)) > 0) {
+        exportHistograms(lay, sl, peaks);
+      }
       for (int th = 1; th <= 3; th++) { // loop over th diffr times
 
-        //leading
-        //histos for side A
-        const char* histo_name_l_A = Form("timeDiffA_leading_layer_%d_slot_%d_thr_1%d", lay, sl, th + 1);
-        TH1F* histoToSave_leading_A = getStatistics().getHisto1D(histo_name_l_A);
-                
-        //histos for side B
-        const char* histo_name_l_B = Form("timeDiffB_leading_layer_%d_slot_%d_thr_1%d", lay, sl, th + 1);
-        TH1F* histoToSave_leading_B = getStatistics().getHisto1D(histo_name_l_B);
-
-        //trailing
-        //histos for side A
-        const char* histo_name_t_A = Form("timeDiffA_trailing_layer_%d_slot_%d_thr_1%d", lay, sl, th + 1);
-        TH1F* histoToSave_trailing_A = getStatistics().getHisto1D(histo_name_t_A);
-        
-        //histos for side B
-        const char* histo_name_t_B = Form("timeDiffB_trailing_layer_%d_slot_%d_thr_1%d", lay, sl, th + 1);
-        TH1F* histoToSave_trailing_B = getStatistics().getHisto1D(histo_name_t_B);
-        
-	//minimal criteria for histograms
-        if (histoToSave_leading_A->GetEntries() != 0 && histoToSave_leading_B->GetEntries() != 0
-            && histoToSave_trailing_A->GetEntries() != 0 && histoToSave_trailing_B->GetEntries() != 0) {
+        const InterThresholdPeak& peak_l_A = peaks[fAccumulators->getChannel(lay, sl, th, InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kLeading)];
+        const InterThresholdPeak& peak_l_B = peaks[fAccumulators->getChannel(lay, sl, th, InterThresholdAccumulators::kSideB, InterThresholdAccumulators::kLeading)];
+        const InterThresholdPeak& peak_t_A = peaks[fAccumulators->getChannel(lay, sl, th, InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kTrailing)];
+        const InterThresholdPeak& peak_t_B = peaks[fAccumulators->getChannel(lay, sl, th, InterThresholdAccumulators::kSideB, InterThresholdAccumulators::kTrailing)];
+
+	//minimal criteria for distributions
+        if (peak_l_A.entries != 0 && peak_l_B.entries != 0 && peak_t_A.entries != 0 && peak_t_B.entries != 0) {
           INFO("#############");
-          INFO("CALIB_INFO: Fitting histogams for layer= " + std::to_string(lay) + ", slot= " + std::to_string(sl) + ", time diffr threshold= " + std::to_string(th));
+          INFO("CALIB_INFO: Estimated peaks for layer= " + std::to_string(lay) + ", slot= " + std::to_string(sl) + ", time diffr threshold= " + std::to_string(th));
           INFO("#############");
 
-          if (histoToSave_leading_A->GetEntries() <= fMin_ev) {
+          if (peak_l_A.entries <= min_ev) {
             results_fit << "#WARNING: Statistics used to determine the leading edge (A) threshold calibration constant was less than " << fMin_ev << " events!" << endl;
             WARNING(": Statistics used to determine the leading edge (A) threshold calibration constant was less than " + std::to_string(fMin_ev) + " events!");
           }
 
-          if (histoToSave_leading_B->GetEntries() <= fMin_ev) {
+          if (peak_l_B.entries <= min_ev) {
             results_fit << "#WARNING: Statistics used to determine the leading edge (B) threshold calibration constant was less than " << fMin_ev << " events!" << endl;
             WARNING(": Statistics used to determine the leading edge (B) threshold calibration constant was less than " + std::to_string(fMin_ev) + " events!");
           }
 
-          if (histoToSave_trailing_A->GetEntries() <= fMin_ev) {
+          if (peak_t_A.entries <= min_ev) {
             results_fit << "#WARNING: Statistics used to determine the trailing edge (A) threshold calibration constant was less than " << fMin_ev << " events!" << endl;
             WARNING(": Statistics used to determine the trailing edge (A) threshold calibration constant was less than " + std::to_string(fMin_ev) + " events!");
           }
 
-          if (histoToSave_trailing_B->GetEntries() <= fMin_ev) {
+          if (peak_t_B.entries <= min_ev) {
             results_fit << "#WARNING: Statistics used to determine the trailing edge (B) threshold calibration constant was less than " << fMin_ev << " events!" << endl;
             WARNING(": Statistics used to determine the trailing edge (B) threshold calibration constant was less than " + std::to_string(fMin_ev) + " events!");
           }
 
-	  //fit scintilators
-          double highestBin_l_A = histoToSave_leading_A->GetBinCenter(histoToSave_leading_A->GetMaximumBin());
-          histoToSave_leading_A->Fit("gaus", "", "", highestBin_l_A - 0.2, highestBin_l_A + 0.2);
-          histoToSave_leading_A->Draw();
-
-          double highestBin_l_B = histoToSave_leading_B->GetBinCenter(histoToSave_leading_B->GetMaximumBin());
-          histoToSave_leading_B->Fit("gaus", "", "", highestBin_l_B - 0.2, highestBin_l_B + 0.2);
-          histoToSave_leading_B->Draw();
-
-          double highestBin_t_A = histoToSave_trailing_A->GetBinCenter(histoToSave_trailing_A->GetMaximumBin());
-          histoToSave_trailing_A->Fit("gaus", "", "", highestBin_t_A - 0.2, highestBin_t_A + 0.2);
-          histoToSave_trailing_A->Draw();
-
-          double highestBin_t_B = histoToSave_trailing_B->GetBinCenter(histoToSave_trailing_B->GetMaximumBin());
-          histoToSave_trailing_B->Fit("gaus", "", "", highestBin_t_B - 0.2, highestBin_t_B + 0.2);
-          histoToSave_trailing_B->Draw();
-
-          TF1* fit_l_A = histoToSave_leading_A->GetFunction("gaus");
-          TF1* fit_l_B = histoToSave_leading_B->GetFunction("gaus");
-          TF1* fit_t_A = histoToSave_trailing_A->GetFunction("gaus");
-          TF1* fit_t_B = histoToSave_trailing_B->GetFunction("gaus");
-
-          double position_peak_l_A = fit_l_A->GetParameter(1);
-          double position_peak_error_l_A = fit_l_A->GetParError(1);
-          double sigma_peak_l_A = fit_l_A->GetParameter(2);
-          double chi2_ndf_l_A = fit_l_A->GetChisquare() / fit_l_A->GetNDF();
-
-          double position_peak_l_B = fit_l_B->GetParameter(1);
-          double position_peak_error_l_B = fit_l_B->GetParError(1);
-          double sigma_peak_l_B = fit_l_B->GetParameter(2);
-          double chi2_ndf_l_B = fit_l_B->GetChisquare() / fit_l_B->GetNDF();
-
-          double position_peak_t_A = fit_t_A->GetParameter(1);
-          double position_peak_error_t_A = fit_t_A->GetParError(1);
-          double sigma_peak_t_A = fit_t_A->GetParameter(2);
-          double chi2_ndf_t_A = fit_t_A->GetChisquare() / fit_t_A->GetNDF();
-
-          double position_peak_t_B = fit_t_B->GetParameter(1);
-          double position_peak_error_t_B = fit_t_B->GetParError(1);
-          double sigma_peak_t_B = fit_t_B->GetParameter(2);
-          double chi2_ndf_t_B = fit_t_B->GetChisquare() / fit_t_B->GetNDF();
-
-
-          if ((position_peak_error_l_A / position_peak_l_A) >= fFrac_err) {
-            results_fit << "#WFIT: Large uncertainty on the calibration constant!" << endl;
-          }
-
-          if ((position_peak_error_l_B / position_peak_l_B) >= fFrac_err) {
-            results_fit << "#WFIT: Large uncertainty on the calibration constant!" << endl;
-          }
-
-          if ((position_peak_error_t_A / position_peak_t_A) >= fFrac_err) {
-            results_fit << "#WFIT: Large uncertainty on the calibration constant!" << endl;
-          }
-
-          if ((position_peak_error_t_B / position_peak_t_B) >= fFrac_err) {
-            results_fit << "#WFIT: Large uncertainty on the calibration constant!" << endl;
+          for (const auto* peak : {&peak_l_A, &peak_l_B, &peak_t_A, &peak_t_B}) {
+            if ((peak->positionError / peak->position) >= fFrac_err) {
+              results_fit << "#WFIT: Large uncertainty on the calibration constant!" << endl;
+            }
           }
 
 	  // writing to apropriate format (txt file)
 	  //side A
-          results_fit << lay << "\t" << sl << "\t" << "A" << "\t" << th << "\t" << position_peak_l_A << "\t" << position_peak_error_l_A << "\t" << position_peak_t_A << "\t" << position_peak_error_t_A << "\t" << sigma_peak_l_A
-                      << "\t" << sigma_peak_t_A << "\t"  << chi2_ndf_l_A << "\t" << chi2_ndf_t_A << endl;
+          results_fit << lay << "\t" << sl << "\t" << "A" << "\t" << th << "\t" << peak_l_A.position << "\t" << peak_l_A.positionError << "\t" << peak_t_A.position << "\t" << peak_t_A.positionError << "\t" << peak_l_A.sigma
+                      << "\t" << peak_t_A.sigma << "\t"  << peak_l_A.chi2NDF << "\t" << peak_t_A.chi2NDF << endl;
 	  
 	  //side B
-          results_fit << lay << "\t" << sl << "\t" << "B" << "\t" << th << "\t" << position_peak_l_B << "\t" << position_peak_error_l_B << "\t" << position_peak_t_B << "\t" << position_peak_error_t_B << "\t" << sigma_peak_l_B
-                      << "\t" << sigma_peak_t_B << "\t"  << chi2_ndf_l_B << "\t" << chi2_ndf_t_B << endl;
+          results_fit << lay << "\t" << sl << "\t" << "B" << "\t" << th << "\t" << peak_l_B.position << "\t" << peak_l_B.positionError << "\t" << peak_t_B.position << "\t" << peak_t_B.positionError << "\t" << peak_l_B.sigma
+                      << "\t" << peak_t_B.sigma << "\t"  << peak_l_B.chi2NDF << "\t" << peak_t_B.chi2NDF << endl;
 	  
         } else {
-          ERROR(": ONE OF THE HISTOGRAMS FOR THRESHOLD " + std::to_string(th) + " LAYER " + std::to_string(lay) + " SLOT " + std::to_string(sl) + " IS EMPTY, WE CANNOT CALIBRATE IT");
+          ERROR(": ONE OF THE DISTRIBUTIONS FOR THRESHOLD " + std::to_string(th) + " LAYER " + std::to_string(lay) + " SLOT " + std::to_string(sl) + " IS EMPTY, WE CANNOT CALIBRATE IT");
         }
       }
     }
@@ -289,109 +206,63 @@ bool InterThresholdCalibration::terminate()
 
 //////////////////////////////////
 
-void InterThresholdCalibration::fillHistosForHit(const JPetHit& hit)
+void InterThresholdCalibration::fillAccumulatorsForHit(const JPetHit& hit)
 {
-
-  auto lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
-
-  auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
-
-  //take slot number for the hit
+  //take layer and slot number for the hit, slots are numbered from 1 in each layer
   int slot_number = hit.getBarrelSlot().getID();
   int layer_number = hit.getBarrelSlot().getLayer().getID();
-  int slot_nr;
-
-  if (layer_number == 1) slot_nr = slot_number;
-  if (layer_number == 2) slot_nr = slot_number - 48;
-  if (layer_number == 3) slot_nr = slot_number - 96;
-
-  double thr_time_diff_t_A[5], thr_time_diff_A[5];
-  double thr_time_diff_t_B[5], thr_time_diff_B[5];
-  double lead_times_first_A, lead_times_first_B;
-  double trail_times_first_A, trail_times_first_B;
-
-  // leading edge
-
-  // A
-  for (auto& thr_time_pair : lead_times_A) {
-    
-    int thr = thr_time_pair.first;
-
-    if (lead_times_A.count(thr) > 0 && trail_times_A.count(thr) > 0 && lead_times_A.size() == 4 && trail_times_A.size() == 4) { //exactly 4 thresholds
-
-      lead_times_first_A = lead_times_A[1];
-
-      if (thr >= 2) {
-	
-        thr_time_diff_A[thr] = lead_times_A[thr] / 1000 - lead_times_first_A / 1000;
-	
-        char* histo_name_l_A = Form("timeDiffA_leading_layer_%d_slot_%d_thr_1%d", layer_number, slot_nr, thr);
-        getStatistics().fillHistogram(histo_name_l_A, thr_time_diff_A[thr]);
-      }
-    }
+  int slot_nr = slot_number;
+  for (int lay = 1; lay < layer_number && lay <= static_cast<int>(kSl_max.size()); lay++) {
+    slot_nr -= kSl_max[lay - 1];
   }
-  
-  // B
-  for (auto& thr_time_pair : lead_times_B) {
-
-    int thr = thr_time_pair.first;
 
-    if (lead_times_B.count(thr) > 0 && trail_times_B.count(thr) > 0 && lead_times_B.size() == 4 && trail_times_B.size() == 4) {
-
-      lead_times_first_B = lead_times_B[1];
-
-      if (thr >= 2) {
-
-        thr_time_diff_B[thr] = lead_times_B[thr] / 1000 - lead_times_first_B / 1000;
-
-        char* histo_name_l_B = Form("timeDiffB_leading_layer_%d_slot_%d_thr_1%d", layer_number, slot_nr, thr);
-        getStatistics().fillHistogram(histo_name_l_B, thr_time_diff_B[thr]);
-      }
-    }
+  if (!fAccumulators->isInSetup(layer_number, slot_nr)) {
+    fHitsOutsideSetup++;
+    return;
   }
 
+  fillAccumulatorsForSide(hit.getSignalA(), layer_number, slot_nr, InterThresholdAccumulators::kSideA);
+  fillAccumulatorsForSide(hit.getSignalB(), layer_number, slot_nr, InterThresholdAccumulators::kSideB);
+}
 
-  // trailing edge
-  for (auto& thr_time_pair : trail_times_A) {
-
-    int thr = thr_time_pair.first;
-
-    if (trail_times_A.count(thr) > 0 && lead_times_A.count(thr) > 0 && lead_times_A.size() == 4 && trail_times_A.size() == 4) {
-
-      trail_times_first_A = trail_times_A[1];
-
-      if (thr >= 2) {
-
-        thr_time_diff_t_A[thr] = trail_times_A[thr] / 1000 - trail_times_first_A / 1000;
+void InterThresholdCalibration::fillAccumulatorsForSide(const JPetPhysSignal& signal, int layer, int slot, InterThresholdAccumulators::Side side)
+{
+  RawSignalTimes times(signal.getRecoSignal().getRawSignal());
 
-        char* histo_name_t_A = Form("timeDiffA_trailing_layer_%d_slot_%d_thr_1%d", layer_number, slot_nr, thr);
-        getStatistics().fillHistogram(histo_name_t_A, thr_time_diff_t_A[thr]);
-      }
-    }
+  //exactly 4 thresholds on both edges
+  if (times.getNumberOfLeading() != 4 || times.getNumberOfTrailing() != 4) {
+    return;
   }
+  double lead_times_first = times.getLeading(1);
+  double trail_times_first = times.getTrailing(1);
 
+  for (int thr = 2; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    fAccumulators->fill(layer, slot, thr - 1, side, InterThresholdAccumulators::kLeading, times.getLeading(thr) / 1000 - lead_times_first / 1000);
+    fAccumulators->fill(layer, slot, thr - 1, side, InterThresholdAccumulators::kTrailing, times.getTrailing(thr) / 1000 - trail_times_first / 1000);
+  }
+}
 
-  for (auto& thr_time_pair : trail_times_B) {
-
-    int thr = thr_time_pair.first;
-
-    if (trail_times_B.count(thr) > 0 && lead_times_B.count(thr) > 0 && lead_times_B.size() == 4 && trail_times_B.size() == 4) {
-
-
-      trail_times_first_B = trail_times_B[1];
-
-      if (thr >= 2) {
-
-        thr_time_diff_t_B[thr] = trail_times_B[thr] / 1000 - trail_times_first_B / 1000;
-
-        char* histo_name_t_B = Form("timeDiffB_trailing_layer_%d_slot_%d_thr_1%d", layer_number, slot_nr, thr);
-        getStatistics().fillHistogram(histo_name_t_B, thr_time_diff_t_B[thr]);
+void InterThresholdCalibration::exportHistograms(int layer, int slot, const std::vector<InterThresholdPeak>& peaks)
+{
+  for (int thr = 2; thr <= 4; thr++) {
+    for (auto side : {InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kSideB}) {
+      for (auto edge : {InterThresholdAccumulators::kLeading, InterThresholdAccumulators::kTrailing}) {
+        std::size_t channel = fAccumulators->getChannel(layer, slot, thr - 1, side, edge);
+        int bins = InterThresholdAccumulators::getNumberOfBins(side);
+        std::string sideName = side == InterThresholdAccumulators::kSideA ? "A" : "B";
+        std::string edgeName = edge == InterThresholdAccumulators::kLeading ? "leading" : "trailing";
+        std::string histo_name = Form("timeDiff%s_%s_layer_%d_slot_%d_thr_1%d", sideName.c_str(), edgeName.c_str(), layer, slot, thr);
+        TH1D* histo = new TH1D(histo_name.c_str(), histo_name.c_str(), bins, InterThresholdAccumulators::getRangeMin(side),
+                               InterThresholdAccumulators::getRangeMax(side));
+        const unsigned int* counts = fAccumulators->getCounts(channel);
+        for (int bin = 0; bin < bins; bin++) {
+          histo->SetBinContent(bin + 1, counts[bin]);
+        }
+        histo->SetEntries(peaks[channel].entries);
+        getStatistics().createHistogramWithAxes(histo, Form("Time difference %s %s [ns]", sideName.c_str(), edgeName.c_str()), "Counts");
       }
     }
   }
-  
 }
 
 
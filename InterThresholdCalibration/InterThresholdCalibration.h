@@ -20,7 +20,18 @@
 #include <JPetRawSignal/JPetRawSignal.h>
 #include <JPetGeomMapping/JPetGeomMapping.h>
 #include <JPetTimer/JPetTimer.h>
+#include "InterThresholdCalibrationTools.h"
+#include <memory>
+#include <set>
 class JPetWriter;
+/**
+ * @brief User Task calculating time offsets between thresholds
+ *
+ * Time differences between thresholds 2-4 and threshold 1 are accumulated for each layer, slot, side and edge
+ * in fixed-bin arrays, bounded by the number of slots in the setup. In terminate the peak of each distribution
+ * is estimated in parallel and the calibration constants are appended to the output file.
+ * Histograms are created only for the slots listed in InterThresholdCalibration_InspectedSlots_std::string option.
+ */
 class InterThresholdCalibration: public JPetUserTask
 {
 public:
@@ -31,7 +42,9 @@ public:
   virtual bool terminate()override;
 protected:
   const char* formatUniqueSlotDescription(const JPetBarrelSlot& slot, int threshold, const char* prefix);
-  void fillHistosForHit(const JPetHit& hit);
+  void fillAccumulatorsForHit(const JPetHit& hit);
+  void fillAccumulatorsForSide(const JPetPhysSignal& signal, int layer, int slot, InterThresholdAccumulators::Side side);
+  void exportHistograms(int layer, int slot, const std::vector<InterThresholdPeak>& peaks);
   JPetGeomMapping* fBarrelMap = nullptr;
   std::string fOutputFile = "TimeConstantsInterThrCalib.txt";
   const std::string fOutputFileKey = "InterThresholdCalibration_TimeConstantsInterThrCalibOutputFile_std::string";
@@ -41,9 +54,14 @@ protected:
   const std::string fFrac_errKey = "InterThresholdCalibration_Frac_err_double";
   int fMin_ev = 100;     //minimal number of events for a distribution to be fitted
   const std::string fMin_evKey = "InterThresholdCalibration_Min_ev_int";
-  std::vector<double> kSl_max; //amount of slots per each layer
-  double fThr_time_diff_t_A[5], fThr_time_diff_A[5];
-  double fThr_time_diff_t_B[5], fThr_time_diff_B[5];
+  const std::string fInspectedSlotsKey = "InterThresholdCalibration_InspectedSlots_std::string";
+  std::set<std::pair<int, int>> fInspectedSlots; //layer and slot pairs, for which histograms are saved
+  const std::string fNumberOfThreadsKey = "InterThresholdCalibration_NumberOfThreads_int";
+  unsigned int fNumberOfThreads = 0; //0 means all available hardware threads
+  const double kPeakWindow = 0.2; //half width of the window around peak used for estimation [ns]
+  std::vector<int> kSl_max; //amount of slots per each layer
+  std::unique_ptr<InterThresholdAccumulators> fAccumulators;
+  unsigned long fHitsOutsideSetup = 0;
 
 };
 #endif /*  !InterThresholdCalibration_H */
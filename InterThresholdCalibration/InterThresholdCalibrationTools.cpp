@@ -0,0 +1,211 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file InterThresholdCalibrationTools.cpp
+ */
+
+#include "InterThresholdCalibrationTools.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <thread>
+
+InterThresholdAccumulators::InterThresholdAccumulators(const std::vector<int>& slotsPerLayer) : fSlotsPerLayer(slotsPerLayer)
+{
+  int numberOfSlots = 0;
+  for (auto slots : fSlotsPerLayer)
+  {
+    fSlotOffsets.push_back(numberOfSlots);
+    numberOfSlots += std::max(slots, 0);
+  }
+  const std::size_t numberOfChannels = numberOfSlots * kNumberOfThresholdDiffs * 4;
+  fEntries.assign(numberOfChannels, 0);
+  fCounts.assign(numberOfChannels * kMaxNumberOfBins, 0);
+}
+
+bool InterThresholdAccumulators::isInSetup(int layer, int slot) const
+{
+  return layer >= 1 && layer <= getNumberOfLayers() && slot >= 1 && slot <= fSlotsPerLayer[layer - 1];
+}
+
+std::size_t InterThresholdAccumulators::getChannel(int layer, int slot, int thrDiff, Side side, Edge edge) const
+{
+  const std::size_t slotIndex = fSlotOffsets[layer - 1] + slot - 1;
+  return ((slotIndex * kNumberOfThresholdDiffs + thrDiff - 1) * 2 + side) * 2 + edge;
+}
+
+bool InterThresholdAccumulators::fill(int layer, int slot, int thrDiff, Side side, Edge edge, double timeDiff)
+{
+  if (!isInSetup(layer, slot) || thrDiff < 1 || thrDiff > kNumberOfThresholdDiffs)
+  {
+    return false;
+  }
+  fill(getChannel(layer, slot, thrDiff, side, edge), timeDiff);
+  return true;
+}
+
+void InterThresholdAccumulators::fill(std::size_t channel, double timeDiff)
+{
+  const Side side = getSide(channel);
+  const double rangeMin = getRangeMin(side);
+  const int numberOfBins = getNumberOfBins(side);
+  fEntries[channel]++;
+  const double bin = std::floor((timeDiff - rangeMin) / (getRangeMax(side) - rangeMin) * numberOfBins);
+  if (bin >= 0.0 && bin < numberOfBins)
+  {
+    fCounts[channel * kMaxNumberOfBins + static_cast<int>(bin)]++;
+  }
+}
+
+InterThresholdPeak InterThresholdCalibrationTools::estimatePeak(const unsigned int* counts, int numberOfBins, double rangeMin, double rangeMax,
+                                                                double window)
+{
+  InterThresholdPeak peak;
+  if (numberOfBins <= 0)
+  {
+    return peak;
+  }
+  const double binWidth = (rangeMax - rangeMin) / numberOfBins;
+  const int maxBin = std::max_element(counts, counts + numberOfBins) - counts;
+  if (counts[maxBin] == 0)
+  {
+    return peak;
+  }
+  double center = rangeMin + (maxBin + 0.5) * binWidth;
+  double sum = 0.0, sumX = 0.0, sumX2 = 0.0;
+  // half-width of the range of summed bins, whole bins containing the window edges are included
+  double summedWindow = window;
+  for (int iteration = 0; iteration < kMaxNumberOfIterations; iteration++)
+  {
+    sum = 0.0;
+    sumX = 0.0;
+    sumX2 = 0.0;
+    const int firstBin = std::max(0, static_cast<int>(std::floor((center - window - rangeMin) / binWidth)));
+    const int lastBin = std::min(numberOfBins - 1, static_cast<int>(std::floor((center + window - rangeMin) / binWidth)));
+    summedWindow = 0.5 * (lastBin + 1 - firstBin) * binWidth;
+    for (int bin = firstBin; bin <= lastBin; bin++)
+    {
+      const double x = rangeMin + (bin + 0.5) * binWidth;
+      sum += counts[bin];
+      sumX += counts[bin] * x;
+      sumX2 += counts[bin] * x * x;
+    }
+    if (sum == 0.0)
+    {
+      return peak;
+    }
+    const double mean = sumX / sum;
+    const bool converged = std::fabs(mean - center) < 1e-3 * binWidth;
+    center = mean;
+    if (converged)
+    {
+      break;
+    }
+  }
+  peak.position = center;
+  // RMS in the window underestimates sigma of the gaussian cut at +-window, it is corrected
+  // with the variance of the truncated gaussian: 1 - 2k * phi(k) / erf(k / sqrt(2)), k = window / sigma,
+  // where the window is the one actually summed, otherwise narrow windows overestimate sigma
+  const double rms = std::sqrt(std::max(sumX2 / sum - center * center, 0.0));
+  double windowFraction = 1.0;
+  peak.sigma = rms;
+  for (int iteration = 0; iteration < kMaxNumberOfIterations && peak.sigma > 0.0; iteration++)
+  {
+    const double k = summedWindow / peak.sigma;
+    windowFraction = std::erf(k / std::sqrt(2.0));
+    const double varianceRatio = 1.0 - 2.0 * k * std::exp(-0.5 * k * k) / std::sqrt(2.0 * M_PI) / windowFraction;
+    if (varianceRatio < kMinVarianceRatio)
+    {
+      break;
+    }
+    peak.sigma = rms / std::sqrt(varianceRatio);
+  }
+  peak.positionError = peak.sigma / std::sqrt(sum);
+  if (peak.sigma > 0.0)
+  {
+    const double amplitude = sum / windowFraction * binWidth / (peak.sigma * std::sqrt(2.0 * M_PI));
+    double chi2 = 0.0;
+    int usedBins = 0;
+    const int firstBin = std::max(0, static_cast<int>(std::floor((center - window - rangeMin) / binWidth)));
+    const int lastBin = std::min(numberOfBins - 1, static_cast<int>(std::floor((center + window - rangeMin) / binWidth)));
+    for (int bin = firstBin; bin <= lastBin; bin++)
+    {
+      if (counts[bin] == 0)
+      {
+        continue;
+      }
+      const double x = (rangeMin + (bin + 0.5) * binWidth - center) / peak.sigma;
+      const double expected = amplitude * std::exp(-0.5 * x * x);
+      chi2 += (counts[bin] - expected) * (counts[bin] - expected) / counts[bin];
+      usedBins++;
+    }
+    if (usedBins > 3)
+    {
+      peak.chi2NDF = chi2 / (usedBins - 3);
+    }
+  }
+  return peak;
+}
+
+std::vector<InterThresholdPeak> InterThresholdCalibrationTools::estimatePeaks(const InterThresholdAccumulators& accumulators, double window,
+                                                                            unsigned int numberOfThreads)
+{
+  const std::size_t numberOfChannels = accumulators.getNumberOfChannels();
+  std::vector<InterThresholdPeak> peaks(numberOfChannels);
+  auto estimateRange = [&accumulators, &peaks, window](std::size_t first, std::size_t last) {
+    for (std::size_t channel = first; channel < last; channel++)
+    {
+      const auto side = InterThresholdAccumulators::getSide(channel);
+      peaks[channel] = estimatePeak(accumulators.getCounts(channel), InterThresholdAccumulators::getNumberOfBins(side),
+                                    InterThresholdAccumulators::getRangeMin(side), InterThresholdAccumulators::getRangeMax(side), window);
+      peaks[channel].entries = accumulators.getEntries(channel);
+    }
+  };
+  numberOfThreads = std::max(1u, std::min<unsigned int>(numberOfThreads, numberOfChannels));
+  if (numberOfThreads == 1)
+  {
+    estimateRange(0, numberOfChannels);
+    return peaks;
+  }
+  std::vector<std::thread> workers;
+  const std::size_t channelsPerThread = (numberOfChannels + numberOfThreads - 1) / numberOfThreads;
+  for (std::size_t first = 0; first < numberOfChannels; first += channelsPerThread)
+  {
+    workers.emplace_back(estimateRange, first, std::min(first + channelsPerThread, numberOfChannels));
+  }
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+  return peaks;
+}
+
+std::set<std::pair<int, int>> InterThresholdCalibrationTools::parseInspectedSlots(const std::string& slots)
+{
+  std::set<std::pair<int, int>> inspectedSlots;
+  std::string normalized = slots;
+  std::replace(normalized.begin(), normalized.end(), ',', ' ');
+  std::istringstream stream(normalized);
+  std::string item;
+  while (stream >> item)
+  {
+    int layer = 0, slot = 0;
+    char separator = 0;
+    std::istringstream itemStream(item);
+    // items with anything after the slot number, e.g. "1:2:3", are malformed as well
+    if (itemStream >> layer >> separator >> slot && separator == ':' && (itemStream >> std::ws).eof())
+    {
+      inspectedSlots.emplace(layer, slot);
+    }
+  }
+  return inspectedSlots;
+}
@@ -0,0 +1,116 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file InterThresholdCalibrationTools.h
+ */
+
+#ifndef INTERTHRESHOLDCALIBRATIONTOOLS_H
+#define INTERTHRESHOLDCALIBRATIONTOOLS_H
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Result of the peak estimation of a single time difference distribution
+ */
+struct InterThresholdPeak
+{
+  double position = 0.0;      ///< [ns]
+  double positionError = 0.0; ///< [ns]
+  double sigma = 0.0;         ///< [ns]
+  double chi2NDF = 0.0;       ///< of the gaussian with estimated parameters, calculated in the peak window
+  unsigned long entries = 0;  ///< all filled values, including the ones outside of the histogram range
+};
+
+/**
+ * @brief Fixed-bin accumulators of threshold time differences
+ *
+ * One distribution (channel) is kept for each layer, slot, threshold difference (t2-t1, t3-t1, t4-t1),
+ * side and edge, all of them in a single contiguous array. Number of channels is defined by the setup
+ * geometry: number of slots in each layer. Layers and slots are numbered from 1.
+ * Binning follows the control histograms used before: 200 bins in [-2, 2] ns for side A
+ * and 300 bins in [-3, 3] ns for side B.
+ */
+class InterThresholdAccumulators
+{
+public:
+  enum Side
+  {
+    kSideA = 0,
+    kSideB = 1
+  };
+  enum Edge
+  {
+    kLeading = 0,
+    kTrailing = 1
+  };
+  static const int kNumberOfThresholdDiffs = 3;
+
+  explicit InterThresholdAccumulators(const std::vector<int>& slotsPerLayer);
+
+  bool isInSetup(int layer, int slot) const;
+  /// thrDiff is 1 for t2-t1, 2 for t3-t1 and 3 for t4-t1, layer and slot have to be in the setup
+  std::size_t getChannel(int layer, int slot, int thrDiff, Side side, Edge edge) const;
+  /// Time differences of channels outside of the setup are ignored, returns false for them
+  bool fill(int layer, int slot, int thrDiff, Side side, Edge edge, double timeDiff);
+  void fill(std::size_t channel, double timeDiff);
+
+  std::size_t getNumberOfChannels() const { return fEntries.size(); }
+  int getNumberOfLayers() const { return fSlotsPerLayer.size(); }
+  int getNumberOfSlots(int layer) const { return fSlotsPerLayer.at(layer - 1); }
+  const unsigned int* getCounts(std::size_t channel) const { return &fCounts[channel * kMaxNumberOfBins]; }
+  unsigned long getEntries(std::size_t channel) const { return fEntries[channel]; }
+
+  static Side getSide(std::size_t channel) { return static_cast<Side>((channel / 2) % 2); }
+  static int getNumberOfBins(Side side) { return side == kSideA ? 200 : 300; }
+  static double getRangeMin(Side side) { return side == kSideA ? -2.0 : -3.0; }
+  static double getRangeMax(Side side) { return side == kSideA ? 2.0 : 3.0; }
+
+private:
+  static const int kMaxNumberOfBins = 300;
+  std::vector<int> fSlotsPerLayer;
+  std::vector<int> fSlotOffsets;
+  std::vector<unsigned int> fCounts;
+  std::vector<unsigned long> fEntries;
+};
+
+/**
+ * @brief Tools for InterThresholdCalibration module
+ *
+ * Peak of each time difference distribution is estimated without fitting:
+ * starting from the highest bin, mean of the bins in the window around the peak is iterated
+ * until it converges, sigma is the RMS in that window corrected for the truncation of the gaussian tails.
+ * The estimation is independent for each channel, so all channels are processed in parallel.
+ */
+class InterThresholdCalibrationTools
+{
+public:
+  static InterThresholdPeak estimatePeak(const unsigned int* counts, int numberOfBins, double rangeMin, double rangeMax, double window);
+  static std::vector<InterThresholdPeak> estimatePeaks(const InterThresholdAccumulators& accumulators, double window, unsigned int numberOfThreads);
+  /// Parses list of "layer:slot" pairs separated with commas or spaces, e.g. "1:12, 3:40", malformed items are skipped
+  static std::set<std::pair<int, int>> parseInspectedSlots(const std::string& slots);
+
+  static const int kMaxNumberOfIterations = 10;
+  /// Below this ratio the distribution is too wide for the window and sigma is not corrected
+  static constexpr double kMinVarianceRatio = 0.1;
+
+private:
+  InterThresholdCalibrationTools() = delete;
+  ~InterThresholdCalibrationTools() = delete;
+  InterThresholdCalibrationTools(const InterThresholdCalibrationTools&) = delete;
+  InterThresholdCalibrationTools& operator=(const InterThresholdCalibrationTools&) = delete;
+};
+
+#endif /* !INTERTHRESHOLDCALIBRATIONTOOLS_H */
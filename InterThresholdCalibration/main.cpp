@@ -18,6 +18,8 @@
 #include "../LargeBarrelAnalysis/SignalFinder.h"
 #include "../LargeBarrelAnalysis/SignalTransformer.h"
 #include "../LargeBarrelAnalysis/HitFinder.h"
+#include "../LargeBarrelAnalysis/ReadAheadTools.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include "InterThresholdCalibration.h"
 using namespace std;
 
@@ -26,11 +28,11 @@ int main(int argc, const char* argv[])
   try {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer"); 
-    manager.registerTask<HitFinder>("HitFinder"); 
-    manager.registerTask<InterThresholdCalibration>("InterThresholdCalibration"); 
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer"); 
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder"); 
+    manager.registerTask<InstrumentedTask<InterThresholdCalibration>>("InterThresholdCalibration"); 
   
     manager.useTask("TimeWindowCreator", "hld", "tslot.calib");
     manager.useTask("SignalFinder", "tslot.calib", "raw.sig");
@@ -38,6 +40,8 @@ int main(int argc, const char* argv[])
     manager.useTask("HitFinder", "phys.sig", "hits");
     manager.useTask("InterThresholdCalibration", "hits", "hits.calib");
 
+    ReadAheadTools::enableReadAhead(ReadAheadTools::readSettings(argc, argv));
+
     manager.run(argc, argv);
   } catch (const std::exception& except) {
     std::cerr << "Unrecoverable error occured:" << except.what() << "Exiting the program!" << std::endl;
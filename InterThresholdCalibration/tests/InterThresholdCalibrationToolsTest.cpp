@@ -0,0 +1,171 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file InterThresholdCalibrationToolsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE InterThresholdCalibrationToolsTest
+
+#include "../InterThresholdCalibrationTools.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+namespace
+{
+/// Counts of a gaussian with given number of entries, integrated over each bin
+std::vector<unsigned int> gaussianCounts(int numberOfBins, double rangeMin, double rangeMax, double mu, double sigma, double entries)
+{
+  std::vector<unsigned int> counts(numberOfBins, 0);
+  const double binWidth = (rangeMax - rangeMin) / numberOfBins;
+  auto cdf = [mu, sigma](double x) { return 0.5 * std::erfc(-(x - mu) / (sigma * std::sqrt(2.0))); };
+  for (int bin = 0; bin < numberOfBins; bin++)
+  {
+    const double low = rangeMin + bin * binWidth;
+    counts[bin] = std::lround(entries * (cdf(low + binWidth) - cdf(low)));
+  }
+  return counts;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(InterThresholdCalibrationToolsTestSuite)
+
+BOOST_AUTO_TEST_CASE(estimatePeakGaussianTest)
+{
+  const double mu = 0.3, sigma = 0.1;
+  auto counts = gaussianCounts(200, -2.0, 2.0, mu, sigma, 1e5);
+
+  auto peak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 200, -2.0, 2.0, 3.0 * sigma);
+  BOOST_REQUIRE_SMALL(peak.position - mu, 1e-3);
+  BOOST_REQUIRE_CLOSE(peak.sigma, sigma, 2.0);
+  BOOST_REQUIRE_CLOSE(peak.positionError, sigma / std::sqrt(1e5), 5.0);
+  BOOST_REQUIRE_LT(peak.chi2NDF, 1.0);
+
+  // Narrow window truncates the tails, sigma is corrected for it
+  auto narrowPeak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 200, -2.0, 2.0, 1.5 * sigma);
+  BOOST_REQUIRE_SMALL(narrowPeak.position - mu, 1e-3);
+  BOOST_REQUIRE_CLOSE(narrowPeak.sigma, sigma, 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(estimatePeakEmptyTest)
+{
+  std::vector<unsigned int> counts(200, 0);
+  auto peak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 200, -2.0, 2.0, 0.3);
+  BOOST_REQUIRE_EQUAL(peak.position, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.positionError, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.sigma, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.chi2NDF, 0.0);
+
+  peak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 0, -2.0, 2.0, 0.3);
+  BOOST_REQUIRE_EQUAL(peak.position, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.sigma, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(estimatePeakLowStatisticsTest)
+{
+  std::vector<unsigned int> counts(200, 0);
+  counts[120] = 1;
+  auto peak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 200, -2.0, 2.0, 0.3);
+  BOOST_REQUIRE_CLOSE(peak.position, 0.41, 1e-6);
+  BOOST_REQUIRE_EQUAL(peak.sigma, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.positionError, 0.0);
+  BOOST_REQUIRE_EQUAL(peak.chi2NDF, 0.0);
+
+  counts[121] = 2;
+  counts[123] = 1;
+  peak = InterThresholdCalibrationTools::estimatePeak(counts.data(), 200, -2.0, 2.0, 0.3);
+  BOOST_REQUIRE_CLOSE(peak.position, (0.41 + 2 * 0.43 + 0.47) / 4.0, 1e-6);
+  BOOST_REQUIRE(std::isfinite(peak.sigma));
+  BOOST_REQUIRE_GT(peak.sigma, 0.0);
+  BOOST_REQUIRE(std::isfinite(peak.positionError));
+  // Too few bins for the goodness of fit
+  BOOST_REQUIRE_EQUAL(peak.chi2NDF, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(estimatePeaksTest)
+{
+  InterThresholdAccumulators accumulators({2, 1});
+  BOOST_REQUIRE_EQUAL(accumulators.getNumberOfChannels(), 3u * InterThresholdAccumulators::kNumberOfThresholdDiffs * 4);
+  BOOST_REQUIRE(!accumulators.fill(3, 1, 1, InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kLeading, 0.0));
+  BOOST_REQUIRE(!accumulators.fill(2, 2, 1, InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kLeading, 0.0));
+  BOOST_REQUIRE(!accumulators.fill(1, 1, 4, InterThresholdAccumulators::kSideA, InterThresholdAccumulators::kLeading, 0.0));
+
+  const double mu = -0.5, sigma = 0.15;
+  std::mt19937 generator(12345);
+  std::normal_distribution<double> distribution(mu, sigma);
+  for (int i = 0; i < 20000; i++)
+  {
+    BOOST_REQUIRE(accumulators.fill(2, 1, 2, InterThresholdAccumulators::kSideB, InterThresholdAccumulators::kTrailing, distribution(generator)));
+  }
+  // Outside of the histogram range, counted only in entries
+  accumulators.fill(2, 1, 2, InterThresholdAccumulators::kSideB, InterThresholdAccumulators::kTrailing, 10.0);
+
+  const auto channel = accumulators.getChannel(2, 1, 2, InterThresholdAccumulators::kSideB, InterThresholdAccumulators::kTrailing);
+  auto peaks = InterThresholdCalibrationTools::estimatePeaks(accumulators, 3.0 * sigma, 1);
+  BOOST_REQUIRE_EQUAL(peaks.size(), accumulators.getNumberOfChannels());
+  BOOST_REQUIRE_EQUAL(peaks[channel].entries, 20001u);
+  BOOST_REQUIRE_SMALL(peaks[channel].position - mu, 5.0 * sigma / std::sqrt(20000.0));
+  BOOST_REQUIRE_CLOSE(peaks[channel].sigma, sigma, 3.0);
+  for (std::size_t other = 0; other < peaks.size(); other++)
+  {
+    if (other != channel)
+    {
+      BOOST_REQUIRE_EQUAL(peaks[other].entries, 0u);
+      BOOST_REQUIRE_EQUAL(peaks[other].sigma, 0.0);
+    }
+  }
+
+  // Result does not depend on the number of threads
+  for (unsigned int threads : {2u, 4u, 1000u})
+  {
+    auto parallelPeaks = InterThresholdCalibrationTools::estimatePeaks(accumulators, 3.0 * sigma, threads);
+    BOOST_REQUIRE_EQUAL(parallelPeaks.size(), peaks.size());
+    for (std::size_t i = 0; i < peaks.size(); i++)
+    {
+      BOOST_REQUIRE_EQUAL(parallelPeaks[i].position, peaks[i].position);
+      BOOST_REQUIRE_EQUAL(parallelPeaks[i].sigma, peaks[i].sigma);
+      BOOST_REQUIRE_EQUAL(parallelPeaks[i].entries, peaks[i].entries);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(estimatePeaksEmptySetupTest)
+{
+  InterThresholdAccumulators accumulators(std::vector<int>{});
+  BOOST_REQUIRE(InterThresholdCalibrationTools::estimatePeaks(accumulators, 0.3, 4).empty());
+}
+
+BOOST_AUTO_TEST_CASE(parseInspectedSlotsTest)
+{
+  auto slots = InterThresholdCalibrationTools::parseInspectedSlots("1:12, 3:40");
+  BOOST_REQUIRE_EQUAL(slots.size(), 2u);
+  BOOST_REQUIRE_EQUAL(slots.count(std::make_pair(1, 12)), 1u);
+  BOOST_REQUIRE_EQUAL(slots.count(std::make_pair(3, 40)), 1u);
+
+  slots = InterThresholdCalibrationTools::parseInspectedSlots(" 2:5,,2:5  1:1,");
+  BOOST_REQUIRE_EQUAL(slots.size(), 2u);
+  BOOST_REQUIRE_EQUAL(slots.count(std::make_pair(2, 5)), 1u);
+  BOOST_REQUIRE_EQUAL(slots.count(std::make_pair(1, 1)), 1u);
+
+  BOOST_REQUIRE(InterThresholdCalibrationTools::parseInspectedSlots("").empty());
+  BOOST_REQUIRE(InterThresholdCalibrationTools::parseInspectedSlots(" , ").empty());
+}
+
+BOOST_AUTO_TEST_CASE(parseMalformedInspectedSlotsTest)
+{
+  auto slots = InterThresholdCalibrationTools::parseInspectedSlots("abc, 1-2, 3:, :4, 1:2:3, 7:8x, 5:6");
+  BOOST_REQUIRE_EQUAL(slots.size(), 1u);
+  BOOST_REQUIRE_EQUAL(slots.count(std::make_pair(5, 6)), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
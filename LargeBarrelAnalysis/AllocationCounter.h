@@ -0,0 +1,100 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AllocationCounter.h
+ */
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Counter of allocations of the buffers that tasks keep between time windows
+ *
+ * Tasks keep their temporary containers as members and only clear them in each time window,
+ * so the containers keep their capacity. Buffers should be filled through this class, which counts
+ * every time a buffer has to grow or a new buffer has to be created, so after the first few windows
+ * the number of allocations per window is expected to drop to zero.
+ * Allocations made inside of stored objects are not counted.
+ */
+class AllocationCounter
+{
+public:
+  void startWindow() { fWindowAllocations = 0; }
+  void finishWindow()
+  {
+    fTotalAllocations += fWindowAllocations;
+    fMaxWindowAllocations = std::max(fMaxWindowAllocations, fWindowAllocations);
+    fNumberOfWindows++;
+  }
+
+  template <class T, class Value>
+  void pushBack(std::vector<T>& buffer, Value&& value)
+  {
+    if (buffer.size() == buffer.capacity())
+    {
+      fWindowAllocations++;
+    }
+    buffer.push_back(std::forward<Value>(value));
+  }
+
+  /// Buffer assigned to the key, created if it is the first use of the key
+  template <class Key, class T>
+  std::vector<T>& getBuffer(std::map<Key, std::vector<T>>& buffers, const Key& key)
+  {
+    auto search = buffers.find(key);
+    if (search == buffers.end())
+    {
+      fWindowAllocations++;
+      search = buffers.emplace(key, std::vector<T>()).first;
+    }
+    return search->second;
+  }
+
+  /// Empties all buffers, keys and capacities are kept for the next time window
+  template <class Key, class T>
+  static void clearBuffers(std::map<Key, std::vector<T>>& buffers)
+  {
+    for (auto& buffer : buffers)
+    {
+      buffer.second.clear();
+    }
+  }
+
+  unsigned long getWindowAllocations() const { return fWindowAllocations; }
+  unsigned long getTotalAllocations() const { return fTotalAllocations; }
+  unsigned long getMaxWindowAllocations() const { return fMaxWindowAllocations; }
+  unsigned long getNumberOfWindows() const { return fNumberOfWindows; }
+  double getMeanWindowAllocations() const { return fNumberOfWindows > 0 ? static_cast<double>(fTotalAllocations) / fNumberOfWindows : 0.0; }
+
+  std::string getSummary() const
+  {
+    std::ostringstream summary;
+    summary << "buffer allocations: " << fTotalAllocations << " in " << fNumberOfWindows << " time windows, mean per window "
+            << getMeanWindowAllocations() << ", max per window " << fMaxWindowAllocations << ", in last window " << fWindowAllocations;
+    return summary.str();
+  }
+
+private:
+  unsigned long fWindowAllocations = 0;
+  unsigned long fTotalAllocations = 0;
+  unsigned long fMaxWindowAllocations = 0;
+  unsigned long fNumberOfWindows = 0;
+};
+
+#endif /* !ALLOCATIONCOUNTER_H */
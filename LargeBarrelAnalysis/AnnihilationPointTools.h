@@ -0,0 +1,135 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file AnnihilationPointTools.h
+ */
+
+#ifndef ANNIHILATIONPOINTTOOLS_H
+#define ANNIHILATIONPOINTTOOLS_H
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Hits of many LORs, e.g. of all 2-gamma events of a time window, stored as structure of arrays
+ *
+ * Positions in cm, times in ps.
+ */
+struct LORBatch
+{
+  std::vector<double> firstX, firstY, firstZ, firstTime;
+  std::vector<double> secondX, secondY, secondZ, secondTime;
+
+  std::size_t size() const { return firstX.size(); }
+
+  void clear()
+  {
+    for (auto column : {&firstX, &firstY, &firstZ, &firstTime, &secondX, &secondY, &secondZ, &secondTime})
+    {
+      column->clear();
+    }
+  }
+
+  void addLOR(double x1, double y1, double z1, double time1, double x2, double y2, double z2, double time2)
+  {
+    firstX.push_back(x1);
+    firstY.push_back(y1);
+    firstZ.push_back(z1);
+    firstTime.push_back(time1);
+    secondX.push_back(x2);
+    secondY.push_back(y2);
+    secondZ.push_back(z2);
+    secondTime.push_back(time2);
+  }
+};
+
+/**
+ * @brief Annihilation points [cm] and TOFs [ps] of the LORs of LORBatch, with the same indices
+ */
+struct AnnihilationPointBatch
+{
+  std::vector<double> x, y, z, tof;
+
+  std::size_t size() const { return x.size(); }
+
+  void resize(std::size_t size)
+  {
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    tof.resize(size);
+  }
+};
+
+/**
+ * @brief Calculation of annihilation points and TOFs of LORs
+ *
+ * Annihilation point lies on the LOR, shifted from its middle towards the second hit by half of
+ * the distance travelled by light in the TOF, where TOF = first time - second time.
+ * The single LOR calculation is shared by EventCategorizerTools::calculateAnnihilationPoint and
+ * the batch one, which processes all LORs in one loop over contiguous arrays without branches,
+ * so it can be vectorized by the compiler and gives the same results as calls for single LORs.
+ */
+class AnnihilationPointTools
+{
+public:
+  static constexpr double kLightVelocity_cm_ps = 0.0299792458;
+
+  static double calculateTOF(double time1, double time2) { return time1 - time2; }
+
+  static void calculateAnnihilationPoint(double x1, double y1, double z1, double x2, double y2, double z2, double tof, double& x, double& y,
+                                         double& z)
+  {
+    const double dx = x2 - x1;
+    const double dy = y2 - y1;
+    const double dz = z2 - z1;
+    // For hits in the same point the direction of the LOR is undefined and the middle is returned
+    const double length2 = dx * dx + dy * dy + dz * dz;
+    const double inverseLength = length2 > 0.0 ? 1.0 / std::sqrt(length2) : 1.0;
+    const double shift = 0.5 * tof * kLightVelocity_cm_ps;
+    x = 0.5 * (x1 + x2) + shift * (dx * inverseLength);
+    y = 0.5 * (y1 + y2) + shift * (dy * inverseLength);
+    z = 0.5 * (z1 + z2) + shift * (dz * inverseLength);
+  }
+
+  static void calculateAnnihilationPoints(const LORBatch& lors, AnnihilationPointBatch& points)
+  {
+    const std::size_t size = lors.size();
+    points.resize(size);
+    const double* x1 = lors.firstX.data();
+    const double* y1 = lors.firstY.data();
+    const double* z1 = lors.firstZ.data();
+    const double* time1 = lors.firstTime.data();
+    const double* x2 = lors.secondX.data();
+    const double* y2 = lors.secondY.data();
+    const double* z2 = lors.secondZ.data();
+    const double* time2 = lors.secondTime.data();
+    double* x = points.x.data();
+    double* y = points.y.data();
+    double* z = points.z.data();
+    double* tof = points.tof.data();
+    for (std::size_t i = 0; i < size; i++)
+    {
+      tof[i] = calculateTOF(time1[i], time2[i]);
+      calculateAnnihilationPoint(x1[i], y1[i], z1[i], x2[i], y2[i], z2[i], tof[i], x[i], y[i], z[i]);
+    }
+  }
+
+private:
+  AnnihilationPointTools() = delete;
+  ~AnnihilationPointTools() = delete;
+  AnnihilationPointTools(const AnnihilationPointTools&) = delete;
+  AnnihilationPointTools& operator=(const AnnihilationPointTools&) = delete;
+};
+
+#endif /* !ANNIHILATIONPOINTTOOLS_H */
@@ -0,0 +1,368 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file CalibrationStore.cpp
+ */
+
+#include "CalibrationStore.h"
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const std::string CalibrationStore::kIndexFileName = "index.txt";
+const unsigned int CalibrationStore::kMaxNumberOfChannels = 1 << 20;
+
+namespace
+{
+const char kTableMagic[8] = {'J', 'P', 'E', 'T', 'C', 'A', 'L', '1'};
+
+struct TableHeader
+{
+  char magic[8];
+  std::uint32_t numberOfChannels;
+  std::uint32_t numberOfParameters;
+};
+
+const char* kIndexHeader = "# name\tgeometry\tfirstRun\tlastRun\ttableFile\tcreated\tsource\tcomment";
+const char* kAnyGeometry = "*";
+
+/// Fields of the index are separated by tabs, so tabs and new lines cannot appear inside them
+std::string sanitize(const std::string& field)
+{
+  std::string result = field;
+  for (auto& character : result)
+  {
+    if (character == '\t' || character == '\n' || character == '\r')
+    {
+      character = ' ';
+    }
+  }
+  return result;
+}
+
+bool parseIndexLine(const std::string& line, CalibrationEntry& entry)
+{
+  std::vector<std::string> fields;
+  std::istringstream stream(line);
+  std::string field;
+  while (std::getline(stream, field, '\t'))
+  {
+    fields.push_back(field);
+  }
+  if (fields.size() < 5)
+  {
+    return false;
+  }
+  fields.resize(8);
+  entry.name = fields[0];
+  entry.geometry = fields[1] == kAnyGeometry ? "" : fields[1];
+  try
+  {
+    entry.firstRun = std::stoi(fields[2]);
+    entry.lastRun = std::stoi(fields[3]);
+  }
+  catch (const std::exception&)
+  {
+    return false;
+  }
+  entry.tableFile = fields[4];
+  entry.provenance.created = fields[5];
+  entry.provenance.source = fields[6];
+  entry.provenance.comment = fields[7];
+  return true;
+}
+
+std::string currentTime()
+{
+  std::time_t now = std::time(nullptr);
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  return buffer;
+}
+}
+
+CalibrationTable::~CalibrationTable() { release(); }
+
+CalibrationTable::CalibrationTable(CalibrationTable&& other) noexcept { *this = std::move(other); }
+
+CalibrationTable& CalibrationTable::operator=(CalibrationTable&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    fMapping = other.fMapping;
+    fMappingSize = other.fMappingSize;
+    fData = other.fData;
+    fNumberOfChannels = other.fNumberOfChannels;
+    fNumberOfParameters = other.fNumberOfParameters;
+    other.fMapping = nullptr;
+    other.fMappingSize = 0;
+    other.fData = nullptr;
+    other.fNumberOfChannels = 0;
+    other.fNumberOfParameters = 0;
+  }
+  return *this;
+}
+
+void CalibrationTable::release()
+{
+  if (fMapping)
+  {
+    munmap(fMapping, fMappingSize);
+  }
+  fMapping = nullptr;
+  fMappingSize = 0;
+  fData = nullptr;
+  fNumberOfChannels = 0;
+  fNumberOfParameters = 0;
+}
+
+CalibrationTable CalibrationTable::map(const std::string& fileName)
+{
+  CalibrationTable table;
+  int descriptor = open(fileName.c_str(), O_RDONLY);
+  if (descriptor < 0)
+  {
+    return table;
+  }
+  struct stat fileStatus;
+  if (fstat(descriptor, &fileStatus) != 0 || static_cast<std::size_t>(fileStatus.st_size) < sizeof(TableHeader))
+  {
+    close(descriptor);
+    return table;
+  }
+  std::size_t size = fileStatus.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+  close(descriptor);
+  if (mapping == MAP_FAILED)
+  {
+    return table;
+  }
+  table.fMapping = mapping;
+  table.fMappingSize = size;
+  TableHeader header;
+  std::memcpy(&header, mapping, sizeof(TableHeader));
+  std::size_t expectedSize = sizeof(TableHeader) + sizeof(double) * static_cast<std::size_t>(header.numberOfChannels) * header.numberOfParameters;
+  if (std::memcmp(header.magic, kTableMagic, sizeof(kTableMagic)) != 0 || size != expectedSize)
+  {
+    table.release();
+    return table;
+  }
+  table.fData = reinterpret_cast<const double*>(static_cast<const char*>(mapping) + sizeof(TableHeader));
+  table.fNumberOfChannels = header.numberOfChannels;
+  table.fNumberOfParameters = header.numberOfParameters;
+  return table;
+}
+
+bool CalibrationTable::hasChannel(unsigned int channel) const { return getRow(channel) != nullptr; }
+
+const double* CalibrationTable::getRow(unsigned int channel) const
+{
+  if (channel >= fNumberOfChannels || fNumberOfParameters == 0)
+  {
+    return nullptr;
+  }
+  const double* row = fData + static_cast<std::size_t>(channel) * fNumberOfParameters;
+  return std::isnan(row[0]) ? nullptr : row;
+}
+
+double CalibrationTable::getParameter(unsigned int channel, unsigned int index) const
+{
+  const double* row = getRow(channel);
+  if (!row || index >= fNumberOfParameters || std::isnan(row[index]))
+  {
+    return 0.0;
+  }
+  return row[index];
+}
+
+std::map<unsigned int, std::vector<double>> CalibrationTable::toConfigurationParameters() const
+{
+  std::map<unsigned int, std::vector<double>> parameters;
+  for (unsigned int channel = 0; channel < fNumberOfChannels; channel++)
+  {
+    const double* row = getRow(channel);
+    if (!row)
+    {
+      continue;
+    }
+    unsigned int size = fNumberOfParameters;
+    while (size > 0 && std::isnan(row[size - 1]))
+    {
+      size--;
+    }
+    parameters.emplace_hint(parameters.end(), channel, std::vector<double>(row, row + size));
+  }
+  return parameters;
+}
+
+CalibrationStore::CalibrationStore(const std::string& directory) : fDirectory(directory) { reload(); }
+
+/**
+ * Missing index means an empty store, lines that cannot be parsed are skipped
+ */
+bool CalibrationStore::reload()
+{
+  fEntries.clear();
+  std::ifstream index(fDirectory + "/" + kIndexFileName);
+  if (!index)
+  {
+    return false;
+  }
+  std::string line;
+  while (std::getline(index, line))
+  {
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+    CalibrationEntry entry;
+    if (parseIndexLine(line, entry))
+    {
+      fEntries.push_back(entry);
+    }
+  }
+  return true;
+}
+
+const CalibrationEntry* CalibrationStore::find(const std::string& name, int run, const std::string& geometry) const
+{
+  for (auto entry = fEntries.rbegin(); entry != fEntries.rend(); ++entry)
+  {
+    if (entry->name == name && entry->isValidFor(run) && (geometry.empty() || entry->geometry.empty() || entry->geometry == geometry))
+    {
+      return &(*entry);
+    }
+  }
+  return nullptr;
+}
+
+CalibrationTable CalibrationStore::load(const std::string& name, int run, const std::string& geometry) const
+{
+  auto entry = find(name, run, geometry);
+  if (!entry)
+  {
+    return CalibrationTable();
+  }
+  return CalibrationTable::map(fDirectory + "/" + entry->tableFile);
+}
+
+/**
+ * Table is written before the entry is appended to the index,
+ * so readers never see an entry without its table
+ */
+bool CalibrationStore::add(const std::string& name, const std::string& geometry, int firstRun, int lastRun,
+                           const CalibrationProvenance& provenance, const Parameters& parameters)
+{
+  if (name.empty() || firstRun > lastRun)
+  {
+    return false;
+  }
+  boost::system::error_code error;
+  boost::filesystem::create_directories(fDirectory, error);
+  if (error)
+  {
+    return false;
+  }
+  reload();
+  CalibrationEntry entry;
+  entry.name = sanitize(name);
+  entry.geometry = sanitize(geometry);
+  entry.firstRun = firstRun;
+  entry.lastRun = lastRun;
+  entry.provenance.source = sanitize(provenance.source);
+  entry.provenance.created = provenance.created.empty() ? currentTime() : sanitize(provenance.created);
+  entry.provenance.comment = sanitize(provenance.comment);
+  std::ostringstream tableFile;
+  tableFile << boost::filesystem::path(entry.name).filename().string() << "_" << firstRun << "-" << lastRun << "_" << fEntries.size() << "_"
+            << getpid() << ".cal";
+  entry.tableFile = tableFile.str();
+  if (!writeTable(fDirectory + "/" + entry.tableFile, parameters))
+  {
+    return false;
+  }
+  const std::string indexFileName = fDirectory + "/" + kIndexFileName;
+  const bool newIndex = !boost::filesystem::exists(indexFileName);
+  std::ofstream index(indexFileName, std::ios::app);
+  if (newIndex)
+  {
+    index << kIndexHeader << "\n";
+  }
+  index << entry.name << "\t" << (entry.geometry.empty() ? kAnyGeometry : entry.geometry) << "\t" << entry.firstRun << "\t" << entry.lastRun
+        << "\t" << entry.tableFile << "\t" << entry.provenance.created << "\t" << entry.provenance.source << "\t" << entry.provenance.comment
+        << "\n";
+  index.close();
+  if (!index)
+  {
+    return false;
+  }
+  fEntries.push_back(entry);
+  return true;
+}
+
+/**
+ * Channel -1 is used by UniversalFileLoader for records without TOMB channel, such records are not stored
+ */
+bool CalibrationStore::writeTable(const std::string& fileName, const Parameters& parameters)
+{
+  const unsigned int noChannel = static_cast<unsigned int>(-1);
+  TableHeader header;
+  std::memcpy(header.magic, kTableMagic, sizeof(kTableMagic));
+  header.numberOfChannels = 0;
+  header.numberOfParameters = 0;
+  for (const auto& channelParameters : parameters)
+  {
+    if (channelParameters.first == noChannel)
+    {
+      continue;
+    }
+    if (channelParameters.first >= kMaxNumberOfChannels)
+    {
+      return false;
+    }
+    header.numberOfChannels = channelParameters.first + 1;
+    header.numberOfParameters = std::max<std::uint32_t>(header.numberOfParameters, channelParameters.second.size());
+  }
+  std::vector<double> data(static_cast<std::size_t>(header.numberOfChannels) * header.numberOfParameters,
+                           std::numeric_limits<double>::quiet_NaN());
+  for (const auto& channelParameters : parameters)
+  {
+    if (channelParameters.first == noChannel)
+    {
+      continue;
+    }
+    std::copy(channelParameters.second.begin(), channelParameters.second.end(),
+              data.begin() + static_cast<std::size_t>(channelParameters.first) * header.numberOfParameters);
+  }
+  const std::string temporaryFileName = fileName + ".tmp";
+  std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(TableHeader));
+  file.write(reinterpret_cast<const char*>(data.data()), sizeof(double) * data.size());
+  file.close();
+  if (!file || std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+  {
+    std::remove(temporaryFileName.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,141 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file CalibrationStore.h
+ */
+
+#ifndef CALIBRATIONSTORE_H
+#define CALIBRATIONSTORE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Origin of a set of calibration constants
+ */
+struct CalibrationProvenance
+{
+  /// File or task the constants come from
+  std::string source;
+  /// Time of adding to the store, filled by the store if empty
+  std::string created;
+  std::string comment;
+};
+
+/**
+ * @brief Record of the store index: set of constants of a given kind, valid for a range of runs and a geometry
+ */
+struct CalibrationEntry
+{
+  std::string name;
+  /// Empty geometry means that the constants do not depend on it
+  std::string geometry;
+  int firstRun = 0;
+  int lastRun = 0;
+  /// Table file, relative to the store directory
+  std::string tableFile;
+  CalibrationProvenance provenance;
+
+  bool isValidFor(int run) const { return firstRun <= run && run <= lastRun; }
+};
+
+/**
+ * @brief Dense table of calibration parameters indexed by TOMB channel, mapped read-only from a store file
+ *
+ * Row of a channel contains all parameters of the channel, channels without constants
+ * and parameters missing in shorter rows are NaN. Table is move-only, memory is unmapped
+ * when the table is destroyed.
+ */
+class CalibrationTable
+{
+public:
+  CalibrationTable() = default;
+  ~CalibrationTable();
+  CalibrationTable(CalibrationTable&& other) noexcept;
+  CalibrationTable& operator=(CalibrationTable&& other) noexcept;
+  CalibrationTable(const CalibrationTable&) = delete;
+  CalibrationTable& operator=(const CalibrationTable&) = delete;
+
+  /// Maps the table file, returned table is not valid if the file is missing or corrupted
+  static CalibrationTable map(const std::string& fileName);
+
+  bool isValid() const { return fData != nullptr; }
+  unsigned int getNumberOfChannels() const { return fNumberOfChannels; }
+  unsigned int getNumberOfParameters() const { return fNumberOfParameters; }
+  bool hasChannel(unsigned int channel) const;
+  /// Returns nullptr for channels without constants
+  const double* getRow(unsigned int channel) const;
+  /// Returns 0.0 for missing parameters, as UniversalFileLoader::getConfigurationParameter
+  double getParameter(unsigned int channel, unsigned int index = 0) const;
+  /// Conversion to the map used by the tasks loading text files, with NaN padding removed
+  std::map<unsigned int, std::vector<double>> toConfigurationParameters() const;
+
+private:
+  void release();
+
+  void* fMapping = nullptr;
+  std::size_t fMappingSize = 0;
+  const double* fData = nullptr;
+  unsigned int fNumberOfChannels = 0;
+  unsigned int fNumberOfParameters = 0;
+};
+
+/**
+ * @brief Local file-backed store of calibration constants with intervals of validity
+ *
+ * Store is a directory with the text index file, listing entries one per line with
+ * the name of constants (e.g. "TimeCalibration"), geometry, range of valid runs, table file
+ * and provenance, and binary table files with dense tables of the constants. Tables are in
+ * the native byte order of the machine. Entries are never modified, newer entries take
+ * precedence over older ones valid for the same run, so a recalibration is added as a new
+ * entry and switching between calibration campaigns means using another store directory.
+ *
+ * Usage:
+ * CalibrationStore store("calibrations");
+ * store.add("Velocities", "setup_2", 3000, 3999, {"velocities_run3.txt"}, velocities);
+ * auto table = store.load("Velocities", 3456, "setup_2");
+ * double velocity = table.getParameter(channel);
+ */
+class CalibrationStore
+{
+public:
+  /// Same as UniversalFileLoader::TOMBChToParameter
+  typedef std::map<unsigned int, std::vector<double>> Parameters;
+
+  explicit CalibrationStore(const std::string& directory);
+
+  const std::string& getDirectory() const { return fDirectory; }
+  const std::vector<CalibrationEntry>& getEntries() const { return fEntries; }
+  /// Re-reads the index, to see entries added by other processes
+  bool reload();
+
+  /// Newest entry valid for the run, nullptr if there is none. Empty geometry matches entries of every geometry
+  const CalibrationEntry* find(const std::string& name, int run, const std::string& geometry = "") const;
+  /// Table of the newest entry valid for the run, not valid if there is none
+  CalibrationTable load(const std::string& name, int run, const std::string& geometry = "") const;
+  /// Writes the table and appends the entry to the index
+  bool add(const std::string& name, const std::string& geometry, int firstRun, int lastRun, const CalibrationProvenance& provenance,
+           const Parameters& parameters);
+
+  static bool writeTable(const std::string& fileName, const Parameters& parameters);
+
+  static const std::string kIndexFileName;
+  static const unsigned int kMaxNumberOfChannels;
+
+private:
+  std::string fDirectory;
+  std::vector<CalibrationEntry> fEntries;
+};
+
+#endif /* !CALIBRATIONSTORE_H */
@@ -0,0 +1,218 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file CategorizerCutScan.cpp
+ */
+
+#include "CategorizerCutScan.h"
+#include "EventCategorizerTools.h"
+#include <TH1F.h>
+#include <TH2F.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace jpet_options_tools;
+
+const std::string CategorizerCutScan::kCountersHistogramName = "CutScan_Counts";
+
+namespace
+{
+struct ScannedCut
+{
+  const char* paramKey;
+  double CategorizerCutSet::*value;
+};
+
+const ScannedCut kScannedCuts[] = {
+    {"EventCategorizer_CutScan_MinAnnihilationTOT_std::vector<double>", &CategorizerCutSet::minAnnihilationTOT},
+    {"EventCategorizer_CutScan_MaxAnnihilationTOT_std::vector<double>", &CategorizerCutSet::maxAnnihilationTOT},
+    {"EventCategorizer_CutScan_MinDeexcitationTOT_std::vector<double>", &CategorizerCutSet::minDeexcitationTOT},
+    {"EventCategorizer_CutScan_MaxDeexcitationTOT_std::vector<double>", &CategorizerCutSet::maxDeexcitationTOT},
+    {"EventCategorizer_CutScan_MaxHitZPos_std::vector<double>", &CategorizerCutSet::maxZPos},
+    {"EventCategorizer_CutScan_BackToBackAngleWindow_std::vector<double>", &CategorizerCutSet::backToBackAngleWindow},
+    {"EventCategorizer_CutScan_MaxTimeDiff_std::vector<double>", &CategorizerCutSet::maxTimeDiff}};
+
+const char* kCounterLabels[] = {"Events", "With annihilation hits", "With deexcitation hits", "2 gamma", "3 gamma"};
+}
+
+bool CategorizerCutSet::isAnnihilationHit(double tot, double posZ) const
+{
+  return std::fabs(posZ) < maxZPos && tot >= minAnnihilationTOT && tot <= maxAnnihilationTOT;
+}
+
+bool CategorizerCutSet::isDeexcitationHit(double tot, double posZ) const
+{
+  return std::fabs(posZ) < maxZPos && tot >= minDeexcitationTOT && tot <= maxDeexcitationTOT;
+}
+
+std::string CategorizerCutSet::describe(bool withDeexcitation) const
+{
+  std::ostringstream description;
+  description << "annih. TOT " << minAnnihilationTOT << "-" << maxAnnihilationTOT << " ps";
+  if (withDeexcitation)
+  {
+    description << ", deex. TOT " << minDeexcitationTOT << "-" << maxDeexcitationTOT << " ps";
+  }
+  description << ", |z| < " << maxZPos << " cm, b2b " << backToBackAngleWindow << " deg, dt " << maxTimeDiff << " ps";
+  return description.str();
+}
+
+std::vector<CategorizerCutSet> CategorizerCutScan::readCutSets(const OptsStrAny& opts, const CategorizerCutSet& nominal, std::string& error)
+{
+  error.clear();
+  std::vector<std::vector<double>> values(sizeof(kScannedCuts) / sizeof(kScannedCuts[0]));
+  std::size_t numberOfSets = 0;
+  for (std::size_t i = 0; i < values.size(); i++)
+  {
+    if (isOptionSet(opts, kScannedCuts[i].paramKey))
+    {
+      values[i] = getOptionAsVectorOfDoubles(opts, kScannedCuts[i].paramKey);
+      numberOfSets = std::max(numberOfSets, values[i].size());
+    }
+  }
+  for (std::size_t i = 0; i < values.size(); i++)
+  {
+    if (!values[i].empty() && values[i].size() != 1 && values[i].size() != numberOfSets)
+    {
+      error = std::string(kScannedCuts[i].paramKey) + " has " + std::to_string(values[i].size()) + " values, expected 1 or " +
+              std::to_string(numberOfSets);
+      return {};
+    }
+  }
+  std::vector<CategorizerCutSet> cutSets(numberOfSets, nominal);
+  for (std::size_t i = 0; i < values.size(); i++)
+  {
+    for (std::size_t set = 0; set < numberOfSets && !values[i].empty(); set++)
+    {
+      cutSets[set].*kScannedCuts[i].value = values[i].size() == 1 ? values[i].front() : values[i][set];
+    }
+  }
+  return cutSets;
+}
+
+std::string CategorizerCutScan::getHistogramName(const std::string& name, unsigned int cutSet)
+{
+  return "CutScan_" + name + "_" + std::to_string(cutSet);
+}
+
+void CategorizerCutScan::init(const std::vector<CategorizerCutSet>& cutSets, bool withDeexcitation, JPetStatistics& stats)
+{
+  fCutSets = cutSets;
+  fWithDeexcitation = withDeexcitation;
+  fAnnihilationHitsNumber.clear();
+  fDeexcitationHitsNumber.clear();
+  fCounters = nullptr;
+  if (fCutSets.empty())
+  {
+    return;
+  }
+
+  const int numberOfSets = fCutSets.size();
+  stats.createHistogram(new TH2F(kCountersHistogramName.c_str(), "Events selected with the scanned cut sets", numberOfSets, -0.5, numberOfSets - 0.5,
+                                 kNumberOfCounters, 0.5, kNumberOfCounters + 0.5));
+  fCounters = stats.getHisto2D(kCountersHistogramName.c_str());
+  fCounters->SetXTitle("Cut set");
+  fCounters->SetYTitle("Category");
+  for (int bin = 1; bin <= kNumberOfCounters; bin++)
+  {
+    fCounters->GetYaxis()->SetBinLabel(bin, kCounterLabels[bin - 1]);
+  }
+
+  for (unsigned int set = 0; set < fCutSets.size(); set++)
+  {
+    const auto description = fCutSets[set].describe(fWithDeexcitation);
+    auto name = getHistogramName("AnnihHitsNumber", set);
+    stats.createHistogram(new TH1F(name.c_str(), ("Number of Annihilation Hits in Event, " + description).c_str(), 50, -0.5, 49.5));
+    fAnnihilationHitsNumber.push_back(stats.getHisto1D(name.c_str()));
+    fAnnihilationHitsNumber.back()->SetXTitle("Number of Annihilation Hits in Event");
+    fAnnihilationHitsNumber.back()->SetYTitle("Counts");
+    if (fWithDeexcitation)
+    {
+      name = getHistogramName("DeexHitsNumber", set);
+      stats.createHistogram(new TH1F(name.c_str(), ("Number of Deexcitation Hits in Event, " + description).c_str(), 50, -0.5, 49.5));
+      fDeexcitationHitsNumber.push_back(stats.getHisto1D(name.c_str()));
+      fDeexcitationHitsNumber.back()->SetXTitle("Number of Deexcitation Hits in Event");
+      fDeexcitationHitsNumber.back()->SetYTitle("Counts");
+    }
+  }
+}
+
+void CategorizerCutScan::evaluate(const std::vector<JPetHit>& hits, const std::vector<double>& tots, JPetStatistics& stats)
+{
+  if (!isEnabled())
+  {
+    return;
+  }
+  const auto numberOfHits = std::min(hits.size(), tots.size());
+  fPreviousAnnihilationMask.clear();
+  for (unsigned int set = 0; set < fCutSets.size(); set++)
+  {
+    const auto& cuts = fCutSets[set];
+    fAnnihilationMask.assign(numberOfHits, false);
+    int deexcitationHits = 0;
+    for (std::size_t i = 0; i < numberOfHits; i++)
+    {
+      fAnnihilationMask[i] = cuts.isAnnihilationHit(tots[i], hits[i].getPosZ());
+      if (fWithDeexcitation && cuts.isDeexcitationHit(tots[i], hits[i].getPosZ()))
+      {
+        deexcitationHits++;
+      }
+    }
+
+    // Consecutive sets often select the same hits, their event and 3 gamma check are reused
+    const bool sameHits = set > 0 && fAnnihilationMask == fPreviousAnnihilationMask;
+    const bool same2GammaCuts =
+        set > 0 && cuts.backToBackAngleWindow == fCutSets[set - 1].backToBackAngleWindow && cuts.maxTimeDiff == fCutSets[set - 1].maxTimeDiff;
+    if (!sameHits)
+    {
+      fAnnihilationEvent = JPetEvent();
+      for (std::size_t i = 0; i < numberOfHits; i++)
+      {
+        if (fAnnihilationMask[i])
+        {
+          fAnnihilationEvent.addHit(hits[i]);
+        }
+      }
+      fIs3Gamma = EventCategorizerTools::checkFor3Gamma(fAnnihilationEvent, stats, false);
+    }
+    if (!sameHits || !same2GammaCuts)
+    {
+      fIs2Gamma = EventCategorizerTools::checkFor2Gamma(fAnnihilationEvent, stats, false, cuts.backToBackAngleWindow, cuts.maxTimeDiff);
+    }
+    fPreviousAnnihilationMask.swap(fAnnihilationMask);
+
+    const int annihilationHits = fAnnihilationEvent.getHits().size();
+    fAnnihilationHitsNumber[set]->Fill(annihilationHits);
+    if (fWithDeexcitation)
+    {
+      fDeexcitationHitsNumber[set]->Fill(deexcitationHits);
+    }
+    fCounters->Fill(set, kAllEvents);
+    if (annihilationHits > 0)
+    {
+      fCounters->Fill(set, kAnnihilationEvents);
+    }
+    if (deexcitationHits > 0)
+    {
+      fCounters->Fill(set, kDeexcitationEvents);
+    }
+    if (fIs2Gamma)
+    {
+      fCounters->Fill(set, k2GammaEvents);
+    }
+    if (fIs3Gamma)
+    {
+      fCounters->Fill(set, k3GammaEvents);
+    }
+  }
+}
@@ -0,0 +1,104 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file CategorizerCutScan.h
+ */
+
+#ifndef CATEGORIZERCUTSCAN_H
+#define CATEGORIZERCUTSCAN_H
+
+#include <JPetEvent/JPetEvent.h>
+#include <JPetHit/JPetHit.h>
+#include <JPetOptionsTools/JPetOptionsTools.h>
+#include <JPetStatistics/JPetStatistics.h>
+#include <string>
+#include <vector>
+
+class TH1F;
+class TH2F;
+
+/**
+ * @brief Cuts selecting annihilation and deexcitation hits and 2 gamma events in the categorizers
+ */
+struct CategorizerCutSet
+{
+  double minAnnihilationTOT = 10000.0;
+  double maxAnnihilationTOT = 25000.0;
+  double minDeexcitationTOT = 30000.0;
+  double maxDeexcitationTOT = 50000.0;
+  double maxZPos = 23.0;
+  double backToBackAngleWindow = 3.0;
+  double maxTimeDiff = 1000.0;
+
+  bool isAnnihilationHit(double tot, double posZ) const;
+  bool isDeexcitationHit(double tot, double posZ) const;
+  std::string describe(bool withDeexcitation) const;
+};
+
+/**
+ * @brief Evaluation of many sets of cuts over the same events in one pass, for cut studies
+ *
+ * Every cut set gets its own counters and histograms of numbers of selected hits, events saved by
+ * the task are still selected with the nominal cuts. TOTs of hits are calculated once by the task
+ * and shared by all cut sets, events of selected hits are built once for consecutive cut sets
+ * selecting the same hits.
+ *
+ * Cut sets are given as vectors of values of the cuts, i-th elements of all vectors form the i-th set.
+ * Vector with one element sets the cut for all sets, cuts not given have nominal values:
+ * - "EventCategorizer_CutScan_MinAnnihilationTOT_std::vector<double>", "EventCategorizer_CutScan_MaxAnnihilationTOT_std::vector<double>"
+ * - "EventCategorizer_CutScan_MinDeexcitationTOT_std::vector<double>", "EventCategorizer_CutScan_MaxDeexcitationTOT_std::vector<double>"
+ * - "EventCategorizer_CutScan_MaxHitZPos_std::vector<double>"
+ * - "EventCategorizer_CutScan_BackToBackAngleWindow_std::vector<double>", "EventCategorizer_CutScan_MaxTimeDiff_std::vector<double>"
+ * Counters of all sets are in the histogram "CutScan_Counts", bin x is the index of the set plus one.
+ */
+class CategorizerCutScan
+{
+public:
+  enum CounterBin
+  {
+    kAllEvents = 1,
+    kAnnihilationEvents,
+    kDeexcitationEvents,
+    k2GammaEvents,
+    k3GammaEvents,
+    kNumberOfCounters = k3GammaEvents
+  };
+
+  /// Empty if no scan options are given, or if lengths of the vectors do not match and the error is set
+  static std::vector<CategorizerCutSet> readCutSets(const jpet_options_tools::OptsStrAny& opts, const CategorizerCutSet& nominal,
+                                                    std::string& error);
+
+  /// Creates counters and histograms of the cut sets in the statistics
+  void init(const std::vector<CategorizerCutSet>& cutSets, bool withDeexcitation, JPetStatistics& stats);
+  bool isEnabled() const { return !fCutSets.empty(); }
+  const std::vector<CategorizerCutSet>& getCutSets() const { return fCutSets; }
+
+  /// TOTs have to be aligned with the hits
+  void evaluate(const std::vector<JPetHit>& hits, const std::vector<double>& tots, JPetStatistics& stats);
+
+  static const std::string kCountersHistogramName;
+  static std::string getHistogramName(const std::string& name, unsigned int cutSet);
+
+private:
+  std::vector<CategorizerCutSet> fCutSets;
+  bool fWithDeexcitation = true;
+  TH2F* fCounters = nullptr;
+  std::vector<TH1F*> fAnnihilationHitsNumber;
+  std::vector<TH1F*> fDeexcitationHitsNumber;
+  std::vector<bool> fAnnihilationMask;
+  std::vector<bool> fPreviousAnnihilationMask;
+  JPetEvent fAnnihilationEvent;
+  bool fIs2Gamma = false;
+  bool fIs3Gamma = false;
+};
+
+#endif /* !CATEGORIZERCUTSCAN_H */
@@ -0,0 +1,356 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ChainDigest.cpp
+ */
+
+#include "ChainDigest.h"
+#include <TH1.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+const char kSeparator = '\t';
+
+std::string toString(const ChainDigest::Record& record)
+{
+  std::ostringstream line;
+  line << record.stage << kSeparator << record.index << kSeparator << record.type;
+  for (const auto& field : record.fields)
+  {
+    line << kSeparator << field.first << "=" << field.second;
+  }
+  return line.str();
+}
+
+std::string describe(const ChainDigest::Record& record)
+{
+  return "stage " + record.stage + ", " + record.type + " #" + std::to_string(record.index);
+}
+}
+
+ChainDigest::ChainDigest(int precision) : fPrecision(precision) {}
+
+void ChainDigest::beginStage(const std::string& stage)
+{
+  fStage = stage;
+  fStageIndex = 0;
+}
+
+ChainDigest::Record& ChainDigest::newRecord(const std::string& type)
+{
+  fRecords.emplace_back();
+  auto& record = fRecords.back();
+  record.stage = fStage;
+  record.index = fStageIndex++;
+  record.type = type;
+  return record;
+}
+
+std::string ChainDigest::format(double value) const
+{
+  std::ostringstream text;
+  text << std::setprecision(fPrecision) << value;
+  return text.str();
+}
+
+void ChainDigest::add(const JPetSigCh& sigCh)
+{
+  auto& fields = newRecord("JPetSigCh").fields;
+  fields.emplace_back("edge", sigCh.getType() == JPetSigCh::Leading ? "L" : "T");
+  fields.emplace_back("value", format(sigCh.getValue()));
+  fields.emplace_back("daqch", std::to_string(sigCh.getDAQch()));
+  fields.emplace_back("pm", std::to_string(sigCh.getPM().getID()));
+  fields.emplace_back("thrNumber", std::to_string(sigCh.getThresholdNumber()));
+  fields.emplace_back("thr", format(sigCh.getThreshold()));
+  fields.emplace_back("flag", std::to_string(sigCh.getRecoFlag()));
+}
+
+void ChainDigest::add(const JPetRawSignal& rawSignal)
+{
+  auto& fields = newRecord("JPetRawSignal").fields;
+  fields.emplace_back("pm", std::to_string(rawSignal.getPM().getID()));
+  fields.emplace_back("flag", std::to_string(rawSignal.getRecoFlag()));
+  for (const auto& edge : {JPetSigCh::Leading, JPetSigCh::Trailing})
+  {
+    const std::string prefix = edge == JPetSigCh::Leading ? "lead" : "trail";
+    for (const auto& sigCh : rawSignal.getPoints(edge, JPetRawSignal::ByThrNum))
+    {
+      fields.emplace_back(prefix + std::to_string(sigCh.getThresholdNumber()), format(sigCh.getValue()));
+    }
+  }
+}
+
+void ChainDigest::add(const JPetPhysSignal& physSignal)
+{
+  auto& fields = newRecord("JPetPhysSignal").fields;
+  fields.emplace_back("pm", std::to_string(physSignal.getPM().getID()));
+  fields.emplace_back("slot", std::to_string(physSignal.getBarrelSlot().getID()));
+  fields.emplace_back("time", format(physSignal.getTime()));
+  fields.emplace_back("flag", std::to_string(physSignal.getRecoFlag()));
+}
+
+void ChainDigest::add(const JPetHit& hit)
+{
+  auto& fields = newRecord("JPetHit").fields;
+  fields.emplace_back("scin", std::to_string(hit.getScintillator().getID()));
+  fields.emplace_back("time", format(hit.getTime()));
+  fields.emplace_back("timeDiff", format(hit.getTimeDiff()));
+  fields.emplace_back("posX", format(hit.getPosX()));
+  fields.emplace_back("posY", format(hit.getPosY()));
+  fields.emplace_back("posZ", format(hit.getPosZ()));
+  fields.emplace_back("energy", format(hit.getEnergy()));
+  fields.emplace_back("timeA", format(hit.getSignalA().getTime()));
+  fields.emplace_back("timeB", format(hit.getSignalB().getTime()));
+  fields.emplace_back("flag", std::to_string(hit.getRecoFlag()));
+}
+
+void ChainDigest::add(const JPetEvent& event)
+{
+  auto& fields = newRecord("JPetEvent").fields;
+  fields.emplace_back("type", std::to_string(static_cast<unsigned int>(event.getEventType())));
+  fields.emplace_back("flag", std::to_string(event.getRecoFlag()));
+  const auto& hits = event.getHits();
+  fields.emplace_back("hits", std::to_string(hits.size()));
+  for (std::size_t i = 0; i < hits.size(); i++)
+  {
+    fields.emplace_back("hit" + std::to_string(i) + "_scin", std::to_string(hits[i].getScintillator().getID()));
+    fields.emplace_back("hit" + std::to_string(i) + "_time", format(hits[i].getTime()));
+  }
+}
+
+void ChainDigest::add(const TH1& histogram)
+{
+  auto& fields = newRecord("Histogram").fields;
+  fields.emplace_back("name", histogram.GetName());
+  fields.emplace_back("entries", format(histogram.GetEntries()));
+  // Sum of weights, sum of weights squared, sums of weighted values and squares, per axis
+  double stats[TH1::kNstat] = {0.0};
+  histogram.GetStats(stats);
+  const int numberOfStats = histogram.GetDimension() == 1 ? 4 : 7;
+  for (int i = 0; i < numberOfStats; i++)
+  {
+    fields.emplace_back("stat" + std::to_string(i), format(stats[i]));
+  }
+  const int numberOfBins = histogram.GetNcells();
+  for (int bin = 0; bin < numberOfBins; bin++)
+  {
+    const double content = histogram.GetBinContent(bin);
+    if (content != 0.0)
+    {
+      fields.emplace_back("bin" + std::to_string(bin), format(content));
+    }
+  }
+}
+
+void ChainDigest::addHistograms(JPetStatistics& stats)
+{
+  std::vector<const TH1*> histograms;
+  TIter next(stats.getStatsTable());
+  while (auto object = next())
+  {
+    if (auto histogram = dynamic_cast<const TH1*>(object))
+    {
+      histograms.push_back(histogram);
+    }
+  }
+  std::sort(histograms.begin(), histograms.end(), [](const TH1* h1, const TH1* h2) { return std::string(h1->GetName()) < h2->GetName(); });
+  for (auto histogram : histograms)
+  {
+    add(*histogram);
+  }
+}
+
+std::vector<std::string> ChainDigest::getStages() const
+{
+  std::vector<std::string> stages;
+  for (const auto& record : fRecords)
+  {
+    if (std::find(stages.begin(), stages.end(), record.stage) == stages.end())
+    {
+      stages.push_back(record.stage);
+    }
+  }
+  return stages;
+}
+
+std::string ChainDigest::getStageHash(const std::string& stage) const
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto& record : fRecords)
+  {
+    if (record.stage != stage)
+    {
+      continue;
+    }
+    for (char c : toString(record) + "\n")
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+  }
+  std::ostringstream text;
+  text << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return text.str();
+}
+
+void ChainDigest::write(std::ostream& output) const
+{
+  for (const auto& stage : getStages())
+  {
+    const auto records = std::count_if(fRecords.begin(), fRecords.end(), [&stage](const Record& record) { return record.stage == stage; });
+    output << "# " << stage << kSeparator << records << " records" << kSeparator << getStageHash(stage) << "\n";
+  }
+  for (const auto& record : fRecords)
+  {
+    output << toString(record) << "\n";
+  }
+}
+
+bool ChainDigest::read(std::istream& input)
+{
+  fRecords.clear();
+  std::string line;
+  while (std::getline(input, line))
+  {
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+    std::istringstream columns(line);
+    std::string column;
+    Record record;
+    if (!std::getline(columns, record.stage, kSeparator) || !std::getline(columns, column, kSeparator))
+    {
+      return false;
+    }
+    record.index = std::stoul(column);
+    if (!std::getline(columns, record.type, kSeparator))
+    {
+      return false;
+    }
+    while (std::getline(columns, column, kSeparator))
+    {
+      const auto equals = column.find('=');
+      if (equals == std::string::npos)
+      {
+        return false;
+      }
+      record.fields.emplace_back(column.substr(0, equals), column.substr(equals + 1));
+    }
+    fRecords.push_back(record);
+  }
+  return true;
+}
+
+bool ChainDigest::writeFile(const std::string& fileName) const
+{
+  std::ofstream output(fileName);
+  if (!output)
+  {
+    return false;
+  }
+  write(output);
+  return static_cast<bool>(output);
+}
+
+bool ChainDigest::readFile(const std::string& fileName)
+{
+  std::ifstream input(fileName);
+  return input && read(input);
+}
+
+std::string ChainDigest::compare(const ChainDigest& expected, const ChainDigest& actual)
+{
+  // Stages are compared separately, so a missing object does not shift the records of later stages
+  auto stages = expected.getStages();
+  for (const auto& stage : actual.getStages())
+  {
+    if (std::find(stages.begin(), stages.end(), stage) == stages.end())
+    {
+      stages.push_back(stage);
+    }
+  }
+  for (const auto& stage : stages)
+  {
+    std::vector<const Record*> expectedRecords, actualRecords;
+    for (const auto& record : expected.getRecords())
+    {
+      if (record.stage == stage)
+      {
+        expectedRecords.push_back(&record);
+      }
+    }
+    for (const auto& record : actual.getRecords())
+    {
+      if (record.stage == stage)
+      {
+        actualRecords.push_back(&record);
+      }
+    }
+    const auto difference = compareStage(expectedRecords, actualRecords);
+    if (!difference.empty())
+    {
+      return difference;
+    }
+  }
+  return "";
+}
+
+std::string ChainDigest::compareStage(const std::vector<const Record*>& expectedRecords, const std::vector<const Record*>& actualRecords)
+{
+  const auto common = std::min(expectedRecords.size(), actualRecords.size());
+  for (std::size_t i = 0; i < common; i++)
+  {
+    const auto& expectedRecord = *expectedRecords[i];
+    const auto& actualRecord = *actualRecords[i];
+    if (expectedRecord.type != actualRecord.type)
+    {
+      return "expected " + describe(expectedRecord) + ", found " + describe(actualRecord);
+    }
+    const auto fields = std::min(expectedRecord.fields.size(), actualRecord.fields.size());
+    for (std::size_t j = 0; j < fields; j++)
+    {
+      const auto& expectedField = expectedRecord.fields[j];
+      const auto& actualField = actualRecord.fields[j];
+      if (expectedField.first != actualField.first)
+      {
+        return describe(expectedRecord) + ": expected field " + expectedField.first + ", found " + actualField.first;
+      }
+      if (expectedField.second != actualField.second)
+      {
+        return describe(expectedRecord) + ", field " + expectedField.first + ": expected " + expectedField.second + ", found " + actualField.second;
+      }
+    }
+    if (expectedRecord.fields.size() > fields)
+    {
+      return describe(expectedRecord) + ": missing field " + expectedRecord.fields[fields].first;
+    }
+    if (actualRecord.fields.size() > fields)
+    {
+      return describe(expectedRecord) + ": unexpected field " + actualRecord.fields[fields].first;
+    }
+  }
+  if (expectedRecords.size() > common)
+  {
+    return "missing " + describe(*expectedRecords[common]) + " and " + std::to_string(expectedRecords.size() - common - 1) + " following records";
+  }
+  if (actualRecords.size() > common)
+  {
+    return "unexpected " + describe(*actualRecords[common]) + " and " + std::to_string(actualRecords.size() - common - 1) + " following records";
+  }
+  return "";
+}
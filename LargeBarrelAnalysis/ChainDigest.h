@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ChainDigest.h
+ */
+
+#ifndef CHAINDIGEST_H
+#define CHAINDIGEST_H
+
+#include <JPetEvent/JPetEvent.h>
+#include <JPetHit/JPetHit.h>
+#include <JPetPhysSignal/JPetPhysSignal.h>
+#include <JPetRawSignal/JPetRawSignal.h>
+#include <JPetSigCh/JPetSigCh.h>
+#include <JPetStatistics/JPetStatistics.h>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TH1;
+
+/**
+ * @brief Canonical digest of the outputs of the stages of the analysis chain, for regression checks
+ *
+ * Every object produced by a stage is stored as a record of named fields, numbers are written with
+ * the given number of significant digits. Digests of two runs are compared record by record, and
+ * the first differing stage, object and field is reported, so the change can be traced to the stage,
+ * where the outputs diverge first. Histograms are compared by their statistics and non-empty bins.
+ *
+ * Text format, one record per line, tab separated: stage, index, type, field=value...
+ * Lines starting with # are comments with the number of records and a hash of every stage.
+ */
+class ChainDigest
+{
+public:
+  struct Record
+  {
+    std::string stage;
+    std::size_t index = 0;
+    std::string type;
+    std::vector<std::pair<std::string, std::string>> fields;
+  };
+
+  explicit ChainDigest(int precision = 10);
+
+  /// Following objects are added to the stage, indices of records start from 0 in every stage
+  void beginStage(const std::string& stage);
+  void add(const JPetSigCh& sigCh);
+  void add(const JPetRawSignal& rawSignal);
+  void add(const JPetPhysSignal& physSignal);
+  void add(const JPetHit& hit);
+  void add(const JPetEvent& event);
+  void add(const TH1& histogram);
+  /// All histograms of the statistics, ordered by name
+  void addHistograms(JPetStatistics& stats);
+
+  const std::vector<Record>& getRecords() const { return fRecords; }
+  std::vector<std::string> getStages() const;
+  /// FNV-1a hash of the records of the stage, in hex
+  std::string getStageHash(const std::string& stage) const;
+
+  void write(std::ostream& output) const;
+  bool read(std::istream& input);
+  bool writeFile(const std::string& fileName) const;
+  bool readFile(const std::string& fileName);
+
+  /// Empty if digests are equal, otherwise description of the first difference
+  static std::string compare(const ChainDigest& expected, const ChainDigest& actual);
+
+private:
+  static std::string compareStage(const std::vector<const Record*>& expectedRecords, const std::vector<const Record*>& actualRecords);
+  Record& newRecord(const std::string& type);
+  std::string format(double value) const;
+
+  int fPrecision;
+  std::string fStage;
+  std::size_t fStageIndex = 0;
+  std::vector<Record> fRecords;
+};
+
+#endif /* !CHAINDIGEST_H */
@@ -0,0 +1,99 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ControlHistogramSampler.h
+ */
+
+#ifndef CONTROLHISTOGRAMSAMPLER_H
+#define CONTROLHISTOGRAMSAMPLER_H
+
+#include <JPetOptionsTools/JPetOptionsTools.h>
+#include <JPetStatistics/JPetStatistics.h>
+#include <TH1.h>
+#include <algorithm>
+#include <string>
+
+/**
+ * @brief Sampling of time windows, in which a task fills its control histograms
+ *
+ * Control histograms are filled only in every N-th time window, starting from the first one.
+ * When the task terminates, histograms are scaled by the ratio of all to sampled time windows,
+ * so their contents estimate the full statistics. Selection of windows depends only on their
+ * order, so repeated runs sample the same windows.
+ *
+ * Usage in the task:
+ * - init(): loadOptions()
+ * - exec(): nextWindow() once per time window, before the checkpoint check, so the windows skipped
+ *   after resuming are counted as in an uninterrupted run; fill histograms only if it returned true
+ * - terminate(): scaleHistograms()
+ * All histograms in the statistics of the task are scaled, so every fill has to be skipped in windows
+ * for which nextWindow() returned false, also in helper methods called for each signal or hit.
+ *
+ * Options shared by all tasks:
+ * - "ControlHistograms_SamplingPeriod_int": N, 1 or not set means filling in every time window
+ */
+class ControlHistogramSampler
+{
+public:
+  void loadOptions(const jpet_options_tools::OptsStrAny& opts)
+  {
+    using namespace jpet_options_tools;
+    if (isOptionSet(opts, kPeriodParamKey))
+    {
+      fPeriod = std::max(getOptionAsInt(opts, kPeriodParamKey), 1);
+    }
+  }
+
+  bool isEnabled() const { return fPeriod > 1; }
+  int getPeriod() const { return fPeriod; }
+  long long getNumberOfWindows() const { return fWindows; }
+  long long getNumberOfSampledWindows() const { return fSampledWindows; }
+
+  /// True if control histograms are filled in the current time window
+  bool nextWindow()
+  {
+    const bool sampled = fWindows % fPeriod == 0;
+    fWindows++;
+    if (sampled)
+    {
+      fSampledWindows++;
+    }
+    return sampled;
+  }
+
+  double getScaleFactor() const { return fSampledWindows > 0 ? static_cast<double>(fWindows) / fSampledWindows : 1.0; }
+
+  void scaleHistograms(JPetStatistics& stats) const
+  {
+    if (!isEnabled() || fSampledWindows == 0 || fSampledWindows == fWindows)
+    {
+      return;
+    }
+    TIter next(stats.getStatsTable());
+    while (auto object = next())
+    {
+      if (auto histogram = dynamic_cast<TH1*>(object))
+      {
+        histogram->Scale(getScaleFactor());
+      }
+    }
+  }
+
+  const std::string kPeriodParamKey = "ControlHistograms_SamplingPeriod_int";
+
+private:
+  int fPeriod = 1;
+  long long fWindows = 0;
+  long long fSampledWindows = 0;
+};
+
+#endif /* !CONTROLHISTOGRAMSAMPLER_H */
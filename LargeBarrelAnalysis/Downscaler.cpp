@@ -17,6 +17,7 @@
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include <iostream>
 #include <algorithm>
+#include <sstream>
 
 using namespace jpet_options_tools;
 using namespace std;
@@ -50,11 +51,22 @@ bool Downscaler::init()
 
   fOutputEvents = new JPetTimeWindow("JPetEvent");
 
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  if (fCheckpoint.resume(getStatistics(), checkpointState))
+  {
+    std::istringstream(checkpointState) >> fRandomGenerator;
+  }
   return true;
 }
 
 bool Downscaler::exec()
 {
+  if (fCheckpoint.skipWindow<JPetEvent>(fOutputEvents))
+  {
+    return true;
+  }
   if (auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent))
   {
     vector<JPetEvent> events;
@@ -82,17 +94,29 @@ bool Downscaler::exec()
   {
     return false;
   }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents, getRandomGeneratorState());
   return true;
 }
 
 bool Downscaler::terminate()
 {
   INFO("Event downscaling completed.");
+  fCheckpoint.finish();
   return true;
 }
 
 double Downscaler::getNormalizedRandom() { return fRandomDistribution(fRandomGenerator); }
 
+/**
+ * State of the generator is saved in checkpoints, so that resumed run draws the same numbers
+ */
+std::string Downscaler::getRandomGeneratorState() const
+{
+  std::ostringstream state;
+  state << fRandomGenerator;
+  return state.str();
+}
+
 void Downscaler::saveEvent(const JPetEvent& event)
 {
   getStatistics().fillHistogram("filtered_event_multiplicity", event.getHits().size());
@@ -18,6 +18,7 @@
 
 #include <JPetEvent/JPetEvent.h>
 #include <JPetUserTask/JPetUserTask.h>
+#include "TaskCheckpoint.h"
 #include <random>
 
 /**
@@ -49,5 +50,7 @@ protected:
 
   void saveEvent(const JPetEvent& event);
   double getNormalizedRandom();
+  std::string getRandomGeneratorState() const;
+  TaskCheckpoint fCheckpoint;
 };
 #endif /* !DOWNSCALER_H */
@@ -74,7 +74,7 @@ bool EventCategorizer::init()
     fSaveControlHistos = getOptionAsBool(fParams.getOptions(), kSaveControlHistosParamKey);
   }
   if (isOptionSet(fParams.getOptions(), kTOTCalculationType)) {
-    fTOTCalculationType = getOptionAsString(fParams.getOptions(), kTOTCalculationType);
+    fTOTCalculationType = HitFinderTools::getTOTCalculationType(getOptionAsString(fParams.getOptions(), kTOTCalculationType));
   } else {
     WARNING("No TOT calculation option given by the user. Using standard sum.");
   }
@@ -82,30 +82,54 @@ bool EventCategorizer::init()
 
   // Input events type
   fOutputEvents = new JPetTimeWindow("JPetEvent");
+  // Optional flat copy of the categorized events
+  fFlatEventWriter.openFromOptions(fParams.getOptions(), getName());
   // Initialise hisotgrams
   if(fSaveControlHistos) initialiseHistograms();
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  fCheckpoint.resume(getStatistics(), checkpointState);
   return true;
 }
 
 bool EventCategorizer::exec()
 {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetEvent>(fOutputEvents)) {
+    // Categorized events of the skipped window are read back from the partial output
+    if (fFlatEventWriter.isOpen()) {
+      for (uint i = 0; i < fOutputEvents->getNumberOfEvents(); i++) {
+        fFlatEventWriter.fill(dynamic_cast<const JPetEvent&>(fOutputEvents->operator[](i)), fTOTCalculationType);
+      }
+    }
+    return true;
+  }
   if (auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent)) {
-    vector<JPetEvent> events;
+    fAllocationCounter.startWindow();
+    fEvents.clear();
     for (uint i = 0; i < timeWindow->getNumberOfEvents(); i++) {
       const auto& event = dynamic_cast<const JPetEvent&>(timeWindow->operator[](i));
 
+      // TOTs of the hits are calculated once and shared by the checks below
+      fHitQuantities.clear();
+      for (const auto& hit : event.getHits()) {
+        fAllocationCounter.pushBack(fHitQuantities, HitFinderTools::calculateHitQuantities(hit, fTOTCalculationType));
+      }
+
       // Check types of current event
       bool is2Gamma = EventCategorizerTools::checkFor2Gamma(
-        event, getStatistics(), fSaveControlHistos, fB2BSlotThetaDiff, fMaxTimeDiff
+        event, getStatistics(), fFillControlHistos, fB2BSlotThetaDiff, fMaxTimeDiff
       );
       bool is3Gamma = EventCategorizerTools::checkFor3Gamma(
-        event, getStatistics(), fSaveControlHistos
+        event, getStatistics(), fFillControlHistos
       );
       bool isPrompt = EventCategorizerTools::checkForPrompt(
-        event, getStatistics(), fSaveControlHistos, fDeexTOTCutMin, fDeexTOTCutMax, fTOTCalculationType
+        event, fHitQuantities, getStatistics(), fFillControlHistos, fDeexTOTCutMin, fDeexTOTCutMax
       );
       bool isScattered = EventCategorizerTools::checkForScatter(
-        event, getStatistics(), fSaveControlHistos, fScatterTOFTimeDiff, fTOTCalculationType
+        event, fHitQuantities, getStatistics(), fFillControlHistos, fScatterTOFTimeDiff
       );
 
       JPetEvent newEvent = event;
@@ -114,21 +138,29 @@ bool EventCategorizer::exec()
       if(isPrompt) newEvent.addEventType(JPetEventType::kPrompt);
       if(isScattered) newEvent.addEventType(JPetEventType::kScattered);
 
-      if(fSaveControlHistos){
-        for(auto hit : event.getHits()){
-          getStatistics().fillHistogram("All_XYpos", hit.getPosX(), hit.getPosY());
+      if(fFillControlHistos){
+        for(const auto& quantities : fHitQuantities){
+          getStatistics().fillHistogram("All_XYpos", quantities.posX, quantities.posY);
         }
       }
-      events.push_back(newEvent);
+      fAllocationCounter.pushBack(fEvents, newEvent);
+      if (fFlatEventWriter.isOpen()) {
+        fFlatEventWriter.fill(newEvent, fHitQuantities);
+      }
     }
-    saveEvents(events);
+    saveEvents(fEvents);
+    fAllocationCounter.finishWindow();
   } else { return false; }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents);
   return true;
 }
 
 bool EventCategorizer::terminate()
 {
-  INFO("Event categorization completed.");
+  INFO("Event categorization completed, " + fAllocationCounter.getSummary());
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fFlatEventWriter.close();
+  fCheckpoint.finish();
   return true;
 }
 
@@ -17,6 +17,9 @@
 #define EVENTCATEGORIZER_H
 
 #include <JPetUserTask/JPetUserTask.h>
+#include "ControlHistogramSampler.h"
+#include "FlatEventTree.h"
+#include "TaskCheckpoint.h"
 #include "EventCategorizerTools.h"
 #include <JPetEvent/JPetEvent.h>
 #include <JPetHit/JPetHit.h>
@@ -56,7 +59,14 @@ protected:
 	double fDeexTOTCutMax = 50000.0;
 	double fMaxTimeDiff = 1000.;
 	bool fSaveControlHistos = true;
-    std::string fTOTCalculationType = "";
+	bool fFillControlHistos = true;
+    HitFinderTools::TOTCalculationType fTOTCalculationType = HitFinderTools::kSimplified;
 	void initialiseHistograms();
+	std::vector<JPetEvent> fEvents;
+	std::vector<HitFinderTools::HitQuantities> fHitQuantities;
+	AllocationCounter fAllocationCounter;
+	ControlHistogramSampler fHistogramSampler;
+	FlatEventWriter fFlatEventWriter;
+	TaskCheckpoint fCheckpoint;
 };
 #endif /* !EVENTCATEGORIZER_H */
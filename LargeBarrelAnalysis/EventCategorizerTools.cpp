@@ -14,12 +14,25 @@
  */
 
 #include "EventCategorizerTools.h"
+#include "AnnihilationPointTools.h"
 #include "HitFinderTools.h"
 #include <TMath.h>
+#include <algorithm>
+#include <array>
 #include <vector>
 
 using namespace std;
 
+namespace
+{
+/// Theta of the slot in [0, 360) degrees
+double normalizeTheta(double theta)
+{
+  theta = fmod(theta, 360.0);
+  return theta < 0.0 ? theta + 360.0 : theta;
+}
+}
+
 /**
 * Method for determining type of event - back to back 2 gamma
 */
@@ -31,22 +44,24 @@ bool EventCategorizerTools::checkFor2Gamma(
   if (event.getHits().size() < 2) {
     return false;
   }
+  // Control histograms are filled for all pairs checked before the back-to-back one,
+  // so only without them the pairs can be checked in other order than by hit indices
+  if (!saveHistos && event.getHits().size() >= kMinHitsForSlotSearch && b2bSlotThetaDiff <= 180.0) {
+    return findBackToBackPair(event.getHits(), b2bSlotThetaDiff, b2bTimeDiff);
+  }
   for (uint i = 0; i < event.getHits().size(); i++) {
     for (uint j = i + 1; j < event.getHits().size(); j++) {
-      JPetHit firstHit, secondHit;
-      if (event.getHits().at(i).getTime() < event.getHits().at(j).getTime()) {
-        firstHit = event.getHits().at(i);
-        secondHit = event.getHits().at(j);
-      } else {
-        firstHit = event.getHits().at(j);
-        secondHit = event.getHits().at(i);
+      const JPetHit* earlierHit = &event.getHits().at(i);
+      const JPetHit* laterHit = &event.getHits().at(j);
+      if (earlierHit->getTime() >= laterHit->getTime()) {
+        swap(earlierHit, laterHit);
       }
+      const JPetHit& firstHit = *earlierHit;
+      const JPetHit& secondHit = *laterHit;
       // Checking for back to back
       double timeDiff = fabs(firstHit.getTime() - secondHit.getTime());
       double deltaLor = (secondHit.getTime() - firstHit.getTime()) * kLightVelocity_cm_ps / 2.;
-      double theta1 = min(firstHit.getBarrelSlot().getTheta(), secondHit.getBarrelSlot().getTheta());
-      double theta2 = max(firstHit.getBarrelSlot().getTheta(), secondHit.getBarrelSlot().getTheta());
-      double thetaDiff = min(theta2 - theta1, 360.0 - theta2 + theta1);
+      double thetaDiff = calculateSlotThetaDiff(firstHit, secondHit);
       if (saveHistos) {
         stats.fillHistogram("2Gamma_Zpos", firstHit.getPosZ());
         stats.fillHistogram("2Gamma_Zpos", secondHit.getPosZ());
@@ -71,6 +86,68 @@ bool EventCategorizerTools::checkFor2Gamma(
   return false;
 }
 
+/**
+* Method checking if two hits are back-to-back, with the same conditions as in checkFor2Gamma
+*/
+bool EventCategorizerTools::isBackToBackPair(
+  const JPetHit& hit1, const JPetHit& hit2, double b2bSlotThetaDiff, double b2bTimeDiff
+)
+{
+  double timeDiff = fabs(hit1.getTime() - hit2.getTime());
+  return fabs(calculateSlotThetaDiff(hit1, hit2) - 180.0) < b2bSlotThetaDiff && timeDiff < b2bTimeDiff;
+}
+
+/**
+* Angle between the slots of two hits in [0, 180] degrees. Thetas are normalized to [0, 360) first,
+* as in the search by slot theta, so slots described with angles out of this range give the same result.
+*/
+double EventCategorizerTools::calculateSlotThetaDiff(const JPetHit& hit1, const JPetHit& hit2)
+{
+  double theta1 = normalizeTheta(hit1.getBarrelSlot().getTheta());
+  double theta2 = normalizeTheta(hit2.getBarrelSlot().getTheta());
+  if (theta1 > theta2) {
+    swap(theta1, theta2);
+  }
+  return min(theta2 - theta1, 360.0 - theta2 + theta1);
+}
+
+/**
+* Search for back-to-back pair of hits in events of high multiplicity.
+* Hits are sorted by theta angle of their slots, and for each hit only the hits
+* in the opposite angular window, 180 +- b2bSlotThetaDiff degrees, are checked,
+* instead of all pairs of hits. Window can not be wider than 180 degrees.
+*/
+bool EventCategorizerTools::findBackToBackPair(
+  const vector<JPetHit>& hits, double b2bSlotThetaDiff, double b2bTimeDiff
+)
+{
+  vector<pair<double, unsigned int>> hitsByTheta;
+  hitsByTheta.reserve(hits.size());
+  for (unsigned int i = 0; i < hits.size(); i++) {
+    hitsByTheta.emplace_back(normalizeTheta(hits.at(i).getBarrelSlot().getTheta()), i);
+  }
+  sort(hitsByTheta.begin(), hitsByTheta.end());
+
+  for (const auto& hitTheta : hitsByTheta) {
+    // Window may wrap around 0/360 degrees, its ends are included, the exact condition is checked for candidates
+    const double windowMin = hitTheta.first + 180.0 - b2bSlotThetaDiff;
+    const double windowMax = hitTheta.first + 180.0 + b2bSlotThetaDiff;
+    for (double shift : {-360.0, 0.0}) {
+      auto candidate = lower_bound(
+        hitsByTheta.begin(), hitsByTheta.end(), make_pair(windowMin + shift, 0u)
+      );
+      for (; candidate != hitsByTheta.end() && candidate->first <= windowMax + shift; ++candidate) {
+        if (candidate->second != hitTheta.second && isBackToBackPair(
+          hits.at(hitTheta.second), hits.at(candidate->second), b2bSlotThetaDiff, b2bTimeDiff
+        )) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
 /**
 * Method for determining type of event - 3Gamma
 */
@@ -80,20 +157,22 @@ bool EventCategorizerTools::checkFor3Gamma(const JPetEvent& event, JPetStatistic
   for (uint i = 0; i < event.getHits().size(); i++) {
     for (uint j = i + 1; j < event.getHits().size(); j++) {
       for (uint k = j + 1; k < event.getHits().size(); k++) {
-        JPetHit firstHit = event.getHits().at(i);
-        JPetHit secondHit = event.getHits().at(j);
-        JPetHit thirdHit = event.getHits().at(k);
-
-        vector<double> thetaAngles;
-        thetaAngles.push_back(firstHit.getBarrelSlot().getTheta());
-        thetaAngles.push_back(secondHit.getBarrelSlot().getTheta());
-        thetaAngles.push_back(thirdHit.getBarrelSlot().getTheta());
+        const JPetHit& firstHit = event.getHits().at(i);
+        const JPetHit& secondHit = event.getHits().at(j);
+        const JPetHit& thirdHit = event.getHits().at(k);
+
+        array<double, 3> thetaAngles = {
+          firstHit.getBarrelSlot().getTheta(),
+          secondHit.getBarrelSlot().getTheta(),
+          thirdHit.getBarrelSlot().getTheta()
+        };
         sort(thetaAngles.begin(), thetaAngles.end());
 
-        vector<double> relativeAngles;
-        relativeAngles.push_back(thetaAngles.at(1) - thetaAngles.at(0));
-        relativeAngles.push_back(thetaAngles.at(2) - thetaAngles.at(1));
-        relativeAngles.push_back(360.0 - thetaAngles.at(2) + thetaAngles.at(0));
+        array<double, 3> relativeAngles = {
+          thetaAngles.at(1) - thetaAngles.at(0),
+          thetaAngles.at(2) - thetaAngles.at(1),
+          360.0 - thetaAngles.at(2) + thetaAngles.at(0)
+        };
         sort(relativeAngles.begin(), relativeAngles.end());
         double transformedX = relativeAngles.at(1) + relativeAngles.at(0);
         double transformedY = relativeAngles.at(1) - relativeAngles.at(0);
@@ -113,10 +192,19 @@ bool EventCategorizerTools::checkFor3Gamma(const JPetEvent& event, JPetStatistic
 bool EventCategorizerTools::checkForPrompt(
   const JPetEvent& event, JPetStatistics& stats, bool saveHistos,
   double deexTOTCutMin, double deexTOTCutMax, std::string fTOTCalculationType)
+{
+  auto hitQuantities = HitFinderTools::calculateHitQuantities(
+    event.getHits(), HitFinderTools::getTOTCalculationType(fTOTCalculationType)
+  );
+  return checkForPrompt(event, hitQuantities, stats, saveHistos, deexTOTCutMin, deexTOTCutMax);
+}
+
+bool EventCategorizerTools::checkForPrompt(
+  const JPetEvent& event, const vector<HitFinderTools::HitQuantities>& hitQuantities,
+  JPetStatistics& stats, bool saveHistos, double deexTOTCutMin, double deexTOTCutMax)
 {
   for (unsigned i = 0; i < event.getHits().size(); i++) {
-    double tot = HitFinderTools::calculateTOT(event.getHits().at(i), 
-                                              HitFinderTools::getTOTCalculationType(fTOTCalculationType));
+    double tot = hitQuantities.at(i).tot;
     if (tot > deexTOTCutMin && tot < deexTOTCutMax) {
       if (saveHistos) {
         stats.fillHistogram("Deex_TOT_cut", tot);
@@ -134,23 +222,33 @@ bool EventCategorizerTools::checkForScatter(
   const JPetEvent& event, JPetStatistics& stats, bool saveHistos, double scatterTOFTimeDiff, 
   std::string fTOTCalculationType)
 {
-  if (event.getHits().size() < 2) {
+  auto hitQuantities = HitFinderTools::calculateHitQuantities(
+    event.getHits(), HitFinderTools::getTOTCalculationType(fTOTCalculationType)
+  );
+  return checkForScatter(event, hitQuantities, stats, saveHistos, scatterTOFTimeDiff);
+}
+
+bool EventCategorizerTools::checkForScatter(
+  const JPetEvent& event, const vector<HitFinderTools::HitQuantities>& hitQuantities,
+  JPetStatistics& stats, bool saveHistos, double scatterTOFTimeDiff)
+{
+  const auto& hits = event.getHits();
+  if (hits.size() < 2) {
     return false;
   }
-  for (uint i = 0; i < event.getHits().size(); i++) {
-    for (uint j = i + 1; j < event.getHits().size(); j++) {
-      JPetHit primaryHit, scatterHit;
-      if (event.getHits().at(i).getTime() < event.getHits().at(j).getTime()) {
-        primaryHit = event.getHits().at(i);
-        scatterHit = event.getHits().at(j);
-      } else {
-        primaryHit = event.getHits().at(j);
-        scatterHit = event.getHits().at(i);
+  for (uint i = 0; i < hits.size(); i++) {
+    for (uint j = i + 1; j < hits.size(); j++) {
+      uint primary = i, scatter = j;
+      if (hitQuantities.at(i).time >= hitQuantities.at(j).time) {
+        primary = j;
+        scatter = i;
       }
+      const JPetHit& primaryHit = hits.at(primary);
+      const JPetHit& scatterHit = hits.at(scatter);
 
       double scattAngle = calculateScatteringAngle(primaryHit, scatterHit);
       double scattTOF = calculateScatteringTime(primaryHit, scatterHit);
-      double timeDiff = scatterHit.getTime() - primaryHit.getTime();
+      double timeDiff = hitQuantities.at(scatter).time - hitQuantities.at(primary).time;
 
       if (saveHistos) {
         stats.fillHistogram("ScatterTOF_TimeDiff", fabs(scattTOF - timeDiff));
@@ -158,10 +256,8 @@ bool EventCategorizerTools::checkForScatter(
 
       if (fabs(scattTOF - timeDiff) < scatterTOFTimeDiff) {
         if (saveHistos) {
-          stats.fillHistogram("ScatterAngle_PrimaryTOT", scattAngle, HitFinderTools::calculateTOT(primaryHit, 
-                                                        HitFinderTools::getTOTCalculationType(fTOTCalculationType)));
-          stats.fillHistogram("ScatterAngle_ScatterTOT", scattAngle, HitFinderTools::calculateTOT(scatterHit, 
-                                                        HitFinderTools::getTOTCalculationType(fTOTCalculationType)));
+          stats.fillHistogram("ScatterAngle_PrimaryTOT", scattAngle, hitQuantities.at(primary).tot);
+          stats.fillHistogram("ScatterAngle_ScatterTOT", scattAngle, hitQuantities.at(scatter).tot);
         }
         return true;
       }
@@ -208,14 +304,9 @@ TVector3 EventCategorizerTools::calculateAnnihilationPoint(const JPetHit& hitA,
 
 TVector3 EventCategorizerTools::calculateAnnihilationPoint(const TVector3& hitA, const TVector3& hitB, double tof)
 {
-  TVector3 middleOfLOR = 0.5 * (hitA + hitB);
-  TVector3 versorOnLOR = (hitB - hitA).Unit()  ;
-
-  double shift = 0.5 * tof  * kLightVelocity_cm_ps;
-  TVector3 annihilationPoint(middleOfLOR.X() + shift * versorOnLOR.X(),
-                             middleOfLOR.Y() + shift * versorOnLOR.Y(),
-                             middleOfLOR.Z() + shift * versorOnLOR.Z());
-  return annihilationPoint;
+  double x = 0.0, y = 0.0, z = 0.0;
+  AnnihilationPointTools::calculateAnnihilationPoint(hitA.X(), hitA.Y(), hitA.Z(), hitB.X(), hitB.Y(), hitB.Z(), tof, x, y, z);
+  return TVector3(x, y, z);
 }
 
 double EventCategorizerTools::calculateTOFByConvention(const JPetHit& hitA, const JPetHit& hitB)
@@ -19,6 +19,8 @@
 #include <JPetStatistics/JPetStatistics.h>
 #include <JPetEvent/JPetEvent.h>
 #include <JPetHit/JPetHit.h>
+#include "HitFinderTools.h"
+#include <vector>
 
 static const double kLightVelocity_cm_ps = 0.0299792458;
 static const double kUndefinedValue = 999.0;
@@ -40,6 +42,12 @@ public:
   static bool checkForScatter(const JPetEvent& event, JPetStatistics& stats,
                               bool saveHistos, double scatterTOFTimeDiff, 
                               std::string fTOTCalculationType);
+  /// Versions using quantities precalculated for event hits with HitFinderTools::calculateHitQuantities,
+  /// hitQuantities have to be aligned with event.getHits()
+  static bool checkForPrompt(const JPetEvent& event, const std::vector<HitFinderTools::HitQuantities>& hitQuantities,
+                             JPetStatistics& stats, bool saveHistos, double deexTOTCutMin, double deexTOTCutMax);
+  static bool checkForScatter(const JPetEvent& event, const std::vector<HitFinderTools::HitQuantities>& hitQuantities,
+                              JPetStatistics& stats, bool saveHistos, double scatterTOFTimeDiff);
   static double calculateDistance(const JPetHit& hit1, const JPetHit& hit2);
   static double calculateScatteringTime(const JPetHit& hit1, const JPetHit& hit2);
   static double calculateScatteringAngle(const JPetHit& hit1, const JPetHit& hit2);
@@ -56,6 +64,13 @@ public:
   static TVector3 calculateAnnihilationPoint(const TVector3& hitA, const TVector3& hitB, double tof);
   static double calculatePlaneCenterDistance(const JPetHit& firstHit,
       const JPetHit& secondHit, const JPetHit& thirdHit);
+  static double calculateSlotThetaDiff(const JPetHit& hit1, const JPetHit& hit2);
+  static bool isBackToBackPair(const JPetHit& hit1, const JPetHit& hit2,
+                               double b2bSlotThetaDiff, double b2bTimeDiff);
+  static bool findBackToBackPair(const std::vector<JPetHit>& hits,
+                                 double b2bSlotThetaDiff, double b2bTimeDiff);
+  /// Below this multiplicity checking all pairs of hits is faster than the search by slot theta
+  static const unsigned int kMinHitsForSlotSearch = 6;
 
 };
 
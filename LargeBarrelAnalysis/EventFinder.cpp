@@ -18,6 +18,8 @@ using namespace std;
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include <JPetWriter/JPetWriter.h>
 #include "EventFinder.h"
+#include "RawSignalTimes.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace jpet_options_tools;
@@ -78,20 +80,32 @@ bool EventFinder::init()
   
   // Initialize histograms
   if (fSaveControlHistos) { initialiseHistograms(); }
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  fCheckpoint.resume(getStatistics(), checkpointState);
   return true;
 }
 
 bool EventFinder::exec()
 {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetEvent>(fOutputEvents)) { return true; }
   if (auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent)) {
+    fAllocationCounter.startWindow();
     saveEvents(buildEvents(*timeWindow));
+    fAllocationCounter.finishWindow();
   } else { return false; }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents);
   return true;
 }
 
 bool EventFinder::terminate()
 {
-  INFO("Event fiding ended.");
+  INFO("Event fiding ended, " + fAllocationCounter.getSummary());
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fCheckpoint.finish();
   return true;
 }
 
@@ -104,15 +118,16 @@ void EventFinder::saveEvents(const vector<JPetEvent>& events)
 
 /**
  * Main method of building Events - Hit in the Time slot are groupped
- * within time parameter, that can be set by the user
+ * within time parameter, that can be set by the user.
+ * Events are stored in the vector reused in every time window.
  */
-vector<JPetEvent> EventFinder::buildEvents(const JPetTimeWindow& timeWindow)
+const vector<JPetEvent>& EventFinder::buildEvents(const JPetTimeWindow& timeWindow)
 {
-  vector<JPetEvent> eventVec;
+  fEvents.clear();
   const unsigned int nHits = timeWindow.getNumberOfEvents();
   unsigned int count = 0;
   while(count<nHits){
-    auto hit = dynamic_cast<const JPetHit&>(timeWindow.operator[](count));
+    const auto& hit = dynamic_cast<const JPetHit&>(timeWindow.operator[](count));
     if(!fUseCorruptedHits && hit.getRecoFlag()==JPetHit::Corrupted){
       count++;
       continue;
@@ -126,27 +141,27 @@ vector<JPetEvent> EventFinder::buildEvents(const JPetTimeWindow& timeWindow)
     } else if(hit.getRecoFlag() == JPetHit::Corrupted){
       event.setRecoFlag(JPetEvent::Corrupted);
     }
-    if (fSaveControlHistos) {
+    if (fFillControlHistos) {
       PlotTDiffAB(hit);
     }
     // Checking, if following hits fulfill time window condition,
     // then moving interator 
     unsigned int nextCount = 1;
     while(count+nextCount < nHits){
-      auto nextHit = dynamic_cast<const JPetHit&>(timeWindow.operator[](count+nextCount));
+      const auto& nextHit = dynamic_cast<const JPetHit&>(timeWindow.operator[](count+nextCount));
       if (fabs(nextHit.getTime() - hit.getTime()) < fEventTimeWindow) {
         if(nextHit.getRecoFlag() == JPetHit::Corrupted) {
           event.setRecoFlag(JPetEvent::Corrupted);
         }
         event.addHit(nextHit);
-        if (fSaveControlHistos) {
+        if (fFillControlHistos) {
           PlotTDiffAB(nextHit);
         }
         nextCount++;
       } else { break; }
     }
     count+=nextCount;
-    if(fSaveControlHistos) {
+    if(fFillControlHistos) {
       getStatistics().fillHistogram("hits_per_event_all", event.getHits().size());
       if(event.getRecoFlag()==JPetEvent::Good){
         getStatistics().fillHistogram("good_vs_bad_events", 1);
@@ -157,13 +172,13 @@ vector<JPetEvent> EventFinder::buildEvents(const JPetTimeWindow& timeWindow)
       }
     }
     if(event.getHits().size() >= fMinMultiplicity){
-      eventVec.push_back(event);
-      if(fSaveControlHistos) {
+      fAllocationCounter.pushBack(fEvents, event);
+      if(fFillControlHistos) {
         getStatistics().fillHistogram("hits_per_event_selected", event.getHits().size());
       }
     }
   }
-  return eventVec;
+  return fEvents;
 }
 
 void EventFinder::initialiseHistograms(){
@@ -197,19 +212,18 @@ void EventFinder::initialiseHistograms(){
   }
 }
 
-void EventFinder::PlotTDiffAB(JPetHit Hit)
+void EventFinder::PlotTDiffAB(const JPetHit& Hit)
 {
   double TDiff_AB = 0.;
-  std::map<int, double> sigALead = Hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> sigBLead = Hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
+  RawSignalTimes timesA(Hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes timesB(Hit.getSignalB().getRecoSignal().getRawSignal());
   unsigned ScintID = Hit.getScintillator().getID();
 
-  if (sigALead.size()>0 && sigBLead.size()>0) {
-    for (unsigned i=1; i<=sigALead.size() && i<=sigBLead.size(); i++) {
-      if (sigBLead.find(i) != sigBLead.end() || sigALead.find(i) != sigALead.end()) {
-        TDiff_AB = (sigBLead.find(i)->second - sigALead.find(i)->second);
-        getStatistics().fillHistogram(Form("TDiff_AB_vs_ID_thr%d", i), TDiff_AB, ScintID);
-      }
+  int numberOfThresholds = std::min(timesA.getNumberOfLeading(), timesB.getNumberOfLeading());
+  for (int i=1; i<=numberOfThresholds; i++) {
+    if (timesA.hasLeading(i) && timesB.hasLeading(i)) {
+      TDiff_AB = timesB.getLeading(i) - timesA.getLeading(i);
+      getStatistics().fillHistogram(Form("TDiff_AB_vs_ID_thr%d", i), TDiff_AB, ScintID);
     }
   }
 }
@@ -17,8 +17,11 @@
 #define EVENTFINDER_H
 
 #include <JPetUserTask/JPetUserTask.h>
+#include "ControlHistogramSampler.h"
+#include "TaskCheckpoint.h"
 #include <JPetEvent/JPetEvent.h>
 #include <JPetHit/JPetHit.h>
+#include "AllocationCounter.h"
 #include <vector>
 #include <map>
 
@@ -42,10 +45,10 @@ public:
   virtual bool exec() override;
   virtual bool terminate() override;
 
-  void PlotTDiffAB(JPetHit Hit);
+  void PlotTDiffAB(const JPetHit& Hit);
   
 protected:
-  std::vector<JPetEvent> buildEvents(const JPetTimeWindow & hits);
+  const std::vector<JPetEvent>& buildEvents(const JPetTimeWindow & hits);
   void saveEvents(const std::vector<JPetEvent>& event);
   void initialiseHistograms();
   const std::string kUseCorruptedHitsParamKey = "EventFinder_UseCorruptedHits_bool";
@@ -56,7 +59,12 @@ protected:
   double fEventTimeWindow = 5000.0;
   bool fUseCorruptedHits = false;
   bool fSaveControlHistos = true;
+  bool fFillControlHistos = true;
   uint fNmbOfThresholds = 4;
   uint fMinMultiplicity = 1;
+  std::vector<JPetEvent> fEvents;
+  AllocationCounter fAllocationCounter;
+  ControlHistogramSampler fHistogramSampler;
+  TaskCheckpoint fCheckpoint;
 };
 #endif /* !EVENTFINDER_H */
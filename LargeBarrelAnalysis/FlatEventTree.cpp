@@ -0,0 +1,232 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file FlatEventTree.cpp
+ */
+
+#include "FlatEventTree.h"
+#include "JPetLoggerInclude.h"
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <algorithm>
+
+using namespace jpet_options_tools;
+
+const std::string FlatEventWriter::kDirectoryParamKey = "FlatEvents_Directory_std::string";
+const std::string FlatEventWriter::kTreeName = "FlatEvents";
+
+namespace
+{
+const char* kEventTypeColumn = "eventType";
+const char* kScinIDColumn = "scinID";
+
+struct DoubleColumn
+{
+  const char* name;
+  std::vector<double> FlatEvent::*values;
+};
+
+const DoubleColumn kDoubleColumns[] = {{"time", &FlatEvent::time}, {"posX", &FlatEvent::posX}, {"posY", &FlatEvent::posY},
+                                       {"posZ", &FlatEvent::posZ}, {"tot", &FlatEvent::tot},   {"energy", &FlatEvent::energy}};
+
+bool isRequested(const std::vector<std::string>& columns, const std::string& column)
+{
+  return columns.empty() || std::find(columns.begin(), columns.end(), column) != columns.end();
+}
+}
+
+void FlatEvent::clear()
+{
+  eventType = 0;
+  time.clear();
+  posX.clear();
+  posY.clear();
+  posZ.clear();
+  tot.clear();
+  energy.clear();
+  scinID.clear();
+}
+
+FlatEventWriter::FlatEventWriter() {}
+
+FlatEventWriter::~FlatEventWriter() { close(); }
+
+std::string FlatEventWriter::getFileName(const OptsStrAny& opts, const std::string& taskName)
+{
+  if (!isOptionSet(opts, kDirectoryParamKey))
+  {
+    return "";
+  }
+  std::string inputFile = getInputFile(opts);
+  inputFile = inputFile.substr(inputFile.find_last_of('/') + 1);
+  const std::string extension = ".root";
+  if (inputFile.size() > extension.size() && inputFile.compare(inputFile.size() - extension.size(), extension.size(), extension) == 0)
+  {
+    inputFile.erase(inputFile.size() - extension.size());
+  }
+  return getOptionAsString(opts, kDirectoryParamKey) + "/" + inputFile + "." + taskName + ".flat.root";
+}
+
+bool FlatEventWriter::open(const std::string& fileName)
+{
+  close();
+  // Opening the file changes the current directory, objects created later by the task, like control histograms, must not be attached to it
+  TDirectory::TContext context;
+  fFile.reset(TFile::Open(fileName.c_str(), "RECREATE"));
+  if (!fFile || fFile->IsZombie())
+  {
+    fFile.reset();
+    return false;
+  }
+  fTree = new TTree(kTreeName.c_str(), "Categorized events with flat columns of hit quantities");
+  fTree->SetDirectory(fFile.get());
+  fTree->Branch(kEventTypeColumn, &fEvent.eventType, "eventType/i");
+  for (const auto& column : kDoubleColumns)
+  {
+    fTree->Branch(column.name, &(fEvent.*column.values));
+  }
+  fTree->Branch(kScinIDColumn, &fEvent.scinID);
+  return true;
+}
+
+bool FlatEventWriter::openFromOptions(const OptsStrAny& opts, const std::string& taskName)
+{
+  const auto fileName = getFileName(opts, taskName);
+  if (fileName.empty())
+  {
+    return true;
+  }
+  if (!open(fileName))
+  {
+    ERROR("Could not open the file for flat events: " + fileName);
+    return false;
+  }
+  INFO("Categorized events are also saved with flat columns in " + fileName);
+  return true;
+}
+
+void FlatEventWriter::fill(const JPetEvent& event, const std::vector<HitFinderTools::HitQuantities>& hitQuantities)
+{
+  if (!isOpen())
+  {
+    return;
+  }
+  fEvent.clear();
+  fEvent.eventType = static_cast<unsigned int>(event.getEventType());
+  const auto& hits = event.getHits();
+  const auto numberOfHits = std::min(hits.size(), hitQuantities.size());
+  for (std::size_t i = 0; i < numberOfHits; i++)
+  {
+    const auto& quantities = hitQuantities[i];
+    fEvent.time.push_back(quantities.time);
+    fEvent.posX.push_back(quantities.posX);
+    fEvent.posY.push_back(quantities.posY);
+    fEvent.posZ.push_back(quantities.posZ);
+    fEvent.tot.push_back(quantities.tot);
+    fEvent.energy.push_back(quantities.energy);
+    fEvent.scinID.push_back(hits[i].getScintillator().getID());
+  }
+  fTree->Fill();
+}
+
+void FlatEventWriter::fill(const JPetEvent& event, HitFinderTools::TOTCalculationType type)
+{
+  fHitQuantities.clear();
+  for (const auto& hit : event.getHits())
+  {
+    fHitQuantities.push_back(HitFinderTools::calculateHitQuantities(hit, type));
+  }
+  fill(event, fHitQuantities);
+}
+
+long long FlatEventWriter::getNumberOfEvents() const { return fTree ? fTree->GetEntries() : 0; }
+
+void FlatEventWriter::close()
+{
+  if (fFile)
+  {
+    // Writing needs the file as the current directory, the directory of the task is restored afterwards
+    TDirectory::TContext context;
+    fFile->cd();
+    fTree->Write();
+    fFile->Close();
+  }
+  fTree = nullptr;
+  fFile.reset();
+}
+
+FlatEventReader::FlatEventReader() {}
+
+FlatEventReader::~FlatEventReader() { close(); }
+
+bool FlatEventReader::open(const std::string& fileName, const std::vector<std::string>& columns)
+{
+  close();
+  TDirectory::TContext context;
+  fFile.reset(TFile::Open(fileName.c_str(), "READ"));
+  if (!fFile || fFile->IsZombie())
+  {
+    fFile.reset();
+    return false;
+  }
+  fTree = dynamic_cast<TTree*>(fFile->Get(FlatEventWriter::kTreeName.c_str()));
+  if (!fTree)
+  {
+    close();
+    return false;
+  }
+  fTree->SetBranchStatus("*", false);
+  if (isRequested(columns, kEventTypeColumn))
+  {
+    fTree->SetBranchStatus(kEventTypeColumn, true);
+    fTree->SetBranchAddress(kEventTypeColumn, &fEvent.eventType);
+  }
+  // addresses of the pointers given to the tree have to stay valid
+  fDoubleColumns.assign(sizeof(kDoubleColumns) / sizeof(kDoubleColumns[0]), nullptr);
+  for (std::size_t i = 0; i < fDoubleColumns.size(); i++)
+  {
+    if (isRequested(columns, kDoubleColumns[i].name))
+    {
+      fDoubleColumns[i] = &(fEvent.*kDoubleColumns[i].values);
+      fTree->SetBranchStatus(kDoubleColumns[i].name, true);
+      fTree->SetBranchAddress(kDoubleColumns[i].name, &fDoubleColumns[i]);
+    }
+  }
+  if (isRequested(columns, kScinIDColumn))
+  {
+    fScinIDColumn = &fEvent.scinID;
+    fTree->SetBranchStatus(kScinIDColumn, true);
+    fTree->SetBranchAddress(kScinIDColumn, &fScinIDColumn);
+  }
+  return true;
+}
+
+long long FlatEventReader::getNumberOfEvents() const { return fTree ? fTree->GetEntries() : 0; }
+
+const FlatEvent* FlatEventReader::getEvent(long long entry)
+{
+  if (!fTree || entry < 0 || entry >= fTree->GetEntries() || fTree->GetEntry(entry) <= 0)
+  {
+    return nullptr;
+  }
+  return &fEvent;
+}
+
+void FlatEventReader::close()
+{
+  fTree = nullptr;
+  fDoubleColumns.clear();
+  fScinIDColumn = nullptr;
+  fEvent.clear();
+  fFile.reset();
+}
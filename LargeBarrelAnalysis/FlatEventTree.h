@@ -0,0 +1,121 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file FlatEventTree.h
+ */
+
+#ifndef FLATEVENTTREE_H
+#define FLATEVENTTREE_H
+
+#include "HitFinderTools.h"
+#include <JPetEvent/JPetEvent.h>
+#include <JPetOptionsTools/JPetOptionsTools.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+
+/**
+ * @brief Quantities of one categorized event and its hits, stored as flat columns
+ *
+ * Vectors hold one element per hit, in the order of hits in the event.
+ * Event type is the bit mask of JPetEventType values.
+ */
+struct FlatEvent
+{
+  unsigned int eventType = 0;
+  std::vector<double> time;   ///< [ps]
+  std::vector<double> posX;   ///< [cm]
+  std::vector<double> posY;   ///< [cm]
+  std::vector<double> posZ;   ///< [cm]
+  std::vector<double> tot;    ///< [ps]
+  std::vector<double> energy; ///< energy stored in the hit
+  std::vector<int> scinID;
+
+  std::size_t getNumberOfHits() const { return time.size(); }
+  void clear();
+};
+
+/**
+ * @brief Writer of the tree of flat events, one entry per event, next to the output of a categorizer
+ *
+ * Columns of the tree "FlatEvents" are plain numbers and vectors of numbers, so the events can be
+ * re-analysed with TTree::Draw, RDataFrame or FlatEventReader without reading the JPetEvent objects.
+ *
+ * Options shared by the categorizer tasks:
+ * - "FlatEvents_Directory_std::string": if set, every categorizer writes its events to
+ *   <directory>/<input file without .root>.<task name>.flat.root
+ */
+class FlatEventWriter
+{
+public:
+  FlatEventWriter();
+  ~FlatEventWriter();
+  FlatEventWriter(const FlatEventWriter&) = delete;
+  FlatEventWriter& operator=(const FlatEventWriter&) = delete;
+
+  /// Empty name if flat events are not requested
+  static std::string getFileName(const jpet_options_tools::OptsStrAny& opts, const std::string& taskName);
+
+  bool open(const std::string& fileName);
+  /// Opens the file given by getFileName if flat events are requested, false only if the file cannot be opened
+  bool openFromOptions(const jpet_options_tools::OptsStrAny& opts, const std::string& taskName);
+  bool isOpen() const { return fTree != nullptr; }
+  /// Hit quantities have to be aligned with the hits of the event
+  void fill(const JPetEvent& event, const std::vector<HitFinderTools::HitQuantities>& hitQuantities);
+  void fill(const JPetEvent& event, HitFinderTools::TOTCalculationType type);
+  long long getNumberOfEvents() const;
+  /// Writes the tree and closes the file
+  void close();
+
+  static const std::string kDirectoryParamKey;
+  static const std::string kTreeName;
+
+private:
+  std::unique_ptr<TFile> fFile;
+  TTree* fTree = nullptr;
+  FlatEvent fEvent;
+  std::vector<HitFinderTools::HitQuantities> fHitQuantities;
+};
+
+/**
+ * @brief Reader of the tree of flat events
+ *
+ * Only the given columns are read, all of them if none are given, other vectors of the event stay empty.
+ * Returned event is reused for every entry.
+ */
+class FlatEventReader
+{
+public:
+  FlatEventReader();
+  ~FlatEventReader();
+  FlatEventReader(const FlatEventReader&) = delete;
+  FlatEventReader& operator=(const FlatEventReader&) = delete;
+
+  bool open(const std::string& fileName, const std::vector<std::string>& columns = {});
+  bool isOpen() const { return fTree != nullptr; }
+  long long getNumberOfEvents() const;
+  /// nullptr if the entry cannot be read
+  const FlatEvent* getEvent(long long entry);
+  void close();
+
+private:
+  std::unique_ptr<TFile> fFile;
+  TTree* fTree = nullptr;
+  FlatEvent fEvent;
+  std::vector<std::vector<double>*> fDoubleColumns;
+  std::vector<int>* fScinIDColumn = nullptr;
+};
+
+#endif /* !FLATEVENTTREE_H */
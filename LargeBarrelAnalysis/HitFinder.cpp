@@ -91,10 +91,10 @@ bool HitFinder::init()
     fSaveControlHistos = getOptionAsBool(fParams.getOptions(), kSaveControlHistosParamKey);
   }
 
-  // Use of velocities file
+  // Use of velocities file or of the calibration store
   JPetGeomMapping mapper(getParamBank());
   auto tombMap = mapper.getTOMBMapping();
-  fVelocities = UniversalFileLoader::loadConfigurationParameters(velocitiesFile, tombMap);
+  fVelocities = UniversalFileLoader::loadConfigurationParameters(fParams.getOptions(), "Velocities", velocitiesFile, tombMap);
   if (fVelocities.empty())
   {
     ERROR("Velocities map seems to be empty");
@@ -139,7 +139,7 @@ bool HitFinder::init()
   }
   if (isOptionSet(fParams.getOptions(), kTOTCalculationType))
   {
-    fTOTCalculationType = getOptionAsString(fParams.getOptions(), kTOTCalculationType);
+    fTOTCalculationType = HitFinderTools::getTOTCalculationType(getOptionAsString(fParams.getOptions(), kTOTCalculationType));
   }
   else
   {
@@ -151,51 +151,77 @@ bool HitFinder::init()
   {
     initialiseHistograms();
   }
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  fCheckpoint.resume(getStatistics(), checkpointState);
   return true;
 }
 
 bool HitFinder::exec()
 {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetHit>(fOutputEvents))
+  {
+    return true;
+  }
   if (auto& timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent))
   {
-    auto signalsBySlot = HitFinderTools::getSignalsBySlot(timeWindow, fUseCorruptedSignals);
+    fAllocationCounter.startWindow();
+    HitFinderTools::getSignalsBySlot(timeWindow, fUseCorruptedSignals, fSignalsBySlot, fAllocationCounter);
     auto totConverter = fToTConverterFactory.getEnergyConverter();
-    auto allHits = HitFinderTools::matchAllSignals(signalsBySlot, fVelocities, fABTimeDiff, fRefDetScinID, fConvertToT, totConverter, getStatistics(),
-                                                   fSaveControlHistos);
-    if (fSaveControlHistos)
+    auto allHits = HitFinderTools::matchAllSignals(fSignalsBySlot, fVelocities, fABTimeDiff, fRefDetScinID, fConvertToT, totConverter, getStatistics(),
+                                                   fFillControlHistos);
+    if (fFillControlHistos)
     {
       getStatistics().fillHistogram("hits_per_time_slot", allHits.size());
     }
+    auto sortedHits = JPetAnalysisTools::getHitsOrderedByTime(allHits);
+    // TOTs are calculated once per hit and shared by synchronization and control histograms
+    std::vector<HitFinderTools::HitQuantities> hitQuantities;
+    if (fSyncToT || fFillControlHistos)
+    {
+      hitQuantities = HitFinderTools::calculateHitQuantities(sortedHits, fTOTCalculationType);
+    }
     if (fSyncToT)
     {
-      HitFinderTools::saveTOTsync(allHits, fTOTCalculationType, fConstantsTree);
+      HitFinderTools::saveTOTsync(sortedHits, hitQuantities, fConstantsTree);
     }
-    saveHits(allHits);
+    saveHits(sortedHits, hitQuantities);
+    fAllocationCounter.finishWindow();
   }
   else
     return false;
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents);
   return true;
 }
 
 bool HitFinder::terminate()
 {
-  INFO("Hit finding ended");
+  INFO("Hit finding ended, " + fAllocationCounter.getSummary());
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fCheckpoint.finish();
   return true;
 }
 
-void HitFinder::saveHits(const std::vector<JPetHit>& hits)
+/**
+ * Saving hits, already sorted by time, hit quantities are used for control histograms
+ * and have to be aligned with the hits if histograms are saved
+ */
+void HitFinder::saveHits(const std::vector<JPetHit>& hits, const std::vector<HitFinderTools::HitQuantities>& hitQuantities)
 {
-  auto sortedHits = JPetAnalysisTools::getHitsOrderedByTime(hits);
-  for (const auto& hit : sortedHits)
+  for (unsigned int i = 0; i < hits.size(); i++)
   {
-    if (fSaveControlHistos)
+    const auto& hit = hits[i];
+    if (fFillControlHistos)
     {
-      auto tot = HitFinderTools::calculateTOT(hit, HitFinderTools::getTOTCalculationType(fTOTCalculationType));
+      auto tot = hitQuantities[i].tot;
       // synchronization
       if (fSyncToT)
       {
 	//ToDo change getEnergy() to getTOT() once implemented
-        getStatistics().fillHistogram("SyncTOT_all_hits", hit.getEnergy());
+        getStatistics().fillHistogram("SyncTOT_all_hits", hitQuantities[i].energy);
       }
       getStatistics().fillHistogram("TOT_all_hits", tot);
       getStatistics().fillHistogram("tot_per_scin", tot, (float)(hit.getScintillator().getID()));
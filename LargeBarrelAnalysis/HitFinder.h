@@ -16,10 +16,13 @@
 #ifndef HITFINDER_H
 #define HITFINDER_H
 
+#include "HitFinderTools.h"
 #include "ToTEnergyConverterFactory.h"
 #include <JPetHit/JPetHit.h>
 #include <JPetRawSignal/JPetRawSignal.h>
 #include <JPetUserTask/JPetUserTask.h>
+#include "ControlHistogramSampler.h"
+#include "TaskCheckpoint.h"
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <map>
@@ -45,7 +48,7 @@ public:
   virtual bool terminate() override;
 
 protected:
-  void saveHits(const std::vector<JPetHit>& hits);
+  void saveHits(const std::vector<JPetHit>& hits, const std::vector<HitFinderTools::HitQuantities>& hitQuantities);
   void initialiseHistograms();
   std::map<unsigned int, std::vector<double>> fVelocities;
   const std::string kUseCorruptedSignalsParamKey = "HitFinder_UseCorruptedSignals_bool";
@@ -60,12 +63,17 @@ protected:
   ToTEnergyConverterFactory fToTConverterFactory;
   bool fUseCorruptedSignals = false;
   bool fSaveControlHistos = true;
+  bool fFillControlHistos = true;
   bool fConvertToT = false;
   double fABTimeDiff = 6000.0;
   int fRefDetScinID = -1;
-  std::string fTOTCalculationType = "";
+  HitFinderTools::TOTCalculationType fTOTCalculationType = HitFinderTools::kSimplified;
   bool fSyncToT = false;
   boost::property_tree::ptree fConstantsTree;
+  std::map<int, std::vector<JPetPhysSignal>> fSignalsBySlot;
+  AllocationCounter fAllocationCounter;
+  ControlHistogramSampler fHistogramSampler;
+  TaskCheckpoint fCheckpoint;
 };
 
 #endif /* !HITFINDER_H */
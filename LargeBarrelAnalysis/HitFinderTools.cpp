@@ -37,33 +37,34 @@ void HitFinderTools::sortByTime(vector<JPetPhysSignal>& sigVec)
 map<int, vector<JPetPhysSignal>> HitFinderTools::getSignalsBySlot(const JPetTimeWindow* timeWindow, bool useCorrupts)
 {
   map<int, vector<JPetPhysSignal>> signalSlotMap;
+  AllocationCounter counter;
+  getSignalsBySlot(timeWindow, useCorrupts, signalSlotMap, counter);
+  return signalSlotMap;
+}
+
+/**
+ * Version distributing Signals into buffers reused between time windows,
+ * vectors of slots without Signals in this time window are left empty
+ */
+void HitFinderTools::getSignalsBySlot(const JPetTimeWindow* timeWindow, bool useCorrupts, map<int, vector<JPetPhysSignal>>& signalsBySlot,
+                                      AllocationCounter& counter)
+{
+  AllocationCounter::clearBuffers(signalsBySlot);
   if (!timeWindow)
   {
     WARNING("Pointer of Time Window object is not set, returning empty map");
-    return signalSlotMap;
+    return;
   }
   const unsigned int nSignals = timeWindow->getNumberOfEvents();
   for (unsigned int i = 0; i < nSignals; i++)
   {
-    auto physSig = dynamic_cast<const JPetPhysSignal&>(timeWindow->operator[](i));
+    const auto& physSig = dynamic_cast<const JPetPhysSignal&>(timeWindow->operator[](i));
     if (!useCorrupts && physSig.getRecoFlag() == JPetBaseSignal::Corrupted)
     {
       continue;
     }
-    int slotID = physSig.getBarrelSlot().getID();
-    auto search = signalSlotMap.find(slotID);
-    if (search == signalSlotMap.end())
-    {
-      vector<JPetPhysSignal> tmp;
-      tmp.push_back(physSig);
-      signalSlotMap.insert(pair<int, vector<JPetPhysSignal>>(slotID, tmp));
-    }
-    else
-    {
-      search->second.push_back(physSig);
-    }
+    counter.pushBack(counter.getBuffer(signalsBySlot, physSig.getBarrelSlot().getID()), physSig);
   }
-  return signalSlotMap;
 }
 
 /**
@@ -362,13 +363,52 @@ double HitFinderTools::calculateTOTside(const std::map<int, double>& thrToTOT_si
     return 0;
   return tot;
 }
+
+HitFinderTools::HitQuantities HitFinderTools::calculateHitQuantities(const JPetHit& hit, TOTCalculationType type)
+{
+  HitQuantities quantities;
+  quantities.tot = calculateTOT(hit, type);
+  quantities.energy = hit.getEnergy();
+  quantities.time = hit.getTime();
+  const TVector3& pos = hit.getPos();
+  quantities.posX = pos.X();
+  quantities.posY = pos.Y();
+  quantities.posZ = pos.Z();
+  quantities.distance = pos.Mag();
+  return quantities;
+}
+
+/**
+ * Quantities of all hits, calculated once, with the same order as the hits vector
+ */
+std::vector<HitFinderTools::HitQuantities> HitFinderTools::calculateHitQuantities(const std::vector<JPetHit>& hits, TOTCalculationType type)
+{
+  std::vector<HitQuantities> hitQuantities;
+  hitQuantities.reserve(hits.size());
+  for (const auto& hit : hits)
+  {
+    hitQuantities.push_back(calculateHitQuantities(hit, type));
+  }
+  return hitQuantities;
+}
+
 void HitFinderTools::saveTOTsync(std::vector<JPetHit>& hits, std::string TOTCalculationType, const boost::property_tree::ptree& syncTree)
 {
-  for (auto& hit : hits)
+  auto hitQuantities = calculateHitQuantities(hits, getTOTCalculationType(TOTCalculationType));
+  saveTOTsync(hits, hitQuantities, syncTree);
+}
+
+/**
+ * Synchronization of TOTs already calculated for the hits, synchronized value is saved
+ * as the energy of the hit and of its quantities
+ */
+void HitFinderTools::saveTOTsync(std::vector<JPetHit>& hits, std::vector<HitQuantities>& hitQuantities, const boost::property_tree::ptree& syncTree)
+{
+  for (unsigned int i = 0; i < hits.size() && i < hitQuantities.size(); i++)
   {
-    auto tot = HitFinderTools::calculateTOT(hit, HitFinderTools::getTOTCalculationType(TOTCalculationType));
-    tot = HitFinderTools::syncTOT(hit, tot, syncTree);
-    hit.setEnergy(tot);
+    auto tot = HitFinderTools::syncTOT(hits[i], hitQuantities[i].tot, syncTree);
+    hits[i].setEnergy(tot);
+    hitQuantities[i].energy = tot;
   }
 }
 double HitFinderTools::syncTOT(const JPetHit& hit, double TOT, const boost::property_tree::ptree& syncTree)
@@ -16,6 +16,7 @@
 #ifndef HITFINDERTOOLS_H
 #define HITFINDERTOOLS_H
 
+#include "AllocationCounter.h"
 #include "ToTEnergyConverter.h"
 #include <JPetHit/JPetHit.h>
 #include <JPetStatistics/JPetStatistics.h>
@@ -40,8 +41,26 @@ public:
     kThresholdRectangular,
     kThresholdTrapeze
   };
+  /**
+   * @brief Quantities derived from a hit, calculated once and kept in a vector aligned with the hits
+   *
+   * Users of many hits (e.g. categorizers checking all pairs) read them from here
+   * instead of recalculating the TOT from the raw signals and copying TVector3 for each access.
+   */
+  struct HitQuantities
+  {
+    double tot = 0.0;      ///< TOT [ps] calculated with the requested TOTCalculationType
+    double energy = 0.0;   ///< energy stored in the hit (deposited energy or synchronized TOT)
+    double time = 0.0;     ///< hit time [ps]
+    double posX = 0.0;     ///< [cm]
+    double posY = 0.0;     ///< [cm]
+    double posZ = 0.0;     ///< [cm]
+    double distance = 0.0; ///< distance of the hit from the center of the detector [cm]
+  };
   static void sortByTime(std::vector<JPetPhysSignal>& signals);
   static std::map<int, std::vector<JPetPhysSignal>> getSignalsBySlot(const JPetTimeWindow* timeWindow, bool useCorrupts);
+  static void getSignalsBySlot(const JPetTimeWindow* timeWindow, bool useCorrupts, std::map<int, std::vector<JPetPhysSignal>>& signalsBySlot,
+                               AllocationCounter& counter);
   static std::vector<JPetHit> matchAllSignals(std::map<int, std::vector<JPetPhysSignal>>& allSignals,
                                               const std::map<unsigned int, std::vector<double>>& velocitiesMap, double timeDiffAB, int refDetScinId,
                                               bool convertToT, const tot_energy_converter::ToTEnergyConverter& totConverter, JPetStatistics& stats,
@@ -58,7 +77,10 @@ public:
   static TOTCalculationType getTOTCalculationType(const std::string& type);
   static double calculateTOT(const JPetHit& hit, TOTCalculationType type = kSimplified);
   static double calculateTOTside(const std::map<int, double>& thrToTOT_side, TOTCalculationType type);
+  static HitQuantities calculateHitQuantities(const JPetHit& hit, TOTCalculationType type);
+  static std::vector<HitQuantities> calculateHitQuantities(const std::vector<JPetHit>& hits, TOTCalculationType type);
   static void saveTOTsync(std::vector<JPetHit>& hits, std::string TOTCalculationType, const boost::property_tree::ptree& syncTree);
+  static void saveTOTsync(std::vector<JPetHit>& hits, std::vector<HitQuantities>& hitQuantities, const boost::property_tree::ptree& syncTree);
   static double syncTOT(const JPetHit& hit, double TOT, const boost::property_tree::ptree& syncTree);
 };
 
@@ -0,0 +1,106 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file InstrumentedTask.h
+ */
+
+#ifndef INSTRUMENTEDTASK_H
+#define INSTRUMENTEDTASK_H
+
+#include "TaskTelemetry.h"
+#include <JPetLoggerInclude.h>
+#include <JPetOptionsTools/JPetOptionsTools.h>
+#include <JPetTimeWindow/JPetTimeWindow.h>
+#include <chrono>
+#include <string>
+
+/**
+ * @brief Wrapper of any user task collecting its performance metrics, see TaskTelemetry
+ *
+ * Tasks are registered in the manager wrapped, with no changes to the tasks themselves:
+ * manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+ *
+ * Metrics are collected and written only if the output file is given in user parameters:
+ * - "Telemetry_OutFile_std::string": file, to which metrics of every task and input file are appended,
+ *   as JSON Lines if the name ends with .json or .jsonl, as plain text otherwise
+ * Otherwise the calls are only forwarded to the task.
+ */
+template <class Task>
+class InstrumentedTask : public Task
+{
+public:
+  explicit InstrumentedTask(const char* name) : Task(name), fTelemetry(name) {}
+
+  virtual bool init() override
+  {
+    using namespace jpet_options_tools;
+    const auto& opts = this->fParams.getOptions();
+    fEnabled = isOptionSet(opts, kOutFileParamKey);
+    if (!fEnabled)
+    {
+      return Task::init();
+    }
+    fOutFile = getOptionAsString(opts, kOutFileParamKey);
+    fTelemetry.setInputFile(getInputFile(opts));
+    const auto start = Clock::now();
+    const bool result = Task::init();
+    fTelemetry.recordInit(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    return result;
+  }
+
+  virtual bool exec() override
+  {
+    if (!fEnabled)
+    {
+      return Task::exec();
+    }
+    unsigned long inputObjects = 0;
+    if (auto timeWindow = dynamic_cast<const JPetTimeWindow*>(this->fEvent))
+    {
+      inputObjects = timeWindow->getNumberOfEvents();
+    }
+    const auto start = Clock::now();
+    const bool result = Task::exec();
+    const double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    const unsigned long outputObjects = this->fOutputEvents ? this->fOutputEvents->getNumberOfEvents() : 0;
+    fTelemetry.recordExec(elapsed, inputObjects, outputObjects);
+    return result;
+  }
+
+  virtual bool terminate() override
+  {
+    if (!fEnabled)
+    {
+      return Task::terminate();
+    }
+    const auto start = Clock::now();
+    const bool result = Task::terminate();
+    fTelemetry.recordTerminate(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    fTelemetry.recordProcessPeakRSS(TaskTelemetry::readProcessPeakRSS());
+    if (!fTelemetry.write(fOutFile))
+    {
+      WARNING("Could not write performance metrics of the task to the file: " + fOutFile);
+    }
+    return result;
+  }
+
+  const TaskTelemetry& getTelemetry() const { return fTelemetry; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  const std::string kOutFileParamKey = "Telemetry_OutFile_std::string";
+  TaskTelemetry fTelemetry;
+  std::string fOutFile;
+  bool fEnabled = false;
+};
+
+#endif /* !INSTRUMENTEDTASK_H */
@@ -0,0 +1,115 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file RawSignalTimes.h
+ */
+
+#ifndef RAWSIGNALTIMES_H
+#define RAWSIGNALTIMES_H
+
+#include <JPetRawSignal/JPetRawSignal.h>
+#include <JPetSigCh/JPetSigCh.h>
+
+/**
+ * @brief Leading and trailing times of a raw signal with their DAQ channels, indexed by threshold number
+ *
+ * Replaces maps returned by JPetRawSignal::getTimesVsThresholdNumber in tasks, that look up times
+ * of every hit by threshold number. Thresholds are numbered from 1 to kMaxThresholds, points with other
+ * threshold numbers are skipped. If there are more points of one threshold on an edge, the last one
+ * is kept, as in the map. Validity of the times is kept as a bit mask with bit (thr - 1) set
+ * for threshold thr. Times are kept in fixed arrays, so filling the object again with the next signal
+ * allocates only the copies of points returned by JPetRawSignal::getPoints (the framework gives no access
+ * to the points without copying them), while the maps allocated also a node for every threshold.
+ */
+class RawSignalTimes
+{
+public:
+  static const int kMaxThresholds = 4;
+
+  RawSignalTimes() = default;
+  explicit RawSignalTimes(const JPetRawSignal& signal) { fill(signal); }
+
+  void fill(const JPetRawSignal& signal)
+  {
+    clear();
+    for (const auto& sigCh : signal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum))
+    {
+      addPoint(fLeading, sigCh);
+    }
+    for (const auto& sigCh : signal.getPoints(JPetSigCh::Trailing, JPetRawSignal::ByThrNum))
+    {
+      addPoint(fTrailing, sigCh);
+    }
+  }
+
+  void clear()
+  {
+    fLeading.mask = 0;
+    fTrailing.mask = 0;
+  }
+
+  static bool isValidThreshold(int thr) { return thr >= 1 && thr <= kMaxThresholds; }
+
+  bool hasLeading(int thr) const { return fLeading.has(thr); }
+  bool hasTrailing(int thr) const { return fTrailing.has(thr); }
+  bool hasBothEdges(int thr) const { return hasLeading(thr) && hasTrailing(thr); }
+
+  /// Times in ps, valid only if the threshold has a point on the edge
+  double getLeading(int thr) const { return fLeading.times[thr - 1]; }
+  double getTrailing(int thr) const { return fTrailing.times[thr - 1]; }
+  double getTOT(int thr) const { return getTrailing(thr) - getLeading(thr); }
+
+  int getLeadingDAQch(int thr) const { return fLeading.daqChannels[thr - 1]; }
+  int getTrailingDAQch(int thr) const { return fTrailing.daqChannels[thr - 1]; }
+
+  unsigned int getLeadingMask() const { return fLeading.mask; }
+  unsigned int getTrailingMask() const { return fTrailing.mask; }
+  int getNumberOfLeading() const { return countBits(fLeading.mask); }
+  int getNumberOfTrailing() const { return countBits(fTrailing.mask); }
+
+private:
+  struct Edge
+  {
+    double times[kMaxThresholds];
+    int daqChannels[kMaxThresholds];
+    unsigned int mask = 0;
+
+    bool has(int thr) const { return isValidThreshold(thr) && (mask & (1u << (thr - 1))); }
+  };
+
+  static void addPoint(Edge& edge, const JPetSigCh& sigCh)
+  {
+    const int thr = sigCh.getThresholdNumber();
+    if (!isValidThreshold(thr))
+    {
+      return;
+    }
+    edge.times[thr - 1] = sigCh.getValue();
+    edge.daqChannels[thr - 1] = sigCh.getDAQch();
+    edge.mask |= 1u << (thr - 1);
+  }
+
+  static int countBits(unsigned int mask)
+  {
+    int bits = 0;
+    for (; mask; mask &= mask - 1)
+    {
+      bits++;
+    }
+    return bits;
+  }
+
+  Edge fLeading;
+  Edge fTrailing;
+};
+
+#endif /* !RAWSIGNALTIMES_H */
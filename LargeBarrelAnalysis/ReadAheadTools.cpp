@@ -0,0 +1,85 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ReadAheadTools.cpp
+ */
+
+#include "ReadAheadTools.h"
+#include <RConfigure.h>
+#include <TEnv.h>
+#include <TROOT.h>
+#include <TTreeCacheUnzip.h>
+#include <algorithm>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <iostream>
+#include <thread>
+
+const std::string ReadAheadTools::kEnableKey = "ReadAhead_Enable_bool";
+const std::string ReadAheadTools::kNumberOfThreadsKey = "ReadAhead_NumberOfThreads_int";
+const std::string ReadAheadTools::kCacheSizeFactorKey = "ReadAhead_CacheSizeFactor_float";
+const std::string ReadAheadTools::kUnzipBufferFactorKey = "ReadAhead_UnzipBufferFactor_float";
+
+ReadAheadSettings ReadAheadTools::readSettings(int argc, const char* argv[])
+{
+  for (int i = 1; i + 1 < argc; i++)
+  {
+    const std::string argument = argv[i];
+    if (argument == "-u" || argument == "--userCfg")
+    {
+      return readSettings(argv[i + 1]);
+    }
+  }
+  return ReadAheadSettings();
+}
+
+ReadAheadSettings ReadAheadTools::readSettings(const std::string& userParamsFile)
+{
+  ReadAheadSettings settings;
+  boost::property_tree::ptree userParams;
+  try
+  {
+    boost::property_tree::read_json(userParamsFile, userParams);
+  }
+  catch (const boost::property_tree::json_parser_error&)
+  {
+    // the framework reports problems with user parameters file itself
+    return settings;
+  }
+  // option names are single keys, not paths
+  using Path = boost::property_tree::ptree::path_type;
+  settings.enabled = userParams.get<bool>(Path(kEnableKey, '/'), settings.enabled);
+  settings.numberOfThreads = std::max(userParams.get<int>(Path(kNumberOfThreadsKey, '/'), settings.numberOfThreads), 0);
+  settings.cacheSizeFactor = userParams.get<float>(Path(kCacheSizeFactorKey, '/'), settings.cacheSizeFactor);
+  settings.unzipBufferFactor = userParams.get<float>(Path(kUnzipBufferFactorKey, '/'), settings.unzipBufferFactor);
+  if (settings.cacheSizeFactor <= 0.f || settings.unzipBufferFactor <= 0.f)
+  {
+    std::cerr << "Read-ahead buffer sizes have to be positive, read-ahead disabled" << std::endl;
+    settings.enabled = false;
+  }
+  return settings;
+}
+
+void ReadAheadTools::enableReadAhead(const ReadAheadSettings& settings)
+{
+  if (!settings.enabled)
+  {
+    return;
+  }
+  gEnv->SetValue("TTreeCache.Size", settings.cacheSizeFactor);
+  TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  TTreeCacheUnzip::SetUnzipRelBufferSize(settings.unzipBufferFactor);
+#ifdef R__USE_IMT
+  // baskets are decompressed by tasks of the ROOT thread pool
+  ROOT::EnableImplicitMT(settings.numberOfThreads > 0 ? settings.numberOfThreads : std::max(std::thread::hardware_concurrency(), 1u));
+#endif
+}
@@ -0,0 +1,73 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file ReadAheadTools.h
+ */
+
+#ifndef READAHEADTOOLS_H
+#define READAHEADTOOLS_H
+
+#include <string>
+
+/**
+ * @brief Settings of reading ahead the input time windows, see ReadAheadTools
+ */
+struct ReadAheadSettings
+{
+  /// Disabled by default, as the threads compete with other jobs running on the same machine
+  bool enabled = false;
+  /// Threads decompressing baskets, 0 means all available hardware threads
+  unsigned int numberOfThreads = 2;
+  /// Size of the tree cache, as multiple of the size of one cluster of entries written at once
+  float cacheSizeFactor = 2.f;
+  /// Size of the buffer for baskets decompressed ahead, as multiple of the cache size
+  float unzipBufferFactor = 1.f;
+};
+
+/**
+ * @brief Tools overlapping decompression of the input time windows with processing in tasks
+ *
+ * Time windows are read by the framework with TTree::GetEntry, which, by default, decompresses
+ * baskets only when an entry is requested, so decompression and exec() of the task alternate.
+ * With read-ahead enabled, the tree cache loads the following cluster of entries at once,
+ * and the baskets are decompressed on background threads while current time window is processed.
+ * Memory used for that is bounded: (1 + unzipBufferFactor) * cacheSizeFactor * cluster size, per input file.
+ * Settings are global, so they apply to every task registered in the manager, they have to be enabled
+ * in main(), before the manager is run.
+ *
+ * Settings are read from the user parameters file passed with -u/--userCfg:
+ * - "ReadAhead_Enable_bool": false by default
+ * - "ReadAhead_NumberOfThreads_int": 2 by default, 0 means all hardware threads
+ * - "ReadAhead_CacheSizeFactor_float"
+ * - "ReadAhead_UnzipBufferFactor_float"
+ */
+class ReadAheadTools
+{
+public:
+  /// Settings from the user parameters file given in the command line, defaults if there is none
+  static ReadAheadSettings readSettings(int argc, const char* argv[]);
+  static ReadAheadSettings readSettings(const std::string& userParamsFile);
+  static void enableReadAhead(const ReadAheadSettings& settings);
+
+  static const std::string kEnableKey;
+  static const std::string kNumberOfThreadsKey;
+  static const std::string kCacheSizeFactorKey;
+  static const std::string kUnzipBufferFactorKey;
+
+private:
+  ReadAheadTools() = delete;
+  ~ReadAheadTools() = delete;
+  ReadAheadTools(const ReadAheadTools&) = delete;
+  ReadAheadTools& operator=(const ReadAheadTools&) = delete;
+};
+
+#endif /* !READAHEADTOOLS_H */
@@ -86,29 +86,41 @@ bool SignalFinder::init()
 
   // Creating control histograms
   if(fSaveControlHistos) { initialiseHistograms(); }
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  fCheckpoint.resume(getStatistics(), checkpointState);
   return true;
 }
 
 bool SignalFinder::exec()
 {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetRawSignal>(fOutputEvents)) { return true; }
   // Getting the data from event in an apropriate format
   if(auto timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent)) {
+    fBuffers.counter.startWindow();
     // Distribute signal channels by PM IDs and filter out Corrupted SigChs if requested
-    auto& sigChByPM = SignalFinderTools::getSigChByPM(timeWindow, fUseCorruptedSigCh, fRefPMID);
+    SignalFinderTools::getSigChByPM(timeWindow, fUseCorruptedSigCh, fRefPMID, fBuffers);
     // Building signals
-    auto allSignals = SignalFinderTools::buildAllSignals(
-      sigChByPM, fSigChEdgeMaxTime, fSigChLeadTrailMaxTime,
-      getStatistics(), fSaveControlHistos, fThresholdOrderings
+    SignalFinderTools::buildAllSignals(
+      fBuffers.sigChByPM, fSigChEdgeMaxTime, fSigChLeadTrailMaxTime,
+      getStatistics(), fFillControlHistos, fThresholdOrderings, fBuffers
     );
     // Saving method invocation
-    saveRawSignals(allSignals);
+    saveRawSignals(fBuffers.rawSignals);
+    fBuffers.counter.finishWindow();
   } else { return false; }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents);
   return true;
 }
 
 bool SignalFinder::terminate()
 {
-  INFO("Signal finding ended.");
+  INFO("Signal finding ended, " + fBuffers.counter.getSummary());
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fCheckpoint.finish();
   return true;
 }
 
@@ -18,6 +18,8 @@
 
 #include <JPetRawSignal/JPetRawSignal.h>
 #include <JPetUserTask/JPetUserTask.h>
+#include "ControlHistogramSampler.h"
+#include "TaskCheckpoint.h"
 #include "SignalFinderTools.h"
 #include <vector>
 
@@ -41,6 +43,7 @@ public:
 
 protected:
   SignalFinderTools::ThresholdOrderings fThresholdOrderings;
+  SignalFinderTools::Buffers fBuffers;
   void saveRawSignals(const std::vector<JPetRawSignal>& sigChVec);
   const std::string kUseCorruptedSigChParamKey = "SignalFinder_UseCorruptedSigCh_bool";
   const std::string kLeadTrailMaxTimeParamKey = "SignalFinder_LeadTrailMaxTime_float";
@@ -53,9 +56,12 @@ protected:
   double fSigChEdgeMaxTime = 5000.0;
   bool fUseCorruptedSigCh = false;
   bool fSaveControlHistos = true;
+  bool fFillControlHistos = true;
   bool fOrderThresholdsByValue = false;
   int fRefPMID = 385;
   void initialiseHistograms();
+  ControlHistogramSampler fHistogramSampler;
+  TaskCheckpoint fCheckpoint;
 };
 
 #endif /* !SIGNALFINDER_H */
@@ -24,10 +24,22 @@ const SignalFinderTools::Permutation SignalFinderTools::kIdentity = {0,1,2,3};
 const map<int, vector<JPetSigCh>> SignalFinderTools::getSigChByPM(
      const JPetTimeWindow* timeWindow, bool useCorrupts, int refPMID
 ){
-  map<int, vector<JPetSigCh>> sigChsPMMap;
+  Buffers buffers;
+  getSigChByPM(timeWindow, useCorrupts, refPMID, buffers);
+  return buffers.sigChByPM;
+}
+
+/**
+ * Method distributing JPetSigCh by photomultiplier ID into the reused buffers.
+ * Vectors of photomultipliers without Signal Channels in this time window are left empty.
+ */
+void SignalFinderTools::getSigChByPM(
+     const JPetTimeWindow* timeWindow, bool useCorrupts, int refPMID, Buffers& buffers
+){
+  AllocationCounter::clearBuffers(buffers.sigChByPM);
   if (!timeWindow) {
     WARNING("Pointer of Time Window object is not set, returning empty map");
-    return sigChsPMMap;
+    return;
   }
   // Map Signal Channels according to PM they belong to
   const unsigned int nSigChs = timeWindow->getNumberOfEvents();
@@ -43,16 +55,8 @@ const map<int, vector<JPetSigCh>> SignalFinderTools::getSigChByPM(
 
     if(!useCorrupts && sigCh.getRecoFlag() == JPetSigCh::Corrupted) { continue; }
 
-    auto search = sigChsPMMap.find(pmtID);
-    if (search == sigChsPMMap.end()) {
-      vector<JPetSigCh> tmp;
-      tmp.push_back(sigCh);
-      sigChsPMMap.insert(pair<int, vector<JPetSigCh>>(pmtID, tmp));
-    } else {
-      search->second.push_back(sigCh);
-    }
+    buffers.counter.pushBack(buffers.counter.getBuffer(buffers.sigChByPM, pmtID), sigCh);
   }
-  return sigChsPMMap;
 }
 
 /**
@@ -62,24 +66,33 @@ vector<JPetRawSignal> SignalFinderTools::buildAllSignals(
    const map<int, vector<JPetSigCh>>& sigChByPM,
    double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
    JPetStatistics& stats, bool saveHistos,
-   ThresholdOrderings thresholdOrderings
+   const ThresholdOrderings& thresholdOrderings
 ) {
-  vector<JPetRawSignal> allSignals;
-  
-  for (auto& sigChPair : sigChByPM) {
-    Permutation P;
-    if(thresholdOrderings.empty()){
-      P = kIdentity;
-    }else{
-      P = thresholdOrderings.at(sigChPair.first);
-    }
+  Buffers buffers;
+  buildAllSignals(
+    sigChByPM, sigChEdgeMaxTime, sigChLeadTrailMaxTime, stats, saveHistos, thresholdOrderings, buffers
+  );
+  return std::move(buffers.rawSignals);
+}
 
-    auto signals = buildRawSignals(
-      sigChPair.second, sigChEdgeMaxTime, sigChLeadTrailMaxTime, stats, saveHistos, P
+/**
+ * Method invoking Raw Signal building method for each PM separately,
+ * signals are stored in rawSignals vector of the buffers
+ */
+void SignalFinderTools::buildAllSignals(
+   const map<int, vector<JPetSigCh>>& sigChByPM,
+   double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
+   JPetStatistics& stats, bool saveHistos,
+   const ThresholdOrderings& thresholdOrderings, Buffers& buffers
+) {
+  buffers.rawSignals.clear();
+  for (auto& sigChPair : sigChByPM) {
+    if (sigChPair.second.empty()) { continue; }
+    const Permutation& P = thresholdOrderings.empty() ? kIdentity : thresholdOrderings.at(sigChPair.first);
+    buildRawSignals(
+      sigChPair.second, sigChEdgeMaxTime, sigChLeadTrailMaxTime, stats, saveHistos, P, buffers
     );
-    allSignals.insert(allSignals.end(), signals.begin(), signals.end());
   }
-  return allSignals;
 }
 
 /**
@@ -89,25 +102,42 @@ vector<JPetRawSignal> SignalFinderTools::buildAllSignals(
  * time window (sigChEdgeMaxTime parameter) and all Trailing SigChs that conform
  * to second time window (sigChLeadTrailMaxTime parameter).
  */
- vector<JPetRawSignal> SignalFinderTools::buildRawSignals(
-   const vector<JPetSigCh>& sigChByPM,
-   double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
-   JPetStatistics& stats, bool saveHistos,
-   Permutation ordering
- ) {
-  vector<JPetRawSignal> rawSigVec;
+vector<JPetRawSignal> SignalFinderTools::buildRawSignals(
+  const vector<JPetSigCh>& sigChByPM,
+  double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
+  JPetStatistics& stats, bool saveHistos,
+  const Permutation& ordering
+) {
+  Buffers buffers;
+  buildRawSignals(
+    sigChByPM, sigChEdgeMaxTime, sigChLeadTrailMaxTime, stats, saveHistos, ordering, buffers
+  );
+  return std::move(buffers.rawSignals);
+}
 
-  vector<JPetSigCh> tmpVec;
-  vector<vector<JPetSigCh>> thrLeadingSigCh(kNumberOfThresholds, tmpVec);
-  vector<vector<JPetSigCh>> thrTrailingSigCh(kNumberOfThresholds, tmpVec);
+/**
+ * Version of Raw Signal reconstruction using the buffers reused between time windows,
+ * created signals are appended to rawSignals vector of the buffers
+ */
+void SignalFinderTools::buildRawSignals(
+  const vector<JPetSigCh>& sigChByPM,
+  double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
+  JPetStatistics& stats, bool saveHistos,
+  const Permutation& ordering, Buffers& buffers
+) {
+  auto& thrLeadingSigCh = buffers.thrLeadingSigCh;
+  auto& thrTrailingSigCh = buffers.thrTrailingSigCh;
+  for (unsigned int kk = 0; kk < kNumberOfThresholds; kk++) {
+    thrLeadingSigCh.at(kk).clear();
+    thrTrailingSigCh.at(kk).clear();
+  }
   for (const JPetSigCh& sigCh : sigChByPM) {
     if(sigCh.getType() == JPetSigCh::Leading) {
-      thrLeadingSigCh.at(ordering[sigCh.getThresholdNumber()-1]).push_back(sigCh);
+      buffers.counter.pushBack(thrLeadingSigCh.at(ordering[sigCh.getThresholdNumber()-1]), sigCh);
     } else if(sigCh.getType() == JPetSigCh::Trailing) {
-      thrTrailingSigCh.at(ordering[sigCh.getThresholdNumber()-1]).push_back(sigCh);
+      buffers.counter.pushBack(thrTrailingSigCh.at(ordering[sigCh.getThresholdNumber()-1]), sigCh);
     }
   }
-  assert(thrLeadingSigCh.size() > 0);
   while (thrLeadingSigCh.at(0).size() > 0) {
     JPetRawSignal rawSig;
     rawSig.setPM(thrLeadingSigCh.at(0).at(0).getPM());
@@ -181,13 +211,13 @@ vector<JPetRawSignal> SignalFinderTools::buildAllSignals(
       }
     }
     // Adding created Raw Signal to vector
-    rawSigVec.push_back(rawSig);
+    buffers.counter.pushBack(buffers.rawSignals, rawSig);
     thrLeadingSigCh.at(0).erase(thrLeadingSigCh.at(0).begin());
   }
   // Filling control histograms
   if(saveHistos){
     for(unsigned int jj=0;jj<kNumberOfThresholds;jj++){
-      for(auto sigCh : thrLeadingSigCh.at(jj)){
+      for(const auto& sigCh : thrLeadingSigCh.at(jj)){
         stats.fillHistogram("unused_sigch_all", 2*sigCh.getThresholdNumber()-1);
         if(sigCh.getRecoFlag()==JPetSigCh::Good){
           stats.fillHistogram("unused_sigch_good", 2*sigCh.getThresholdNumber()-1);
@@ -195,7 +225,7 @@ vector<JPetRawSignal> SignalFinderTools::buildAllSignals(
           stats.fillHistogram("unused_sigch_corr", 2*sigCh.getThresholdNumber()-1);
         }
       }
-      for(auto sigCh : thrTrailingSigCh.at(jj)){
+      for(const auto& sigCh : thrTrailingSigCh.at(jj)){
         stats.fillHistogram("unused_sigch_all", 2*sigCh.getThresholdNumber());
         if(sigCh.getRecoFlag()==JPetSigCh::Good){
           stats.fillHistogram("unused_sigch_good", 2*sigCh.getThresholdNumber());
@@ -205,7 +235,6 @@ vector<JPetRawSignal> SignalFinderTools::buildAllSignals(
       }
     }
   }
-  return rawSigVec;
 }
 
 /**
@@ -27,6 +27,7 @@
 #include <JPetRawSignal/JPetRawSignal.h>
 #include <JPetParamBank/JPetParamBank.h>
 #include <JPetSigCh/JPetSigCh.h>
+#include "AllocationCounter.h"
 #include <utility>
 #include <vector>
 #include <map>
@@ -42,20 +43,47 @@ public:
   using ThresholdOrderings = std::map<PMid, Permutation>;
   static const Permutation kIdentity;
 
+  /**
+   * Containers kept by the task between time windows, so they are allocated
+   * only until they reach the size needed by the largest time window
+   */
+  struct Buffers {
+    std::map<int, std::vector<JPetSigCh>> sigChByPM;
+    std::array<std::vector<JPetSigCh>, kNumberOfThresholds> thrLeadingSigCh;
+    std::array<std::vector<JPetSigCh>, kNumberOfThresholds> thrTrailingSigCh;
+    std::vector<JPetRawSignal> rawSignals;
+    AllocationCounter counter;
+  };
+
   static const std::map<int, std::vector<JPetSigCh>> getSigChByPM(
      const JPetTimeWindow* timeWindow, bool useCorrupts, int refPMID
   );
+  static void getSigChByPM(
+     const JPetTimeWindow* timeWindow, bool useCorrupts, int refPMID, Buffers& buffers
+  );
   static std::vector<JPetRawSignal> buildAllSignals(
     const std::map<int, std::vector<JPetSigCh>>& sigChByPM,
     double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
     JPetStatistics& stats, bool saveHistos,
-    ThresholdOrderings thresholdOrderings
+    const ThresholdOrderings& thresholdOrderings
+  );
+  static void buildAllSignals(
+    const std::map<int, std::vector<JPetSigCh>>& sigChByPM,
+    double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
+    JPetStatistics& stats, bool saveHistos,
+    const ThresholdOrderings& thresholdOrderings, Buffers& buffers
   );
   static std::vector<JPetRawSignal> buildRawSignals(
     const std::vector<JPetSigCh>& sigChByPM,
     double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
     JPetStatistics& stats, bool saveHistos,
-    Permutation ordering = SignalFinderTools::kIdentity
+    const Permutation& ordering = SignalFinderTools::kIdentity
+  );
+  static void buildRawSignals(
+    const std::vector<JPetSigCh>& sigChByPM,
+    double sigChEdgeMaxTime, double sigChLeadTrailMaxTime,
+    JPetStatistics& stats, bool saveHistos,
+    const Permutation& ordering, Buffers& buffers
   );
   static int findSigChOnNextThr(
     double sigChValue, double sigChEdgeMaxTime,
@@ -57,11 +57,18 @@ bool SignalTransformer::init()
 
   // Control histograms
   if(fSaveControlHistos) { initialiseHistograms(); }
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  fCheckpoint.resume(getStatistics(), checkpointState);
   return true;
 }
 
 bool SignalTransformer::exec()
 {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetPhysSignal>(fOutputEvents)) { return true; }
   if(auto & timeWindow = dynamic_cast<const JPetTimeWindow* const>(fEvent)) {
     uint n = timeWindow->getNumberOfEvents();
     for(uint i=0;i<n;++i){
@@ -69,7 +76,7 @@ bool SignalTransformer::exec()
       if(!fUseCorruptedSignals && rawSignal.getRecoFlag()==JPetBaseSignal::Corrupted) {
         continue;
       }
-      if(fSaveControlHistos) {
+      if(fFillControlHistos) {
         auto leads = rawSignal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
         auto trails = rawSignal.getPoints(JPetSigCh::Trailing, JPetRawSignal::ByThrNum);
         for(unsigned int i=0;i<leads.size();i++){
@@ -121,12 +128,15 @@ bool SignalTransformer::exec()
   } else {
     return false;
   }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents);
   return true;
 }
 
 bool SignalTransformer::terminate()
 {
   INFO("Signal transforming finished");
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fCheckpoint.finish();
   return true;
 }
 
@@ -181,13 +191,17 @@ void SignalTransformer::correctForWalk(const JPetRecoSignal& recoSignal)
      if(TOT>0. && fWalkCorrConst[i] >0.){
        double WalkCorr = fWalkCorrConst[i]/sqrt(TOT);
        leadingSigChVec.at(i).setValue(leadingSigChVec.at(i).getValue() - WalkCorr);
-       getStatistics().fillHistogram("WalkCorrLead", WalkCorr);
+       if (fFillControlHistos) {
+         getStatistics().fillHistogram("WalkCorrLead", WalkCorr);
+       }
      }
    for (unsigned i = 0; i < trailingSigChVec.size();i++){
      if(TOT>0. && fWalkCorrConst[i] >0.){
        double WalkCorr = fWalkCorrConst[i]/sqrt(TOT);
        trailingSigChVec.at(i).setValue(trailingSigChVec.at(i).getValue() - WalkCorr);
-       getStatistics().fillHistogram("WalkCorrTrail", WalkCorr);
+       if (fFillControlHistos) {
+         getStatistics().fillHistogram("WalkCorrTrail", WalkCorr);
+       }
      }
    }
   }
@@ -18,6 +18,8 @@
 
 #include "JPetRecoSignal/JPetRecoSignal.h"
 #include "JPetUserTask/JPetUserTask.h"
+#include "ControlHistogramSampler.h"
+#include "TaskCheckpoint.h"
 
 class JPetWriter;
 
@@ -50,6 +52,9 @@ protected:
 	const std::string kWalkCorrConst4ParamKey = "SignalTransformer_WalkCorrConstThr4_float";
 	bool fUseCorruptedSignals = false;
 	bool fSaveControlHistos = true;
+	bool fFillControlHistos = true;
 	double fWalkCorrConst[4] = {0.,0.,0,0.};
+	ControlHistogramSampler fHistogramSampler;
+	TaskCheckpoint fCheckpoint;
 };
 #endif /* !SIGNALTRANSFORMER_H */
@@ -0,0 +1,318 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file TaskCheckpoint.cpp
+ */
+
+#include "TaskCheckpoint.h"
+#include "JPetLoggerInclude.h"
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TObjString.h>
+#include <TParameter.h>
+#include <TTree.h>
+#include <algorithm>
+#include <cstdio>
+
+using namespace jpet_options_tools;
+
+const std::string TaskCheckpoint::kIntervalParamKey = "Checkpoint_Interval_int";
+const std::string TaskCheckpoint::kDirectoryParamKey = "Checkpoint_Directory_std::string";
+const std::string TaskCheckpoint::kResumeParamKey = "Checkpoint_Resume_bool";
+
+namespace
+{
+const char* kCompletedWindowsName = "completedWindows";
+const char* kTaskStateName = "taskState";
+const char* kOutputTreeName = "output";
+const char* kOutputBranchName = "window";
+
+bool readCompletedWindows(const std::string& fileName, long long& completedWindows)
+{
+  TDirectory::TContext context;
+  TFile file(fileName.c_str(), "READ");
+  if (file.IsZombie())
+  {
+    return false;
+  }
+  auto savedCompletedWindows = dynamic_cast<TParameter<Long64_t>*>(file.Get(kCompletedWindowsName));
+  if (!savedCompletedWindows)
+  {
+    return false;
+  }
+  completedWindows = savedCompletedWindows->GetVal();
+  return true;
+}
+}
+
+TaskCheckpoint::TaskCheckpoint() {}
+
+TaskCheckpoint::~TaskCheckpoint()
+{
+  closeResumedOutput();
+  closeOutput();
+}
+
+/**
+ * Checkpoint file is named after the input file and the task,
+ * so runs over many files and chains of tasks do not overwrite the checkpoints
+ */
+void TaskCheckpoint::loadOptions(const OptsStrAny& opts, const std::string& taskName)
+{
+  if (isOptionSet(opts, kIntervalParamKey))
+  {
+    fInterval = std::max(getOptionAsInt(opts, kIntervalParamKey), 0);
+  }
+  if (isOptionSet(opts, kResumeParamKey))
+  {
+    fResume = getOptionAsBool(opts, kResumeParamKey);
+  }
+  std::string directory = ".";
+  if (isOptionSet(opts, kDirectoryParamKey))
+  {
+    directory = getOptionAsString(opts, kDirectoryParamKey);
+  }
+  std::string inputFile = getInputFile(opts);
+  inputFile = inputFile.substr(inputFile.find_last_of('/') + 1);
+  fFileName = directory + "/" + inputFile + "." + taskName + ".checkpoint.root";
+  fOutputFileName = directory + "/" + inputFile + "." + taskName + ".checkpoint.output.root";
+}
+
+/**
+ * Resuming is refused, if the partial output of the interrupted run does not contain
+ * all time windows completed before the checkpoint, so that the output is never incomplete
+ */
+bool TaskCheckpoint::resume(JPetStatistics& stats, std::string& taskState)
+{
+  if (!fResume)
+  {
+    return false;
+  }
+  long long completedWindows = 0;
+  if (!readCompletedWindows(fFileName, completedWindows))
+  {
+    WARNING("Resuming was requested, but the checkpoint " + fFileName + " could not be read, processing all time windows");
+    return false;
+  }
+  if (!openResumedOutput(completedWindows))
+  {
+    ERROR("Resuming was requested, but the partial output " + getOutputFileName() + " does not contain the " + std::to_string(completedWindows)
+          + " time windows completed before the checkpoint, refusing to resume and processing all time windows");
+    closeResumedOutput();
+    return false;
+  }
+  if (!load(fFileName, stats, taskState, completedWindows))
+  {
+    WARNING("Resuming was requested, but the checkpoint " + fFileName + " could not be read, processing all time windows");
+    closeResumedOutput();
+    return false;
+  }
+  fWindowsToSkip = completedWindows;
+  INFO("Resuming from the checkpoint " + fFileName + ", output of " + std::to_string(completedWindows)
+       + " completed time windows is taken from the partial output");
+  return true;
+}
+
+const JPetTimeWindow* TaskCheckpoint::nextSkippedWindow()
+{
+  if (fCompletedWindows >= fWindowsToSkip)
+  {
+    closeResumedOutput();
+    return nullptr;
+  }
+  fResumedTree->GetEntry(fCompletedWindows);
+  fCompletedWindows++;
+  return fResumedWindow;
+}
+
+void TaskCheckpoint::windowCompleted(JPetStatistics& stats, const JPetTimeWindow* output, const std::string& taskState)
+{
+  fCompletedWindows++;
+  storeOutput(output);
+  if (isEnabled() && fCompletedWindows % fInterval == 0)
+  {
+    if (fOutputTree)
+    {
+      // Partial output has to contain all windows counted in the checkpoint
+      fOutputTree->AutoSave("SaveSelf");
+    }
+    if (!save(stats, taskState))
+    {
+      WARNING("Could not write the checkpoint " + fFileName);
+    }
+  }
+}
+
+/**
+ * Output of every completed time window is appended to the partial output, if checkpoints are enabled
+ */
+void TaskCheckpoint::storeOutput(const JPetTimeWindow* output)
+{
+  if (!isEnabled() || !output)
+  {
+    return;
+  }
+  if (!fOutputFile)
+  {
+    // Current directory is kept, so objects created later by the task are not attached to the partial output
+    TDirectory::TContext context;
+    fOutputFile.reset(TFile::Open(getOutputFileName().c_str(), "RECREATE"));
+    if (!fOutputFile || fOutputFile->IsZombie())
+    {
+      WARNING("Could not open the partial output " + getOutputFileName() + ", the run will not be resumable");
+      fOutputFile.reset();
+      fInterval = 0;
+      return;
+    }
+    fOutputTree = new TTree(kOutputTreeName, "Output time windows of the task");
+    fOutputTree->SetDirectory(fOutputFile.get());
+    fOutputWindow = const_cast<JPetTimeWindow*>(output);
+    fOutputTree->Branch(kOutputBranchName, &fOutputWindow);
+  }
+  fOutputWindow = const_cast<JPetTimeWindow*>(output);
+  fOutputTree->Fill();
+}
+
+bool TaskCheckpoint::openResumedOutput(long long completedWindows)
+{
+  // Partial output of the interrupted run is read, while the resumed run writes its own from the beginning
+  const std::string resumedFileName = getOutputFileName() + ".resumed";
+  if (std::rename(getOutputFileName().c_str(), resumedFileName.c_str()) != 0)
+  {
+    return false;
+  }
+  TDirectory::TContext context;
+  fResumedFile.reset(TFile::Open(resumedFileName.c_str(), "READ"));
+  if (!fResumedFile || fResumedFile->IsZombie())
+  {
+    return false;
+  }
+  fResumedTree = dynamic_cast<TTree*>(fResumedFile->Get(kOutputTreeName));
+  if (!fResumedTree || fResumedTree->GetEntries() < completedWindows)
+  {
+    return false;
+  }
+  fResumedWindow = new JPetTimeWindow();
+  fResumedTree->SetBranchAddress(kOutputBranchName, &fResumedWindow);
+  return true;
+}
+
+void TaskCheckpoint::closeResumedOutput()
+{
+  fResumedTree = nullptr;
+  if (fResumedFile)
+  {
+    const std::string resumedFileName = fResumedFile->GetName();
+    fResumedFile.reset();
+    std::remove(resumedFileName.c_str());
+  }
+  delete fResumedWindow;
+  fResumedWindow = nullptr;
+}
+
+void TaskCheckpoint::closeOutput()
+{
+  if (!fOutputFile)
+  {
+    return;
+  }
+  fOutputTree = nullptr;
+  fOutputFile.reset();
+}
+
+/**
+ * Finished task does not need the checkpoint, it is removed together with the partial output,
+ * so that it is not resumed by mistake
+ */
+void TaskCheckpoint::finish()
+{
+  closeResumedOutput();
+  closeOutput();
+  if (isEnabled())
+  {
+    std::remove(fFileName.c_str());
+    std::remove(getOutputFileName().c_str());
+  }
+}
+
+/**
+ * Checkpoint is written to a temporary file, which replaces the previous checkpoint only when complete,
+ * so interruption during writing leaves the previous checkpoint usable
+ */
+bool TaskCheckpoint::save(const JPetStatistics& stats, const std::string& taskState) const
+{
+  const std::string tmpFileName = fFileName + ".tmp";
+  {
+    TDirectory::TContext context;
+    TFile file(tmpFileName.c_str(), "RECREATE");
+    if (file.IsZombie())
+    {
+      return false;
+    }
+    TParameter<Long64_t> completedWindows(kCompletedWindowsName, fCompletedWindows);
+    file.WriteTObject(&completedWindows);
+    TObjString state(taskState.c_str());
+    file.WriteTObject(&state, kTaskStateName);
+    TIter next(stats.getStatsTable());
+    while (auto object = next())
+    {
+      if (dynamic_cast<TH1*>(object))
+      {
+        file.WriteTObject(object);
+      }
+    }
+    file.Close();
+  }
+  return std::rename(tmpFileName.c_str(), fFileName.c_str()) == 0;
+}
+
+/**
+ * Histograms existing in the statistics are replaced by the saved ones,
+ * so they have to be created before loading the checkpoint
+ */
+bool TaskCheckpoint::load(const std::string& fileName, JPetStatistics& stats, std::string& taskState, long long& completedWindows)
+{
+  TDirectory::TContext context;
+  TFile file(fileName.c_str(), "READ");
+  if (file.IsZombie())
+  {
+    return false;
+  }
+  auto savedCompletedWindows = dynamic_cast<TParameter<Long64_t>*>(file.Get(kCompletedWindowsName));
+  auto savedState = dynamic_cast<TObjString*>(file.Get(kTaskStateName));
+  if (!savedCompletedWindows || !savedState)
+  {
+    return false;
+  }
+  completedWindows = savedCompletedWindows->GetVal();
+  taskState = savedState->GetString().Data();
+
+  TIter next(stats.getStatsTable());
+  while (auto object = next())
+  {
+    auto histogram = dynamic_cast<TH1*>(object);
+    if (!histogram)
+    {
+      continue;
+    }
+    auto savedHistogram = dynamic_cast<TH1*>(file.Get(histogram->GetName()));
+    if (!savedHistogram)
+    {
+      WARNING(std::string("Histogram ") + histogram->GetName() + " not found in the checkpoint " + fileName);
+      continue;
+    }
+    histogram->Reset();
+    histogram->Add(savedHistogram);
+  }
+  return true;
+}
@@ -0,0 +1,122 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file TaskCheckpoint.h
+ */
+
+#ifndef TASKCHECKPOINT_H
+#define TASKCHECKPOINT_H
+
+#include <JPetOptionsTools/JPetOptionsTools.h>
+#include <JPetStatistics/JPetStatistics.h>
+#include <JPetTimeWindow/JPetTimeWindow.h>
+#include <memory>
+#include <string>
+
+class TFile;
+class TTree;
+
+/**
+ * @brief Periodic checkpoints of a task, allowing to resume an interrupted run
+ *
+ * Every given number of time windows, the task writes a ROOT file with the number of completed
+ * time windows, copies of all histograms from its statistics and the state the task keeps
+ * between time windows (serialized by the task to a string). Output time windows of the task
+ * are kept in a partial output file next to the checkpoint. If the run is interrupted, it can be
+ * started again with the resume option: histograms and the state are restored in init() and
+ * the time windows completed before the checkpoint are not processed again, their output is
+ * read back from the partial output instead. The statistics, the state and the output at the end
+ * are the same as after an uninterrupted run. If the partial output does not contain all
+ * completed time windows, resuming is refused and all time windows are processed.
+ * The checkpoint and the partial output are removed when the task terminates.
+ *
+ * Usage in the task:
+ * - init(): loadOptions(), after creation of histograms resume()
+ * - exec(): return at the beginning if skipWindow<T>(fOutputEvents), with T the type of output objects,
+ *   windowCompleted(stats, fOutputEvents) at the end
+ * - terminate(): finish()
+ *
+ * Options shared by all tasks:
+ * - "Checkpoint_Interval_int": number of time windows between checkpoints, 0 or not set disables checkpoints
+ * - "Checkpoint_Directory_std::string": directory of checkpoint files, current directory by default
+ * - "Checkpoint_Resume_bool": resume from the checkpoint of the interrupted run
+ */
+class TaskCheckpoint
+{
+public:
+  TaskCheckpoint();
+  ~TaskCheckpoint();
+
+  void loadOptions(const jpet_options_tools::OptsStrAny& opts, const std::string& taskName);
+  bool isEnabled() const { return fInterval > 0; }
+  const std::string& getFileName() const { return fFileName; }
+  const std::string& getOutputFileName() const { return fOutputFileName; }
+  long long getCompletedWindows() const { return fCompletedWindows; }
+
+  /// Restores histograms and returns state of the task from the checkpoint, false if there is nothing to resume
+  bool resume(JPetStatistics& stats, std::string& taskState);
+  /**
+   * True for time windows completed before the resumed checkpoint, they should not be processed again,
+   * their output is added to the output time window of the task
+   */
+  template <class T>
+  bool skipWindow(JPetTimeWindow* output)
+  {
+    auto window = nextSkippedWindow();
+    if (!window)
+    {
+      return false;
+    }
+    for (unsigned int i = 0; i < window->getNumberOfEvents(); i++)
+    {
+      output->add<T>(dynamic_cast<const T&>(window->operator[](i)));
+    }
+    storeOutput(output);
+    return true;
+  }
+  void windowCompleted(JPetStatistics& stats, const JPetTimeWindow* output, const std::string& taskState = "");
+  void finish();
+
+  bool save(const JPetStatistics& stats, const std::string& taskState) const;
+  static bool load(const std::string& fileName, JPetStatistics& stats, std::string& taskState, long long& completedWindows);
+
+  static const std::string kIntervalParamKey;
+  static const std::string kDirectoryParamKey;
+  static const std::string kResumeParamKey;
+
+private:
+  TaskCheckpoint(const TaskCheckpoint&) = delete;
+  TaskCheckpoint& operator=(const TaskCheckpoint&) = delete;
+
+  const JPetTimeWindow* nextSkippedWindow();
+  void storeOutput(const JPetTimeWindow* output);
+  bool openResumedOutput(long long completedWindows);
+  void closeResumedOutput();
+  void closeOutput();
+
+  std::string fFileName;
+  std::string fOutputFileName;
+  long long fInterval = 0;
+  bool fResume = false;
+  long long fCompletedWindows = 0;
+  long long fWindowsToSkip = 0;
+  /// Partial output written during the run
+  std::unique_ptr<TFile> fOutputFile;
+  TTree* fOutputTree = nullptr;
+  JPetTimeWindow* fOutputWindow = nullptr;
+  /// Partial output of the interrupted run, read when resuming
+  std::unique_ptr<TFile> fResumedFile;
+  TTree* fResumedTree = nullptr;
+  JPetTimeWindow* fResumedWindow = nullptr;
+};
+
+#endif /* !TASKCHECKPOINT_H */
@@ -0,0 +1,235 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file TaskTelemetry.h
+ */
+
+#ifndef TASKTELEMETRY_H
+#define TASKTELEMETRY_H
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/**
+ * @brief Histogram of durations with logarithmic bins
+ *
+ * Bin 0 holds durations below 2 us, bin i > 0 holds durations in [2^i, 2^(i+1)) us,
+ * so percentiles are known with precision of factor of 2, with constant memory and cost of filling.
+ */
+class LatencyHistogram
+{
+public:
+  static const int kNumberOfBins = 40;
+
+  void fill(double microseconds)
+  {
+    int bin = 0;
+    if (microseconds >= 2.0)
+    {
+      bin = std::min(static_cast<int>(std::log2(microseconds)), kNumberOfBins - 1);
+    }
+    fBins[bin]++;
+    fCount++;
+  }
+
+  unsigned long getCount() const { return fCount; }
+  unsigned long getBinContent(int bin) const { return fBins.at(bin); }
+  static double getBinLowEdge(int bin) { return bin == 0 ? 0.0 : std::pow(2.0, bin); }
+  static double getBinUpEdge(int bin) { return std::pow(2.0, bin + 1); }
+
+  /// Upper edge of the bin containing the given quantile, 0 for empty histogram
+  double getPercentile(double quantile) const
+  {
+    if (fCount == 0)
+    {
+      return 0.0;
+    }
+    const double limit = quantile * fCount;
+    unsigned long sum = 0;
+    for (int bin = 0; bin < kNumberOfBins; bin++)
+    {
+      sum += fBins[bin];
+      if (sum >= limit && fBins[bin] > 0)
+      {
+        return getBinUpEdge(bin);
+      }
+    }
+    return getBinUpEdge(kNumberOfBins - 1);
+  }
+
+private:
+  std::array<unsigned long, kNumberOfBins> fBins{};
+  unsigned long fCount = 0;
+};
+
+/**
+ * @brief Performance metrics of one task run over one input file
+ *
+ * Times of init() and terminate(), latency of exec() for every time window, numbers of consumed
+ * and produced objects and peak resident memory of the whole process (not of the task alone, all tasks
+ * of the process share it). Metrics are written as one line of JSON (JSON Lines, if the file name ends
+ * with .json or .jsonl) or as a plain text block, appended to the given file, so runs of many tasks,
+ * files and processes can share it.
+ * See InstrumentedTask, which collects them for any JPetUserTask.
+ */
+class TaskTelemetry
+{
+public:
+  explicit TaskTelemetry(const std::string& taskName = "") : fTaskName(taskName) {}
+
+  void setTaskName(const std::string& taskName) { fTaskName = taskName; }
+  void setInputFile(const std::string& inputFile) { fInputFile = inputFile; }
+  void recordInit(double milliseconds) { fInitTime = milliseconds; }
+  void recordTerminate(double milliseconds) { fTerminateTime = milliseconds; }
+  void recordProcessPeakRSS(long kilobytes) { fProcessPeakRSS = std::max(fProcessPeakRSS, kilobytes); }
+
+  void recordExec(double microseconds, unsigned long inputObjects, unsigned long outputObjects)
+  {
+    fExecLatency.fill(microseconds);
+    fExecTotalTime += microseconds;
+    fExecMinTime = fExecLatency.getCount() == 1 ? microseconds : std::min(fExecMinTime, microseconds);
+    fExecMaxTime = std::max(fExecMaxTime, microseconds);
+    fInputObjects += inputObjects;
+    fOutputObjects += outputObjects;
+  }
+
+  const std::string& getTaskName() const { return fTaskName; }
+  const LatencyHistogram& getExecLatency() const { return fExecLatency; }
+  unsigned long getNumberOfWindows() const { return fExecLatency.getCount(); }
+  unsigned long getInputObjects() const { return fInputObjects; }
+  unsigned long getOutputObjects() const { return fOutputObjects; }
+  double getInitTime() const { return fInitTime; }
+  double getTerminateTime() const { return fTerminateTime; }
+  double getExecTotalTime() const { return fExecTotalTime; }
+  double getExecMeanTime() const { return getNumberOfWindows() > 0 ? fExecTotalTime / getNumberOfWindows() : 0.0; }
+  double getExecMinTime() const { return fExecMinTime; }
+  double getExecMaxTime() const { return fExecMaxTime; }
+  double getWindowsPerSecond() const { return fExecTotalTime > 0.0 ? getNumberOfWindows() * 1.e6 / fExecTotalTime : 0.0; }
+  long getProcessPeakRSS() const { return fProcessPeakRSS; }
+
+  std::string toJSON() const
+  {
+    std::ostringstream out;
+    out << "{\"task\": \"" << escape(fTaskName) << "\", \"inputFile\": \"" << escape(fInputFile) << "\""
+        << ", \"initMs\": " << fInitTime << ", \"terminateMs\": " << fTerminateTime << ", \"timeWindows\": " << getNumberOfWindows()
+        << ", \"execTotalMs\": " << fExecTotalTime / 1000.0 << ", \"execMeanUs\": " << getExecMeanTime() << ", \"execMinUs\": " << fExecMinTime
+        << ", \"execMaxUs\": " << fExecMaxTime << ", \"execP50Us\": " << fExecLatency.getPercentile(0.5)
+        << ", \"execP90Us\": " << fExecLatency.getPercentile(0.9) << ", \"execP99Us\": " << fExecLatency.getPercentile(0.99)
+        << ", \"windowsPerSecond\": " << getWindowsPerSecond() << ", \"inputObjects\": " << fInputObjects
+        << ", \"outputObjects\": " << fOutputObjects << ", \"processPeakRSSkB\": " << fProcessPeakRSS << ", \"execLatencyHistogramUs\": [";
+    bool first = true;
+    for (int bin = 0; bin < LatencyHistogram::kNumberOfBins; bin++)
+    {
+      if (fExecLatency.getBinContent(bin) == 0)
+      {
+        continue;
+      }
+      out << (first ? "" : ", ") << "[" << LatencyHistogram::getBinLowEdge(bin) << ", " << fExecLatency.getBinContent(bin) << "]";
+      first = false;
+    }
+    out << "]}";
+    return out.str();
+  }
+
+  std::string toText() const
+  {
+    std::ostringstream out;
+    out << "[" << fTaskName << "] " << fInputFile << "\n"
+        << "  init: " << fInitTime << " ms, terminate: " << fTerminateTime << " ms\n"
+        << "  exec: " << getNumberOfWindows() << " time windows, total " << fExecTotalTime / 1000.0 << " ms, " << getWindowsPerSecond()
+        << " windows/s\n"
+        << "  exec latency [us]: mean " << getExecMeanTime() << ", min " << fExecMinTime << ", max " << fExecMaxTime << ", p50 < "
+        << fExecLatency.getPercentile(0.5) << ", p90 < " << fExecLatency.getPercentile(0.9) << ", p99 < " << fExecLatency.getPercentile(0.99)
+        << "\n"
+        << "  objects: " << fInputObjects << " consumed, " << fOutputObjects << " produced\n"
+        << "  process peak RSS: " << fProcessPeakRSS << " kB\n";
+    return out.str();
+  }
+
+  /**
+   * Appends metrics to the file, format chosen by the extension. Each record is written with a single write()
+   * to the file opened with O_APPEND, so records of tasks and processes sharing the file are not interleaved.
+   */
+  bool write(const std::string& fileName) const
+  {
+    const bool json = endsWith(fileName, ".json") || endsWith(fileName, ".jsonl");
+    const std::string record = json ? toJSON() + "\n" : toText();
+    const int file = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (file < 0)
+    {
+      return false;
+    }
+    ssize_t written = 0;
+    do
+    {
+      written = ::write(file, record.data(), record.size());
+    } while (written < 0 && errno == EINTR);
+    const bool closed = ::close(file) == 0;
+    return written == static_cast<ssize_t>(record.size()) && closed;
+  }
+
+  /// Peak resident set size of the whole process in kB
+  static long readProcessPeakRSS()
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+      return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+
+private:
+  static bool endsWith(const std::string& text, const std::string& suffix)
+  {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  static std::string escape(const std::string& text)
+  {
+    std::string escaped;
+    for (char c : text)
+    {
+      if (c == '"' || c == '\\')
+      {
+        escaped += '\\';
+      }
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  std::string fTaskName;
+  std::string fInputFile;
+  LatencyHistogram fExecLatency;
+  double fInitTime = 0.0;      // ms
+  double fTerminateTime = 0.0; // ms
+  double fExecTotalTime = 0.0; // us
+  double fExecMinTime = 0.0;   // us
+  double fExecMaxTime = 0.0;   // us
+  unsigned long fInputObjects = 0;
+  unsigned long fOutputObjects = 0;
+  long fProcessPeakRSS = 0; // kB, of the whole process
+};
+
+#endif /* !TASKTELEMETRY_H */
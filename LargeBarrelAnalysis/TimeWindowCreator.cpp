@@ -75,15 +75,20 @@ bool TimeWindowCreator::init() {
   // Use of Time Calibratin and Thresholds files
   JPetGeomMapping mapper(getParamBank());
   auto tombMap = mapper.getTOMBMapping();
-  fTimeCalibration =
-      UniversalFileLoader::loadConfigurationParameters(calibFile, tombMap);
+  // Constants are taken from the calibration store, if it is used
+  fTimeCalibration = UniversalFileLoader::loadConfigurationParameters(
+      fParams.getOptions(), "TimeCalibration", calibFile, tombMap);
   if (fTimeCalibration.empty()) {
     ERROR("Time Calibration seems to be empty");
   }
-  fThresholds =
-      UniversalFileLoader::loadConfigurationParameters(thresholdFile, tombMap);
+  bool thresholdsFromStore = false;
+  fThresholds = UniversalFileLoader::loadConfigurationParameters(
+      fParams.getOptions(), "Thresholds", thresholdFile, tombMap,
+      thresholdsFromStore);
   if (fThresholds.empty()) {
     ERROR("Thresholds values seem to be empty");
+  } else if (thresholdsFromStore) {
+    fSetTHRValuesFromChannels = false;
   }
 
   // Reference Detector
@@ -117,17 +122,33 @@ bool TimeWindowCreator::init() {
     }
   }
 
+  // Attributes of all channels of the setup are resolved once, for the lookups of every TDC hit
+  fChannelTable.build(getParamBank().getTOMBChannels(), fTimeCalibration,
+                      fThresholds, fSetTHRValuesFromChannels);
+  if (fMainStripSet) {
+    fChannelTable.restrictTo(fAllowedChannels);
+  }
+
   // Control histograms
   if (fSaveControlHistos) {
     initialiseHistograms();
   }
+  fHistogramSampler.loadOptions(fParams.getOptions());
+  // Checkpoints of long runs, histograms have to be created before resuming
+  fCheckpoint.loadOptions(fParams.getOptions(), getName());
+  std::string checkpointState;
+  if (fCheckpoint.resume(getStatistics(), checkpointState)) {
+    fCurrEventNumber = std::stoll(checkpointState);
+  }
   return true;
 }
 
 bool TimeWindowCreator::exec() {
+  fFillControlHistos = fHistogramSampler.nextWindow() && fSaveControlHistos;
+  if (fCheckpoint.skipWindow<JPetSigCh>(fOutputEvents)) { return true; }
   if (auto event = dynamic_cast<EventIII *const>(fEvent)) {
     int kTDCChannels = event->GetTotalNTDCChannels();
-    if (fSaveControlHistos) {
+    if (fFillControlHistos) {
       getStatistics().fillHistogram("sig_ch_per_time_slot", kTDCChannels);
     }
     // Loop over all TDC channels in file
@@ -135,36 +156,32 @@ bool TimeWindowCreator::exec() {
     for (int i = 0; i < kTDCChannels; ++i) {
       auto tdcChannel = dynamic_cast<TDCChannel *const>(tdcChannels->At(i));
       auto tombNumber = tdcChannel->GetChannel();
-      // Skip trigger signals from TRB - every 65th
-      if (tombNumber % 65 == 0)
-        continue;
-      // Check if channel exists in database from loaded local file
-      if (getParamBank().getTOMBChannels().count(tombNumber) == 0) {
-        WARNING(Form("DAQ Channel %d appears in data but does not exist in the "
-                     "detector setup.",
-                     tombNumber));
+      if (!fChannelTable.isAccepted(tombNumber)) {
+        // Skip trigger signals from TRB - every 65th
+        if (DAQChannelTable::isTriggerChannel(tombNumber))
+          continue;
+        // Check if channel exists in database from loaded local file
+        if (!fChannelTable.find(tombNumber)) {
+          WARNING(Form("DAQ Channel %d appears in data but does not exist in the "
+                       "detector setup.",
+                       tombNumber));
+        }
+        // Reference Detector
+        // Ignore irrelevant channels
         continue;
       }
-      // Get channel for corresponding number
-      auto &tombChannel = getParamBank().getTOMBChannel(tombNumber);
-
-      // Reference Detector
-      // Ignore irrelevant channels
-      if (!isAllowedChannel(tombChannel))
-        continue;
 
       // Building Signal Channels for this TOMB Channel
       auto allSigChs = TimeWindowCreatorTools::buildSigChs(
-          tdcChannel, tombChannel, fTimeCalibration, fThresholds, fMaxTime,
-          fMinTime, fSetTHRValuesFromChannels, getStatistics(),
-          fSaveControlHistos);
+          tdcChannel, fChannelTable.get(tombNumber), fMaxTime, fMinTime,
+          getStatistics(), fFillControlHistos);
 
       // Sort Signal Channels in time
       TimeWindowCreatorTools::sortByValue(allSigChs);
 
       // Flag with Good or Corrupted
       TimeWindowCreatorTools::flagSigChs(allSigChs, getStatistics(),
-                                         fSaveControlHistos);
+                                         fFillControlHistos);
 
       // Save result
       saveSigChs(allSigChs);
@@ -173,11 +190,14 @@ bool TimeWindowCreator::exec() {
   } else {
     return false;
   }
+  fCheckpoint.windowCompleted(getStatistics(), fOutputEvents, std::to_string(fCurrEventNumber));
   return true;
 }
 
 bool TimeWindowCreator::terminate() {
   INFO("TimeSlot Creation Ended");
+  fHistogramSampler.scaleHistograms(getStatistics());
+  fCheckpoint.finish();
   return true;
 }
 
@@ -187,21 +207,6 @@ void TimeWindowCreator::saveSigChs(const vector<JPetSigCh> &sigChVec) {
   }
 }
 
-/**
- * Reference Detector
- * Returns true if signal from the channel given as argument should be passed
- */
-bool TimeWindowCreator::isAllowedChannel(JPetTOMBChannel &tombChannel) const {
-  // If main strip was not defined, pass all channels
-  if (!fMainStripSet)
-    return true;
-  if (fAllowedChannels.find(tombChannel.getChannel()) !=
-      fAllowedChannels.end()) {
-    return true;
-  }
-  return false;
-}
-
 void TimeWindowCreator::initialiseHistograms() {
   getStatistics().createHistogramWithAxes(new TH1D("sig_ch_per_time_slot", "Signal Channels Per Time Slot", 250, -0.125, 999.875),
                                                     "Signal Channels in Time Slot", "Number of Time Slots");
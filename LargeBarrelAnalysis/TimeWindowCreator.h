@@ -19,6 +19,9 @@
 #include <JPetTOMBChannel/JPetTOMBChannel.h>
 #include <JPetTimeWindow/JPetTimeWindow.h>
 #include <JPetUserTask/JPetUserTask.h>
+#include "ControlHistogramSampler.h"
+#include "TaskCheckpoint.h"
+#include "TimeWindowCreatorTools.h"
 #include <map>
 #include <set>
 
@@ -43,7 +46,6 @@ public:
 	virtual bool terminate() override;
 
 protected:
-	bool isAllowedChannel(JPetTOMBChannel& tombChannel) const;
 	void saveSigChs(const std::vector<JPetSigCh>& sigChVec);
 	void initialiseHistograms();
 	const std::string kTimeCalibFileParamKey = "TimeCalibLoader_ConfigFile_std::string";
@@ -59,10 +61,14 @@ protected:
 	long long int fCurrEventNumber = 0;
 	std::set<int> fAllowedChannels;
 	bool fSaveControlHistos = true;
+	bool fFillControlHistos = true;
 	std::pair<int,int> fMainStrip;
 	bool fMainStripSet = false;
 	double fMinTime = -1.e6;
 	double fMaxTime = 0.;
+	DAQChannelTable fChannelTable;
+	ControlHistogramSampler fHistogramSampler;
+	TaskCheckpoint fCheckpoint;
 };
 
 #endif /* !TIMEWINDOWCREATOR_H */
@@ -24,7 +24,7 @@ using namespace std;
  void TimeWindowCreatorTools::sortByValue(vector<JPetSigCh>& input)
  {
    std::sort(input.begin(), input.end(),
-     [] (JPetSigCh sigCh1, JPetSigCh sigCh2) {
+     [] (const JPetSigCh& sigCh1, const JPetSigCh& sigCh2) {
        return sigCh1.getValue() < sigCh2.getValue();
      }
    );
@@ -161,3 +161,109 @@ JPetSigCh TimeWindowCreatorTools::generateSigCh(
   }
   return sigCh;
 }
+
+/**
+ * Building all Signal Channels from one TDC, with attributes of its DAQ channel
+ * taken from the table
+ */
+vector<JPetSigCh> TimeWindowCreatorTools::buildSigChs(
+  TDCChannel* tdcChannel, const DAQChannelInfo& channelInfo,
+  double maxTime, double minTime, JPetStatistics& stats, bool saveHistos
+){
+  vector<JPetSigCh> allTDCSigChs;
+  allTDCSigChs.reserve(tdcChannel->GetLeadHitsNum() + tdcChannel->GetTrailHitsNum());
+  for (int j = 0; j < tdcChannel->GetLeadHitsNum(); j++) {
+    auto leadTime = tdcChannel->GetLeadTime(j);
+    if (leadTime > maxTime || leadTime < minTime ) { continue; }
+    allTDCSigChs.push_back(generateSigCh(leadTime, channelInfo, JPetSigCh::Leading));
+    if (saveHistos){
+      stats.fillHistogram(channelInfo.occupationHistogram.c_str(), channelInfo.pmID);
+    }
+  }
+  for (int j = 0; j < tdcChannel->GetTrailHitsNum(); j++) {
+    auto trailTime = tdcChannel->GetTrailTime(j);
+    if (trailTime > maxTime || trailTime < minTime ) { continue; }
+    allTDCSigChs.push_back(generateSigCh(trailTime, channelInfo, JPetSigCh::Trailing));
+    if (saveHistos){
+      stats.fillHistogram(channelInfo.occupationHistogram.c_str(), channelInfo.pmID);
+    }
+  }
+  return allTDCSigChs;
+}
+
+/**
+* Sets up Signal Channel fields with time calibration and threshold value
+* resolved in the table
+*/
+JPetSigCh TimeWindowCreatorTools::generateSigCh(
+  double tdcChannelTime, const DAQChannelInfo& channelInfo, JPetSigCh::EdgeType edge
+) {
+  const auto& channel = *channelInfo.tombChannel;
+  JPetSigCh sigCh;
+  sigCh.setValue(1000.*(tdcChannelTime + channelInfo.timeCalibration));
+  sigCh.setType(edge);
+  sigCh.setTOMBChannel(channel);
+  sigCh.setPM(channel.getPM());
+  sigCh.setFEB(channel.getFEB());
+  sigCh.setTRB(channel.getTRB());
+  sigCh.setDAQch(channel.getChannel());
+  sigCh.setThresholdNumber(channelInfo.thresholdNumber);
+  sigCh.setThreshold(channelInfo.thresholdValue);
+  return sigCh;
+}
+
+void DAQChannelTable::build(
+  const map<int, JPetTOMBChannel*>& tombChannels,
+  const map<unsigned int, vector<double>>& timeCalibrationMap,
+  const map<unsigned int, vector<double>>& thresholdsMap,
+  bool setTHRValuesFromChannels
+) {
+  clear();
+  if (tombChannels.empty() || tombChannels.rbegin()->first < 0) { return; }
+  const unsigned int size = tombChannels.rbegin()->first + 1;
+  fChannels.resize(size);
+  fAccepted.assign((size + 63) / 64, 0);
+  for (const auto& tombChannel : tombChannels) {
+    if (tombChannel.first < 0 || !tombChannel.second) { continue; }
+    const unsigned int number = tombChannel.first;
+    const auto& channel = *tombChannel.second;
+    auto& info = fChannels[number];
+    info.tombChannel = tombChannel.second;
+    info.pmID = channel.getPM().getID();
+    info.side = channel.getPM().getSide();
+    info.thresholdNumber = channel.getLocalChannelNumber();
+    info.timeCalibration = UniversalFileLoader::getConfigurationParameter(timeCalibrationMap, number);
+    if (setTHRValuesFromChannels) {
+      info.thresholdValue = channel.getThreshold();
+    } else {
+      info.thresholdValue = UniversalFileLoader::getConfigurationParameter(thresholdsMap, number);
+    }
+    info.occupationHistogram = Form("pm_occupation_thr%d", info.thresholdNumber);
+    setAccepted(number, !isTriggerChannel(number));
+  }
+}
+
+/**
+ * Only channels from the set remain accepted
+ */
+void DAQChannelTable::restrictTo(const set<int>& allowedChannels) {
+  for (unsigned int channel = 0; channel < fChannels.size(); channel++) {
+    if (allowedChannels.find(channel) == allowedChannels.end()) {
+      setAccepted(channel, false);
+    }
+  }
+}
+
+void DAQChannelTable::clear() {
+  fChannels.clear();
+  fAccepted.clear();
+}
+
+void DAQChannelTable::setAccepted(unsigned int channel, bool accepted) {
+  const uint64_t bit = uint64_t(1) << (channel % 64);
+  if (accepted) {
+    fAccepted[channel / 64] |= bit;
+  } else {
+    fAccepted[channel / 64] &= ~bit;
+  }
+}
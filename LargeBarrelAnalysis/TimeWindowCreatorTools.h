@@ -21,8 +21,65 @@
 #include "JPetStatistics/JPetStatistics.h"
 #include "JPetTOMBChannel/JPetTOMBChannel.h"
 #include "TDCChannel.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
 #include <vector>
 
+/**
+ * @brief Attributes of one DAQ channel needed to build Signal Channels from its TDC hits
+ *
+ * Time calibration and threshold value are resolved once, when the table is built,
+ * threshold value is taken either from the setup or from the thresholds file.
+ */
+struct DAQChannelInfo {
+  const JPetTOMBChannel* tombChannel = nullptr;
+  int pmID = 0;
+  JPetPM::Side side = JPetPM::SideA;
+  int thresholdNumber = 0;
+  double thresholdValue = 0.0;
+  double timeCalibration = 0.0;
+  std::string occupationHistogram;
+};
+
+/**
+ * @brief Dense table of DAQ channels of the setup, indexed by DAQ channel number
+ *
+ * Built once in the init of the task, replaces parameter bank and calibration maps lookups
+ * for every TDC hit. Channels accepted for processing are kept in a bitmap - channel
+ * is accepted if it exists in the setup, is not a TRB trigger channel (every 65th)
+ * and passes the filter of allowed channels, if one is set.
+ */
+class DAQChannelTable {
+public:
+  void build(const std::map<int, JPetTOMBChannel*>& tombChannels,
+             const std::map<unsigned int, std::vector<double>>& timeCalibrationMap,
+             const std::map<unsigned int, std::vector<double>>& thresholdsMap,
+             bool setTHRValuesFromChannels);
+  void restrictTo(const std::set<int>& allowedChannels);
+  void clear();
+
+  bool isAccepted(unsigned int channel) const {
+    return channel < fChannels.size() && (fAccepted[channel / 64] >> (channel % 64)) & 1u;
+  }
+  /// Returns nullptr if the channel does not exist in the setup
+  const DAQChannelInfo* find(unsigned int channel) const {
+    if (channel >= fChannels.size() || !fChannels[channel].tombChannel) { return nullptr; }
+    return &fChannels[channel];
+  }
+  /// Valid only for accepted channels
+  const DAQChannelInfo& get(unsigned int channel) const { return fChannels[channel]; }
+  static bool isTriggerChannel(unsigned int channel) { return channel % 65 == 0; }
+  std::size_t size() const { return fChannels.size(); }
+
+private:
+  void setAccepted(unsigned int channel, bool accepted);
+
+  std::vector<DAQChannelInfo> fChannels;
+  std::vector<uint64_t> fAccepted;
+};
+
 /**
  * @brief Set of tools for Time Window Creator task
  *
@@ -44,6 +101,13 @@ public:
                 std::map<unsigned int, std::vector<double>> &timeCalibrationMap,
                 std::map<unsigned int, std::vector<double>> &thresholdsMap,
                 JPetSigCh::EdgeType edge, bool setTHRValuesFromChannels);
+  static std::vector<JPetSigCh>
+  buildSigChs(TDCChannel *tdcChannel, const DAQChannelInfo &channelInfo,
+              double maxTime, double minTime, JPetStatistics &stats,
+              bool saveHistos);
+  static JPetSigCh generateSigCh(double tdcChannelTime,
+                                 const DAQChannelInfo &channelInfo,
+                                 JPetSigCh::EdgeType edge);
 };
 
 #endif /* !TIMEWINDOWCREATORTOOLS_H */
@@ -18,8 +18,15 @@
 #include <algorithm>
 #include <sstream>
 #include "UniversalFileLoader.h"
+#include "CalibrationStore.h"
 #include "JPetLoggerInclude.h"
 
+const std::string UniversalFileLoader::kStoreDirectoryParamKey = "CalibrationStore_Directory_std::string";
+const std::string UniversalFileLoader::kStoreGeometryParamKey = "CalibrationStore_GeometryID_std::string";
+const std::string UniversalFileLoader::kStoreRegisterParamKey = "CalibrationStore_Register_bool";
+const std::string UniversalFileLoader::kStoreFirstRunParamKey = "CalibrationStore_FirstRun_int";
+const std::string UniversalFileLoader::kStoreLastRunParamKey = "CalibrationStore_LastRun_int";
+
 /**
  * Method returns a patameter for given TOMB channel
  */
@@ -54,6 +61,73 @@ UniversalFileLoader::TOMBChToParameter UniversalFileLoader::loadConfigurationPar
   return generateConfigurationParameters(confRecords, tombMap);
 }
 
+/**
+ * Method loading parameters of the current run from the calibration store,
+ * if the store directory is given in the options, otherwise from ASCII file.
+ * Constants loaded from ASCII file, when the store has none for the run, are added
+ * to the store if requested in the options, with validity for the current run
+ * or for the range of runs given in the options.
+ * Arguments: user options, name of the constants in the store (e.g. "TimeCalibration"),
+ * file name string and TOMBChMap as in the method above.
+ */
+UniversalFileLoader::TOMBChToParameter UniversalFileLoader::loadConfigurationParameters(
+  const jpet_options_tools::OptsStrAny& opts,
+  const std::string& calibrationName,
+  const std::string& confFile,
+  const UniversalFileLoader::TOMBChMap& tombMap)
+{
+  bool loadedFromStore = false;
+  return loadConfigurationParameters(opts, calibrationName, confFile, tombMap, loadedFromStore);
+}
+
+UniversalFileLoader::TOMBChToParameter UniversalFileLoader::loadConfigurationParameters(
+  const jpet_options_tools::OptsStrAny& opts,
+  const std::string& calibrationName,
+  const std::string& confFile,
+  const UniversalFileLoader::TOMBChMap& tombMap,
+  bool& loadedFromStore)
+{
+  using namespace jpet_options_tools;
+  loadedFromStore = false;
+  if (!isOptionSet(opts, kStoreDirectoryParamKey)) {
+    return loadConfigurationParameters(confFile, tombMap);
+  }
+  auto run = getRunNumber(opts);
+  std::string geometry;
+  if (isOptionSet(opts, kStoreGeometryParamKey)) {
+    geometry = getOptionAsString(opts, kStoreGeometryParamKey);
+  }
+  CalibrationStore store(getOptionAsString(opts, kStoreDirectoryParamKey));
+  if (auto entry = store.find(calibrationName, run, geometry)) {
+    auto table = CalibrationTable::map(store.getDirectory() + "/" + entry->tableFile);
+    if (table.isValid()) {
+      INFO("Loading " + calibrationName + " for run " + std::to_string(run) + " from calibration store: "
+        + store.getDirectory() + "/" + entry->tableFile + ", source: " + entry->provenance.source
+        + ", created: " + entry->provenance.created);
+      loadedFromStore = true;
+      return table.toConfigurationParameters();
+    }
+    ERROR("Table of " + calibrationName + " in calibration store is corrupted: " + entry->tableFile);
+  } else {
+    WARNING("No " + calibrationName + " for run " + std::to_string(run) + " in calibration store: " + store.getDirectory());
+  }
+  auto configurationParameters = loadConfigurationParameters(confFile, tombMap);
+  if (!configurationParameters.empty()
+    && isOptionSet(opts, kStoreRegisterParamKey) && getOptionAsBool(opts, kStoreRegisterParamKey)) {
+    auto firstRun = isOptionSet(opts, kStoreFirstRunParamKey) ? getOptionAsInt(opts, kStoreFirstRunParamKey) : run;
+    auto lastRun = isOptionSet(opts, kStoreLastRunParamKey) ? getOptionAsInt(opts, kStoreLastRunParamKey) : run;
+    CalibrationProvenance provenance;
+    provenance.source = boost::filesystem::absolute(confFile).string();
+    if (store.add(calibrationName, geometry, firstRun, lastRun, provenance, configurationParameters)) {
+      INFO("Added " + calibrationName + " for runs " + std::to_string(firstRun) + "-" + std::to_string(lastRun)
+        + " to calibration store: " + store.getDirectory());
+    } else {
+      ERROR("Could not add " + calibrationName + " to calibration store: " + store.getDirectory());
+    }
+  }
+  return configurationParameters;
+}
+
 /**
  * Method generates a dependedce map between TOMB channel numbers and
  * configuration paramters. Arguments: vector of configuration records,
@@ -27,6 +27,7 @@
 #include <map>
 #include <string>
 #include "JPetPM/JPetPM.h"
+#include "JPetOptionsTools/JPetOptionsTools.h"
 
 /**
  * POD structure, allowed values for fields (-1 corresponds to not set)
@@ -50,11 +51,26 @@ public:
   typedef std::map<std::tuple<int, int, JPetPM::Side, int>, int> TOMBChMap;
   static double getConfigurationParameter(const TOMBChToParameter& confParameters, const unsigned int channel);
   static TOMBChToParameter loadConfigurationParameters(const std::string& confFile, const TOMBChMap& tombMap);
+  static TOMBChToParameter loadConfigurationParameters(
+    const jpet_options_tools::OptsStrAny& opts, const std::string& calibrationName,
+    const std::string& confFile, const TOMBChMap& tombMap
+  );
+  /// As above, loadedFromStore tells if the parameters were taken from the calibration store
+  static TOMBChToParameter loadConfigurationParameters(
+    const jpet_options_tools::OptsStrAny& opts, const std::string& calibrationName,
+    const std::string& confFile, const TOMBChMap& tombMap, bool& loadedFromStore
+  );
   static TOMBChToParameter generateConfigurationParameters(const std::vector<ConfRecord>& confRecords,  const TOMBChMap& tombMap);
   static std::vector<ConfRecord> readConfigurationParametersFromFile(const std::string& confFile);
   static bool fillConfRecord(const std::string& input, ConfRecord& outRecord);
   static bool areConfRecordsValid(const std::vector<ConfRecord>& records);
 
+  static const std::string kStoreDirectoryParamKey;
+  static const std::string kStoreGeometryParamKey;
+  static const std::string kStoreRegisterParamKey;
+  static const std::string kStoreFirstRunParamKey;
+  static const std::string kStoreLastRunParamKey;
+
 private:
   UniversalFileLoader(const UniversalFileLoader&);
   void operator=(const UniversalFileLoader&);
@@ -0,0 +1,182 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  @file WorkStealingPool.h
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool of worker threads running a known set of jobs with work stealing
+ *
+ * Jobs are sorted by their estimated cost, e.g. size of the input file, from the largest,
+ * and dealt to the queues of the workers round robin. Each worker takes jobs from the front
+ * of its own queue and, when it is empty, steals from the back of the longest queue of another
+ * worker, so the cheapest jobs are moved and the workers finish at similar times even if
+ * the estimates are wrong.
+ *
+ * Usage:
+ * WorkStealingPool pool(8);
+ * pool.run(fileSizes, [&](std::size_t job, unsigned int worker) { process(files[job]); });
+ *
+ * Exception thrown by a job stops taking further jobs and is rethrown by run() after
+ * all workers finished.
+ */
+class WorkStealingPool
+{
+public:
+  typedef std::function<void(std::size_t job, unsigned int worker)> Job;
+
+  /// Number of workers 0 means all available hardware threads
+  explicit WorkStealingPool(unsigned int numberOfWorkers = 0)
+      : fNumberOfWorkers(numberOfWorkers > 0 ? numberOfWorkers : std::max(std::thread::hardware_concurrency(), 1u))
+  {
+  }
+
+  unsigned int getNumberOfWorkers() const { return fNumberOfWorkers; }
+  /// Number of jobs taken from queues of other workers in the last run
+  std::size_t getNumberOfStolenJobs() const { return fNumberOfStolenJobs; }
+
+  /// Runs jobs with indices 0 .. costs.size() - 1 and returns when all are done
+  void run(const std::vector<double>& costs, const Job& job)
+  {
+    std::vector<std::size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](std::size_t first, std::size_t second) { return costs[first] > costs[second]; });
+
+    fQueues.clear();
+    for (unsigned int worker = 0; worker < fNumberOfWorkers; worker++)
+    {
+      fQueues.emplace_back(new Queue());
+    }
+    for (std::size_t i = 0; i < order.size(); i++)
+    {
+      fQueues[i % fNumberOfWorkers]->jobs.push_back(order[i]);
+    }
+    fNumberOfStolenJobs = 0;
+    fStopped = false;
+    fException = nullptr;
+
+    std::vector<std::thread> workers;
+    for (unsigned int worker = 1; worker < fNumberOfWorkers; worker++)
+    {
+      workers.emplace_back(&WorkStealingPool::work, this, worker, std::cref(job));
+    }
+    work(0, job);
+    for (auto& worker : workers)
+    {
+      worker.join();
+    }
+    if (fException)
+    {
+      std::rethrow_exception(fException);
+    }
+  }
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<std::size_t> jobs;
+  };
+
+  void work(unsigned int worker, const Job& job)
+  {
+    std::size_t index = 0;
+    while (!fStopped && (pop(worker, index) || steal(worker, index)))
+    {
+      try
+      {
+        job(index, worker);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(fExceptionMutex);
+        if (!fException)
+        {
+          fException = std::current_exception();
+        }
+        fStopped = true;
+      }
+    }
+  }
+
+  bool pop(unsigned int worker, std::size_t& index)
+  {
+    auto& queue = *fQueues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+    {
+      return false;
+    }
+    index = queue.jobs.front();
+    queue.jobs.pop_front();
+    return true;
+  }
+
+  /// Jobs are never added during the run, so no job left in any queue means the end of work
+  bool steal(unsigned int thief, std::size_t& index)
+  {
+    while (true)
+    {
+      unsigned int victim = thief;
+      std::size_t longest = 0;
+      for (unsigned int worker = 0; worker < fNumberOfWorkers; worker++)
+      {
+        if (worker == thief)
+        {
+          continue;
+        }
+        std::lock_guard<std::mutex> lock(fQueues[worker]->mutex);
+        if (fQueues[worker]->jobs.size() > longest)
+        {
+          longest = fQueues[worker]->jobs.size();
+          victim = worker;
+        }
+      }
+      if (longest == 0)
+      {
+        return false;
+      }
+      std::lock_guard<std::mutex> lock(fQueues[victim]->mutex);
+      // queue could be emptied by its owner or another thief in the meantime
+      if (!fQueues[victim]->jobs.empty())
+      {
+        index = fQueues[victim]->jobs.back();
+        fQueues[victim]->jobs.pop_back();
+        fNumberOfStolenJobs++;
+        return true;
+      }
+    }
+  }
+
+  const unsigned int fNumberOfWorkers;
+  std::vector<std::unique_ptr<Queue>> fQueues;
+  std::atomic<std::size_t> fNumberOfStolenJobs{0};
+  std::atomic<bool> fStopped{false};
+  std::mutex fExceptionMutex;
+  std::exception_ptr fException;
+};
+
+#endif /* !WORKSTEALINGPOOL_H */
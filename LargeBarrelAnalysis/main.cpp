@@ -17,6 +17,8 @@
 #include "EventCategorizer.h"
 #include "EventFinder.h"
 #include "HitFinder.h"
+#include "InstrumentedTask.h"
+#include "ReadAheadTools.h"
 #include "SignalFinder.h"
 #include "SignalTransformer.h"
 #include "TimeWindowCreator.h"
@@ -30,13 +32,13 @@ int main(int argc, const char* argv[])
   {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<EventFinder>("EventFinder");
-    manager.registerTask<Downscaler>("Downscaler");
-    manager.registerTask<EventCategorizer>("EventCategorizer");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<EventFinder>>("EventFinder");
+    manager.registerTask<InstrumentedTask<Downscaler>>("Downscaler");
+    manager.registerTask<InstrumentedTask<EventCategorizer>>("EventCategorizer");
 
     manager.useTask("TimeWindowCreator", "hld", "tslot.calib");
     manager.useTask("SignalFinder", "tslot.calib", "raw.sig");
@@ -46,6 +48,8 @@ int main(int argc, const char* argv[])
     manager.useTask("Downscaler", "unk.evt", "presel.evt");
     manager.useTask("EventCategorizer", "presel.evt", "cat.evt");
 
+    ReadAheadTools::enableReadAhead(ReadAheadTools::readSettings(argc, argv));
+
     manager.run(argc, argv);
   }
   catch (const std::exception& except)
@@ -0,0 +1,91 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file AllocationCounterTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AllocationCounterTest
+
+#include "../AllocationCounter.h"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(AllocationCounterTestSuite)
+
+BOOST_AUTO_TEST_CASE(emptyCounterTest)
+{
+  AllocationCounter counter;
+  BOOST_REQUIRE_EQUAL(counter.getTotalAllocations(), 0u);
+  BOOST_REQUIRE_EQUAL(counter.getNumberOfWindows(), 0u);
+  BOOST_REQUIRE_CLOSE(counter.getMeanWindowAllocations(), 0.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(vectorBufferTest)
+{
+  AllocationCounter counter;
+  std::vector<int> buffer;
+  counter.startWindow();
+  for (int i = 0; i < 100; i++)
+  {
+    counter.pushBack(buffer, i);
+  }
+  counter.finishWindow();
+  BOOST_REQUIRE_EQUAL(buffer.size(), 100u);
+  BOOST_REQUIRE(counter.getWindowAllocations() > 0u);
+  auto firstWindowAllocations = counter.getWindowAllocations();
+
+  // The same number of elements fits into the buffer kept from the previous window
+  buffer.clear();
+  counter.startWindow();
+  for (int i = 0; i < 100; i++)
+  {
+    counter.pushBack(buffer, i);
+  }
+  counter.finishWindow();
+  BOOST_REQUIRE_EQUAL(counter.getWindowAllocations(), 0u);
+  BOOST_REQUIRE_EQUAL(counter.getTotalAllocations(), firstWindowAllocations);
+  BOOST_REQUIRE_EQUAL(counter.getMaxWindowAllocations(), firstWindowAllocations);
+  BOOST_REQUIRE_EQUAL(counter.getNumberOfWindows(), 2u);
+  BOOST_REQUIRE_CLOSE(counter.getMeanWindowAllocations(), firstWindowAllocations / 2.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(mapBuffersTest)
+{
+  AllocationCounter counter;
+  std::map<int, std::vector<double>> buffers;
+  counter.startWindow();
+  counter.pushBack(counter.getBuffer(buffers, 1), 1.0);
+  counter.pushBack(counter.getBuffer(buffers, 2), 2.0);
+  counter.pushBack(counter.getBuffer(buffers, 1), 3.0);
+  counter.finishWindow();
+  BOOST_REQUIRE_EQUAL(buffers.size(), 2u);
+  BOOST_REQUIRE_EQUAL(buffers.at(1).size(), 2u);
+  BOOST_REQUIRE_EQUAL(buffers.at(2).size(), 1u);
+
+  AllocationCounter::clearBuffers(buffers);
+  BOOST_REQUIRE_EQUAL(buffers.size(), 2u);
+  BOOST_REQUIRE(buffers.at(1).empty());
+  BOOST_REQUIRE(buffers.at(1).capacity() >= 2u);
+
+  counter.startWindow();
+  counter.pushBack(counter.getBuffer(buffers, 2), 4.0);
+  counter.finishWindow();
+  BOOST_REQUIRE_EQUAL(counter.getWindowAllocations(), 0u);
+
+  counter.startWindow();
+  counter.getBuffer(buffers, 3);
+  counter.finishWindow();
+  BOOST_REQUIRE_EQUAL(counter.getWindowAllocations(), 1u);
+  BOOST_REQUIRE_EQUAL(counter.getNumberOfWindows(), 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
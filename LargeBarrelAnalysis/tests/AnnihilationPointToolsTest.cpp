@@ -0,0 +1,86 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file AnnihilationPointToolsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AnnihilationPointToolsTest
+
+#include "../AnnihilationPointTools.h"
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(AnnihilationPointToolsTestSuite)
+
+BOOST_AUTO_TEST_CASE(singleLORTest)
+{
+  double x = 0.0, y = 0.0, z = 0.0;
+  AnnihilationPointTools::calculateAnnihilationPoint(-10.0, 0.0, 0.0, 10.0, 0.0, 0.0, 0.0, x, y, z);
+  BOOST_REQUIRE_SMALL(x, 1.e-9);
+  BOOST_REQUIRE_SMALL(y, 1.e-9);
+  BOOST_REQUIRE_SMALL(z, 1.e-9);
+
+  // First hit later than the second one by 200 ps, so the point is shifted by 3 cm towards the second one
+  const double tof = AnnihilationPointTools::calculateTOF(1200.0, 1000.0);
+  BOOST_REQUIRE_CLOSE(tof, 200.0, 1.e-9);
+  AnnihilationPointTools::calculateAnnihilationPoint(0.0, -10.0, 2.0, 0.0, 10.0, 2.0, tof, x, y, z);
+  BOOST_REQUIRE_SMALL(x, 1.e-9);
+  BOOST_REQUIRE_CLOSE(y, 0.5 * 200.0 * AnnihilationPointTools::kLightVelocity_cm_ps, 1.e-9);
+  BOOST_REQUIRE_CLOSE(z, 2.0, 1.e-9);
+
+  // Hits in the same point give the middle of the LOR
+  AnnihilationPointTools::calculateAnnihilationPoint(1.0, 2.0, 3.0, 1.0, 2.0, 3.0, 500.0, x, y, z);
+  BOOST_REQUIRE_CLOSE(x, 1.0, 1.e-9);
+  BOOST_REQUIRE_CLOSE(y, 2.0, 1.e-9);
+  BOOST_REQUIRE_CLOSE(z, 3.0, 1.e-9);
+}
+
+BOOST_AUTO_TEST_CASE(batchTest)
+{
+  LORBatch lors;
+  AnnihilationPointBatch points;
+  AnnihilationPointTools::calculateAnnihilationPoints(lors, points);
+  BOOST_REQUIRE_EQUAL(points.size(), 0u);
+
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> time(0.0, 5000.0);
+  const std::size_t numberOfLORs = 1001;
+  for (std::size_t i = 0; i < numberOfLORs; i++)
+  {
+    lors.addLOR(position(generator), position(generator), position(generator), time(generator), position(generator), position(generator),
+                position(generator), time(generator));
+  }
+  lors.addLOR(5.0, 5.0, 5.0, 100.0, 5.0, 5.0, 5.0, 300.0);
+  AnnihilationPointTools::calculateAnnihilationPoints(lors, points);
+  BOOST_REQUIRE_EQUAL(points.size(), lors.size());
+
+  for (std::size_t i = 0; i < lors.size(); i++)
+  {
+    double x = 0.0, y = 0.0, z = 0.0;
+    const double tof = AnnihilationPointTools::calculateTOF(lors.firstTime[i], lors.secondTime[i]);
+    AnnihilationPointTools::calculateAnnihilationPoint(lors.firstX[i], lors.firstY[i], lors.firstZ[i], lors.secondX[i], lors.secondY[i],
+                                                       lors.secondZ[i], tof, x, y, z);
+    BOOST_REQUIRE_CLOSE(points.tof[i], tof, 1.e-9);
+    BOOST_REQUIRE_SMALL(points.x[i] - x, 1.e-9);
+    BOOST_REQUIRE_SMALL(points.y[i] - y, 1.e-9);
+    BOOST_REQUIRE_SMALL(points.z[i] - z, 1.e-9);
+  }
+
+  lors.clear();
+  BOOST_REQUIRE_EQUAL(lors.size(), 0u);
+  AnnihilationPointTools::calculateAnnihilationPoints(lors, points);
+  BOOST_REQUIRE_EQUAL(points.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file CalibrationStoreTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CalibrationStoreTest
+
+#include "../CalibrationStore.h"
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+namespace
+{
+struct StoreDirectory
+{
+  const std::string path = "CalibrationStoreTest_store";
+  StoreDirectory() { boost::filesystem::remove_all(path); }
+  ~StoreDirectory() { boost::filesystem::remove_all(path); }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(CalibrationStoreTestSuite)
+
+BOOST_AUTO_TEST_CASE(emptyStoreTest)
+{
+  StoreDirectory directory;
+  CalibrationStore store(directory.path);
+  BOOST_REQUIRE(store.getEntries().empty());
+  BOOST_REQUIRE(store.find("TimeCalibration", 1) == nullptr);
+  BOOST_REQUIRE(!store.load("TimeCalibration", 1).isValid());
+  BOOST_REQUIRE(!CalibrationTable::map(directory.path + "/missing.cal").isValid());
+}
+
+BOOST_AUTO_TEST_CASE(tableTest)
+{
+  StoreDirectory directory;
+  boost::filesystem::create_directories(directory.path);
+  const std::string fileName = directory.path + "/table.cal";
+  CalibrationStore::Parameters parameters = {{2, {1.5, 2.5}}, {5, {-3.0}}, {static_cast<unsigned int>(-1), {-1.0, -1.0}}};
+  BOOST_REQUIRE(CalibrationStore::writeTable(fileName, parameters));
+
+  auto table = CalibrationTable::map(fileName);
+  BOOST_REQUIRE(table.isValid());
+  BOOST_REQUIRE_EQUAL(table.getNumberOfChannels(), 6u);
+  BOOST_REQUIRE_EQUAL(table.getNumberOfParameters(), 2u);
+  BOOST_REQUIRE(!table.hasChannel(0));
+  BOOST_REQUIRE(table.hasChannel(2));
+  BOOST_REQUIRE(table.hasChannel(5));
+  BOOST_REQUIRE(!table.hasChannel(100));
+  BOOST_REQUIRE_EQUAL(table.getParameter(2), 1.5);
+  BOOST_REQUIRE_EQUAL(table.getParameter(2, 1), 2.5);
+  BOOST_REQUIRE_EQUAL(table.getParameter(5), -3.0);
+  BOOST_REQUIRE_EQUAL(table.getParameter(5, 1), 0.0);
+  BOOST_REQUIRE_EQUAL(table.getParameter(3), 0.0);
+  BOOST_REQUIRE_EQUAL(table.getParameter(2, 7), 0.0);
+
+  CalibrationStore::Parameters expected = {{2, {1.5, 2.5}}, {5, {-3.0}}};
+  BOOST_REQUIRE(table.toConfigurationParameters() == expected);
+
+  auto movedTable = std::move(table);
+  BOOST_REQUIRE(!table.isValid());
+  BOOST_REQUIRE(movedTable.isValid());
+  BOOST_REQUIRE_EQUAL(movedTable.getParameter(2, 1), 2.5);
+
+  std::ofstream(directory.path + "/corrupted.cal") << "not a table";
+  BOOST_REQUIRE(!CalibrationTable::map(directory.path + "/corrupted.cal").isValid());
+  BOOST_REQUIRE(!CalibrationStore::writeTable(fileName, {{CalibrationStore::kMaxNumberOfChannels, {1.0}}}));
+}
+
+BOOST_AUTO_TEST_CASE(intervalOfValidityTest)
+{
+  StoreDirectory directory;
+  CalibrationStore store(directory.path);
+  CalibrationProvenance provenance;
+  provenance.source = "calib_\trun_1.txt";
+  provenance.comment = "first campaign";
+  BOOST_REQUIRE(store.add("TimeCalibration", "", 100, 199, provenance, {{1, {10.0}}}));
+  BOOST_REQUIRE(store.add("TimeCalibration", "setup_2", 150, 160, {"recalibration.txt", "", ""}, {{1, {20.0}}}));
+  BOOST_REQUIRE(store.add("Velocities", "setup_2", 100, 199, {"velocities.txt", "", ""}, {{1, {12.0}}}));
+  BOOST_REQUIRE(!store.add("Velocities", "setup_2", 200, 199, {"velocities.txt", "", ""}, {{1, {12.0}}}));
+
+  BOOST_REQUIRE_EQUAL(store.load("TimeCalibration", 120).getParameter(1), 10.0);
+  BOOST_REQUIRE_EQUAL(store.load("TimeCalibration", 155).getParameter(1), 20.0);
+  BOOST_REQUIRE_EQUAL(store.load("TimeCalibration", 155, "setup_2").getParameter(1), 20.0);
+  BOOST_REQUIRE_EQUAL(store.load("TimeCalibration", 155, "setup_1").getParameter(1), 10.0);
+  BOOST_REQUIRE_EQUAL(store.load("TimeCalibration", 199).getParameter(1), 10.0);
+  BOOST_REQUIRE(!store.load("TimeCalibration", 200).isValid());
+  BOOST_REQUIRE(!store.load("Velocities", 120, "setup_1").isValid());
+  BOOST_REQUIRE_EQUAL(store.load("Velocities", 120, "setup_2").getParameter(1), 12.0);
+
+  CalibrationStore reopened(directory.path);
+  BOOST_REQUIRE_EQUAL(reopened.getEntries().size(), 3u);
+  auto entry = reopened.find("TimeCalibration", 120);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->geometry, "");
+  BOOST_REQUIRE_EQUAL(entry->firstRun, 100);
+  BOOST_REQUIRE_EQUAL(entry->lastRun, 199);
+  BOOST_REQUIRE_EQUAL(entry->provenance.source, "calib_ run_1.txt");
+  BOOST_REQUIRE_EQUAL(entry->provenance.comment, "first campaign");
+  BOOST_REQUIRE(!entry->provenance.created.empty());
+  BOOST_REQUIRE_EQUAL(reopened.find("TimeCalibration", 155)->provenance.source, "recalibration.txt");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file CategorizerCutScanTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CategorizerCutScanTest
+
+#include "../CategorizerCutScan.h"
+#include <TH1F.h>
+#include <TH2F.h>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(CategorizerCutScanTestSuite)
+
+BOOST_AUTO_TEST_CASE(noScanTest)
+{
+  jpet_options_tools::OptsStrAny opts;
+  std::string error;
+  auto cutSets = CategorizerCutScan::readCutSets(opts, CategorizerCutSet(), error);
+  BOOST_REQUIRE(cutSets.empty());
+  BOOST_REQUIRE(error.empty());
+}
+
+BOOST_AUTO_TEST_CASE(broadcastAndNominalCutsTest)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["EventCategorizer_CutScan_MinAnnihilationTOT_std::vector<double>"] = std::vector<double>{8000.0, 10000.0, 12000.0};
+  opts["EventCategorizer_CutScan_MaxHitZPos_std::vector<double>"] = std::vector<double>{20.0};
+  CategorizerCutSet nominal;
+  nominal.maxAnnihilationTOT = 30000.0;
+  std::string error;
+  auto cutSets = CategorizerCutScan::readCutSets(opts, nominal, error);
+  BOOST_REQUIRE(error.empty());
+  BOOST_REQUIRE_EQUAL(cutSets.size(), 3u);
+  BOOST_REQUIRE_EQUAL(cutSets[0].minAnnihilationTOT, 8000.0);
+  BOOST_REQUIRE_EQUAL(cutSets[2].minAnnihilationTOT, 12000.0);
+  for (const auto& cuts : cutSets)
+  {
+    BOOST_REQUIRE_EQUAL(cuts.maxZPos, 20.0);
+    BOOST_REQUIRE_EQUAL(cuts.maxAnnihilationTOT, 30000.0);
+    BOOST_REQUIRE_EQUAL(cuts.maxTimeDiff, nominal.maxTimeDiff);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(mismatchedLengthsTest)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["EventCategorizer_CutScan_MinAnnihilationTOT_std::vector<double>"] = std::vector<double>{8000.0, 10000.0, 12000.0};
+  opts["EventCategorizer_CutScan_MaxAnnihilationTOT_std::vector<double>"] = std::vector<double>{20000.0, 25000.0};
+  std::string error;
+  auto cutSets = CategorizerCutScan::readCutSets(opts, CategorizerCutSet(), error);
+  BOOST_REQUIRE(cutSets.empty());
+  BOOST_REQUIRE(!error.empty());
+}
+
+BOOST_AUTO_TEST_CASE(hitSelectionTest)
+{
+  CategorizerCutSet cuts;
+  BOOST_REQUIRE(cuts.isAnnihilationHit(15000.0, 10.0));
+  BOOST_REQUIRE(!cuts.isAnnihilationHit(15000.0, -24.0));
+  BOOST_REQUIRE(!cuts.isAnnihilationHit(35000.0, 0.0));
+  BOOST_REQUIRE(cuts.isDeexcitationHit(35000.0, 0.0));
+  BOOST_REQUIRE(!cuts.isDeexcitationHit(15000.0, 0.0));
+}
+
+BOOST_AUTO_TEST_CASE(countersTest)
+{
+  std::vector<CategorizerCutSet> cutSets(2);
+  cutSets[1].maxZPos = 10.0;
+  JPetStatistics stats;
+  CategorizerCutScan scan;
+  scan.init(cutSets, true, stats);
+  BOOST_REQUIRE(scan.isEnabled());
+
+  JPetHit hit;
+  hit.setPosZ(15.0);
+  std::vector<JPetHit> hits = {hit};
+  std::vector<double> tots = {15000.0};
+  scan.evaluate(hits, tots, stats);
+  scan.evaluate(hits, tots, stats);
+
+  auto counters = stats.getHisto2D(CategorizerCutScan::kCountersHistogramName.c_str());
+  BOOST_REQUIRE_EQUAL(counters->GetBinContent(1, CategorizerCutScan::kAllEvents), 2.0);
+  BOOST_REQUIRE_EQUAL(counters->GetBinContent(2, CategorizerCutScan::kAllEvents), 2.0);
+  BOOST_REQUIRE_EQUAL(counters->GetBinContent(1, CategorizerCutScan::kAnnihilationEvents), 2.0);
+  BOOST_REQUIRE_EQUAL(counters->GetBinContent(2, CategorizerCutScan::kAnnihilationEvents), 0.0);
+  BOOST_REQUIRE_EQUAL(counters->GetBinContent(1, CategorizerCutScan::k2GammaEvents), 0.0);
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D(CategorizerCutScan::getHistogramName("AnnihHitsNumber", 0).c_str())->GetMean(), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
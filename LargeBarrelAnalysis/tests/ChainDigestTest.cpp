@@ -0,0 +1,502 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ChainDigestTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ChainDigestTest
+
+#include "../ChainDigest.h"
+#include "../EventCategorizerTools.h"
+#include "../EventFinder.h"
+#include "../HitFinderTools.h"
+#include "../SignalFinderTools.h"
+#include "../SignalTransformer.h"
+#include "../TimeWindowCreatorTools.h"
+#include "../ToTEnergyConverter.h"
+#include <JPetAnalysisTools/JPetAnalysisTools.h>
+#include <JPetBarrelSlot/JPetBarrelSlot.h>
+#include <JPetCachedFunction/JPetCachedFunction.h>
+#include <JPetFEB/JPetFEB.h>
+#include <JPetLayer/JPetLayer.h>
+#include <JPetPM/JPetPM.h>
+#include <JPetScin/JPetScin.h>
+#include <JPetTOMBChannel/JPetTOMBChannel.h>
+#include <JPetTRB/JPetTRB.h>
+#include <JPetTimeWindow/JPetTimeWindow.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+using namespace tot_energy_converter;
+using namespace jpet_common_tools;
+
+namespace
+{
+const int kSlots = 8;
+const int kPMIDOffset = 100;
+const double kRadius = 42.5;  // [cm]
+const double kVelocity = 12.0; // [cm/ns]
+const float kThresholds[SignalFinderTools::kNumberOfThresholds] = {80.0, 160.0, 240.0, 320.0};
+
+// Default parameters of the tasks
+const int kRefPMID = 385;
+const double kSigChEdgeMaxTime = 5000.0;
+const double kSigChLeadTrailMaxTime = 23000.0;
+const double kABTimeDiff = 6000.0;
+const int kRefDetScinID = -1;
+const double kScatterTOFTimeDiff = 2000.0;
+const double kB2BSlotThetaDiff = 3.0;
+const double kDeexTOTCutMin = 30000.0;
+const double kDeexTOTCutMax = 50000.0;
+const double kMaxTimeDiff = 1000.0;
+
+const char* kUpdateGoldenEnvironmentVariable = "JPET_UPDATE_CHAIN_DIGEST";
+
+/// Channels are numbered away from the multiples of 65, that are TRB trigger channels
+unsigned int getChannelNumber(int slot, int side, int threshold) { return 1 + slot * 8 + side * 4 + threshold; }
+
+/// Detector of one layer of slots, each with a scintillator read by two PMs on four thresholds
+class SyntheticSetup
+{
+public:
+  SyntheticSetup()
+  {
+    for (int slot = 0; slot < kSlots; slot++)
+    {
+      fSlots.emplace_back(slot + 1, true, "slot" + std::to_string(slot + 1), 45.0 * slot, slot + 1);
+      fSlots.back().setLayer(fLayer);
+      fScins.emplace_back(slot + 1);
+      fScins.back().setBarrelSlot(fSlots.back());
+      for (int side = 0; side < 2; side++)
+      {
+        fPMs.emplace_back(kPMIDOffset + 2 * slot + side, "pm" + std::to_string(kPMIDOffset + 2 * slot + side));
+        auto& pm = fPMs.back();
+        pm.setScin(fScins.back());
+        pm.setBarrelSlot(fSlots.back());
+        pm.setSide(side == 0 ? JPetPM::SideA : JPetPM::SideB);
+        for (int threshold = 0; threshold < SignalFinderTools::kNumberOfThresholds; threshold++)
+        {
+          const auto number = getChannelNumber(slot, side, threshold);
+          fChannels.emplace_back(number);
+          auto& channel = fChannels.back();
+          channel.setFEB(fFEB);
+          channel.setTRB(fTRB);
+          channel.setPM(pm);
+          channel.setThreshold(kThresholds[threshold]);
+          channel.setLocalChannelNumber(threshold + 1);
+          fTOMBChannels[number] = &channel;
+          fVelocities[number] = {kVelocity};
+        }
+      }
+    }
+    fChannelTable.build(fTOMBChannels, {}, {}, true);
+  }
+
+  const DAQChannelTable& getChannelTable() const { return fChannelTable; }
+  const std::map<unsigned int, std::vector<double>>& getVelocities() const { return fVelocities; }
+
+private:
+  JPetLayer fLayer{1, true, "layer1", kRadius};
+  JPetFEB fFEB{1, true, "synthetic", "front-end board of the synthetic setup", 1, 1, 4, 4};
+  JPetTRB fTRB{1, 1, 1};
+  // Containers keeping addresses of elements, referenced by the other objects of the setup
+  std::deque<JPetBarrelSlot> fSlots;
+  std::deque<JPetScin> fScins;
+  std::deque<JPetPM> fPMs;
+  std::deque<JPetTOMBChannel> fChannels;
+  std::map<int, JPetTOMBChannel*> fTOMBChannels;
+  std::map<unsigned int, std::vector<double>> fVelocities;
+  DAQChannelTable fChannelTable;
+};
+
+/// Gamma interacting in a scintillator, seen by the PMs on both sides unless a side is given
+struct Interaction
+{
+  int slot;
+  double time; // [ns]
+  double posZ; // [cm]
+  double tot;  // [ns] on the lowest threshold
+  int onlySide = -1;
+  bool repeatedLeading = false;
+};
+
+/**
+ * Two time windows covering: back-to-back pair with a prompt photon, three photons,
+ * a signal seen on one side only, a repeated leading edge giving Corrupted Signal Channels,
+ * another pair and a photon scattered to the neighbouring slot.
+ */
+std::vector<std::vector<Interaction>> getSyntheticWindows()
+{
+  return {{{0, 100.0, 3.2, 2.9},
+           {4, 100.4, -2.5, 3.1},
+           {2, 102.0, 1.0, 5.2},
+           {1, 400.0, 7.5, 2.4},
+           {3, 400.6, -11.0, 2.6},
+           {6, 401.1, 0.4, 2.2},
+           {7, 600.0, 0.0, 3.0, 0},
+           {5, 800.0, -4.0, 2.7, -1, true}},
+          {{2, 50.0, 12.5, 3.0}, {6, 50.3, -12.0, 3.3}, {0, 300.0, -6.0, 2.8}, {1, 301.5, -5.0, 1.9}}};
+}
+
+/// Times of the edges registered by the TDC channels [ns], as in an unpacked event
+struct TDCTimes
+{
+  std::vector<double> leads;
+  std::vector<double> trails;
+};
+
+std::map<unsigned int, TDCTimes> getTDCTimes(const std::vector<Interaction>& interactions)
+{
+  std::map<unsigned int, TDCTimes> tdcTimes;
+  for (const auto& interaction : interactions)
+  {
+    for (int side = 0; side < 2; side++)
+    {
+      if (interaction.onlySide >= 0 && interaction.onlySide != side)
+      {
+        continue;
+      }
+      const double sideTime = interaction.time + (side == 0 ? -1.0 : 1.0) * interaction.posZ / kVelocity;
+      for (int threshold = 0; threshold < SignalFinderTools::kNumberOfThresholds; threshold++)
+      {
+        auto& times = tdcTimes[getChannelNumber(interaction.slot, side, threshold)];
+        times.leads.push_back(sideTime + 0.2 * threshold);
+        times.trails.push_back(sideTime + interaction.tot - 0.3 * threshold);
+        if (interaction.repeatedLeading && side == 1 && threshold == 1)
+        {
+          times.leads.push_back(sideTime - 1.5);
+        }
+      }
+    }
+  }
+  return tdcTimes;
+}
+
+void createHistograms(JPetStatistics& stats, const std::vector<std::string>& names1D, const std::vector<std::string>& names2D)
+{
+  // Common binning, the digest compares also statistics of the histograms, sensitive to exact values
+  for (const auto& name : names1D)
+  {
+    stats.createHistogram(new TH1D(name.c_str(), name.c_str(), 2000, -100000.0, 100000.0));
+  }
+  for (const auto& name : names2D)
+  {
+    stats.createHistogram(new TH2D(name.c_str(), name.c_str(), 200, -100000.0, 100000.0, 200, -100000.0, 100000.0));
+  }
+}
+
+class ChainSignalTransformer : public SignalTransformer
+{
+public:
+  ChainSignalTransformer() : SignalTransformer("ChainSignalTransformer") {}
+  using SignalTransformer::createPhysSignal;
+  using SignalTransformer::createRecoSignal;
+};
+
+class ChainEventFinder : public EventFinder
+{
+public:
+  ChainEventFinder() : EventFinder("ChainEventFinder") { fFillControlHistos = false; }
+  using EventFinder::buildEvents;
+};
+
+using TimeWindows = std::vector<std::unique_ptr<JPetTimeWindow>>;
+
+/**
+ * Runs the chain from Signal Channels to categorized Events with default parameters of the tasks,
+ * with the same tools the tasks call in their exec, including the buffers kept between time windows.
+ * Control histograms filled by the tools are digested, histograms filled directly by the tasks
+ * and the I/O of the framework are not covered.
+ */
+ChainDigest runChain(const SyntheticSetup& setup)
+{
+  ChainDigest digest;
+
+  digest.beginStage("TimeWindowCreator");
+  JPetStatistics timeWindowStats;
+  createHistograms(timeWindowStats,
+                   {"good_vs_bad_sigch", "LT_time_diff", "LL_per_PM", "LL_per_THR", "LL_time_diff", "TT_per_PM", "TT_per_THR", "TT_time_diff",
+                    "pm_occupation_thr1", "pm_occupation_thr2", "pm_occupation_thr3", "pm_occupation_thr4"},
+                   {});
+  TimeWindows sigChWindows;
+  for (const auto& interactions : getSyntheticWindows())
+  {
+    sigChWindows.emplace_back(new JPetTimeWindow("JPetSigCh"));
+    for (const auto& channelTimes : getTDCTimes(interactions))
+    {
+      if (!setup.getChannelTable().isAccepted(channelTimes.first))
+      {
+        continue;
+      }
+      const auto& channelInfo = setup.getChannelTable().get(channelTimes.first);
+      std::vector<JPetSigCh> sigChs;
+      for (auto time : channelTimes.second.leads)
+      {
+        sigChs.push_back(TimeWindowCreatorTools::generateSigCh(time, channelInfo, JPetSigCh::Leading));
+        timeWindowStats.fillHistogram(channelInfo.occupationHistogram.c_str(), channelInfo.pmID);
+      }
+      for (auto time : channelTimes.second.trails)
+      {
+        sigChs.push_back(TimeWindowCreatorTools::generateSigCh(time, channelInfo, JPetSigCh::Trailing));
+        timeWindowStats.fillHistogram(channelInfo.occupationHistogram.c_str(), channelInfo.pmID);
+      }
+      TimeWindowCreatorTools::sortByValue(sigChs);
+      TimeWindowCreatorTools::flagSigChs(sigChs, timeWindowStats, true);
+      for (const auto& sigCh : sigChs)
+      {
+        sigChWindows.back()->add<JPetSigCh>(sigCh);
+        digest.add(sigCh);
+      }
+    }
+  }
+  digest.addHistograms(timeWindowStats);
+
+  digest.beginStage("SignalFinder");
+  JPetStatistics signalFinderStats;
+  createHistograms(signalFinderStats,
+                   {"unused_sigch_all", "unused_sigch_good", "unused_sigch_corr", "lead_thr1_thr2_diff", "lead_thr1_thr3_diff", "lead_thr1_thr4_diff",
+                    "lead_trail_thr1_diff", "lead_trail_thr2_diff", "lead_trail_thr3_diff", "lead_trail_thr4_diff", "good_v_bad_raw_sigs"},
+                   {});
+  TimeWindows rawSignalWindows;
+  SignalFinderTools::Buffers signalFinderBuffers;
+  for (const auto& sigChWindow : sigChWindows)
+  {
+    signalFinderBuffers.counter.startWindow();
+    SignalFinderTools::getSigChByPM(sigChWindow.get(), false, kRefPMID, signalFinderBuffers);
+    SignalFinderTools::buildAllSignals(signalFinderBuffers.sigChByPM, kSigChEdgeMaxTime, kSigChLeadTrailMaxTime, signalFinderStats, true,
+                                       SignalFinderTools::ThresholdOrderings(), signalFinderBuffers);
+    rawSignalWindows.emplace_back(new JPetTimeWindow("JPetRawSignal"));
+    for (const auto& rawSignal : signalFinderBuffers.rawSignals)
+    {
+      rawSignalWindows.back()->add<JPetRawSignal>(rawSignal);
+      digest.add(rawSignal);
+    }
+    signalFinderBuffers.counter.finishWindow();
+  }
+  digest.addHistograms(signalFinderStats);
+
+  digest.beginStage("SignalTransformer");
+  ChainSignalTransformer signalTransformer;
+  TimeWindows physSignalWindows;
+  for (const auto& rawSignalWindow : rawSignalWindows)
+  {
+    physSignalWindows.emplace_back(new JPetTimeWindow("JPetPhysSignal"));
+    for (unsigned int i = 0; i < rawSignalWindow->getNumberOfEvents(); i++)
+    {
+      const auto& rawSignal = dynamic_cast<const JPetRawSignal&>(rawSignalWindow->operator[](i));
+      if (rawSignal.getRecoFlag() == JPetBaseSignal::Corrupted)
+      {
+        continue;
+      }
+      auto physSignal = signalTransformer.createPhysSignal(signalTransformer.createRecoSignal(rawSignal));
+      physSignalWindows.back()->add<JPetPhysSignal>(physSignal);
+      digest.add(physSignal);
+    }
+  }
+
+  digest.beginStage("HitFinder");
+  JPetStatistics hitFinderStats;
+  createHistograms(hitFinderStats, {"good_vs_bad_hits", "remain_signals_per_scin", "remain_signals_tdiff"}, {"time_diff_per_scin", "hit_pos_per_scin"});
+  ToTEnergyConverter totConverter(JPetCachedFunctionParams("pol1", {0.0, 10.0}), Range(10000, 0., 100.));
+  TimeWindows hitWindows;
+  std::map<int, std::vector<JPetPhysSignal>> signalsBySlot;
+  AllocationCounter hitFinderCounter;
+  for (const auto& physSignalWindow : physSignalWindows)
+  {
+    hitFinderCounter.startWindow();
+    HitFinderTools::getSignalsBySlot(physSignalWindow.get(), false, signalsBySlot, hitFinderCounter);
+    auto allHits = HitFinderTools::matchAllSignals(signalsBySlot, setup.getVelocities(), kABTimeDiff, kRefDetScinID, false, totConverter,
+                                                   hitFinderStats, true);
+    hitWindows.emplace_back(new JPetTimeWindow("JPetHit"));
+    for (const auto& hit : JPetAnalysisTools::getHitsOrderedByTime(allHits))
+    {
+      hitWindows.back()->add<JPetHit>(hit);
+      digest.add(hit);
+    }
+    hitFinderCounter.finishWindow();
+  }
+  digest.addHistograms(hitFinderStats);
+
+  digest.beginStage("EventFinder");
+  ChainEventFinder eventFinder;
+  TimeWindows eventWindows;
+  for (const auto& hitWindow : hitWindows)
+  {
+    eventWindows.emplace_back(new JPetTimeWindow("JPetEvent"));
+    for (const auto& event : eventFinder.buildEvents(*hitWindow))
+    {
+      eventWindows.back()->add<JPetEvent>(event);
+      digest.add(event);
+    }
+  }
+
+  digest.beginStage("EventCategorizer");
+  JPetStatistics categorizerStats;
+  createHistograms(categorizerStats,
+                   {"2Gamma_Zpos", "2Gamma_DLOR", "2Gamma_ThetaDiff", "2Gamma_TimeDiff", "2Gamma_Dist", "Annih_TOF", "Annih_DLOR", "ScatterTOF_TimeDiff",
+                    "Deex_TOT_cut"},
+                   {"AnnihPoint_XY", "AnnihPoint_ZX", "AnnihPoint_ZY", "3Gamma_Angles", "ScatterAngle_PrimaryTOT", "ScatterAngle_ScatterTOT"});
+  for (const auto& eventWindow : eventWindows)
+  {
+    for (unsigned int i = 0; i < eventWindow->getNumberOfEvents(); i++)
+    {
+      const auto& event = dynamic_cast<const JPetEvent&>(eventWindow->operator[](i));
+      auto hitQuantities = HitFinderTools::calculateHitQuantities(event.getHits(), HitFinderTools::kSimplified);
+      JPetEvent newEvent = event;
+      if (EventCategorizerTools::checkFor2Gamma(event, categorizerStats, true, kB2BSlotThetaDiff, kMaxTimeDiff))
+      {
+        newEvent.addEventType(JPetEventType::k2Gamma);
+      }
+      if (EventCategorizerTools::checkFor3Gamma(event, categorizerStats, true))
+      {
+        newEvent.addEventType(JPetEventType::k3Gamma);
+      }
+      if (EventCategorizerTools::checkForPrompt(event, hitQuantities, categorizerStats, true, kDeexTOTCutMin, kDeexTOTCutMax))
+      {
+        newEvent.addEventType(JPetEventType::kPrompt);
+      }
+      if (EventCategorizerTools::checkForScatter(event, hitQuantities, categorizerStats, true, kScatterTOFTimeDiff))
+      {
+        newEvent.addEventType(JPetEventType::kScattered);
+      }
+      digest.add(newEvent);
+    }
+  }
+  digest.addHistograms(categorizerStats);
+  return digest;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(ChainDigestTestSuite)
+
+BOOST_AUTO_TEST_CASE(compareReportsFirstDifferenceTest)
+{
+  JPetScin scin(1);
+  JPetHit hit1, hit2;
+  hit1.setScintillator(scin);
+  hit2.setScintillator(scin);
+  hit1.setTime(1000.0);
+  hit1.setPosZ(2.5);
+  hit2.setTime(3000.0);
+  hit2.setPosZ(-1.5);
+
+  ChainDigest expected;
+  expected.beginStage("HitFinder");
+  expected.add(hit1);
+  expected.add(hit2);
+
+  ChainDigest same;
+  same.beginStage("HitFinder");
+  same.add(hit1);
+  same.add(hit2);
+  BOOST_REQUIRE(ChainDigest::compare(expected, same).empty());
+
+  hit2.setPosZ(-1.25);
+  ChainDigest changed;
+  changed.beginStage("HitFinder");
+  changed.add(hit1);
+  changed.add(hit2);
+  BOOST_REQUIRE_EQUAL(ChainDigest::compare(expected, changed), "stage HitFinder, JPetHit #1, field posZ: expected -1.5, found -1.25");
+
+  ChainDigest missing;
+  missing.beginStage("HitFinder");
+  missing.add(hit1);
+  BOOST_REQUIRE_EQUAL(ChainDigest::compare(expected, missing), "missing stage HitFinder, JPetHit #1 and 0 following records");
+
+  JPetEvent event;
+  ChainDigest otherType;
+  otherType.beginStage("HitFinder");
+  otherType.add(hit1);
+  otherType.add(event);
+  BOOST_REQUIRE_EQUAL(ChainDigest::compare(expected, otherType), "expected stage HitFinder, JPetHit #1, found stage HitFinder, JPetEvent #1");
+}
+
+BOOST_AUTO_TEST_CASE(histogramDigestTest)
+{
+  JPetStatistics stats;
+  stats.createHistogram(new TH1D("b_histogram", "b_histogram", 10, 0.0, 10.0));
+  stats.createHistogram(new TH1D("a_histogram", "a_histogram", 10, 0.0, 10.0));
+  stats.fillHistogram("a_histogram", 2.5);
+  stats.fillHistogram("b_histogram", 7.5, 2.0);
+
+  ChainDigest digest;
+  digest.beginStage("Histograms");
+  digest.addHistograms(stats);
+  BOOST_REQUIRE_EQUAL(digest.getRecords().size(), 2u);
+  BOOST_REQUIRE_EQUAL(digest.getRecords()[0].fields[0].second, "a_histogram");
+  BOOST_REQUIRE_EQUAL(digest.getRecords()[1].fields[0].second, "b_histogram");
+  BOOST_REQUIRE_EQUAL(digest.getRecords()[1].fields.back().first, "bin8");
+  BOOST_REQUIRE_EQUAL(digest.getRecords()[1].fields.back().second, "2");
+}
+
+BOOST_AUTO_TEST_CASE(writeReadTest)
+{
+  JPetPM pm(1, "pm1");
+  JPetSigCh sigCh(JPetSigCh::Leading, 1234.5);
+  sigCh.setPM(pm);
+  sigCh.setThresholdNumber(2);
+  sigCh.setRecoFlag(JPetSigCh::Corrupted);
+  ChainDigest digest;
+  digest.beginStage("TimeWindowCreator");
+  digest.add(sigCh);
+  digest.add(sigCh);
+
+  std::stringstream text;
+  digest.write(text);
+  ChainDigest readDigest;
+  BOOST_REQUIRE(readDigest.read(text));
+  BOOST_REQUIRE_EQUAL(readDigest.getRecords().size(), 2u);
+  BOOST_REQUIRE(ChainDigest::compare(digest, readDigest).empty());
+  BOOST_REQUIRE_EQUAL(digest.getStageHash("TimeWindowCreator"), readDigest.getStageHash("TimeWindowCreator"));
+}
+
+BOOST_AUTO_TEST_CASE(chainIsDeterministicTest)
+{
+  SyntheticSetup setup;
+  auto digest1 = runChain(setup);
+  auto digest2 = runChain(setup);
+  BOOST_REQUIRE_EQUAL(digest1.getStages().size(), 6u);
+  BOOST_REQUIRE_MESSAGE(ChainDigest::compare(digest1, digest2).empty(), ChainDigest::compare(digest1, digest2));
+  for (const auto& stage : digest1.getStages())
+  {
+    BOOST_REQUIRE_EQUAL(digest1.getStageHash(stage), digest2.getStageHash(stage));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(goldenDigestTest)
+{
+  SyntheticSetup setup;
+  auto digest = runChain(setup);
+  const std::string goldenFile = CHAIN_DIGEST_GOLDEN_FILE;
+  // Golden digest is rewritten only on explicit request, after an intended change of the output
+  if (std::getenv(kUpdateGoldenEnvironmentVariable))
+  {
+    BOOST_REQUIRE_MESSAGE(digest.writeFile(goldenFile), "Could not write golden digest of the chain to " + goldenFile);
+    BOOST_TEST_MESSAGE("Golden digest of the chain recorded in " + goldenFile);
+    return;
+  }
+  ChainDigest golden;
+  BOOST_REQUIRE_MESSAGE(golden.readFile(goldenFile), "Missing golden digest of the chain " + goldenFile + ", record it with "
+                                                         + kUpdateGoldenEnvironmentVariable + "=1 and commit it");
+  BOOST_REQUIRE_MESSAGE(!golden.getRecords().empty(), "Golden digest of the chain " + goldenFile + " is empty");
+  const auto difference = ChainDigest::compare(golden, digest);
+  BOOST_REQUIRE_MESSAGE(difference.empty(), "Output of the chain differs from " + goldenFile + ": " + difference);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ControlHistogramSamplerTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ControlHistogramSamplerTest
+
+#include "../ControlHistogramSampler.h"
+#include <TH1F.h>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(ControlHistogramSamplerTestSuite)
+
+BOOST_AUTO_TEST_CASE(defaultSamplingTest)
+{
+  ControlHistogramSampler sampler;
+  jpet_options_tools::OptsStrAny opts;
+  sampler.loadOptions(opts);
+  BOOST_REQUIRE(!sampler.isEnabled());
+  for (int i = 0; i < 10; i++)
+  {
+    BOOST_REQUIRE(sampler.nextWindow());
+  }
+  BOOST_REQUIRE_EQUAL(sampler.getScaleFactor(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(everyNthWindowTest)
+{
+  ControlHistogramSampler sampler;
+  jpet_options_tools::OptsStrAny opts;
+  opts[sampler.kPeriodParamKey] = 3;
+  sampler.loadOptions(opts);
+  BOOST_REQUIRE(sampler.isEnabled());
+  BOOST_REQUIRE_EQUAL(sampler.getPeriod(), 3);
+  std::vector<bool> expected = {true, false, false, true, false, false, true};
+  for (auto sampled : expected)
+  {
+    BOOST_REQUIRE_EQUAL(sampler.nextWindow(), sampled);
+  }
+  BOOST_REQUIRE_EQUAL(sampler.getNumberOfWindows(), 7);
+  BOOST_REQUIRE_EQUAL(sampler.getNumberOfSampledWindows(), 3);
+  BOOST_REQUIRE_CLOSE(sampler.getScaleFactor(), 7.0 / 3.0, 0.0001);
+}
+
+BOOST_AUTO_TEST_CASE(nonPositivePeriodTest)
+{
+  ControlHistogramSampler sampler;
+  jpet_options_tools::OptsStrAny opts;
+  opts[sampler.kPeriodParamKey] = -5;
+  sampler.loadOptions(opts);
+  BOOST_REQUIRE(!sampler.isEnabled());
+  BOOST_REQUIRE(sampler.nextWindow());
+  BOOST_REQUIRE(sampler.nextWindow());
+}
+
+BOOST_AUTO_TEST_CASE(scaleHistogramsTest)
+{
+  ControlHistogramSampler sampler;
+  jpet_options_tools::OptsStrAny opts;
+  opts[sampler.kPeriodParamKey] = 4;
+  sampler.loadOptions(opts);
+  JPetStatistics stats;
+  stats.createHistogram(new TH1F("sampled", "sampled", 10, -0.5, 9.5));
+  for (int i = 0; i < 8; i++)
+  {
+    if (sampler.nextWindow())
+    {
+      stats.getHisto1D("sampled")->Fill(i);
+    }
+  }
+  sampler.scaleHistograms(stats);
+  auto histogram = stats.getHisto1D("sampled");
+  BOOST_REQUIRE_CLOSE(histogram->GetBinContent(histogram->FindBin(0)), 4.0, 0.0001);
+  BOOST_REQUIRE_CLOSE(histogram->GetBinContent(histogram->FindBin(4)), 4.0, 0.0001);
+  BOOST_REQUIRE_CLOSE(histogram->Integral(), 8.0, 0.0001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,6 +18,8 @@
 #include "../EventCategorizerTools.h"
 #include "JPetSigCh/JPetSigCh.h"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
 
 /// Accuracy for BOOST_REQUIRE_CLOSE comparisons
 const double kEpsilon = 0.01;
@@ -50,6 +52,109 @@ BOOST_AUTO_TEST_CASE(checkFor2GammaTest) {
       !EventCategorizerTools::checkFor2Gamma(event, stats, false, 5.0, 10.0));
 }
 
+BOOST_AUTO_TEST_CASE(checkFor2GammaHighMultiplicityTest) {
+  // Only slots with thetas 359.0 and 177.5 are back-to-back within 2 degrees,
+  // window of the search wraps around 360 degrees
+  std::vector<double> thetas = {10.0, 40.0, 359.0, 75.0, 100.0, 130.0, 177.5, 250.0};
+  std::vector<JPetBarrelSlot> slots;
+  for (unsigned int i = 0; i < thetas.size(); i++) {
+    slots.push_back(JPetBarrelSlot(i + 1, true, "slot", thetas.at(i), i + 1));
+  }
+  JPetEvent event;
+  for (unsigned int i = 0; i < thetas.size(); i++) {
+    JPetHit hit;
+    hit.setBarrelSlot(slots.at(i));
+    hit.setTime(100.0 * i);
+    event.addHit(hit);
+  }
+  BOOST_REQUIRE(event.getHits().size() >= EventCategorizerTools::kMinHitsForSlotSearch);
+
+  JPetStatistics stats;
+  BOOST_REQUIRE(EventCategorizerTools::checkFor2Gamma(event, stats, false, 2.0, 1000.0));
+  BOOST_REQUIRE(!EventCategorizerTools::checkFor2Gamma(event, stats, false, 1.0, 1000.0));
+  BOOST_REQUIRE(!EventCategorizerTools::checkFor2Gamma(event, stats, false, 2.0, 300.0));
+  BOOST_REQUIRE(EventCategorizerTools::findBackToBackPair(event.getHits(), 2.0, 1000.0));
+  BOOST_REQUIRE(EventCategorizerTools::isBackToBackPair(
+    event.getHits().at(2), event.getHits().at(6), 2.0, 1000.0));
+}
+
+BOOST_AUTO_TEST_CASE(isBackToBackPairThetaOutOfRangeTest) {
+  // Thetas 365.0 and -175.0 are the same as 5.0 and 185.0
+  JPetBarrelSlot firstSlot(1, true, "first", 365.0, 1);
+  JPetBarrelSlot secondSlot(2, true, "second", -175.0, 2);
+  JPetHit firstHit;
+  JPetHit secondHit;
+  firstHit.setBarrelSlot(firstSlot);
+  secondHit.setBarrelSlot(secondSlot);
+  firstHit.setTime(500.0);
+  secondHit.setTime(700.0);
+
+  BOOST_REQUIRE_CLOSE(EventCategorizerTools::calculateSlotThetaDiff(firstHit, secondHit), 180.0, kEpsilon);
+  BOOST_REQUIRE(EventCategorizerTools::isBackToBackPair(firstHit, secondHit, 1.0, 1000.0));
+  BOOST_REQUIRE(EventCategorizerTools::findBackToBackPair({firstHit, secondHit}, 1.0, 1000.0));
+}
+
+BOOST_AUTO_TEST_CASE(findBackToBackPairRandomTest) {
+  // Search by slot theta has to find a pair exactly when the loop over all pairs of hits does
+  auto pairwiseSearch = [](const std::vector<JPetHit>& hits, double b2bSlotThetaDiff, double b2bTimeDiff) {
+    for (unsigned int i = 0; i < hits.size(); i++) {
+      for (unsigned int j = i + 1; j < hits.size(); j++) {
+        double theta1 = std::fmod(hits.at(i).getBarrelSlot().getTheta(), 360.0);
+        double theta2 = std::fmod(hits.at(j).getBarrelSlot().getTheta(), 360.0);
+        theta1 = theta1 < 0.0 ? theta1 + 360.0 : theta1;
+        theta2 = theta2 < 0.0 ? theta2 + 360.0 : theta2;
+        double thetaDiff = std::fabs(theta1 - theta2);
+        thetaDiff = std::min(thetaDiff, 360.0 - thetaDiff);
+        double timeDiff = std::fabs(hits.at(i).getTime() - hits.at(j).getTime());
+        if (std::fabs(thetaDiff - 180.0) < b2bSlotThetaDiff && timeDiff < b2bTimeDiff) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  std::mt19937 generator(20211019);
+  // Thetas on the grid of slots of a layer, so that some pairs are exactly on the edge of the window
+  std::uniform_int_distribution<int> slotDistribution(0, 47);
+  std::uniform_int_distribution<int> turnDistribution(-1, 1);
+  std::uniform_int_distribution<int> multiplicityDistribution(2, 20);
+  std::uniform_real_distribution<double> timeDistribution(0.0, 3000.0);
+  std::vector<double> slotThetaDiffs = {0.5, 2.0, 7.5, 30.0, 180.0};
+  std::vector<double> timeDiffs = {200.0, 1000.0, 5000.0};
+
+  int foundPairs = 0;
+  for (int iteration = 0; iteration < 2000; iteration++) {
+    int multiplicity = multiplicityDistribution(generator);
+    std::vector<JPetBarrelSlot> slots;
+    for (int i = 0; i < multiplicity; i++) {
+      double theta = 7.5 * slotDistribution(generator) + 360.0 * turnDistribution(generator);
+      slots.push_back(JPetBarrelSlot(i + 1, true, "slot", theta, i + 1));
+    }
+    JPetEvent event;
+    for (int i = 0; i < multiplicity; i++) {
+      JPetHit hit;
+      hit.setBarrelSlot(slots.at(i));
+      hit.setTime(timeDistribution(generator));
+      event.addHit(hit);
+    }
+    JPetStatistics stats;
+    for (auto slotThetaDiff : slotThetaDiffs) {
+      for (auto timeDiff : timeDiffs) {
+        bool expected = pairwiseSearch(event.getHits(), slotThetaDiff, timeDiff);
+        BOOST_REQUIRE_EQUAL(
+          EventCategorizerTools::findBackToBackPair(event.getHits(), slotThetaDiff, timeDiff), expected);
+        BOOST_REQUIRE_EQUAL(
+          EventCategorizerTools::checkFor2Gamma(event, stats, false, slotThetaDiff, timeDiff), expected);
+        foundPairs += expected;
+      }
+    }
+  }
+  // Both outcomes are covered
+  BOOST_REQUIRE_GT(foundPairs, 0);
+  BOOST_REQUIRE_LT(foundPairs, 2000 * 15);
+}
+
 BOOST_AUTO_TEST_CASE(checkFor3GammaTest) {
   JPetBarrelSlot firstSlot(1, true, "first", 10.0, 1);
   JPetBarrelSlot secondSlot(2, true, "second", 190.0, 2);
@@ -0,0 +1,175 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file FlatEventTreeTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE FlatEventTreeTest
+
+#include "../FlatEventTree.h"
+#include <JPetEventType/JPetEventType.h>
+#include <TDirectory.h>
+#include <TH1F.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+const std::string kTestFileName = "flatEventTreeTest.flat.root";
+
+HitFinderTools::HitQuantities makeQuantities(double time, double posX, double posY, double posZ, double tot, double energy)
+{
+  HitFinderTools::HitQuantities quantities;
+  quantities.time = time;
+  quantities.posX = posX;
+  quantities.posY = posY;
+  quantities.posZ = posZ;
+  quantities.tot = tot;
+  quantities.energy = energy;
+  return quantities;
+}
+
+void writeTestEvents()
+{
+  JPetScin scin1(12);
+  JPetScin scin2(34);
+  JPetHit hit1;
+  JPetHit hit2;
+  hit1.setScintillator(scin1);
+  hit2.setScintillator(scin2);
+
+  JPetEvent event1;
+  event1.setEventType(JPetEventType::k2Gamma);
+  event1.addHit(hit1);
+  event1.addHit(hit2);
+  JPetEvent event2;
+  event2.setEventType(JPetEventType::kPrompt);
+  event2.addEventType(JPetEventType::kScattered);
+  event2.addHit(hit2);
+
+  FlatEventWriter writer;
+  BOOST_REQUIRE(writer.open(kTestFileName));
+  writer.fill(event1, {makeQuantities(100.0, 1.0, 2.0, 3.0, 20000.0, 250.0), makeQuantities(200.0, -1.0, -2.0, -3.0, 30000.0, 350.0)});
+  writer.fill(event2, {makeQuantities(300.0, 4.0, 5.0, 6.0, 40000.0, 450.0)});
+  BOOST_REQUIRE_EQUAL(writer.getNumberOfEvents(), 2);
+  writer.close();
+  BOOST_REQUIRE(!writer.isOpen());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(FlatEventTreeTestSuite)
+
+BOOST_AUTO_TEST_CASE(fileNameTest)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["inputFile_std::string"] = std::string("data/dabc_17025151847.presel.evt.root");
+  BOOST_REQUIRE(FlatEventWriter::getFileName(opts, "EventCategorizer").empty());
+  opts[FlatEventWriter::kDirectoryParamKey] = std::string("flat");
+  BOOST_REQUIRE_EQUAL(FlatEventWriter::getFileName(opts, "EventCategorizer"), "flat/dabc_17025151847.presel.evt.EventCategorizer.flat.root");
+}
+
+BOOST_AUTO_TEST_CASE(writeAndReadTest)
+{
+  writeTestEvents();
+  FlatEventReader reader;
+  BOOST_REQUIRE(reader.open(kTestFileName));
+  BOOST_REQUIRE_EQUAL(reader.getNumberOfEvents(), 2);
+
+  auto event = reader.getEvent(0);
+  BOOST_REQUIRE(event);
+  BOOST_REQUIRE_EQUAL(event->eventType, static_cast<unsigned int>(JPetEventType::k2Gamma));
+  BOOST_REQUIRE_EQUAL(event->getNumberOfHits(), 2u);
+  BOOST_REQUIRE_EQUAL(event->time[1], 200.0);
+  BOOST_REQUIRE_EQUAL(event->posX[1], -1.0);
+  BOOST_REQUIRE_EQUAL(event->posY[0], 2.0);
+  BOOST_REQUIRE_EQUAL(event->posZ[0], 3.0);
+  BOOST_REQUIRE_EQUAL(event->tot[1], 30000.0);
+  BOOST_REQUIRE_EQUAL(event->energy[0], 250.0);
+  BOOST_REQUIRE_EQUAL(event->scinID[0], 12);
+  BOOST_REQUIRE_EQUAL(event->scinID[1], 34);
+
+  event = reader.getEvent(1);
+  BOOST_REQUIRE(event);
+  BOOST_REQUIRE_EQUAL(event->eventType, static_cast<unsigned int>(JPetEventType::kPrompt | JPetEventType::kScattered));
+  BOOST_REQUIRE_EQUAL(event->getNumberOfHits(), 1u);
+  BOOST_REQUIRE_EQUAL(event->tot[0], 40000.0);
+  BOOST_REQUIRE_EQUAL(event->scinID[0], 34);
+
+  BOOST_REQUIRE(!reader.getEvent(2));
+  reader.close();
+  std::remove(kTestFileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(readSelectedColumnsTest)
+{
+  writeTestEvents();
+  FlatEventReader reader;
+  BOOST_REQUIRE(reader.open(kTestFileName, {"tot", "scinID"}));
+  auto event = reader.getEvent(0);
+  BOOST_REQUIRE(event);
+  BOOST_REQUIRE_EQUAL(event->tot.size(), 2u);
+  BOOST_REQUIRE_EQUAL(event->tot[0], 20000.0);
+  BOOST_REQUIRE_EQUAL(event->scinID[1], 34);
+  BOOST_REQUIRE(event->time.empty());
+  BOOST_REQUIRE_EQUAL(event->eventType, 0u);
+  reader.close();
+  std::remove(kTestFileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(openFromOptionsTest)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["inputFile_std::string"] = std::string("data/flatEventTreeTest.cat.evt.root");
+  FlatEventWriter writer;
+  BOOST_REQUIRE(writer.openFromOptions(opts, "EventCategorizer"));
+  BOOST_REQUIRE(!writer.isOpen());
+  opts[FlatEventWriter::kDirectoryParamKey] = std::string("notExistingFlatEventsDirectory");
+  BOOST_REQUIRE(!writer.openFromOptions(opts, "EventCategorizer"));
+  BOOST_REQUIRE(!writer.isOpen());
+  opts[FlatEventWriter::kDirectoryParamKey] = std::string(".");
+  BOOST_REQUIRE(writer.openFromOptions(opts, "EventCategorizer"));
+  BOOST_REQUIRE(writer.isOpen());
+  writer.close();
+  std::remove("flatEventTreeTest.cat.evt.EventCategorizer.flat.root");
+}
+
+BOOST_AUTO_TEST_CASE(currentDirectoryTest)
+{
+  // Directory of the task output, other than the global one, which is current after closing any file
+  TDirectory taskDirectory("taskDirectory", "taskDirectory");
+  TDirectory::TContext taskContext(&taskDirectory);
+  auto directory = gDirectory;
+  FlatEventWriter writer;
+  BOOST_REQUIRE(writer.open(kTestFileName));
+  BOOST_REQUIRE_EQUAL(gDirectory, directory);
+  // Histogram created by the task after opening the writer must survive closing of the flat file
+  std::unique_ptr<TH1F> histogram(new TH1F("histogramAfterOpen", "histogramAfterOpen", 10, 0.0, 10.0));
+  BOOST_REQUIRE_EQUAL(histogram->GetDirectory(), directory);
+  writer.close();
+  BOOST_REQUIRE_EQUAL(gDirectory, directory);
+  histogram->Fill(5.0);
+  BOOST_REQUIRE_EQUAL(histogram->GetEntries(), 1.0);
+  BOOST_REQUIRE_EQUAL(histogram->GetDirectory(), directory);
+  std::remove(kTestFileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(missingFileTest)
+{
+  FlatEventReader reader;
+  BOOST_REQUIRE(!reader.open("notExistingFlatEvents.root"));
+  BOOST_REQUIRE(!reader.isOpen());
+  BOOST_REQUIRE(!reader.getEvent(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
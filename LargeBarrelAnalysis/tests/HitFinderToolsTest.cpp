@@ -637,4 +637,46 @@ BOOST_AUTO_TEST_CASE(checkForPromptTest_checkTOTCalc) {
                       kEpsilon);
 }
 
+BOOST_AUTO_TEST_CASE(calculateHitQuantities_test)
+{
+  JPetSigCh leading(JPetSigCh::Leading, 10.0);
+  JPetSigCh trailing(JPetSigCh::Trailing, 23.0);
+  leading.setThresholdNumber(1);
+  trailing.setThresholdNumber(1);
+  leading.setThreshold(80);
+  trailing.setThreshold(80);
+  JPetRawSignal rawSignal;
+  rawSignal.addPoint(leading);
+  rawSignal.addPoint(trailing);
+  JPetRecoSignal recoSignal;
+  recoSignal.setRawSignal(rawSignal);
+  JPetPhysSignal physSignal;
+  physSignal.setRecoSignal(recoSignal);
+
+  JPetHit hit1;
+  hit1.setSignals(physSignal, physSignal);
+  hit1.setTime(150.0);
+  hit1.setEnergy(400.0);
+  hit1.setPos(3.0, 4.0, -12.0);
+  JPetHit hit2;
+  hit2.setTime(100.0);
+  hit2.setPos(0.0, 0.0, 1.0);
+
+  std::vector<JPetHit> hits = {hit1, hit2};
+  auto quantities = HitFinderTools::calculateHitQuantities(hits, HitFinderTools::kSimplified);
+  BOOST_REQUIRE_EQUAL(quantities.size(), hits.size());
+  BOOST_REQUIRE_CLOSE(quantities.at(0).tot, HitFinderTools::calculateTOT(hit1, HitFinderTools::kSimplified), kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).tot, 26.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).time, 150.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).energy, 400.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).posX, 3.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).posY, 4.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).posZ, -12.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(0).distance, 13.0, kEpsilon);
+  BOOST_REQUIRE_SMALL(quantities.at(1).tot, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(1).time, 100.0, kEpsilon);
+  BOOST_REQUIRE_CLOSE(quantities.at(1).distance, 1.0, kEpsilon);
+  BOOST_REQUIRE(HitFinderTools::calculateHitQuantities(std::vector<JPetHit>(), HitFinderTools::kSimplified).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
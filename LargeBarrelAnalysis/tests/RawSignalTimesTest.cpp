@@ -0,0 +1,170 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file RawSignalTimesTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE RawSignalTimesTest
+
+#include "../RawSignalTimes.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+/// Number of allocations made with global operator new in this test
+unsigned long gAllocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+  gAllocations++;
+  if (void* memory = std::malloc(size ? size : 1))
+  {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+JPetSigCh makeSigCh(JPetSigCh::EdgeType type, int thr, double time, int daqChannel)
+{
+  JPetSigCh sigCh;
+  sigCh.setType(type);
+  sigCh.setThresholdNumber(thr);
+  sigCh.setValue(time);
+  sigCh.setDAQch(daqChannel);
+  return sigCh;
+}
+
+BOOST_AUTO_TEST_SUITE(RawSignalTimesTestSuite)
+
+BOOST_AUTO_TEST_CASE(emptySignalTest)
+{
+  JPetRawSignal rawSignal;
+  RawSignalTimes times(rawSignal);
+  BOOST_REQUIRE_EQUAL(times.getLeadingMask(), 0u);
+  BOOST_REQUIRE_EQUAL(times.getTrailingMask(), 0u);
+  BOOST_REQUIRE_EQUAL(times.getNumberOfLeading(), 0);
+  for (int thr = 0; thr <= RawSignalTimes::kMaxThresholds + 1; thr++)
+  {
+    BOOST_REQUIRE(!times.hasLeading(thr));
+    BOOST_REQUIRE(!times.hasTrailing(thr));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(allThresholdsTest)
+{
+  JPetRawSignal rawSignal;
+  for (int thr = 1; thr <= 4; thr++)
+  {
+    rawSignal.addPoint(makeSigCh(JPetSigCh::Leading, thr, 100.0 * thr, 10 + thr));
+    rawSignal.addPoint(makeSigCh(JPetSigCh::Trailing, thr, 2000.0 - 100.0 * thr, 20 + thr));
+  }
+  RawSignalTimes times(rawSignal);
+  BOOST_REQUIRE_EQUAL(times.getLeadingMask(), 0xFu);
+  BOOST_REQUIRE_EQUAL(times.getNumberOfLeading(), 4);
+  BOOST_REQUIRE_EQUAL(times.getNumberOfTrailing(), 4);
+
+  auto leadingMap = rawSignal.getTimesVsThresholdNumber(JPetSigCh::Leading);
+  auto trailingMap = rawSignal.getTimesVsThresholdNumber(JPetSigCh::Trailing);
+  for (int thr = 1; thr <= 4; thr++)
+  {
+    BOOST_REQUIRE(times.hasBothEdges(thr));
+    BOOST_REQUIRE_CLOSE(times.getLeading(thr), leadingMap.at(thr), 1.e-9);
+    BOOST_REQUIRE_CLOSE(times.getTrailing(thr), trailingMap.at(thr), 1.e-9);
+    BOOST_REQUIRE_CLOSE(times.getTOT(thr), 2000.0 - 200.0 * thr, 1.e-9);
+    BOOST_REQUIRE_EQUAL(times.getLeadingDAQch(thr), 10 + thr);
+    BOOST_REQUIRE_EQUAL(times.getTrailingDAQch(thr), 20 + thr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(missingAndInvalidThresholdsTest)
+{
+  JPetRawSignal rawSignal;
+  rawSignal.addPoint(makeSigCh(JPetSigCh::Leading, 1, 100.0, 1));
+  rawSignal.addPoint(makeSigCh(JPetSigCh::Leading, 3, 300.0, 3));
+  rawSignal.addPoint(makeSigCh(JPetSigCh::Leading, 5, 500.0, 5));
+  rawSignal.addPoint(makeSigCh(JPetSigCh::Trailing, 3, 900.0, 7));
+  RawSignalTimes times(rawSignal);
+  BOOST_REQUIRE_EQUAL(times.getLeadingMask(), 0x5u);
+  BOOST_REQUIRE_EQUAL(times.getTrailingMask(), 0x4u);
+  BOOST_REQUIRE(times.hasLeading(1));
+  BOOST_REQUIRE(!times.hasLeading(2));
+  BOOST_REQUIRE(!times.hasLeading(5));
+  BOOST_REQUIRE(!times.hasBothEdges(1));
+  BOOST_REQUIRE(times.hasBothEdges(3));
+  BOOST_REQUIRE_CLOSE(times.getTOT(3), 600.0, 1.e-9);
+}
+
+BOOST_AUTO_TEST_CASE(refillTest)
+{
+  JPetRawSignal first;
+  first.addPoint(makeSigCh(JPetSigCh::Leading, 2, 100.0, 1));
+  first.addPoint(makeSigCh(JPetSigCh::Trailing, 2, 400.0, 2));
+  JPetRawSignal second;
+  second.addPoint(makeSigCh(JPetSigCh::Leading, 4, 700.0, 3));
+
+  RawSignalTimes times(first);
+  BOOST_REQUIRE(times.hasBothEdges(2));
+  times.fill(second);
+  BOOST_REQUIRE(!times.hasLeading(2));
+  BOOST_REQUIRE(!times.hasTrailing(2));
+  BOOST_REQUIRE(times.hasLeading(4));
+  BOOST_REQUIRE_CLOSE(times.getLeading(4), 700.0, 1.e-9);
+  BOOST_REQUIRE_EQUAL(times.getLeadingDAQch(4), 3);
+}
+
+BOOST_AUTO_TEST_CASE(allocationsTest)
+{
+  JPetRawSignal rawSignal;
+  for (int thr = 1; thr <= 4; thr++)
+  {
+    rawSignal.addPoint(makeSigCh(JPetSigCh::Leading, thr, 100.0 * thr, 10 + thr));
+    rawSignal.addPoint(makeSigCh(JPetSigCh::Trailing, thr, 2000.0 - 100.0 * thr, 20 + thr));
+  }
+  RawSignalTimes times;
+
+  // Copies of the points made by the framework cannot be avoided
+  unsigned long start = gAllocations;
+  {
+    auto leading = rawSignal.getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
+    auto trailing = rawSignal.getPoints(JPetSigCh::Trailing, JPetRawSignal::ByThrNum);
+  }
+  const unsigned long pointsAllocations = gAllocations - start;
+
+  start = gAllocations;
+  for (int i = 0; i < 10; i++)
+  {
+    times.fill(rawSignal);
+  }
+  const unsigned long fillAllocations = gAllocations - start;
+
+  start = gAllocations;
+  for (int i = 0; i < 10; i++)
+  {
+    auto leadingMap = rawSignal.getTimesVsThresholdNumber(JPetSigCh::Leading);
+    auto trailingMap = rawSignal.getTimesVsThresholdNumber(JPetSigCh::Trailing);
+  }
+  const unsigned long mapAllocations = gAllocations - start;
+
+  // Nothing is allocated apart from the copies of the points
+  BOOST_REQUIRE_EQUAL(fillAllocations, 10 * pointsAllocations);
+  BOOST_REQUIRE_LT(fillAllocations, mapAllocations);
+  BOOST_REQUIRE(times.hasBothEdges(4));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file ReadAheadToolsTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ReadAheadToolsTest
+
+#include "../ReadAheadTools.h"
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+BOOST_AUTO_TEST_SUITE(ReadAheadToolsTestSuite)
+
+BOOST_AUTO_TEST_CASE(defaultSettingsTest)
+{
+  const char* argv[] = {"LargeBarrelAnalysis.x", "-t", "hld", "-f", "dabc.hld"};
+  auto settings = ReadAheadTools::readSettings(5, argv);
+  BOOST_REQUIRE(!settings.enabled);
+  BOOST_REQUIRE_EQUAL(settings.numberOfThreads, 2u);
+  BOOST_REQUIRE_CLOSE(settings.cacheSizeFactor, 2.f, 0.001f);
+  BOOST_REQUIRE_CLOSE(settings.unzipBufferFactor, 1.f, 0.001f);
+
+  settings = ReadAheadTools::readSettings("not_existing_user_params.json");
+  BOOST_REQUIRE(!settings.enabled);
+}
+
+BOOST_AUTO_TEST_CASE(userParamsSettingsTest)
+{
+  {
+    std::ofstream userParams("readAheadUserParams.json");
+    userParams << "{\n"
+               << "  \"ReadAhead_Enable_bool\": true,\n"
+               << "  \"ReadAhead_NumberOfThreads_int\": 3,\n"
+               << "  \"ReadAhead_CacheSizeFactor_float\": 4.5,\n"
+               << "  \"HitFinder_ABTimeDiff_float\": 6000.0\n"
+               << "}\n";
+  }
+  const char* argv[] = {"LargeBarrelAnalysis.x", "-t", "hld", "-u", "readAheadUserParams.json"};
+  auto settings = ReadAheadTools::readSettings(5, argv);
+  BOOST_REQUIRE(settings.enabled);
+  BOOST_REQUIRE_EQUAL(settings.numberOfThreads, 3u);
+  BOOST_REQUIRE_CLOSE(settings.cacheSizeFactor, 4.5f, 0.001f);
+  BOOST_REQUIRE_CLOSE(settings.unzipBufferFactor, 1.f, 0.001f);
+
+  {
+    std::ofstream userParams("readAheadUserParams.json");
+    userParams << "{ \"ReadAhead_Enable_bool\": false }\n";
+  }
+  BOOST_REQUIRE(!ReadAheadTools::readSettings("readAheadUserParams.json").enabled);
+
+  {
+    std::ofstream userParams("readAheadUserParams.json");
+    userParams << "{ \"ReadAhead_Enable_bool\": true, \"ReadAhead_UnzipBufferFactor_float\": 0 }\n";
+  }
+  BOOST_REQUIRE(!ReadAheadTools::readSettings("readAheadUserParams.json").enabled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
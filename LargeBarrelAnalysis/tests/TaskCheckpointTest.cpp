@@ -0,0 +1,165 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file TaskCheckpointTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TaskCheckpointTest
+
+#include "../TaskCheckpoint.h"
+#include <JPetEvent/JPetEvent.h>
+#include <JPetHit/JPetHit.h>
+#include <TH1F.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+
+namespace
+{
+const std::string kTaskName = "TaskCheckpointTest";
+
+jpet_options_tools::OptsStrAny getOptions(bool resume)
+{
+  jpet_options_tools::OptsStrAny opts;
+  opts["inputFile_std::string"] = std::string("taskCheckpointTest.hld");
+  opts[TaskCheckpoint::kIntervalParamKey] = 2;
+  opts[TaskCheckpoint::kResumeParamKey] = resume;
+  return opts;
+}
+
+void createHistograms(JPetStatistics& stats) { stats.createHistogram(new TH1F("window_size", "window_size", 10, 0.5, 10.5)); }
+
+/// Output of the window with given index has index + 1 events, with hit times identifying the window
+void fillWindow(JPetTimeWindow& output, int index)
+{
+  for (int i = 0; i <= index; i++)
+  {
+    JPetHit hit;
+    hit.setTime(100.0 * index + i);
+    JPetEvent event;
+    event.addHit(hit);
+    output.add<JPetEvent>(event);
+  }
+}
+
+/// Runs the given number of windows and leaves the checkpoint as after an interruption
+void runInterrupted(int windows)
+{
+  JPetStatistics stats;
+  createHistograms(stats);
+  TaskCheckpoint checkpoint;
+  checkpoint.loadOptions(getOptions(false), kTaskName);
+  for (int index = 0; index < windows; index++)
+  {
+    BOOST_REQUIRE(!checkpoint.skipWindow<JPetEvent>(nullptr));
+    JPetTimeWindow output("JPetEvent");
+    fillWindow(output, index);
+    stats.fillHistogram("window_size", output.getNumberOfEvents());
+    checkpoint.windowCompleted(stats, &output, std::to_string(index));
+  }
+}
+
+void removeFiles()
+{
+  TaskCheckpoint checkpoint;
+  checkpoint.loadOptions(getOptions(false), kTaskName);
+  std::remove(checkpoint.getFileName().c_str());
+  std::remove(checkpoint.getOutputFileName().c_str());
+  std::remove((checkpoint.getOutputFileName() + ".resumed").c_str());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(TaskCheckpointTestSuite)
+
+BOOST_AUTO_TEST_CASE(saveLoadTest)
+{
+  removeFiles();
+  runInterrupted(3);
+
+  TaskCheckpoint checkpoint;
+  checkpoint.loadOptions(getOptions(false), kTaskName);
+  JPetStatistics stats;
+  createHistograms(stats);
+  std::string taskState;
+  long long completedWindows = 0;
+  BOOST_REQUIRE(TaskCheckpoint::load(checkpoint.getFileName(), stats, taskState, completedWindows));
+  // Checkpoint was written after the second window
+  BOOST_REQUIRE_EQUAL(completedWindows, 2);
+  BOOST_REQUIRE_EQUAL(taskState, "1");
+  auto histogram = stats.getHisto1D("window_size");
+  BOOST_REQUIRE_EQUAL(histogram->GetEntries(), 2.0);
+  BOOST_REQUIRE_EQUAL(histogram->GetBinContent(1), 1.0);
+  BOOST_REQUIRE_EQUAL(histogram->GetBinContent(2), 1.0);
+  BOOST_REQUIRE_EQUAL(histogram->GetBinContent(3), 0.0);
+
+  checkpoint.finish();
+  BOOST_REQUIRE(!TaskCheckpoint::load(checkpoint.getFileName(), stats, taskState, completedWindows));
+  removeFiles();
+}
+
+BOOST_AUTO_TEST_CASE(resumeTest)
+{
+  removeFiles();
+  runInterrupted(3);
+
+  JPetStatistics stats;
+  createHistograms(stats);
+  TaskCheckpoint checkpoint;
+  checkpoint.loadOptions(getOptions(true), kTaskName);
+  std::string taskState;
+  BOOST_REQUIRE(checkpoint.resume(stats, taskState));
+  BOOST_REQUIRE_EQUAL(taskState, "1");
+
+  // Windows completed before the checkpoint are skipped, with their output read back
+  for (int index = 0; index < 2; index++)
+  {
+    JPetTimeWindow output("JPetEvent");
+    BOOST_REQUIRE(checkpoint.skipWindow<JPetEvent>(&output));
+    BOOST_REQUIRE_EQUAL(output.getNumberOfEvents(), index + 1);
+    const auto& event = dynamic_cast<const JPetEvent&>(output[index]);
+    BOOST_REQUIRE_EQUAL(event.getHits().at(0).getTime(), 100.0 * index + index);
+    BOOST_REQUIRE_EQUAL(checkpoint.getCompletedWindows(), index + 1);
+  }
+  JPetTimeWindow output("JPetEvent");
+  BOOST_REQUIRE(!checkpoint.skipWindow<JPetEvent>(&output));
+  BOOST_REQUIRE_EQUAL(output.getNumberOfEvents(), 0);
+  BOOST_REQUIRE_EQUAL(checkpoint.getCompletedWindows(), 2);
+
+  fillWindow(output, 2);
+  checkpoint.windowCompleted(stats, &output);
+  BOOST_REQUIRE_EQUAL(checkpoint.getCompletedWindows(), 3);
+  checkpoint.finish();
+  removeFiles();
+}
+
+BOOST_AUTO_TEST_CASE(refuseResumeWithoutPartialOutputTest)
+{
+  removeFiles();
+  runInterrupted(3);
+
+  TaskCheckpoint checkpoint;
+  checkpoint.loadOptions(getOptions(true), kTaskName);
+  std::remove(checkpoint.getOutputFileName().c_str());
+  JPetStatistics stats;
+  createHistograms(stats);
+  std::string taskState;
+  BOOST_REQUIRE(!checkpoint.resume(stats, taskState));
+  BOOST_REQUIRE_EQUAL(stats.getHisto1D("window_size")->GetEntries(), 0.0);
+
+  JPetTimeWindow output("JPetEvent");
+  BOOST_REQUIRE(!checkpoint.skipWindow<JPetEvent>(&output));
+  BOOST_REQUIRE_EQUAL(checkpoint.getCompletedWindows(), 0);
+  checkpoint.finish();
+  removeFiles();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file TaskTelemetryTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TaskTelemetryTest
+
+#include "../TaskTelemetry.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE(TaskTelemetryTestSuite)
+
+BOOST_AUTO_TEST_CASE(latencyHistogramTest)
+{
+  LatencyHistogram histogram;
+  BOOST_REQUIRE_EQUAL(histogram.getCount(), 0u);
+  BOOST_REQUIRE_CLOSE(histogram.getPercentile(0.5), 0.0, 0.001);
+
+  histogram.fill(1.0);
+  histogram.fill(3.0);
+  histogram.fill(5.0);
+  histogram.fill(1000.0);
+  BOOST_REQUIRE_EQUAL(histogram.getCount(), 4u);
+  BOOST_REQUIRE_EQUAL(histogram.getBinContent(0), 1u);
+  BOOST_REQUIRE_EQUAL(histogram.getBinContent(1), 1u);
+  BOOST_REQUIRE_EQUAL(histogram.getBinContent(2), 1u);
+  BOOST_REQUIRE_EQUAL(histogram.getBinContent(9), 1u);
+  BOOST_REQUIRE_CLOSE(histogram.getPercentile(0.5), 4.0, 0.001);
+  BOOST_REQUIRE_CLOSE(histogram.getPercentile(0.99), 1024.0, 0.001);
+
+  histogram.fill(1.e20);
+  BOOST_REQUIRE_EQUAL(histogram.getBinContent(LatencyHistogram::kNumberOfBins - 1), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(recordTest)
+{
+  TaskTelemetry telemetry("SignalFinder");
+  telemetry.recordInit(10.0);
+  telemetry.recordExec(100.0, 50, 20);
+  telemetry.recordExec(300.0, 70, 30);
+  telemetry.recordTerminate(5.0);
+  telemetry.recordProcessPeakRSS(2048);
+  telemetry.recordProcessPeakRSS(1024);
+
+  BOOST_REQUIRE_EQUAL(telemetry.getNumberOfWindows(), 2u);
+  BOOST_REQUIRE_EQUAL(telemetry.getInputObjects(), 120u);
+  BOOST_REQUIRE_EQUAL(telemetry.getOutputObjects(), 50u);
+  BOOST_REQUIRE_CLOSE(telemetry.getExecTotalTime(), 400.0, 0.001);
+  BOOST_REQUIRE_CLOSE(telemetry.getExecMeanTime(), 200.0, 0.001);
+  BOOST_REQUIRE_CLOSE(telemetry.getExecMinTime(), 100.0, 0.001);
+  BOOST_REQUIRE_CLOSE(telemetry.getExecMaxTime(), 300.0, 0.001);
+  BOOST_REQUIRE_CLOSE(telemetry.getWindowsPerSecond(), 5000.0, 0.001);
+  BOOST_REQUIRE_EQUAL(telemetry.getProcessPeakRSS(), 2048);
+  BOOST_REQUIRE(TaskTelemetry::readProcessPeakRSS() > 0);
+  BOOST_REQUIRE(telemetry.toJSON().find("\"processPeakRSSkB\": 2048") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(writeTest)
+{
+  TaskTelemetry telemetry("Hit\"Finder");
+  telemetry.setInputFile("dabc.root");
+  telemetry.recordExec(3.0, 1, 1);
+
+  BOOST_REQUIRE(telemetry.toJSON().find("\"task\": \"Hit\\\"Finder\"") != std::string::npos);
+  BOOST_REQUIRE(telemetry.toJSON().find("\"execLatencyHistogramUs\": [[2, 1]]") != std::string::npos);
+  BOOST_REQUIRE(telemetry.toText().find("[Hit\"Finder] dabc.root") == 0);
+
+  const std::string fileName = "TaskTelemetryTest_metrics.jsonl";
+  std::remove(fileName.c_str());
+  BOOST_REQUIRE(telemetry.write(fileName));
+  BOOST_REQUIRE(telemetry.write(fileName));
+  std::ifstream file(fileName);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line))
+  {
+    BOOST_REQUIRE_EQUAL(line, telemetry.toJSON());
+    lines++;
+  }
+  BOOST_REQUIRE_EQUAL(lines, 2);
+  std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(writeFromProcessesTest)
+{
+  TaskTelemetry telemetry("EventCategorizer");
+  telemetry.setInputFile(std::string(2000, 'x') + ".root");
+  for (int i = 0; i < 100; i++)
+  {
+    telemetry.recordExec(1.0 * i, 1, 1);
+  }
+
+  const std::string fileName = "TaskTelemetryTest_processes.jsonl";
+  std::remove(fileName.c_str());
+  const int numberOfProcesses = 4;
+  const int recordsPerProcess = 200;
+  for (int process = 0; process < numberOfProcesses; process++)
+  {
+    const pid_t pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+      bool success = true;
+      for (int i = 0; i < recordsPerProcess; i++)
+      {
+        success = telemetry.write(fileName) && success;
+      }
+      _exit(success ? 0 : 1);
+    }
+  }
+  for (int process = 0; process < numberOfProcesses; process++)
+  {
+    int status = 0;
+    wait(&status);
+    BOOST_REQUIRE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  // Records written at the same time by all processes are complete lines
+  std::ifstream file(fileName);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line))
+  {
+    BOOST_REQUIRE(line == telemetry.toJSON());
+    lines++;
+  }
+  BOOST_REQUIRE_EQUAL(lines, numberOfProcesses * recordsPerProcess);
+  std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
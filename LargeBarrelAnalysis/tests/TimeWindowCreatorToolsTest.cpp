@@ -97,6 +97,108 @@ BOOST_AUTO_TEST_CASE(generateSigCh_test) {
   BOOST_REQUIRE_CLOSE(sigCh.getValue(), 1000.0 * (50.0 + 22.0), epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(daqChannelTable_test) {
+  JPetFEB feb(1, true, "just great", "very nice front-end board", 1, 1, 4, 4);
+  JPetTRB trb(2, 555, 333);
+  std::pair<float, float> hvGains(23.4, 43.2);
+  JPetPM pm(JPetPM::SideB, 23, 123, 321, hvGains, "average pm");
+
+  JPetTOMBChannel channel1(123);
+  channel1.setFEB(feb);
+  channel1.setTRB(trb);
+  channel1.setPM(pm);
+  channel1.setThreshold(34.5);
+  channel1.setLocalChannelNumber(2);
+  JPetTOMBChannel channel2(124);
+  channel2.setFEB(feb);
+  channel2.setTRB(trb);
+  channel2.setPM(pm);
+  channel2.setThreshold(56.7);
+  channel2.setLocalChannelNumber(3);
+  JPetTOMBChannel triggerChannel(130);
+  triggerChannel.setPM(pm);
+
+  std::map<int, JPetTOMBChannel*> tombChannels;
+  tombChannels[123] = &channel1;
+  tombChannels[124] = &channel2;
+  tombChannels[130] = &triggerChannel;
+  std::map<unsigned int, std::vector<double>> timeCalibrationMap;
+  timeCalibrationMap[123] = {22.0, 33.0};
+  std::map<unsigned int, std::vector<double>> thresholdsMap;
+  thresholdsMap[124] = {80.0};
+
+  DAQChannelTable table;
+  table.build(tombChannels, timeCalibrationMap, thresholdsMap, false);
+  BOOST_REQUIRE_EQUAL(table.size(), 131u);
+  BOOST_REQUIRE(table.isAccepted(123));
+  BOOST_REQUIRE(table.isAccepted(124));
+  BOOST_REQUIRE(!table.isAccepted(130));
+  BOOST_REQUIRE(table.find(130));
+  BOOST_REQUIRE(!table.isAccepted(125));
+  BOOST_REQUIRE(!table.find(125));
+  BOOST_REQUIRE(!table.isAccepted(1000));
+  BOOST_REQUIRE(!table.find(1000));
+
+  auto epsilon = 0.0001;
+  const auto& info1 = table.get(123);
+  BOOST_REQUIRE_EQUAL(info1.pmID, 23);
+  BOOST_REQUIRE_EQUAL(info1.side, JPetPM::SideB);
+  BOOST_REQUIRE_EQUAL(info1.thresholdNumber, 2);
+  BOOST_REQUIRE_CLOSE(info1.timeCalibration, 22.0, epsilon);
+  BOOST_REQUIRE_EQUAL(info1.thresholdValue, 0.0);
+  BOOST_REQUIRE_EQUAL(info1.occupationHistogram, "pm_occupation_thr2");
+  const auto& info2 = table.get(124);
+  BOOST_REQUIRE_EQUAL(info2.timeCalibration, 0.0);
+  BOOST_REQUIRE_CLOSE(info2.thresholdValue, 80.0, epsilon);
+
+  table.build(tombChannels, timeCalibrationMap, thresholdsMap, true);
+  BOOST_REQUIRE_CLOSE(table.get(123).thresholdValue, 34.5, epsilon);
+  BOOST_REQUIRE_CLOSE(table.get(124).thresholdValue, 56.7, epsilon);
+
+  table.restrictTo({124, 130});
+  BOOST_REQUIRE(!table.isAccepted(123));
+  BOOST_REQUIRE(table.find(123));
+  BOOST_REQUIRE(table.isAccepted(124));
+  BOOST_REQUIRE(!table.isAccepted(130));
+}
+
+BOOST_AUTO_TEST_CASE(generateSigChFromTable_test) {
+  JPetFEB feb(1, true, "just great", "very nice front-end board", 1, 1, 4, 4);
+  JPetTRB trb(2, 555, 333);
+  std::pair<float, float> hvGains(23.4, 43.2);
+  JPetPM pm(JPetPM::SideA, 23, 123, 321, hvGains, "average pm");
+
+  JPetTOMBChannel channel(123);
+  channel.setFEB(feb);
+  channel.setTRB(trb);
+  channel.setPM(pm);
+  channel.setThreshold(34.5);
+  channel.setLocalChannelNumber(1);
+
+  std::map<int, JPetTOMBChannel*> tombChannels;
+  tombChannels[123] = &channel;
+  std::map<unsigned int, std::vector<double>> thresholdsMap;
+  std::map<unsigned int, std::vector<double>> timeCalibrationMap;
+  timeCalibrationMap[123] = {22.0, 33.0, 44.0};
+  DAQChannelTable table;
+  table.build(tombChannels, timeCalibrationMap, thresholdsMap, true);
+
+  auto sigCh = TimeWindowCreatorTools::generateSigCh(50.0, table.get(123), JPetSigCh::Trailing);
+  auto sigChFromMaps = TimeWindowCreatorTools::generateSigCh(
+      50.0, channel, timeCalibrationMap, thresholdsMap, JPetSigCh::Trailing,
+      true);
+
+  auto epsilon = 0.0001;
+  BOOST_REQUIRE_EQUAL(sigCh.getType(), sigChFromMaps.getType());
+  BOOST_REQUIRE_EQUAL(sigCh.getPM().getID(), 23);
+  BOOST_REQUIRE_EQUAL(sigCh.getFEB().getID(), 1);
+  BOOST_REQUIRE_EQUAL(sigCh.getTRB().getID(), 2);
+  BOOST_REQUIRE_EQUAL(sigCh.getDAQch(), sigChFromMaps.getDAQch());
+  BOOST_REQUIRE_EQUAL(sigCh.getThresholdNumber(), sigChFromMaps.getThresholdNumber());
+  BOOST_REQUIRE_CLOSE(sigCh.getThreshold(), sigChFromMaps.getThreshold(), epsilon);
+  BOOST_REQUIRE_CLOSE(sigCh.getValue(), sigChFromMaps.getValue(), epsilon);
+}
+
 BOOST_AUTO_TEST_CASE(flagSigChs_test)
 {
   JPetSigCh sigCh00(JPetSigCh::Leading, 10.0);
@@ -1,7 +1,9 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE UniversalFileLoader
 
+#include "../CalibrationStore.h"
 #include "../UniversalFileLoader.h"
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 struct myFixtures {
@@ -285,4 +287,28 @@ BOOST_FIXTURE_TEST_CASE(generateConfigurationParameters, myFixtures) {
   BOOST_REQUIRE_CLOSE(configuration.at(73).at(0), -3, epsilon);
 }
 
+BOOST_FIXTURE_TEST_CASE(loadConfigurationParameters_from_store, myFixtures) {
+  const std::string directory = "UniversalFileLoaderTest_store";
+  boost::filesystem::remove_all(directory);
+  CalibrationStore store(directory);
+  BOOST_REQUIRE(store.add("Thresholds", "", 1, 10, {"thresholds.txt", "", ""}, {{22, {80.0}}}));
+
+  jpet_options_tools::OptsStrAny opts;
+  opts[UniversalFileLoader::kStoreDirectoryParamKey] = directory;
+  opts["runId_int"] = 5;
+  bool loadedFromStore = false;
+  auto configuration = UniversalFileLoader::loadConfigurationParameters(
+      opts, "Thresholds", "blabalbaahl.txt", fCorrectTombMap, loadedFromStore);
+  BOOST_REQUIRE(loadedFromStore);
+  BOOST_REQUIRE_EQUAL(configuration.at(22).at(0), 80.0);
+
+  // No constants for the run in the store, parameters are taken from the file
+  opts["runId_int"] = 20;
+  configuration = UniversalFileLoader::loadConfigurationParameters(
+      opts, "Thresholds", "blabalbaahl.txt", fCorrectTombMap, loadedFromStore);
+  BOOST_REQUIRE(!loadedFromStore);
+  BOOST_REQUIRE(configuration.empty());
+  boost::filesystem::remove_all(directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file WorkStealingPoolTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE WorkStealingPoolTest
+
+#include "../WorkStealingPool.h"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <stdexcept>
+
+BOOST_AUTO_TEST_SUITE(WorkStealingPoolTestSuite)
+
+BOOST_AUTO_TEST_CASE(allJobsDoneOnceTest)
+{
+  WorkStealingPool pool(4);
+  BOOST_REQUIRE_EQUAL(pool.getNumberOfWorkers(), 4u);
+  std::vector<double> costs(1000);
+  for (std::size_t i = 0; i < costs.size(); i++)
+  {
+    costs[i] = i % 17;
+  }
+  // Boost test assertions are not thread safe, so results are checked after the run
+  std::vector<std::atomic<int>> done(costs.size());
+  std::atomic<unsigned int> maxWorker(0);
+  for (auto& counter : done)
+  {
+    counter = 0;
+  }
+  pool.run(costs, [&done, &maxWorker](std::size_t job, unsigned int worker) {
+    done[job]++;
+    unsigned int current = maxWorker;
+    while (worker > current && !maxWorker.compare_exchange_weak(current, worker))
+    {
+    }
+  });
+  for (const auto& counter : done)
+  {
+    BOOST_REQUIRE_EQUAL(counter.load(), 1);
+  }
+  BOOST_REQUIRE(maxWorker < 4u);
+
+  std::atomic<int> emptyRunJobs(0);
+  pool.run({}, [&emptyRunJobs](std::size_t, unsigned int) { emptyRunJobs++; });
+  BOOST_REQUIRE_EQUAL(emptyRunJobs.load(), 0);
+  BOOST_REQUIRE(WorkStealingPool().getNumberOfWorkers() > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stealingTest)
+{
+  // Jobs run by the first worker are slow, so the other one has to steal from its queue
+  WorkStealingPool pool(2);
+  std::vector<double> costs(8, 1.0);
+  std::vector<unsigned int> workers(costs.size(), 99);
+  pool.run(costs, [&workers](std::size_t job, unsigned int worker) {
+    workers[job] = worker;
+    if (worker == 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+  });
+  for (auto worker : workers)
+  {
+    BOOST_REQUIRE(worker < 2u);
+  }
+  BOOST_REQUIRE(pool.getNumberOfStolenJobs() > 0u);
+  BOOST_REQUIRE(std::count(workers.begin(), workers.end(), 1u) > 4);
+}
+
+BOOST_AUTO_TEST_CASE(exceptionTest)
+{
+  WorkStealingPool pool(3);
+  std::vector<double> costs(20, 1.0);
+  BOOST_REQUIRE_THROW(pool.run(costs,
+                               [](std::size_t job, unsigned int) {
+                                 if (job == 5)
+                                 {
+                                   throw std::runtime_error("job failed");
+                                 }
+                               }),
+                      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
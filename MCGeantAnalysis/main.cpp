@@ -15,6 +15,7 @@
 
 #include <JPetManager/JPetManager.h>
 #include "../LargeBarrelAnalysis/EventFinder.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include "EventAnalyzer.h"
 using namespace std;
 
@@ -23,8 +24,8 @@ int main(int argc, const char* argv[])
   try {
     JPetManager& manager = JPetManager::getManager();
     
-    manager.registerTask<EventFinder>("EventFinder");
-    manager.registerTask<EventAnalyzer>("EventAnalyzer");
+    manager.registerTask<InstrumentedTask<EventFinder>>("EventFinder");
+    manager.registerTask<InstrumentedTask<EventAnalyzer>>("EventAnalyzer");
     
     manager.useTask("EventFinder", "hits", "unk.evt");
     manager.useTask("EventAnalyzer", "unk.evt", "ana.evt");
@@ -19,6 +19,7 @@
 #include "../LargeBarrelAnalysis/SignalFinder.h"
 #include "../LargeBarrelAnalysis/SignalTransformer.h"
 #include "../LargeBarrelAnalysis/TimeWindowCreator.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include <JPetManager/JPetManager.h>
 using namespace std;
 
@@ -26,12 +27,12 @@ int main(int argc, const char* argv[]) {
   try {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<EventFinder>("EventFinder");
-    manager.registerTask<EventCategorizer>("EventCategorizer");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<EventFinder>>("EventFinder");
+    manager.registerTask<InstrumentedTask<EventCategorizer>>("EventCategorizer");
 
     manager.useTask("TimeWindowCreator", "hld", "tslot.calib");
     manager.useTask("SignalFinder", "tslot.calib", "raw.sig");
@@ -32,6 +32,9 @@ bool EventCategorizerPhysics::init()
 
   fOutputEvents = new JPetTimeWindow("JPetEvent");
 
+  // Optional flat copy of the categorized events
+  fFlatEventWriter.openFromOptions(fParams.getOptions(), getName());
+
   if (isOptionSet(fParams.getOptions(), kMinAnnihilationParamKey)) {
     fMinAnnihilationTOT = getOptionAsFloat(fParams.getOptions(), kMinAnnihilationParamKey);
   } else {
@@ -78,11 +81,29 @@ bool EventCategorizerPhysics::init()
     WARNING(Form("No value of the %s parameter provided by the user. Using default value of %lf.", kDecayInto3MinAngleParamKey.c_str(), fDecayInto3MinAngle));
   }
   if (isOptionSet(fParams.getOptions(), kTOTCalculationType)) {
-    fTOTCalculationType = getOptionAsString(fParams.getOptions(), kTOTCalculationType);
+    fTOTCalculationType = HitFinderTools::getTOTCalculationType(getOptionAsString(fParams.getOptions(), kTOTCalculationType));
   } else {
     WARNING("No TOT calculation option given by the user. Using standard sum.");
   }
 
+  // Optional scan of many sets of cuts, evaluated next to the nominal ones
+  CategorizerCutSet nominalCuts;
+  nominalCuts.minAnnihilationTOT = fMinAnnihilationTOT;
+  nominalCuts.maxAnnihilationTOT = fMaxAnnihilationTOT;
+  nominalCuts.minDeexcitationTOT = fMinDeexcitationTOT;
+  nominalCuts.maxDeexcitationTOT = fMaxDeexcitationTOT;
+  nominalCuts.maxZPos = fMaxZPos;
+  nominalCuts.backToBackAngleWindow = fBackToBackAngleWindow;
+  nominalCuts.maxTimeDiff = fMaxTimeDiff;
+  std::string cutScanError;
+  auto cutSets = CategorizerCutScan::readCutSets(fParams.getOptions(), nominalCuts, cutScanError);
+  if (!cutScanError.empty()) {
+    ERROR("Scan of cuts disabled: " + cutScanError);
+  } else if (!cutSets.empty()) {
+    INFO(Form("Scanning %d sets of cuts", (int) cutSets.size()));
+  }
+  fCutScan.init(cutSets, true, getStatistics());
+
   if(fSaveControlHistos) initialiseHistograms();
   return true;
 }
@@ -109,6 +130,7 @@ bool EventCategorizerPhysics::exec()
 bool EventCategorizerPhysics::terminate()
 {
   INFO("Physics streaming ended.");
+  fFlatEventWriter.close();
   return true;
 }
 
@@ -116,6 +138,9 @@ void EventCategorizerPhysics::saveEvents(const vector<JPetEvent>& events)
 {
   for (const auto& event : events) {
     fOutputEvents->add<JPetEvent>(event);
+    if (fFlatEventWriter.isOpen()) {
+      fFlatEventWriter.fill(event, fTOTCalculationType);
+    }
   }
 }
 
@@ -125,9 +150,14 @@ JPetEvent EventCategorizerPhysics::physicsAnalysis(vector<JPetHit> hits)
   JPetEvent annihilationHits;
   JPetEvent deexcitationHits;
 
+  // TOTs are calculated once and shared with the scanned sets of cuts
+  fHitTOTs.clear();
+  for (const auto& hit : hits) {
+    fHitTOTs.push_back(HitFinderTools::calculateTOT(hit, fTOTCalculationType));
+  }
   for (unsigned i = 0; i < hits.size(); i++) {
     if (fabs(hits[i].getPosZ()) < fMaxZPos) {
-      double TOTofHit = HitFinderTools::calculateTOT(hits[i], HitFinderTools::getTOTCalculationType(fTOTCalculationType));
+      double TOTofHit = fHitTOTs[i];
       if (fSaveControlHistos) {
         getStatistics().getHisto1D("AllHitTOT")->Fill(TOTofHit / 1000.);
       }
@@ -176,6 +206,7 @@ JPetEvent EventCategorizerPhysics::physicsAnalysis(vector<JPetHit> hits)
       physicEvent.addEventType(JPetEventType::k3Gamma);
     }
   }
+  fCutScan.evaluate(hits, fHitTOTs, getStatistics());
   return physicEvent;
 }
 
@@ -13,6 +13,7 @@
  *  @file main.cpp
  */
 
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include "JPetMakePhysSignal/SDAMakePhysSignals.h"
 #include "JPetManager/JPetManager.h"
 #include "JPetMatchHits/SDAMatchHits.h"
@@ -28,13 +29,13 @@ int main(int argc, const char *argv[]) {
   try {
     JPetManager &manager = JPetManager::getManager();
 
-    manager.registerTask<SDARecoOffsetsCalc>("SDARecoOffsetsCalc");
-    manager.registerTask<SDARecoChargeCalc>("SDARecoChargeCalc");
-    manager.registerTask<SDARecoAmplitudeCalc>("SDARecoAmplitudeCalc");
-    manager.registerTask<SDARecoDrawAllCharges>("SDARecoDrawAllCharges");
-    manager.registerTask<SDAMakePhysSignals>("SDAMakePhysSignals");
-    manager.registerTask<SDAMatchHits>("SDAMatchHits");
-    manager.registerTask<SDAMatchLORs>("SDAMatchLORs");
+    manager.registerTask<InstrumentedTask<SDARecoOffsetsCalc>>("SDARecoOffsetsCalc");
+    manager.registerTask<InstrumentedTask<SDARecoChargeCalc>>("SDARecoChargeCalc");
+    manager.registerTask<InstrumentedTask<SDARecoAmplitudeCalc>>("SDARecoAmplitudeCalc");
+    manager.registerTask<InstrumentedTask<SDARecoDrawAllCharges>>("SDARecoDrawAllCharges");
+    manager.registerTask<InstrumentedTask<SDAMakePhysSignals>>("SDAMakePhysSignals");
+    manager.registerTask<InstrumentedTask<SDAMatchHits>>("SDAMatchHits");
+    manager.registerTask<InstrumentedTask<SDAMatchLORs>>("SDAMatchLORs");
 
     manager.useTask("SDARecoOffsetsCalc", "reco.sig", "reco.sig.offsets");
     manager.useTask("SDARecoChargeCalc", "reco.sig.offsets",
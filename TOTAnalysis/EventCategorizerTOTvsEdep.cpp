@@ -14,10 +14,10 @@
  */
 
 #include "EventCategorizerTOTvsEdep.h"
-#include <JPetAnalysisTools/JPetAnalysisTools.h>
 #include <JPetWriter/JPetWriter.h>
 #include <TH3F.h>
 #include <TMath.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -71,7 +71,7 @@ bool EventCategorizer::exec()
       }
       if (event.getHits().size() == 3)
       {
-        vector<JPetEvent> vec = analyseThreeHitEvent(&event);
+        analyseThreeHitEvent(event);
       }
       fEventNumber++;
     }
@@ -94,79 +94,68 @@ void EventCategorizer::saveEvents(const vector<JPetEvent>& events)
 }
 
 // Three hit events
-vector<JPetEvent> EventCategorizer::analyseThreeHitEvent(const JPetEvent* event)
+void EventCategorizer::analyseThreeHitEvent(const JPetEvent& event)
 {
+  const auto& hits = event.getHits();
+  // TOTs of the hits are shared by all triples
+  fHitTOTs.clear();
+  for (const auto& hit : hits)
+  {
+    fHitTOTs.push_back(HitFinderTools::calculateTOT(hit, fTOTCalculationType) * kPsToNs);
+  }
 
-  vector<JPetHit> hits = event->getHits();
   for (unsigned int i = 0; i < hits.size(); i++)
   {
     for (unsigned int j = i + 1; j < hits.size(); j++)
     {
       for (unsigned int k = j + 1; k < hits.size(); k++)
       {
-        JPetHit firstHit = event->getHits().at(i);
-        JPetHit secondHit = event->getHits().at(j);
-        JPetHit thirdHit = event->getHits().at(k);
-
-        vector<JPetHit> orderedHits;
-        orderedHits.push_back(firstHit);
-        orderedHits.push_back(secondHit);
-        orderedHits.push_back(thirdHit);
-        orderedHits = reorderHits(orderedHits);
+        const JPetHit& firstHit = hits[i];
+        const JPetHit& secondHit = hits[j];
+        const JPetHit& thirdHit = hits[k];
 
         getStatistics().fillHistogram("Time difference 2-1 BOrdering", TMath::Abs(secondHit.getTime() - firstHit.getTime()) * kPsToNs);
         getStatistics().fillHistogram("Time difference 3-2 BOrdering", TMath::Abs(thirdHit.getTime() - secondHit.getTime()) * kPsToNs);
         getStatistics().fillHistogram("Time difference 3-1 BOrdering", TMath::Abs(thirdHit.getTime() - firstHit.getTime()) * kPsToNs);
 
-        // Ordered in time after corrections
-        JPetHit firstHit2 = orderedHits.at(0);
-        JPetHit secondHit2 = orderedHits.at(1);
-        JPetHit thirdHit2 = orderedHits.at(2);
+        // Ordered in time after corrections, the corrected times are used for the conditions only
+        const OrderedHits orderedHits = reorderHits(hits, fHitTOTs, i, j, k);
 
         // Time difference after ordering
+        getStatistics().fillHistogram("Time difference 2-1", TMath::Abs(orderedHits[1].time - orderedHits[0].time) * kPsToNs);
+        getStatistics().fillHistogram("Time difference 3-2", TMath::Abs(orderedHits[2].time - orderedHits[1].time) * kPsToNs);
+        getStatistics().fillHistogram("Time difference 3-1", TMath::Abs(orderedHits[2].time - orderedHits[0].time) * kPsToNs);
 
-        getStatistics().fillHistogram("Time difference 2-1", TMath::Abs(secondHit2.getTime() - firstHit2.getTime()) * kPsToNs);
-        getStatistics().fillHistogram("Time difference 3-2", TMath::Abs(thirdHit2.getTime() - secondHit2.getTime()) * kPsToNs);
-        getStatistics().fillHistogram("Time difference 3-1", TMath::Abs(thirdHit2.getTime() - firstHit2.getTime()) * kPsToNs);
-
-        // ORDERING DONE (not beautifully however), NOW NEW HITS ARE NAMED AS firstHit2, secondHit2, thirdHit2
-        // New hits with ordered in time will be used for the conditions only.
-        vector<double> angles;
-        angles.push_back(calcAngle(firstHit2, secondHit2));
-        angles.push_back(calcAngle(secondHit2, thirdHit2));
-        angles.push_back(calcAngle(thirdHit2, firstHit2));
+        HitAngles angles = {calcAngle(*orderedHits[0].hit, *orderedHits[1].hit), calcAngle(*orderedHits[1].hit, *orderedHits[2].hit),
+                            calcAngle(*orderedHits[2].hit, *orderedHits[0].hit)};
         sort(angles.begin(), angles.end());
 
         // 3-D angles
         getStatistics().fillHistogram("3_hit_angles", angles[0] + angles[1], angles[1] - angles[0]);
 
-        double Angle_3D_1_2_B = TMath::Abs(calcAngle(firstHit, secondHit));
-        double Angle_3D_2_3_B = TMath::Abs(calcAngle(secondHit, thirdHit));
-        double Angle_3D_3_1_B = TMath::Abs(calcAngle(thirdHit, firstHit));
-
-        deexcitationSelection(angles, firstHit2, secondHit2, thirdHit2);
-        annihilationSelection(angles, firstHit2, secondHit2, thirdHit2);
+        deexcitationSelection(angles, orderedHits);
+        annihilationSelection(angles, orderedHits);
       }
     }
   }
-  vector<JPetEvent> eventVector;
-  return eventVector;
 }
 
 // de-excitation gamma selection
-void EventCategorizer::deexcitationSelection(const vector<double>& angles, const JPetHit& firstHit2, const JPetHit& secondHit2,
-                                             const JPetHit& thirdHit2)
+void EventCategorizer::deexcitationSelection(const HitAngles& angles, const OrderedHits& hits)
 {
   if ((angles[0] + angles[1]) < 178 || (angles[0] + angles[1]) > 182)
   {
-    double time_diff_check = (thirdHit2.getTime() - firstHit2.getTime()) * kPsToNs;
-    double deex_selection = HitFinderTools::calculateTOT(firstHit2, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs;
+    const auto& first = hits[0];
+    const auto& second = hits[1];
+    const auto& third = hits[2];
+    double time_diff_check = (third.time - first.time) * kPsToNs;
+    double deex_selection = first.tot;
     getStatistics().fillHistogram("3_hit_angles after cut", angles[0] + angles[1], angles[1] - angles[0]);
     getStatistics().fillHistogram("De-exci time criteria t3-t1", time_diff_check);
 
-    int firstHitScinID = firstHit2.getScintillator().getID();
-    int secondHitScinID = secondHit2.getScintillator().getID();
-    int thirdHitScinID = thirdHit2.getScintillator().getID();
+    int firstHitScinID = first.hit->getScintillator().getID();
+    int secondHitScinID = second.hit->getScintillator().getID();
+    int thirdHitScinID = third.hit->getScintillator().getID();
 
     // TimeDiff_From && TimeDiff_To used to put time difference between prompt photon and annihilation photon  registration, values are fixed in
     // EventCategorizerTOTvsEdep.h
@@ -174,67 +163,65 @@ void EventCategorizer::deexcitationSelection(const vector<double>& angles, const
 
     // Make it sure the first hit is from center
     if (time_diff_check > TimeDiff_From && time_diff_check < TimeDiff_To && deex_selection < fDeexSelUpper &&
-        TMath::Abs(firstHit2.getPosZ()) < 23.0 && TMath::Abs(secondHit2.getPosZ()) < 23.0 && TMath::Abs(thirdHit2.getPosZ()) < 23.0 &&
+        TMath::Abs(first.hit->getPosZ()) < 23.0 && TMath::Abs(second.hit->getPosZ()) < 23.0 && TMath::Abs(third.hit->getPosZ()) < 23.0 &&
         firstHitScinID != secondHitScinID && firstHitScinID != thirdHitScinID && secondHitScinID != thirdHitScinID)
     {
       fTotal3HitEvents++;
-      vector<double> vec0 = scatterAnalysis(firstHit2, secondHit2, thirdHit2, 1274.6);
-      getStatistics().fillHistogram("2 hit assignment", vec0.at(5));
+      const ScatterResult result = scatterAnalysis(first, second, third, 1274.6);
+      getStatistics().fillHistogram("2 hit assignment", result.scatterTest);
 
-      if (vec0.at(9) < 4)
+      if (result.phiAngle < 4)
         return;
 
-      if (vec0.at(5) > -0.5 && vec0.at(5) < 0.75)
+      if (result.scatterTest > -0.5 && result.scatterTest < 0.75)
       {
-        writeSelected(firstHit2, secondHit2, vec0, true, 1274.6, firstHit2.getPosZ(), firstHitScinID);
+        writeSelected(first, result, 1274.6);
         getStatistics().fillHistogram("De-exci time accepted t3-t1", time_diff_check);
       }
     }
   }
 }
 
-void EventCategorizer::annihilationSelection(const vector<double>& angles, const JPetHit& firstHit2, const JPetHit& secondHit2,
-                                             const JPetHit& thirdHit2)
+void EventCategorizer::annihilationSelection(const HitAngles& angles, const OrderedHits& hits)
 {
+  const auto& first = hits[0];
+  const auto& second = hits[1];
+  const auto& third = hits[2];
+
   // b2b gammas selection
-  getStatistics().fillHistogram("Time difference 2-1", TMath::Abs(secondHit2.getTime() - firstHit2.getTime()) * kPsToNs);
-  getStatistics().fillHistogram("Time difference 3-2", TMath::Abs(thirdHit2.getTime() - secondHit2.getTime()) * kPsToNs);
+  getStatistics().fillHistogram("Time difference 2-1", TMath::Abs(second.time - first.time) * kPsToNs);
+  getStatistics().fillHistogram("Time difference 3-2", TMath::Abs(third.time - second.time) * kPsToNs);
 
-  int firstHitScinID = firstHit2.getScintillator().getID();
-  int secondHitScinID = secondHit2.getScintillator().getID();
-  int thirdHitScinID = thirdHit2.getScintillator().getID();
+  int firstHitScinID = first.hit->getScintillator().getID();
+  int secondHitScinID = second.hit->getScintillator().getID();
+  int thirdHitScinID = third.hit->getScintillator().getID();
 
   if ((angles[0] + angles[1]) > 178 && (angles[0] + angles[1]) < 182 &&
-      (TMath::Abs(firstHit2.getTime() - secondHit2.getTime()) * kPsToNs) < 0.2 // Time diff. criteria between hits will cut elongation of scatter test
-      && TMath::Abs(firstHit2.getPosZ()) < 23.0 && TMath::Abs(secondHit2.getPosZ()) < 23.0 && TMath::Abs(thirdHit2.getPosZ()) < 23.0 &&
-      HitFinderTools::calculateTOT(firstHit2, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs < fAnniSelUpper &&
-      HitFinderTools::calculateTOT(secondHit2, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs < fAnniSelUpper &&
-      firstHitScinID != secondHitScinID && firstHitScinID != thirdHitScinID && secondHitScinID != thirdHitScinID)
+      (TMath::Abs(first.time - second.time) * kPsToNs) < 0.2 // Time diff. criteria between hits will cut elongation of scatter test
+      && TMath::Abs(first.hit->getPosZ()) < 23.0 && TMath::Abs(second.hit->getPosZ()) < 23.0 && TMath::Abs(third.hit->getPosZ()) < 23.0 &&
+      first.tot < fAnniSelUpper && second.tot < fAnniSelUpper && firstHitScinID != secondHitScinID && firstHitScinID != thirdHitScinID &&
+      secondHitScinID != thirdHitScinID)
   {
 
     fTotal3HitEvents++;
 
-    double Angle_3D_1_2 = TMath::Abs(calcAngle(firstHit2, secondHit2));
-    double Angle_3D_2_3 = TMath::Abs(calcAngle(secondHit2, thirdHit2));
-    double Angle_3D_3_1 = TMath::Abs(calcAngle(thirdHit2, firstHit2));
-
     getStatistics().fillHistogram("3_hit_angles after cut BTB", angles[0] + angles[1], angles[1] - angles[0]);
 
-    vector<double> vec1 = scatterAnalysis(firstHit2, thirdHit2, secondHit2, 511.0);
-    vector<double> vec2 = scatterAnalysis(secondHit2, thirdHit2, firstHit2, 511.0);
+    const ScatterResult result1 = scatterAnalysis(first, third, second, 511.0);
+    const ScatterResult result2 = scatterAnalysis(second, third, first, 511.0);
 
-    if (TMath::Abs(vec1.at(13) > 2))
+    if (result1.distanceFromCenter > 2)
       return;
-    if (vec1.at(9) < 4 || vec1.at(9) < 4)
+    if (result1.phiAngle < 4)
       return;
 
-    getStatistics().fillHistogram("3rd hit assignment_wc", vec1.at(5), vec2.at(5));
-    getStatistics().fillHistogram("Annihilation points XY position", vec1.at(10), vec1.at(11));
+    getStatistics().fillHistogram("3rd hit assignment_wc", result1.scatterTest, result2.scatterTest);
+    getStatistics().fillHistogram("Annihilation points XY position", result1.annihilationPoint.X(), result1.annihilationPoint.Y());
 
     // Implementation of ellip. cuts :
 
     // Calculate the equations:
-    double x = vec1.at(5), y = vec2.at(5), angle = 0.785398, a = 1.50, b = 0.82;
+    double x = result1.scatterTest, y = result2.scatterTest, angle = 0.785398, a = 1.50, b = 0.82;
     double Cut_sca_13 =
         pow((((x - 0.4324) * cos(angle) + (y + 2.266) * sin(angle)) / a), 2) + pow((((x - 0.4324) * sin(angle) - (y + 2.266) * cos(angle)) / b), 2);
     double Cut_sca_23 =
@@ -242,72 +229,72 @@ void EventCategorizer::annihilationSelection(const vector<double>& angles, const
 
     if (Cut_sca_13 < 1)
     {
-      writeSelected(firstHit2, thirdHit2, vec1, true, 511, firstHit2.getPosZ(), firstHitScinID);
-      getStatistics().fillHistogram("3rd hit assignment", vec1.at(5), vec2.at(5));
-      getStatistics().fillHistogram("Scatt_ZHit", firstHit2.getPosZ(), vec1.at(2));
-      getStatistics().fillHistogram("scatter_angle_sel_511", vec1.at(2));
-      getStatistics().fillHistogram("Energy_dep_sel_511", 511 * (1 - (1 / (1 + ((511 / 511) * (1 - cos(vec1.at(2) * TMath::Pi() / 180)))))));
+      writeSelected(first, result1, 511);
+      getStatistics().fillHistogram("3rd hit assignment", result1.scatterTest, result2.scatterTest);
+      getStatistics().fillHistogram("Scatt_ZHit", first.hit->getPosZ(), result1.scatterAngle);
+      getStatistics().fillHistogram("scatter_angle_sel_511", result1.scatterAngle);
+      getStatistics().fillHistogram("Energy_dep_sel_511", 511 * (1 - (1 / (1 + ((511 / 511) * (1 - cos(result1.scatterAngle * TMath::Pi() / 180)))))));
     }
     else if (Cut_sca_23 < 1)
     {
-      writeSelected(secondHit2, thirdHit2, vec2, true, 511, secondHit2.getPosZ(), secondHitScinID);
-      getStatistics().fillHistogram("3rd hit assignment", vec1.at(5), vec2.at(5));
-      getStatistics().fillHistogram("Scatt_ZHit", secondHit2.getPosZ(), vec2.at(2));
-      getStatistics().fillHistogram("scatter_angle_sel_511", vec2.at(2));
-      getStatistics().fillHistogram("Energy_dep_sel_511", 511 * (1 - (1 / (1 + ((511 / 511) * (1 - cos(vec2.at(2) * TMath::Pi() / 180)))))));
+      writeSelected(second, result2, 511);
+      getStatistics().fillHistogram("3rd hit assignment", result1.scatterTest, result2.scatterTest);
+      getStatistics().fillHistogram("Scatt_ZHit", second.hit->getPosZ(), result2.scatterAngle);
+      getStatistics().fillHistogram("scatter_angle_sel_511", result2.scatterAngle);
+      getStatistics().fillHistogram("Energy_dep_sel_511", 511 * (1 - (1 / (1 + ((511 / 511) * (1 - cos(result2.scatterAngle * TMath::Pi() / 180)))))));
     }
   }
 }
 
-vector<JPetHit> EventCategorizer::reorderHits(vector<JPetHit> hits)
+EventCategorizer::OrderedHits EventCategorizer::reorderHits(const vector<JPetHit>& hits, const vector<double>& tots, unsigned int i, unsigned int j,
+                                                            unsigned int k)
+{
+  OrderedHits orderedHits;
+  const unsigned int indices[] = {i, j, k};
+  for (unsigned int n = 0; n < orderedHits.size(); n++)
+  {
+    const auto& hit = hits[indices[n]];
+    // Corrected time is a original time in pico seconds
+    // minus value of time of flight from the center - distance/speed of light
+    orderedHits[n].hit = &hit;
+    orderedHits[n].time = hit.getTime() - hit.getPos().Mag() * kNsToPs / kLightVelocity_cm_ns;
+    orderedHits[n].tot = tots[indices[n]];
+  }
+  sort(orderedHits.begin(), orderedHits.end(), [](const TimeCorrectedHit& h1, const TimeCorrectedHit& h2) { return h1.time < h2.time; });
+  return orderedHits;
+}
+
+/// Annihilation point of two 511 keV gammas, with the time of flight given by the corrected times of the hits
+TVector3 EventCategorizer::calculateAnnihilationPoint(const TimeCorrectedHit& primary1, const TimeCorrectedHit& primary2)
 {
-  vector<JPetHit> reorderedHits;
-  auto first = new JPetHit(hits.at(0));
-  auto second = new JPetHit(hits.at(1));
-  auto third = new JPetHit(hits.at(2));
-
-  // Corrected time is a original time in pico seconds
-  // minus value of time of flight from the center - distance/speed of light
-  // Setting the time of new hits as corrected ones
-  first->setTime(hits.at(0).getTime() - hits.at(0).getPos().Mag() * kNsToPs / kLightVelocity_cm_ns);
-  second->setTime(hits.at(1).getTime() - hits.at(1).getPos().Mag() * kNsToPs / kLightVelocity_cm_ns);
-  third->setTime(hits.at(2).getTime() - hits.at(2).getPos().Mag() * kNsToPs / kLightVelocity_cm_ns);
-
-  reorderedHits.push_back(*first);
-  reorderedHits.push_back(*second);
-  reorderedHits.push_back(*third);
-
-  return JPetAnalysisTools::getHitsOrderedByTime(reorderedHits);
+  return EventCategorizerTools::calculateAnnihilationPoint(primary1.hit->getPos(), primary2.hit->getPos(),
+                                                           EventCategorizerTools::calculateTOF(primary1.time, primary2.time));
 }
 
 // Scatter Analysis
-vector<double> EventCategorizer::scatterAnalysis(const JPetHit& primary1, const JPetHit& scatter, const JPetHit& primary2, double gamma)
+EventCategorizer::ScatterResult EventCategorizer::scatterAnalysis(const TimeCorrectedHit& primary1, const TimeCorrectedHit& scatter,
+                                                                  const TimeCorrectedHit& primary2, double gamma)
 {
-  vector<double> values;
+  ScatterResult result;
   // cm/nsec
   TVector3 primary1Vec, scatterVec;
-  double xcor, ycor, zcor, distanceFromCenter;
 
   if (gamma == 511.0)
   {
-    TVector3 anniPoint = EventCategorizerTools::calculateAnnihilationPoint(primary1, primary2);
-    xcor = anniPoint.X();
-    ycor = anniPoint.Y();
-    zcor = anniPoint.Z();
-    distanceFromCenter = sqrt(pow(xcor, 2) + pow(ycor, 2));
-    primary1Vec = primary1.getPos() - primary2.getPos();
-    scatterVec = scatter.getPos() - primary1.getPos();
+    result.annihilationPoint = calculateAnnihilationPoint(primary1, primary2);
+    result.distanceFromCenter = result.annihilationPoint.Perp();
+    primary1Vec = primary1.hit->getPos() - primary2.hit->getPos();
+    scatterVec = scatter.hit->getPos() - primary1.hit->getPos();
   }
   else if (gamma == 1274.6)
   {
-    primary1Vec = primary1.getPos();
-    scatterVec = scatter.getPos() - primary1.getPos();
+    primary1Vec = primary1.hit->getPos();
+    scatterVec = scatter.hit->getPos() - primary1.hit->getPos();
   }
 
   double distance = scatterVec.Mag();
-  double primary1Theta = primary1.getBarrelSlot().getTheta();
-  double scatterTheta = scatter.getBarrelSlot().getTheta();
-  double PhiAngle = TMath::Abs(scatterTheta - primary1Theta);
+  double primary1Theta = primary1.hit->getBarrelSlot().getTheta();
+  double scatterTheta = scatter.hit->getBarrelSlot().getTheta();
 
   // Follow dot product recipe
   double scatterAngle = TMath::RadToDeg() * scatterVec.Angle(primary1Vec);
@@ -332,11 +319,10 @@ vector<double> EventCategorizer::scatterAnalysis(const JPetHit& primary1, const
   }
 
   // Distance b/w hits
-  double computedDistance = (primary1.getPos() - scatter.getPos()).Mag();
+  double computedDistance = (primary1.hit->getPos() - scatter.hit->getPos()).Mag();
 
   // pico to nano scatter conversion
-  double hitTimeDiff = (scatter.getTime() - primary1.getTime()) * kPsToNs;
-  double evalSpeedLight = distance / TMath::Abs(hitTimeDiff);
+  double hitTimeDiff = (scatter.time - primary1.time) * kPsToNs;
 
   // Using scattered angle, calculate theoretical value of energy deposition
   double Edep = gamma * (1 - (1 / (1 + ((gamma / 511) * (1 - cos(scatterAngle * TMath::Pi() / 180))))));
@@ -352,26 +338,17 @@ vector<double> EventCategorizer::scatterAnalysis(const JPetHit& primary1, const
     getStatistics().fillHistogram("scatter_angle_all_1275", scatterAngle);
   }
 
-  // FILLING VALUES
-  // 0: distance, 1: thetaDiff, 2: scatterAngle, 3: distance-computedDistance
-  // 4: speed of light constrain 5: hit-assignemnet 6:angle-edep
-  // 7: Primary Scint ID, 8: Scint_Id of scintillator with scattering
-  // 9: Phi angle of scatter, 10,11,12 - annihilation point coordinates,..
-  values.push_back(distance);
-  values.push_back(thetaDiff);
-  values.push_back(scatterAngle);
-  values.push_back(TMath::Abs(distance - computedDistance));
-  values.push_back(evalSpeedLight);
-  values.push_back(hitTimeDiff - distance / kLightVelocity_cm_ns);
-  values.push_back(Edep);
-  values.push_back(primary1.getScintillator().getID());
-  values.push_back(scatter.getScintillator().getID());
-  values.push_back(PhiAngle);
-  values.push_back(xcor);
-  values.push_back(ycor);
-  values.push_back(zcor);
-  values.push_back(distanceFromCenter);
-  return values;
+  result.distance = distance;
+  result.thetaDiff = thetaDiff;
+  result.scatterAngle = scatterAngle;
+  result.distanceDiff = TMath::Abs(distance - computedDistance);
+  result.evalSpeedLight = distance / TMath::Abs(hitTimeDiff);
+  result.scatterTest = hitTimeDiff - distance / kLightVelocity_cm_ns;
+  result.edep = Edep;
+  result.primaryScinID = primary1.hit->getScintillator().getID();
+  result.scatterScinID = scatter.hit->getScintillator().getID();
+  result.phiAngle = TMath::Abs(scatterTheta - primary1Theta);
+  return result;
 }
 
 // ANGLE CALCULATION
@@ -381,37 +358,28 @@ double EventCategorizer::calcAngle(const JPetHit& primary, const JPetHit& scatte
 }
 
 // Write selected histogram section
-void EventCategorizer::writeSelected(JPetHit orig, JPetHit /*scatter*/, vector<double> values, bool isScatter, double Gamma_inv, double hitZ,
-                                     int /*ScinID*/
-)
+void EventCategorizer::writeSelected(const TimeCorrectedHit& orig, const ScatterResult& result, double gamma)
 {
-  if (isScatter)
-  {
-    // gerenal fill
-    getStatistics().fillHistogram("scatter_angle_sel", values.at(2));
-    getStatistics().fillHistogram("TOT_EDEP", values.at(6),
-                                  HitFinderTools::calculateTOT(orig, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs);
-    getStatistics().fillHistogram("TOT_Spectra_3-Hit",
-                                  HitFinderTools::calculateTOT(orig, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs);
-  }
+  // gerenal fill
+  getStatistics().fillHistogram("scatter_angle_sel", result.scatterAngle);
+  getStatistics().fillHistogram("TOT_EDEP", result.edep, orig.tot);
+  getStatistics().fillHistogram("TOT_Spectra_3-Hit", orig.tot);
 
   // 511 keV fill
-  if (Gamma_inv == 511)
+  if (gamma == 511)
   {
-    getStatistics().fillHistogram("TOT_EDEP 511", values.at(6),
-                                  HitFinderTools::calculateTOT(orig, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs);
+    getStatistics().fillHistogram("TOT_EDEP 511", result.edep, orig.tot);
   }
 
   // 1274 fill
-  if (Gamma_inv == 1274.6)
+  if (gamma == 1274.6)
   {
-    double primary2_Scatt_angle = values.at(2);
+    double primary2_Scatt_angle = result.scatterAngle;
     double primary2_eng_dep_511 = 511 * (1 - (1 / (1 + ((511 / 511) * (1 - cos(primary2_Scatt_angle * TMath::Pi() / 180))))));
     double primary2_TOT_val = -2332.32 + 632.1 * log(primary2_eng_dep_511 + 606.909) - 42.0769 * pow(log(primary2_eng_dep_511 + 606.909), 2);
-    double primary2_eng_dep_1275 = Gamma_inv * (1 - (1 / (1 + ((Gamma_inv / 511) * (1 - cos(primary2_Scatt_angle * TMath::Pi() / 180))))));
-    getStatistics().fillHistogram("TOT_EDEP 1274", values.at(6),
-                                  HitFinderTools::calculateTOT(orig, HitFinderTools::getTOTCalculationType("standard")) * kPsToNs);
-    getStatistics().fillHistogram("scatter_angle_sel_1275", values.at(2));
+    double primary2_eng_dep_1275 = gamma * (1 - (1 / (1 + ((gamma / 511) * (1 - cos(primary2_Scatt_angle * TMath::Pi() / 180))))));
+    getStatistics().fillHistogram("TOT_EDEP 1274", result.edep, orig.tot);
+    getStatistics().fillHistogram("scatter_angle_sel_1275", result.scatterAngle);
     getStatistics().fillHistogram("TOT_EDEP_dummy", primary2_eng_dep_1275, primary2_TOT_val);
   }
 }
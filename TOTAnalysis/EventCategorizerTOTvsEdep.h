@@ -22,6 +22,8 @@
 #include <JPetEvent/JPetEvent.h>
 #include <JPetHit/JPetHit.h>
 #include <JPetUserTask/JPetUserTask.h>
+#include <TVector3.h>
+#include <array>
 #include <map>
 #include <vector>
 
@@ -41,10 +43,23 @@ public:
   virtual bool exec() override;
   virtual bool terminate() override;
 
+  /// Hit of a three-hit event with its time corrected for the time of flight from the center
+  struct TimeCorrectedHit
+  {
+    const JPetHit* hit = nullptr;
+    double time = 0.0; ///< corrected time [ps]
+    double tot = 0.0;  ///< [ns]
+  };
+  using OrderedHits = std::array<TimeCorrectedHit, 3>;
+
+  static OrderedHits reorderHits(const std::vector<JPetHit>& hits, const std::vector<double>& tots, unsigned int i, unsigned int j,
+                                 unsigned int k);
+  static TVector3 calculateAnnihilationPoint(const TimeCorrectedHit& primary1, const TimeCorrectedHit& primary2);
+
 private:
-  const double kLightVelocity_cm_ns = 29.9792458; // cm /ns
-  const double kNsToPs = 1000;                    // nano second to pico second converter
-  const double kPsToNs = 0.001;                   // pico second to nano second converter
+  static constexpr double kLightVelocity_cm_ns = 29.9792458; // cm /ns
+  static constexpr double kNsToPs = 1000;                    // nano second to pico second converter
+  static constexpr double kPsToNs = 0.001;                   // pico second to nano second converter
 
   const std::string kTOTvsEdepAnniSelUpperParamKey = "TOTvsEdep_AnniSelUpper_float";
   const std::string kTOTvsEdepDeexSelUpperParamKey = "TOTvsEdep_DeexSelUpper_float";
@@ -59,13 +74,35 @@ private:
   bool fSaveControlHistos = true;
   void initialiseHistograms();
   void saveEvents(const std::vector<JPetEvent>& event);
-  void deexcitationSelection(const std::vector<double>& angles, const JPetHit& firstHit2, const JPetHit& secondHit2, const JPetHit& thirdHit2);
-  void annihilationSelection(const std::vector<double>& angles, const JPetHit& firstHit2, const JPetHit& secondHit2, const JPetHit& thirdHit2);
-  std::vector<JPetHit> reorderHits(std::vector<JPetHit> hits);
-  std::vector<JPetEvent> analyseThreeHitEvent(const JPetEvent* event);
-  std::vector<double_t> scatterAnalysis(const JPetHit& orig, const JPetHit& scatter, const JPetHit&, double);
+
+  using HitAngles = std::array<double, 3>;
+
+  /// Quantities of a primary hit and a hit regarded as its scattering
+  struct ScatterResult
+  {
+    double distance = 0.0;           ///< between the hits [cm]
+    double thetaDiff = 0.0;          ///< of the barrel slots [deg]
+    double scatterAngle = 0.0;       ///< [deg]
+    double distanceDiff = 0.0;       ///< [cm]
+    double evalSpeedLight = 0.0;     ///< [cm/ns]
+    double scatterTest = 0.0;        ///< time difference of the hits minus distance / c [ns]
+    double edep = 0.0;               ///< expected from the scatter angle [keV]
+    int primaryScinID = 0;
+    int scatterScinID = 0;
+    double phiAngle = 0.0;           ///< [deg]
+    TVector3 annihilationPoint;      ///< only for 511 keV gammas [cm]
+    double distanceFromCenter = 0.0; ///< of the annihilation point in XY [cm]
+  };
+
+  const HitFinderTools::TOTCalculationType fTOTCalculationType = HitFinderTools::getTOTCalculationType("standard");
+  std::vector<double> fHitTOTs;
+
+  void deexcitationSelection(const HitAngles& angles, const OrderedHits& hits);
+  void annihilationSelection(const HitAngles& angles, const OrderedHits& hits);
+  void analyseThreeHitEvent(const JPetEvent& event);
+  ScatterResult scatterAnalysis(const TimeCorrectedHit& primary1, const TimeCorrectedHit& scatter, const TimeCorrectedHit& primary2, double gamma);
   double calcAngle(const JPetHit& orig, const JPetHit& scatter);
-  void writeSelected(JPetHit orig, JPetHit scatter, std::vector<double_t> values, bool isScatter, double, double, int ScinID);
+  void writeSelected(const TimeCorrectedHit& orig, const ScatterResult& result, double gamma);
 };
 
 #endif /* !EVENTCATEGORIZER_H */
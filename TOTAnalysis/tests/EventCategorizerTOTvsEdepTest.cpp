@@ -0,0 +1,101 @@
+/**
+ *  @copyright Copyright 2021 The J-PET Framework Authors. All rights reserved.
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may find a copy of the License in the LICENCE file.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *  @file EventCategorizerTOTvsEdepTest.cpp
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE EventCategorizerTOTvsEdepTest
+
+#include "../EventCategorizerTOTvsEdep.h"
+#include <JPetAnalysisTools/JPetAnalysisTools.h>
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+/// Triple of hits of the annihilation selection. Hits are far from the center at different distances,
+/// so the time of flight correction changes the TOF of the first two hits by about 150 ps.
+std::vector<JPetHit> createTriple()
+{
+  std::vector<JPetHit> hits(3);
+  hits[0].setPos(42.5, 0.0, 0.0);
+  hits[0].setTime(1000.0);
+  hits[1].setPos(-42.5, 0.0, 20.0);
+  hits[1].setTime(1160.0);
+  hits[2].setPos(0.0, 42.5, -3.0);
+  hits[2].setTime(3000.0);
+  return hits;
+}
+
+/// Hits ordered as before the three-hit analysis was changed to work on references:
+/// copies with times corrected for the time of flight from the center, ordered by time
+std::vector<JPetHit> reorderHitsByCopies(const std::vector<JPetHit>& hits)
+{
+  std::vector<JPetHit> reorderedHits;
+  for (const auto& hit : hits)
+  {
+    JPetHit copy(hit);
+    copy.setTime(hit.getTime() - hit.getPos().Mag() * 1000.0 / 29.9792458);
+    reorderedHits.push_back(copy);
+  }
+  return JPetAnalysisTools::getHitsOrderedByTime(reorderedHits);
+}
+
+/// Annihilation point is rejected if it is further than 2 cm from the axis of the detector
+bool isRejected(const TVector3& annihilationPoint) { return annihilationPoint.Perp() > 2; }
+}
+
+BOOST_AUTO_TEST_SUITE(EventCategorizerTOTvsEdepTestSuite)
+
+BOOST_AUTO_TEST_CASE(reorderHitsTest)
+{
+  auto hits = createTriple();
+  // Order of the hits given to the analysis does not matter
+  std::swap(hits[0], hits[2]);
+  const std::vector<double> tots = {1.0, 2.0, 3.0};
+  const auto orderedHits = EventCategorizer::reorderHits(hits, tots, 0, 1, 2);
+  const auto expectedHits = reorderHitsByCopies(hits);
+  for (unsigned int n = 0; n < orderedHits.size(); n++)
+  {
+    BOOST_REQUIRE_EQUAL((orderedHits[n].hit->getPos() - expectedHits[n].getPos()).Mag(), 0.0);
+    BOOST_REQUIRE_CLOSE(orderedHits[n].time, expectedHits[n].getTime(), 1e-9);
+  }
+  BOOST_REQUIRE_EQUAL(orderedHits[0].tot, 3.0);
+  BOOST_REQUIRE_EQUAL(orderedHits[1].tot, 2.0);
+  BOOST_REQUIRE_EQUAL(orderedHits[2].tot, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(annihilationPointTest)
+{
+  const auto hits = createTriple();
+  const std::vector<double> tots(3, 0.0);
+  const auto orderedHits = EventCategorizer::reorderHits(hits, tots, 0, 1, 2);
+  const auto expectedHits = reorderHitsByCopies(hits);
+
+  // Both scatter analyses of the annihilation selection, with the first and the second hit as the primary one
+  const std::vector<std::pair<unsigned int, unsigned int>> primaries = {{0, 1}, {1, 0}};
+  for (const auto& primary : primaries)
+  {
+    const auto point = EventCategorizer::calculateAnnihilationPoint(orderedHits[primary.first], orderedHits[primary.second]);
+    const auto expectedPoint = EventCategorizerTools::calculateAnnihilationPoint(expectedHits[primary.first], expectedHits[primary.second]);
+    BOOST_REQUIRE_SMALL((point - expectedPoint).Mag(), 1e-9);
+    BOOST_REQUIRE_EQUAL(isRejected(point), isRejected(expectedPoint));
+    BOOST_REQUIRE(!isRejected(point));
+
+    // With the original times of the hits the point would be rejected
+    const auto uncorrectedPoint =
+        EventCategorizerTools::calculateAnnihilationPoint(*orderedHits[primary.first].hit, *orderedHits[primary.second].hit);
+    BOOST_REQUIRE(isRejected(uncorrectedPoint));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
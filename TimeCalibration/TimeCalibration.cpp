@@ -20,6 +20,7 @@
 #include <sstream>
 #include <cctype>
 #include "TimeCalibration.h"
+#include "../LargeBarrelAnalysis/RawSignalTimes.h"
 #include "TF1.h"
 #include "TString.h"
 #include <TDirectory.h>
@@ -125,8 +126,8 @@ bool TimeCalibration::init()
 
 bool TimeCalibration::exec()
 {
-  double RefTimeLead[4] = { -1.e43, -1.e43, -1.e43, -1.e43};
-  double RefTimeTrail[4] = { -1.e43, -1.e43, -1.e43, -1.e43};
+  double RefTimeLead = -1.e43;
+  double RefTimeTrail = -1.e43;
   std::vector <JPetHit> fhitsCalib;
   std::vector <double> fRefTimesL;
   std::vector <double> fRefTimesT;
@@ -144,21 +145,17 @@ bool TimeCalibration::exec()
       //
 
       if (PMid == kPMidRef) {
-        auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-        auto trail_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
+        RawSignalTimes times_B(hit.getSignalB().getRecoSignal().getRawSignal());
         //
-        for (auto& thr_time_pair : lead_times_B) {
-          int thr = thr_time_pair.first;
-          RefTimeLead[thr] = thr_time_pair.second;
-
+        //only the first threshold of the reference detector is used
+        if (times_B.hasLeading(1)) {
+          RefTimeLead = times_B.getLeading(1);
         }
-
-        for (auto& thr_time_pair : trail_times_B) {
-          int thr = thr_time_pair.first;
-          RefTimeTrail[thr] = thr_time_pair.second;
+        if (times_B.hasTrailing(1)) {
+          RefTimeTrail = times_B.getTrailing(1);
         }
-        fRefTimesL.push_back(RefTimeLead[1]);
-        fRefTimesT.push_back(RefTimeTrail[1]);
+        fRefTimesL.push_back(RefTimeLead);
+        fRefTimesT.push_back(RefTimeTrail);
       } else {
         fhitsCalib.push_back(hit);
       }
@@ -337,11 +334,8 @@ bool TimeCalibration::terminate()
 void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<double>&   fRefTimesL, const std::vector<double>& fRefTimesT)
 {
 
-  auto lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
-
-  auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
+  RawSignalTimes times_A(hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes times_B(hit.getSignalB().getRecoSignal().getRawSignal());
 //
 //-----------TOT calculation for the slot hit
   float TOT_A = 0.;
@@ -353,17 +347,14 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
   //**	int StripToCalibTemp = hit.getScintillator().getID();
   //**	int LayerToCalibTemp = hit.getBarrelSlot().getLayer().getID();
   //
-  for (auto& thr_time_pair : lead_times_A) {
-    int thr = thr_time_pair.first;
-
-    if (trail_times_A.count(thr) > 0 ) {
-      TOT_A = TOT_A + trail_times_A[thr] - lead_times_A[thr];
+  for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    if (times_A.hasBothEdges(thr)) {
+      TOT_A = TOT_A + times_A.getTOT(thr);
     }
   }
-  for (auto& thr_time_pair : lead_times_B) {
-    int thr = thr_time_pair.first;
-    if ( trail_times_B.count(thr) > 0 ) {
-      TOT_B = TOT_B + trail_times_B[thr] - lead_times_B[thr];
+  for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    if (times_B.hasBothEdges(thr)) {
+      TOT_B = TOT_B + times_B.getTOT(thr);
     }
   }
   float tTOT = (TOT_A + TOT_B) / 1000.; //total TOT in ns
@@ -372,14 +363,12 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
   if (tTOT >= TOTcut[0] && tTOT <= TOTcut[1]) {
 //
 //leading edge
-    for (auto& thr_time_pair : lead_times_A) {
-
-      int thr = thr_time_pair.first;
+    for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
       //**		const char * histo_name_l = Form("%slayer_%d_slot_%d_thr_%d","timeDiffAB_leading_",LayerToCalib,StripToCalib,thr);
       //**const char * histo_name_Ref_l = Form("%slayer_%d_slot_%d_thr_%d","timeDiffRef_leading_",LayerToCalib,StripToCalib,thr);
       //**std::cout << histo_name_l<<" "<<histo_name_l<< std::endl;
-      if ( lead_times_B.count(thr) > 0 ) { // if there was leading time at the same threshold at opposite side
-        double timeDiffAB_l = lead_times_B[thr] - lead_times_A[thr];
+      if (times_A.hasLeading(thr) && times_B.hasLeading(thr)) { // if there was leading time at the same threshold at opposite side
+        double timeDiffAB_l = times_B.getLeading(thr) - times_A.getLeading(thr);
         timeDiffAB_l /= 1000.; // we want the plots in ns instead of ps
 
         // fill the appropriate histogram
@@ -390,7 +379,7 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
 //take minimum time difference between Ref and Scint
         timeDiffLmin = 10000000000000.;
         for (unsigned int i = 0; i < fRefTimesL.size(); i++) {
-          double timeDiffHit_L = (lead_times_A[thr] + lead_times_B[thr]) / 2. - fRefTimesL[i];
+          double timeDiffHit_L = (times_A.getLeading(thr) + times_B.getLeading(thr)) / 2. - fRefTimesL[i];
           timeDiffHit_L = timeDiffHit_L / 1000.; //ps -> ns
           if (fabs(timeDiffHit_L) < timeDiffLmin) {
             timeDiffLmin = timeDiffHit_L;
@@ -407,14 +396,13 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
 
 
 //trailing
-    for (auto& thr_time_pair : trail_times_A) {
-      int thr = thr_time_pair.first;
+    for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
       //**const char * histo_name_t = Form("%slayer_%d_slot_%d_thr_%d","timeDiffAB_trailing_",LayerToCalib,StripToCalib,thr);
       //**const char* histo_name_Ref_t = Form("%slayer_%d_slot_%d_thr_%d","timeDiffRef_trailing_",LayerToCalib,StripToCalib,thr);
 
-      if ( trail_times_B.count(thr) > 0 ) { // if there was trailing time at the same threshold at opposite side
+      if (times_A.hasTrailing(thr) && times_B.hasTrailing(thr)) { // if there was trailing time at the same threshold at opposite side
 
-        double timeDiffAB_t = trail_times_B[thr] - trail_times_A[thr];
+        double timeDiffAB_t = times_B.getTrailing(thr) - times_A.getTrailing(thr);
         timeDiffAB_t /= 1000.; // we want the plots in ns instead of ps
 
         //fill the appropriate histogram
@@ -425,7 +413,7 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
 //taken minimal time difference between Ref and Scint
         timeDiffTmin = 10000000000000.;
         for (unsigned int i = 0; i < fRefTimesT.size(); i++) {
-          double timeDiffHit_T = (trail_times_A[thr] + trail_times_B[thr]) / 2. - fRefTimesT[i];
+          double timeDiffHit_T = (times_A.getTrailing(thr) + times_B.getTrailing(thr)) / 2. - fRefTimesT[i];
           timeDiffHit_T = timeDiffHit_T / 1000.; //ps->ns
           if (fabs(timeDiffHit_T) < timeDiffTmin) {
             timeDiffTmin = timeDiffHit_T;
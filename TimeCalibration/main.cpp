@@ -17,6 +17,8 @@
 #include "../LargeBarrelAnalysis/SignalTransformer.h"
 #include "../LargeBarrelAnalysis/SignalFinder.h"
 #include "../LargeBarrelAnalysis/HitFinder.h"
+#include "../LargeBarrelAnalysis/ReadAheadTools.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 #include <JPetManager/JPetManager.h>
 #include "TimeCalibration.h"
 using namespace std;
@@ -25,11 +27,11 @@ int main(int argc, const char* argv[]) {
   try {
     JPetManager& manager = JPetManager::getManager();
 
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<TimeCalibration>("TimeCalibration");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<TimeCalibration>>("TimeCalibration");
 
     manager.useTask("TimeWindowCreator", "hld", "tslot.calib");
     manager.useTask("SignalFinder", "tslot.calib", "raw.sig");
@@ -37,6 +39,8 @@ int main(int argc, const char* argv[]) {
     manager.useTask("HitFinder", "phys.sig", "hits");
     manager.useTask("TimeCalibration", "hits", "calib");
 
+    ReadAheadTools::enableReadAhead(ReadAheadTools::readSettings(argc, argv));
+
     manager.run(argc, argv);
   } catch (const std::exception& except) {
     std::cerr << "Unrecoverable error occured:" << except.what() << "Exiting the program!" << std::endl;
@@ -14,6 +14,7 @@
  */
 
 #include "TimeCalibration.h"
+#include "../LargeBarrelAnalysis/RawSignalTimes.h"
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include <JPetCommonTools/JPetCommonTools.h>
 
@@ -176,8 +177,8 @@ void TimeCalibration::createHistograms()
 
 bool TimeCalibration::exec()
 {
-  double RefTimeLead[4] = { -1.e43, -1.e43, -1.e43, -1.e43};
-  double RefTimeTrail[4] = { -1.e43, -1.e43, -1.e43, -1.e43};
+  double RefTimeLead = -1.e43;
+  double RefTimeTrail = -1.e43;
   std::vector <JPetHit> histCalib;
   std::vector <double> refTimesL;
   std::vector <double> refTimesT;
@@ -188,20 +189,17 @@ bool TimeCalibration::exec()
       const JPetHit& hit = dynamic_cast<const JPetHit&>(timeWindow->operator[](i));
       int PMid = hit.getSignalB().getRecoSignal().getRawSignal().getPM().getID();
       if (PMid == kPMIdRef) {
-        auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-        auto trail_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
+        RawSignalTimes times_B(hit.getSignalB().getRecoSignal().getRawSignal());
         //
-        for (auto& thr_time_pair : lead_times_B) {
-          int thr = thr_time_pair.first;
-          RefTimeLead[thr] = thr_time_pair.second;
-
+        //only the first threshold of the reference detector is used
+        if (times_B.hasLeading(1)) {
+          RefTimeLead = times_B.getLeading(1);
         }
-        for (auto& thr_time_pair : trail_times_B) {
-          int thr = thr_time_pair.first;
-          RefTimeTrail[thr] = thr_time_pair.second;
+        if (times_B.hasTrailing(1)) {
+          RefTimeTrail = times_B.getTrailing(1);
         }
-        refTimesL.push_back(RefTimeLead[1] / 1000.);
-        refTimesT.push_back(RefTimeTrail[1] / 1000.);
+        refTimesL.push_back(RefTimeLead / 1000.);
+        refTimesT.push_back(RefTimeTrail / 1000.);
       } else {
         if (isInChosenStrip(hit)) {
           histCalib.push_back(hit);
@@ -243,41 +241,33 @@ bool TimeCalibration::CheckIfExit(int Niter)
 
 void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<double>&   refTimesL, const std::vector<double>& refTimesT)
 {
-  auto lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
-
-  auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto trail_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Trailing);
+  RawSignalTimes times_A(hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes times_B(hit.getSignalB().getRecoSignal().getRawSignal());
   float TOT_A = 0.;
   float TOT_B = 0.;
   double timeDiffTmin = 0;
   double timeDiffLmin = 0;
 
-  for (auto& thr_time_pair : lead_times_A) {
-    int thr = thr_time_pair.first;
-
-    if (trail_times_A.count(thr) > 0 ) {
-      TOT_A = TOT_A + trail_times_A[thr] - lead_times_A[thr];
+  for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    if (times_A.hasBothEdges(thr)) {
+      TOT_A = TOT_A + times_A.getTOT(thr);
     }
   }
-  for (auto& thr_time_pair : lead_times_B) {
-    int thr = thr_time_pair.first;
-    if ( trail_times_B.count(thr) > 0 ) {
-      TOT_B = TOT_B + trail_times_B[thr] - lead_times_B[thr];
+  for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    if (times_B.hasBothEdges(thr)) {
+      TOT_B = TOT_B + times_B.getTOT(thr);
     }
   }
   float tTOT = (TOT_A + TOT_B) / 1000.;
   if (tTOT >= TOTcut[0] && tTOT <= TOTcut[1]) {
-    for (auto& thr_time_pair : lead_times_A) {
-
-      int thr = thr_time_pair.first;
-      if ( lead_times_B.count(thr) > 0 ) {
-        double timeDiffAB_l = (lead_times_B[thr] / 1000. + CBlCor[thr]) - (lead_times_A[thr] / 1000. + CAlCor[thr]);
+    for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+      if (times_A.hasLeading(thr) && times_B.hasLeading(thr)) {
+        double timeDiffAB_l = (times_B.getLeading(thr) / 1000. + CBlCor[thr]) - (times_A.getLeading(thr) / 1000. + CAlCor[thr]);
         const char* histo_name_l = formatUniqueSlotDescription(hit.getBarrelSlot(), thr, "timeDiffAB_leading_");
         getStatistics().fillHistogram(histo_name_l, timeDiffAB_l);
         timeDiffLmin = 10000000000000.;
         for (unsigned int i = 0; i < refTimesL.size(); i++) {
-          double timeDiffHit_L = (lead_times_A[thr] / 1000. + CAlCor[thr]) + (lead_times_B[thr] / 1000. + CBlCor[thr]);
+          double timeDiffHit_L = (times_A.getLeading(thr) / 1000. + CAlCor[thr]) + (times_B.getLeading(thr) / 1000. + CBlCor[thr]);
           timeDiffHit_L = timeDiffHit_L / 2. - refTimesL[i];
           if (fabs(timeDiffHit_L) < timeDiffLmin) {
             timeDiffLmin = timeDiffHit_L;
@@ -289,16 +279,15 @@ void TimeCalibration::fillHistosForHit(const JPetHit& hit, const std::vector<dou
         }
       }
     }
-    for (auto& thr_time_pair : trail_times_A) {
-      int thr = thr_time_pair.first;
-      if ( trail_times_B.count(thr) > 0 ) {
+    for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+      if (times_A.hasTrailing(thr) && times_B.hasTrailing(thr)) {
 
-        double timeDiffAB_t = (trail_times_B[thr] / 1000. + CBtCor[thr]) - (trail_times_A[thr] / 1000. + CAtCor[thr]);
+        double timeDiffAB_t = (times_B.getTrailing(thr) / 1000. + CBtCor[thr]) - (times_A.getTrailing(thr) / 1000. + CAtCor[thr]);
         const char* histo_name_t = formatUniqueSlotDescription(hit.getBarrelSlot(), thr, "timeDiffAB_trailing_");
         getStatistics().fillHistogram(histo_name_t, timeDiffAB_t);
         timeDiffTmin = 10000000000000.;
         for (unsigned int i = 0; i < refTimesT.size(); i++) {
-          double timeDiffHit_T = (trail_times_A[thr] / 1000. + CAtCor[thr]) + (trail_times_B[thr] / 1000. + CBtCor[thr]);
+          double timeDiffHit_T = (times_A.getTrailing(thr) / 1000. + CAtCor[thr]) + (times_B.getTrailing(thr) / 1000. + CBtCor[thr]);
           timeDiffHit_T = timeDiffHit_T / 2. - refTimesT[i];
           if (fabs(timeDiffHit_T) < timeDiffTmin) {
             timeDiffTmin = timeDiffHit_T;
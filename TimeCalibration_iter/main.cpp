@@ -19,6 +19,8 @@
 #include "../LargeBarrelAnalysis/SignalFinder.h"
 #include "../LargeBarrelAnalysis/SignalTransformer.h"
 #include "../LargeBarrelAnalysis/HitFinder.h"
+#include "../LargeBarrelAnalysis/ReadAheadTools.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 
 using namespace std;
 
@@ -27,17 +29,18 @@ int main(int argc, const char* argv[])
   try {
     //
     JPetManager& manager = JPetManager::getManager();
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<TimeCalibration>("TimeCalibration");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<TimeCalibration>>("TimeCalibration");
     //
     manager.useTask("TimeWindowCreator", "hld", "tslot.raw");
     manager.useTask("SignalFinder", "tslot.raw", "raw.sig");
     manager.useTask("SignalTransformer", "raw.sig", "phys.sig");
     manager.useTask("HitFinder", "phys.sig", "hits");
     manager.useTask("TimeCalibration", "hits", "calib",-1);
+    ReadAheadTools::enableReadAhead(ReadAheadTools::readSettings(argc, argv));
     manager.run(argc, argv);
 
   } catch (const std::exception& except) {
@@ -16,10 +16,12 @@
 #include "../LargeBarrelAnalysis/EventCategorizerTools.h"
 #include "../LargeBarrelAnalysis/UniversalFileLoader.h"
 #include "../LargeBarrelAnalysis/HitFinderTools.h"
+#include "../LargeBarrelAnalysis/RawSignalTimes.h"
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include <JPetGeomMapping/JPetGeomMapping.h>
 #include <JPetWriter/JPetWriter.h>
 #include "PALSCalibrationTask.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace jpet_options_tools;
@@ -277,35 +279,29 @@ void PALSCalibrationTask::initialiseHistograms(){
 void PALSCalibrationTask::PlotTDiffAB_afterCalibration(JPetHit Hit)
 {
   double TDiff_AB = 0.;
-  std::map<int, double> sigALead = Hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> sigBLead = Hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
+  RawSignalTimes timesA(Hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes timesB(Hit.getSignalB().getRecoSignal().getRawSignal());
   unsigned ScintID = Hit.getScintillator().getID();
   double ABcorrection = 0.;
   
-  std::vector<JPetSigCh> SigCh = Hit.getSignalB().getRecoSignal().getRawSignal().getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
-  if (sigALead.size()>0 && sigBLead.size()>0) {
-    for (unsigned i=1; i<=sigALead.size() && i<=sigBLead.size(); i++) {
-      if (sigBLead.find(i) != sigBLead.end() || sigALead.find(i) != sigALead.end())
-        TDiff_AB = (sigBLead.find(i)->second - sigALead.find(i)->second);
-      else
-        TDiff_AB = 0;
-      ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, SigCh.at(i-1).getDAQch());
-      getStatistics().fillHistogram(Form("TDiff_AB_vs_ID_thr%d_calibrated", i), TDiff_AB - ABcorrection, ScintID);
-    }
+  int numberOfThresholds = std::min(timesA.getNumberOfLeading(), timesB.getNumberOfLeading());
+  for (int i=1; i<=numberOfThresholds; i++) {
+    if (!timesA.hasLeading(i) || !timesB.hasLeading(i))
+      continue;
+    TDiff_AB = timesB.getLeading(i) - timesA.getLeading(i);
+    ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, timesB.getLeadingDAQch(i));
+    getStatistics().fillHistogram(Form("TDiff_AB_vs_ID_thr%d_calibrated", i), TDiff_AB - ABcorrection, ScintID);
   }
 }
 
 void PALSCalibrationTask::PlotLifetimesForThresholds(JPetHit Hit1, JPetHit Hit2)
 {
   double TDiff = 0.;
-  std::map<int, double> sigALeadHit1 = Hit1.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> sigBLeadHit1 = Hit1.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-
-  std::map<int, double> sigALeadHit2 = Hit2.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> sigBLeadHit2 = Hit2.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
+  RawSignalTimes timesAHit1(Hit1.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes timesBHit1(Hit1.getSignalB().getRecoSignal().getRawSignal());
 
-  std::vector<JPetSigCh> SigCh1 = Hit1.getSignalB().getRecoSignal().getRawSignal().getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
-  std::vector<JPetSigCh> SigCh2 = Hit2.getSignalB().getRecoSignal().getRawSignal().getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
+  RawSignalTimes timesAHit2(Hit2.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes timesBHit2(Hit2.getSignalB().getRecoSignal().getRawSignal());
   
   unsigned ScintID_1 = Hit1.getScintillator().getID();
   unsigned ScintID_2 = Hit2.getScintillator().getID();
@@ -314,14 +310,16 @@ void PALSCalibrationTask::PlotLifetimesForThresholds(JPetHit Hit1, JPetHit Hit2)
   double TOFDiff = (POF1 - POF2)/kLightVelocity_cm_ps;
   double PALScorrection = 0., ABcorrection = 0.;
 
-  if (sigALeadHit1.size() > 0 && sigBLeadHit1.size() > 0 && sigALeadHit2.size() > 0 && sigBLeadHit2.size() > 0) {
-    for (unsigned i=1; i<=sigALeadHit1.size() && i<=sigBLeadHit1.size() && i<=sigALeadHit2.size() && i<=sigBLeadHit2.size(); i++) {
-      TDiff = (sigBLeadHit1.find(i)->second + sigALeadHit1.find(i)->second)/2 - (sigBLeadHit2.find(i)->second + sigALeadHit2.find(i)->second)/2;  //TimeHit1 - TimeHit2
-      ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, SigCh1.at(i-1).getDAQch())/2;
-      ABcorrection -= UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, SigCh2.at(i-1).getDAQch())/2;
+  int numberOfThresholds = std::min(std::min(timesAHit1.getNumberOfLeading(), timesBHit1.getNumberOfLeading()),
+                                    std::min(timesAHit2.getNumberOfLeading(), timesBHit2.getNumberOfLeading()));
+  for (int i=1; i<=numberOfThresholds; i++) {
+    if (timesAHit1.hasLeading(i) && timesBHit1.hasLeading(i) && timesAHit2.hasLeading(i) && timesBHit2.hasLeading(i)) {
+      TDiff = (timesBHit1.getLeading(i) + timesAHit1.getLeading(i))/2 - (timesBHit2.getLeading(i) + timesAHit2.getLeading(i))/2;  //TimeHit1 - TimeHit2
+      ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, timesBHit1.getLeadingDAQch(i))/2;
+      ABcorrection -= UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, timesBHit2.getLeadingDAQch(i))/2;
 
-      PALScorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationPALS, SigCh1.at(i-1).getDAQch())/2;
-      PALScorrection -= UniversalFileLoader::getConfigurationParameter(fTimeCalibrationPALS, SigCh2.at(i-1).getDAQch())/2;
+      PALScorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationPALS, timesBHit1.getLeadingDAQch(i))/2;
+      PALScorrection -= UniversalFileLoader::getConfigurationParameter(fTimeCalibrationPALS, timesBHit2.getLeadingDAQch(i))/2;
 
       getStatistics().fillHistogram(Form("PALS_vs_AnnihilationID_thr%d",i), TDiff - TOFDiff - ABcorrection, ScintID_1);
       getStatistics().fillHistogram(Form("PALS_vs_DeexcitationID_thr%d",i), TDiff - TOFDiff - ABcorrection, ScintID_2);
@@ -334,17 +332,14 @@ void PALSCalibrationTask::PlotLifetimesForThresholds(JPetHit Hit1, JPetHit Hit2)
 double PALSCalibrationTask::CorrectZPosition(JPetHit Hit)
 {
   double TDiff = 0., ABcorrection = 0, velocity = 1;;
-  std::map<int, double> sigALead = Hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  std::map<int, double> sigBLead = Hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  
-  std::vector<JPetSigCh> SigCh = Hit.getSignalB().getRecoSignal().getRawSignal().getPoints(JPetSigCh::Leading, JPetRawSignal::ByThrNum);
+  RawSignalTimes timesA(Hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes timesB(Hit.getSignalB().getRecoSignal().getRawSignal());
   
-  if (sigBLead.find(1) != sigBLead.end() || sigALead.find(1) != sigALead.end())
-    TDiff = (sigBLead.find(1)->second - sigALead.find(1)->second);
-  else
-    TDiff = 0;
-  ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, SigCh.at(0).getDAQch());
-  velocity = UniversalFileLoader::getConfigurationParameter(fVelocityCalibration, SigCh.at(0).getDAQch());
+  if (!timesA.hasLeading(1) || !timesB.hasLeading(1))
+    return 0.;
+  TDiff = timesB.getLeading(1) - timesA.getLeading(1);
+  ABcorrection = UniversalFileLoader::getConfigurationParameter(fTimeCalibrationAB, timesB.getLeadingDAQch(1));
+  velocity = UniversalFileLoader::getConfigurationParameter(fVelocityCalibration, timesB.getLeadingDAQch(1));
 
   return (TDiff-ABcorrection)*velocity/2;
 }
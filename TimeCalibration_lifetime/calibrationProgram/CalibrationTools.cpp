@@ -529,21 +529,27 @@ Parameter CalibrationTools::FindMiddle(TH1D* histo, double firstBinCenter, doubl
 {
   Parameter finalEstimatioOfExtremum;
   int filterHalf = (int)(fNumberOfPointsToFilter/2);
-  std::vector<double> Values, Arguments, temp;
+  //Buffers are members, so the projections of all channels reuse the same memory
+  std::vector<double>& Values = fValues;
+  std::vector<double>& Arguments = fArguments;
+  std::vector<double>& FirstDerivative = fFirstDerivative;
+  std::vector<double>& SecondDerivative = fSecondDerivative;
+  fSmoothingBuffer.clear();
+  Arguments.clear();
+  SecondDerivative.clear();
   for (int i=0; i<histo->GetXaxis()->GetNbins(); i++) {
     if (firstBinCenter < histo->GetBinCenter(i) && histo->GetBinCenter(i) < lastBinCenter) {
-      Values.push_back( histo->GetBinContent(i) );
+      fSmoothingBuffer.push_back( histo->GetBinContent(i) );
       Arguments.push_back( histo->GetBinCenter(i) );
     }
   }
   //Smoothing of distribution to decrease influence of statistical fluctuations
-  Values = SmoothByLinearFilter(Values, filterHalf);
-  Values = ReduceBoundaryEffect(Values, filterHalf);
-  Arguments = ReduceBoundaryEffect(Arguments, filterHalf);
+  SmoothByLinearFilter(fSmoothingBuffer, filterHalf, Values);
+  ReduceBoundaryEffectInPlace(Values, filterHalf);
+  ReduceBoundaryEffectInPlace(Arguments, filterHalf);
   
-  std::vector<double> FirstDerivative, SecondDerivative;
-  FirstDerivative = CalculateDerivative(Values);
-  FirstDerivative = SmoothByLinearFilter(FirstDerivative, filterHalf);
+  CalculateDerivative(Values, fSmoothingBuffer);
+  SmoothByLinearFilter(fSmoothingBuffer, filterHalf, FirstDerivative);
 
   unsigned firstEstimationForExtremumBin;
   if (side == Side::MaxAnni || side == Side::MaxDeex) {
@@ -559,7 +565,7 @@ Parameter CalibrationTools::FindMiddle(TH1D* histo, double firstBinCenter, doubl
     finalEstimatioOfExtremum.Value = finalEstimatioOfExtremum.Value - argumentShift;
     
     if (fSaveDerivatives) {
-      DrawDerivatives(titleOfHistogram, side, filterHalf, Arguments, FirstDerivative, temp);
+      DrawDerivatives(titleOfHistogram, side, filterHalf, Arguments, FirstDerivative, SecondDerivative);
     }
   } else if (side == Side::Right || side == Side::Left) {
     //In case of the TDiff BA distributions maximum of the derivative corresponding to the edge on a given side is very sensitive
@@ -567,8 +573,8 @@ Parameter CalibrationTools::FindMiddle(TH1D* histo, double firstBinCenter, doubl
     //Change of the trend and direction of the changing the iterator depends on the side on which we want to estimate and edge
     firstEstimationForExtremumBin = EstimateExtremumBin(FirstDerivative, filterHalf, fNumberOfPointsToFilter, side);
 
-    SecondDerivative = CalculateDerivative(FirstDerivative);
-    SecondDerivative = SmoothByLinearFilter(SecondDerivative, filterHalf);
+    CalculateDerivative(FirstDerivative, fSmoothingBuffer);
+    SmoothByLinearFilter(fSmoothingBuffer, filterHalf, SecondDerivative);
     
     double argumentShift = Arguments.at(firstEstimationForExtremumBin+1) - Arguments.at(firstEstimationForExtremumBin);
 
@@ -583,8 +589,8 @@ Parameter CalibrationTools::FindMiddle(TH1D* histo, double firstBinCenter, doubl
   } else {
     firstEstimationForExtremumBin = EstimateExtremumBin(FirstDerivative, filterHalf, fNumberOfPointsToFilter, Side::Right);
       
-    SecondDerivative = CalculateDerivative(FirstDerivative);
-    SecondDerivative = SmoothByLinearFilter(SecondDerivative, filterHalf);
+    CalculateDerivative(FirstDerivative, fSmoothingBuffer);
+    SmoothByLinearFilter(fSmoothingBuffer, filterHalf, SecondDerivative);
     finalEstimatioOfExtremum.Value = 0;
     double argumentShift = Arguments.at(firstEstimationForExtremumBin+1) - Arguments.at(firstEstimationForExtremumBin);
 
@@ -604,7 +610,7 @@ Parameter CalibrationTools::FindMiddle(TH1D* histo, double firstBinCenter, doubl
 }
 
 //Looking for a maximum in some range (minimalArgument, maximalArgument)
-unsigned FindMaximum(std::vector<double> Values, std::vector<double> Arguments, double minimalArgument, double maximalArgument)
+unsigned FindMaximum(const std::vector<double>& Values, const std::vector<double>& Arguments, double minimalArgument, double maximalArgument)
 {
   double maximum = 0.;
   unsigned maxID = 0;
@@ -619,7 +625,7 @@ unsigned FindMaximum(std::vector<double> Values, std::vector<double> Arguments,
 
 //Finding bin with extremum (maximum or minimum) in order to proceed with more sophisticated methods of finding extremum.
 //Extremum is estimated based on the change in the trend of the moving average
-unsigned CalibrationTools::EstimateExtremumBin(std::vector<double> vector, int filterHalf, unsigned shiftFromFilterHalf, Side side)
+unsigned CalibrationTools::EstimateExtremumBin(const std::vector<double>& vector, int filterHalf, unsigned shiftFromFilterHalf, Side side)
 {
   unsigned extremum = 0;
   unsigned firstPoint = (side == Side::Right) ? vector.size() - shiftFromFilterHalf - 1 : shiftFromFilterHalf;
@@ -661,7 +667,7 @@ unsigned CalibrationTools::EstimateExtremumBin(std::vector<double> vector, int f
 }
 
 //Linear regression to estimate peak between firstPoint and lastPoint
-Parameter CalibrationTools::FindPeak(std::vector<double> arguments, std::vector<double> values, unsigned firstPoint, unsigned lastPoint)
+Parameter CalibrationTools::FindPeak(const std::vector<double>& arguments, const std::vector<double>& values, unsigned firstPoint, unsigned lastPoint)
 {
   unsigned size = lastPoint - firstPoint;
   double meanX=0, meanY=0;
@@ -709,7 +715,7 @@ Parameter CalibrationTools::FindPeak(std::vector<double> arguments, std::vector<
   return peak;
 }
 
-std::pair<int, int> FindRangeForMinimum(const std::vector<double> arguments, const std::vector<double> values, double peakValue)
+std::pair<int, int> FindRangeForMinimum(const std::vector<double>& arguments, const std::vector<double>& values, double peakValue)
 {
   unsigned peakIndex = arguments.size()/2;
   double minDistance = 1000;
@@ -741,7 +747,7 @@ std::pair<int, int> FindRangeForMinimum(const std::vector<double> arguments, con
   return std::make_pair(start, end);
 }
 
-Parameter getSigmaFromFit(const std::vector<double> arguments, const std::vector<double> values, std::pair<int, int> range, std::string title)
+Parameter getSigmaFromFit(const std::vector<double>& arguments, const std::vector<double>& values, std::pair<int, int> range, std::string title)
 {
   int rangeSize = range.second - range.first + 1;
   Parameter sigma;
@@ -1064,8 +1070,8 @@ void DrawPeaksOnHistogram(TH1D *projection_copy1, TH1D *projection_copy2, Parame
 }
 
 //For a better visual feeling derivatives are drawn on the primary distribution (TDiff BA or PALS), following Alek`s idea from presentation
-void DrawDerivatives(std::string titleOfHistogram, Side side, int filterHalf, std::vector<double> arguments, 
-                     std::vector<double> firstDerivativeVector, std::vector<double> secondDerivativeVector)
+void DrawDerivatives(std::string titleOfHistogram, Side side, int filterHalf, const std::vector<double>& arguments, 
+                     const std::vector<double>& firstDerivativeVector, const std::vector<double>& secondDerivativeVector)
 {
   if (arguments.size() < 2 || firstDerivativeVector.size() < 2) {
     std::cerr << "Empty or not sufficient (size < 2) vectors for drawing derivatives" << std::endl;
@@ -1183,55 +1189,84 @@ std::vector<double> GetParamsFromLine(std::string line)
   return ParametersLine;
 }
 
-std::vector<double> CalculateDerivative(std::vector<double> values)
+//Derivative as a difference of neighbouring points, the first point gets the same value as the second one.
+//Output has the size of the input and may be the same range as the input
+void CalculateDerivative(const double* values, unsigned size, double* derivative)
 {
-  std::vector<double> derivative;
-  if (values.size() == 0)
-    return derivative;
-  
-  if (values.size() > 1)
-    derivative.push_back(values.at(1) - values.at(0));
-  else
-    derivative.push_back(0);
-  for (unsigned i=0; i<values.size()-1; i++) {
-    derivative.push_back(values.at(i+1) - values.at(i));
+  if (size == 0)
+    return;
+  for (unsigned i=size-1; i>0; i--) {
+    derivative[i] = values[i] - values[i-1];
   }
-  return derivative;
+  derivative[0] = (size > 1) ? derivative[1] : 0;
 }
 
-std::vector<double> SmoothByLinearFilter(std::vector<double> values, int filterHalf)
+//Moving average over the window [i - h, i + h) divided by 2h + 1, where h = min(filterHalf, i, size - 1 - i),
+//so the window shrinks symmetrically on both boundaries. Both ends of the window only move forward, therefore
+//the sum is updated with the points entering and leaving the window and the whole range is smoothed in O(size).
+//Output has the size of the input and can not be the same range as the input
+void SmoothByLinearFilter(const double* values, unsigned size, int filterHalf, double* smoothed)
 {
-  double sumToFilter;
-  std::vector<double> smoothed = values;
-  unsigned minIterator = 0, maxIterator = 1;
-  for (unsigned i=0; i<values.size(); i++) {
-    sumToFilter = 0.;
-    minIterator = ((i-filterHalf) >= 0 ? (i-filterHalf) : 0);
-    maxIterator = ((i+filterHalf) < values.size() ? (i+filterHalf) : values.size()-1);
-    if (i - minIterator < maxIterator - i) {
-      maxIterator = i + (i - minIterator);
-    } else if (i - minIterator > maxIterator - i) {
-      minIterator = i - (maxIterator - i);
+  unsigned maxHalf = (filterHalf > 0) ? filterHalf : 0;
+  unsigned windowBegin = 0, windowEnd = 0;
+  double sumToFilter = 0.;
+  for (unsigned i=0; i<size; i++) {
+    unsigned half = std::min(maxHalf, std::min(i, size - 1 - i));
+    while (windowEnd < i + half) {
+      sumToFilter += values[windowEnd++];
     }
-    for (unsigned j=minIterator; j<maxIterator; j++) {
-      sumToFilter += values.at(j);
+    while (windowBegin < i - half) {
+      sumToFilter -= values[windowBegin++];
     }
-    smoothed.at(i) = sumToFilter/(maxIterator-minIterator+1);
+    //Empty window - clearing rounding errors accumulated by the running sum
+    if (windowBegin == windowEnd)
+      sumToFilter = 0.;
+    smoothed[i] = sumToFilter/(2*half + 1);
   }
-  return smoothed;
 }
 
-std::vector<double> ReduceBoundaryEffect(std::vector<double> values, int filterHalf)
+void CalculateDerivative(const std::vector<double>& values, std::vector<double>& derivative)
 {
-  std::vector<double> reduced;
+  derivative.resize(values.size());
+  CalculateDerivative(values.data(), values.size(), derivative.data());
+}
+
+void SmoothByLinearFilter(const std::vector<double>& values, int filterHalf, std::vector<double>& smoothed)
+{
+  smoothed.resize(values.size());
+  SmoothByLinearFilter(values.data(), values.size(), filterHalf, smoothed.data());
+}
+
+void ReduceBoundaryEffectInPlace(std::vector<double>& values, int filterHalf)
+{
+  if (filterHalf <= 0)
+    return;
   if ((int)values.size() < 2*filterHalf+1) {
     std::cout << "Could not reduce the boundaries effect after smoothing. Vector is too small to proceed. Vector size: " << values.size() << std::endl;
-    reduced = values;
-  } else {
-    for (unsigned i=filterHalf; i<=values.size()-filterHalf-1; i++) {
-      reduced.push_back(values.at(i));
-    }
+    return;
   }
+  values.erase(values.end() - filterHalf, values.end());
+  values.erase(values.begin(), values.begin() + filterHalf);
+}
+
+std::vector<double> CalculateDerivative(const std::vector<double>& values)
+{
+  std::vector<double> derivative;
+  CalculateDerivative(values, derivative);
+  return derivative;
+}
+
+std::vector<double> SmoothByLinearFilter(const std::vector<double>& values, int filterHalf)
+{
+  std::vector<double> smoothed;
+  SmoothByLinearFilter(values, filterHalf, smoothed);
+  return smoothed;
+}
+
+std::vector<double> ReduceBoundaryEffect(const std::vector<double>& values, int filterHalf)
+{
+  std::vector<double> reduced = values;
+  ReduceBoundaryEffectInPlace(reduced, filterHalf);
   return reduced;
 }
 
@@ -69,8 +69,8 @@ public:
   void FindTOTEdges(std::vector<TH2D*> Histos);
   Parameter FindMiddle(TH1D* histo, double firstBinCenter, double lastBinCenter, 
                                                             Side side, std::string titleOfHistogram);
-  unsigned EstimateExtremumBin(const std::vector<double> vector, int filterHalf, unsigned shiftFromFilterHalf, Side side);
-  Parameter FindPeak(const std::vector<double> arguments, const std::vector<double> values, unsigned firstPoint, unsigned lastPoint);
+  unsigned EstimateExtremumBin(const std::vector<double>& vector, int filterHalf, unsigned shiftFromFilterHalf, Side side);
+  Parameter FindPeak(const std::vector<double>& arguments, const std::vector<double>& values, unsigned firstPoint, unsigned lastPoint);
   
 private:
   const std::string kHistoFileSingleKey = "File_with_histos_single_std::string";
@@ -122,6 +122,11 @@ private:
   std::vector<std::vector<Parameter>> fMaxDeexcitation;
   std::vector<std::vector<Parameter>> fTOTsAnni;
   std::vector<std::vector<Parameter>> fTOTsDeex;
+  std::vector<double> fValues;
+  std::vector<double> fArguments;
+  std::vector<double> fFirstDerivative;
+  std::vector<double> fSecondDerivative;
+  std::vector<double> fSmoothingBuffer;
 };
 
 class EffLengthTools {
@@ -154,17 +159,24 @@ private:
 std::vector<TH2D*> GetHistosFromFile(TFile* fileIn, int numberOfThresholds, std::string calibrationOption, std::string histoName, std::string histoName2);
 void DrawEdgesOnHistogram(TH1D *projection_copy, Parameter middleLeft, Parameter middleRight, std::string titleOfHistogram);
 void DrawPeaksOnHistogram(TH1D *projection_copy1, TH1D *projection_copy2, Parameter middleAnni, Parameter middleDeex, std::string titleOfHistogram);
-void DrawDerivatives(std::string titleOfHistogram, Side side, int filterHalf, std::vector<double> arguments, 
-                     std::vector<double> firstDerivativeVector, std::vector<double> secondDerivativeVector);
+void DrawDerivatives(std::string titleOfHistogram, Side side, int filterHalf, const std::vector<double>& arguments, 
+                     const std::vector<double>& firstDerivativeVector, const std::vector<double>& secondDerivativeVector);
 void PlotCorrectionHistos(std::vector<std::vector<Parameter>> vector1, std::vector<std::vector<Parameter>> vector2, double meanUnc);
-unsigned FindMaximum(std::vector<double> Values, std::vector<double> Arguments, double minimalArgument, double maximalArgument);
-std::pair<int, int> FindRangeForMinimum(const std::vector<double> arguments, const std::vector<double> values, double peakValue);
-Parameter getSigmaFromFit(const std::vector<double> arguments, const std::vector<double> values, std::pair<int, int> range, std::string title);
+unsigned FindMaximum(const std::vector<double>& Values, const std::vector<double>& Arguments, double minimalArgument, double maximalArgument);
+std::pair<int, int> FindRangeForMinimum(const std::vector<double>& arguments, const std::vector<double>& values, double peakValue);
+Parameter getSigmaFromFit(const std::vector<double>& arguments, const std::vector<double>& values, std::pair<int, int> range, std::string title);
 std::vector<double> GetParamsFromLine(std::string line);
 std::vector<std::vector<std::vector<double>>> LoadParametersFromFiles(std::vector<std::string> filenames);
-std::vector<double> CalculateDerivative(std::vector<double> values);
-std::vector<double> SmoothByLinearFilter(std::vector<double> values, int filterHalf);
-std::vector<double> ReduceBoundaryEffect(std::vector<double> values, int filterHalf);
+//Kernels working on ranges of values in O(size), outputs of the size of the inputs are allocated by the caller
+void CalculateDerivative(const double* values, unsigned size, double* derivative);
+void SmoothByLinearFilter(const double* values, unsigned size, int filterHalf, double* smoothed);
+//Output vectors are resized and reuse their memory when called repeatedly
+void CalculateDerivative(const std::vector<double>& values, std::vector<double>& derivative);
+void SmoothByLinearFilter(const std::vector<double>& values, int filterHalf, std::vector<double>& smoothed);
+void ReduceBoundaryEffectInPlace(std::vector<double>& values, int filterHalf);
+std::vector<double> CalculateDerivative(const std::vector<double>& values);
+std::vector<double> SmoothByLinearFilter(const std::vector<double>& values, int filterHalf);
+std::vector<double> ReduceBoundaryEffect(const std::vector<double>& values, int filterHalf);
 Parameter CalculateMeanCorrection(std::vector<std::vector<Parameter>> vector1, std::vector<std::vector<Parameter>> vector2);
 double CalcMeanDiff(std::vector<double> vector1, std::vector<double> vector2);
 void SaveABEdgesResults(std::string oldFileWithConstants, std::string fileWithConstants, std::string fileWithABParametersToVelocity, 
@@ -22,6 +22,8 @@
 #include "../LargeBarrelAnalysis/HitFinderTools.h"
 #include "../LargeBarrelAnalysis/EventFinder.h"
 #include "../LargeBarrelAnalysis/EventCategorizerTools.h"
+#include "../LargeBarrelAnalysis/ReadAheadTools.h"
+#include "../LargeBarrelAnalysis/InstrumentedTask.h"
 
 using namespace std;
 
@@ -29,12 +31,12 @@ int main(int argc, const char* argv[])
 {
   try {
     JPetManager& manager = JPetManager::getManager();
-    manager.registerTask<TimeWindowCreator>("TimeWindowCreator");
-    manager.registerTask<SignalFinder>("SignalFinder");
-    manager.registerTask<SignalTransformer>("SignalTransformer");
-    manager.registerTask<HitFinder>("HitFinder");
-    manager.registerTask<EventFinder>("EventFinder");
-    manager.registerTask<PALSCalibrationTask>("PALSCalibrationTask");
+    manager.registerTask<InstrumentedTask<TimeWindowCreator>>("TimeWindowCreator");
+    manager.registerTask<InstrumentedTask<SignalFinder>>("SignalFinder");
+    manager.registerTask<InstrumentedTask<SignalTransformer>>("SignalTransformer");
+    manager.registerTask<InstrumentedTask<HitFinder>>("HitFinder");
+    manager.registerTask<InstrumentedTask<EventFinder>>("EventFinder");
+    manager.registerTask<InstrumentedTask<PALSCalibrationTask>>("PALSCalibrationTask");
 
     manager.useTask("TimeWindowCreator", "hld", "tslot.raw");
     manager.useTask("SignalFinder", "tslot.raw", "raw.sig");
@@ -42,6 +44,7 @@ int main(int argc, const char* argv[])
     manager.useTask("HitFinder", "phys.sig", "hits");
     manager.useTask("EventFinder", "hits", "unk.evt");
     manager.useTask("PALSCalibrationTask", "unk.evt", "cal.it");
+    ReadAheadTools::enableReadAhead(ReadAheadTools::readSettings(argc, argv));
     manager.run(argc, argv);
 
   } catch (const std::exception& except) {
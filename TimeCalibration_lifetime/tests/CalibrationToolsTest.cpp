@@ -130,6 +130,90 @@ BOOST_AUTO_TEST_CASE(checkFindingMaximum) {
   BOOST_REQUIRE_EQUAL(maximum2, 2);
 }
 
+BOOST_AUTO_TEST_CASE(checkSmoothingByLinearFilter) {
+  std::vector<double> values = {1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> smoothed = SmoothByLinearFilter(values, 2);
+  std::vector<double> expected = {0, 1, 2, 2.8, 3.6, 11./3, 0};
+  BOOST_REQUIRE_EQUAL(smoothed.size(), expected.size());
+  for (unsigned i=0; i<expected.size(); i++) {
+    BOOST_REQUIRE_SMALL(smoothed.at(i) - expected.at(i), 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(checkSmoothingOfSmallVectors) {
+  BOOST_REQUIRE(SmoothByLinearFilter(std::vector<double>(), 3).empty());
+
+  std::vector<double> single = SmoothByLinearFilter(std::vector<double>{5}, 3);
+  BOOST_REQUIRE_EQUAL(single.size(), 1);
+  BOOST_REQUIRE_SMALL(single.at(0), 1e-12);
+
+  std::vector<double> values = {1, 2, 3};
+  std::vector<double> smoothed = SmoothByLinearFilter(values, 10);
+  BOOST_REQUIRE_EQUAL(smoothed.size(), 3);
+  BOOST_REQUIRE_SMALL(smoothed.at(0), 1e-12);
+  BOOST_REQUIRE_CLOSE(smoothed.at(1), 1, kEpsilon);
+  BOOST_REQUIRE_SMALL(smoothed.at(2), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(checkSmoothingRunningSum) {
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+  std::vector<double> values(1000);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  int filterHalf = 3;
+  std::vector<double> smoothed;
+  SmoothByLinearFilter(values, filterHalf, smoothed);
+  const double* firstData = smoothed.data();
+  SmoothByLinearFilter(values, filterHalf, smoothed);
+  BOOST_REQUIRE(firstData == smoothed.data());
+  BOOST_REQUIRE_EQUAL(smoothed.size(), values.size());
+  for (int i=0; i<(int)values.size(); i++) {
+    int half = std::min(filterHalf, std::min(i, (int)values.size() - 1 - i));
+    double sum = 0;
+    for (int j=i-half; j<i+half; j++) {
+      sum += values.at(j);
+    }
+    BOOST_REQUIRE_SMALL(smoothed.at(i) - sum/(2*half + 1), 1e-9);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(checkCalculatingDerivative) {
+  BOOST_REQUIRE(CalculateDerivative(std::vector<double>()).empty());
+
+  std::vector<double> single = CalculateDerivative(std::vector<double>{5});
+  BOOST_REQUIRE_EQUAL(single.size(), 1);
+  BOOST_REQUIRE_SMALL(single.at(0), 1e-12);
+
+  std::vector<double> values = {1, 4, 9, 16};
+  std::vector<double> expected = {3, 3, 5, 7};
+  std::vector<double> derivative = CalculateDerivative(values);
+  BOOST_REQUIRE_EQUAL(derivative.size(), expected.size());
+  CalculateDerivative(values.data(), values.size(), values.data());
+  for (unsigned i=0; i<expected.size(); i++) {
+    BOOST_REQUIRE_CLOSE(derivative.at(i), expected.at(i), kEpsilon);
+    BOOST_REQUIRE_CLOSE(values.at(i), expected.at(i), kEpsilon);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(checkReducingBoundaryEffect) {
+  std::vector<double> values = {1, 2, 3, 4, 5, 6, 7};
+  std::vector<double> reduced = ReduceBoundaryEffect(values, 2);
+  std::vector<double> expected = {3, 4, 5};
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(reduced.begin(), reduced.end(), expected.begin(), expected.end());
+
+  ReduceBoundaryEffectInPlace(values, 0);
+  BOOST_REQUIRE_EQUAL(values.size(), 7);
+  ReduceBoundaryEffectInPlace(values, 3);
+  BOOST_REQUIRE_EQUAL(values.size(), 1);
+  BOOST_REQUIRE_CLOSE(values.at(0), 4, kEpsilon);
+
+  std::vector<double> tooSmall = {1, 2, 3};
+  reduced = ReduceBoundaryEffect(tooSmall, 2);
+  BOOST_REQUIRE_EQUAL_COLLECTIONS(reduced.begin(), reduced.end(), tooSmall.begin(), tooSmall.end());
+}
+
 BOOST_AUTO_TEST_CASE(checkCalculationsMeanDifference) {
   std::vector<double> vector1 = {1, 2, 3, 2, 1, 4, 5, 4, 3, 2, 1};
   double diff = CalcMeanDiff(vector1, vector1);
@@ -38,6 +38,8 @@ bool LORFinder::init() {
 bool LORFinder::exec() {
   if (auto timeWindow = dynamic_cast<const JPetTimeWindow *const>(fEvent)) {
 
+    fLORs.clear();
+    fLOREventIndices.clear();
     for (uint i = 0; i < timeWindow->getNumberOfEvents(); i++) {
       const auto &event =
           dynamic_cast<const JPetEvent &>(timeWindow->operator[](i));
@@ -45,19 +47,31 @@ bool LORFinder::exec() {
       if (event.getHits().size() == 2 &&
           EventCategorizerTools::checkFor2Gamma(event, getStatistics(), false,
                                                 fB2BSlotThetaDiff, fMaxTimeDiff)) {
-
-        // if the event looks like a 2-gamma one,
-        // reconstruct the annihilation point on the LOR
-        TVector3 annihilation_point =
-            EventCategorizerTools::calculateAnnihilationPoint(
-                event.getHits().at(0), event.getHits().at(1));
-        // and store it as a JPetLORevent
-        JPetLORevent lor_event = event;
-        lor_event.setAnnihilationPoint(annihilation_point);
-        fOutputEvents->add<JPetLORevent>(lor_event);
+        // if the event looks like a 2-gamma one, collect its LOR
+        const auto &firstHit = event.getHits().at(0);
+        const auto &secondHit = event.getHits().at(1);
+        fLORs.addLOR(firstHit.getPosX(), firstHit.getPosY(), firstHit.getPosZ(),
+                     firstHit.getTime(), secondHit.getPosX(),
+                     secondHit.getPosY(), secondHit.getPosZ(),
+                     secondHit.getTime());
+        fLOREventIndices.push_back(i);
       }
     }
 
+    // reconstruct the annihilation points on all LORs of the time window
+    AnnihilationPointTools::calculateAnnihilationPoints(fLORs,
+                                                        fAnnihilationPoints);
+
+    // and store them as JPetLORevents
+    for (uint j = 0; j < fLOREventIndices.size(); j++) {
+      JPetLORevent lor_event = dynamic_cast<const JPetEvent &>(
+          timeWindow->operator[](fLOREventIndices[j]));
+      lor_event.setAnnihilationPoint(TVector3(fAnnihilationPoints.x[j],
+                                              fAnnihilationPoints.y[j],
+                                              fAnnihilationPoints.z[j]));
+      fOutputEvents->add<JPetLORevent>(lor_event);
+    }
+
   } else {
     return false;
   }
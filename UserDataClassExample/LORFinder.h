@@ -16,6 +16,7 @@
 #ifndef LORFINDER_H
 #define LORFINDER_H
 
+#include "../LargeBarrelAnalysis/AnnihilationPointTools.h"
 #include <JPetEvent/JPetEvent.h>
 #include <JPetHit/JPetHit.h>
 #include <JPetUserTask/JPetUserTask.h>
@@ -36,5 +37,9 @@ public:
 protected:
   double fB2BSlotThetaDiff = 15.0;
   double fMaxTimeDiff = 1000.;
+  // 2-gamma events of the current time window, with annihilation points calculated in one batch
+  LORBatch fLORs;
+  AnnihilationPointBatch fAnnihilationPoints;
+  std::vector<unsigned int> fLOREventIndices;
 };
 #endif /*  !LORFINDER_H */
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <JPetOptionsTools/JPetOptionsTools.h>
 #include "DeltaTFinder.h"
+#include "../LargeBarrelAnalysis/RawSignalTimes.h"
 
 
 using namespace std;
@@ -167,12 +168,11 @@ bool DeltaTFinder::terminate()
 void DeltaTFinder::fillHistosForHit(const JPetHit& hit)
 {
   
-  auto lead_times_A = hit.getSignalA().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  auto lead_times_B = hit.getSignalB().getRecoSignal().getRawSignal().getTimesVsThresholdNumber(JPetSigCh::Leading);
-  for (auto & thr_time_pair : lead_times_A) {
-    int thr = thr_time_pair.first;
-    if ( lead_times_B.count(thr) > 0 ) { // if there was leading time at the same threshold at opposite side
-      double timeDiffAB = lead_times_A[thr] - lead_times_B[thr];
+  RawSignalTimes times_A(hit.getSignalA().getRecoSignal().getRawSignal());
+  RawSignalTimes times_B(hit.getSignalB().getRecoSignal().getRawSignal());
+  for (int thr = 1; thr <= RawSignalTimes::kMaxThresholds; thr++) {
+    if ( times_A.hasLeading(thr) && times_B.hasLeading(thr) ) { // if there was leading time at the same threshold at opposite side
+      double timeDiffAB = times_A.getLeading(thr) - times_B.getLeading(thr);
       timeDiffAB /= 1000.; // we want the plots in ns instead of ps
       // fill the appropriate histogram
       const char* histo_name = formatUniqueSlotDescription(hit.getBarrelSlot(), thr, "timeDiffAB_");